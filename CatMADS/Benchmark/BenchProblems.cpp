@@ -0,0 +1,120 @@
+#include "BenchProblems.hpp"
+#include <cmath>
+#include <stdexcept>
+
+// The problems below are synthetic mixed-variable variants of classical
+// analytical functions. The categorical variables select shifts, scalings and
+// offsets, so that the best category is not known in advance and interacts
+// with the quantitative variables.
+
+namespace {
+
+    const double PI = 3.14159265358979323846;
+
+    double branin(double x1, double x2) {
+        const double b = 5.1 / (4.0 * PI * PI);
+        const double c = 5.0 / PI;
+        const double t = 1.0 / (8.0 * PI);
+        return std::pow(x2 - b * x1 * x1 + c * x1 - 6.0, 2) + 10.0 * (1.0 - t) * std::cos(x1) + 10.0;
+    }
+
+    // x = (c, x1, x2), c in {0,...,3}
+    void braninCat(const std::vector<double>& x, std::vector<double>& outputs) {
+        const double a[4] = {0.0, 1.5, -2.0, 3.0};
+        const double b[4] = {0.0, -2.0, 3.0, 1.0};
+        const double d[4] = {2.0, 0.5, 1.0, 0.0};
+        const int c = static_cast<int>(x[0]);
+        outputs = { branin(x[1] - a[c], x[2] - b[c]) + d[c] };
+    }
+
+    // x = (c1, c2, x1, ..., x4), c1, c2 in {0,1,2}
+    void rosenbrockCat(const std::vector<double>& x, std::vector<double>& outputs) {
+        const double w[3] = {100.0, 10.0, 1.0};
+        const double s[3] = {0.0, 0.5, -0.5};
+        const double o[3][3] = {{0.5, 1.0, 0.0}, {2.0, 0.2, 1.0}, {1.0, 3.0, 0.8}};
+        const int c1 = static_cast<int>(x[0]);
+        const int c2 = static_cast<int>(x[1]);
+        double f = o[c1][c2];
+        for (size_t i = 2; i + 1 < x.size(); ++i) {
+            f += w[c1] * std::pow(x[i+1] - x[i] * x[i], 2) + std::pow(1.0 - x[i] - s[c2], 2);
+        }
+        outputs = { f };
+    }
+
+    // x = (c, k, x1, x2, x3), c in {0,...,4}, k integer
+    void sphereCatConstrained(const std::vector<double>& x, std::vector<double>& outputs) {
+        const int c = static_cast<int>(x[0]);
+        const double center = c - 2.0;
+        double f = std::pow(x[1] - 1.0, 2) + 0.3 * c;
+        double sum = 0.0;
+        for (size_t i = 2; i < x.size(); ++i) {
+            f += std::pow(x[i] - center, 2);
+            sum += x[i];
+        }
+        outputs = { f, 1.0 - sum, x[1] * x[1] - 4.0 };
+    }
+
+    // x = (c, x1, x2, x3), c in {0,...,3}
+    void styblinskiTangCatConstrained(const std::vector<double>& x, std::vector<double>& outputs) {
+        const double scale[4] = {1.0, 0.8, 1.2, 0.5};
+        const double shift[4] = {0.0, -10.0, 5.0, -20.0};
+        const int c = static_cast<int>(x[0]);
+        double f = 0.0, sum = 0.0;
+        for (size_t i = 1; i < x.size(); ++i) {
+            f += std::pow(x[i], 4) - 16.0 * x[i] * x[i] + 5.0 * x[i];
+            sum += x[i];
+        }
+        outputs = { 0.5 * scale[c] * f + shift[c], sum - 2.0 + 0.5 * c };
+    }
+
+    std::vector<BenchProblem> makeBenchProblems() {
+        std::vector<BenchProblem> problems;
+
+        problems.push_back({"BraninCat", 1, 0, 2, {4},
+                            {-5.0, 0.0}, {10.0, 15.0},
+                            {NOMAD::BBOutputType::OBJ},
+                            braninCat});
+
+        problems.push_back({"RosenbrockCat", 2, 0, 4, {3, 3},
+                            std::vector<double>(4, -2.0), std::vector<double>(4, 2.0),
+                            {NOMAD::BBOutputType::OBJ},
+                            rosenbrockCat});
+
+        problems.push_back({"SphereCat_constrained", 1, 1, 3, {5},
+                            std::vector<double>(4, -5.0), std::vector<double>(4, 5.0),
+                            {NOMAD::BBOutputType::OBJ, NOMAD::BBOutputType::PB, NOMAD::BBOutputType::PB},
+                            sphereCatConstrained});
+
+        problems.push_back({"StyblinskiTangCat_constrained", 1, 0, 3, {4},
+                            std::vector<double>(3, -5.0), std::vector<double>(3, 5.0),
+                            {NOMAD::BBOutputType::OBJ, NOMAD::BBOutputType::PB},
+                            styblinskiTangCatConstrained});
+
+        return problems;
+    }
+}
+
+
+int BenchProblem::nbCategoriesTotal() const {
+    int total = 0;
+    for (auto l : nbCategories) {
+        total += l;
+    }
+    return total;
+}
+
+
+const std::vector<BenchProblem>& getBenchProblems() {
+    static const std::vector<BenchProblem> problems = makeBenchProblems();
+    return problems;
+}
+
+
+const BenchProblem& getBenchProblem(const std::string& name) {
+    for (const auto& problem : getBenchProblems()) {
+        if (problem.name == name) {
+            return problem;
+        }
+    }
+    throw std::runtime_error("Unknown benchmark problem: " + name);
+}
@@ -0,0 +1,35 @@
+#ifndef CATMADS_BENCH_PROBLEMS_HPP
+#define CATMADS_BENCH_PROBLEMS_HPP
+
+#include "Nomad/nomad.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+// Analytical mixed-variable problem used by catmads_bench.
+// Variables are ordered as in the CatMADS problems: categorical, integer, continuous.
+// A categorical variable takes the values 0, ..., nbCategories-1.
+struct BenchProblem {
+    std::string name;
+    int Ncat;
+    int Nint;
+    int Ncon;
+    std::vector<int> nbCategories;          // one entry per categorical variable
+    std::vector<double> lowerBound;         // integer and continuous variables only
+    std::vector<double> upperBound;
+    NOMAD::BBOutputTypeList bbOutputTypes;  // OBJ first, then constraints
+    // Fill the outputs (objective then constraints, g <= 0 is feasible)
+    std::function<void(const std::vector<double>& x, std::vector<double>& outputs)> eval;
+
+    int dimension() const { return Ncat + Nint + Ncon; }
+    bool isConstrained() const { return bbOutputTypes.size() > 1; }
+    int nbCategoriesTotal() const;
+};
+
+// Table of the registered problems
+const std::vector<BenchProblem>& getBenchProblems();
+
+// Find a problem by name. Throws if not found.
+const BenchProblem& getBenchProblem(const std::string& name);
+
+#endif
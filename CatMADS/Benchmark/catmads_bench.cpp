@@ -0,0 +1,596 @@
+// catmads_bench: run the analytical problem set for several seeds and
+// compute evaluations-to-target, optimizer overhead and data profiles.
+//
+// Usage: catmads_bench [--problems=name1,name2] [--seeds=n | --seeds=first-last]
+//                      [--jobs=n] [--out=dir] [--evals-per-var=n]
+//                      [--solver=mads|catmads] [--python=path] [--list]
+//
+// NOMAD keeps the cache, the evaluator control and the output queue in
+// process-wide singletons, so two optimizations cannot share a process.
+// Each (problem, seed) job runs in a forked worker; up to --jobs workers run
+// at the same time. Workers write their evaluation history in the output
+// directory, and the parent process computes the metrics when all jobs are done.
+//
+// With --solver=catmads, the CatMADS callbacks (categorical poll, speculative
+// search, extended poll) are used. They call the Python scripts of CatMADS with
+// the interpreter given by --python. The scripts exchange data with the
+// optimizer through fixed files in CatMADS/readwrite_files, so CatMADS jobs
+// run one at a time and these files are removed before each job.
+
+#include "BenchProblems.hpp"
+#include "CatMADS.hpp"
+#include "MyExtendedPoll/MyExtendedPollMethod2.hpp"
+#include "Nomad/nomad.hpp"
+#include "Algos/EvcInterface.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+
+namespace {
+
+    // Tolerances of the convergence test f(x) <= fL + tau (f0 - fL)
+    const std::vector<double> TAUS = {1e-1, 1e-3, 1e-5, 1e-7};
+
+    struct BenchOptions {
+        std::vector<std::string> problems;
+        std::vector<int> seeds;
+        size_t nbJobs = 1;
+        std::string outDir = "catmads_bench_out";
+        int nbEvalsPerVariable = 10;  // same budget rule as CatMADS: N * nbEvalsPerVariable
+        double lhsRatio = 0.2;        // same LHS budget rule as CatMADS
+        bool useCatMads = false;
+        std::string pythonEnv;
+    };
+
+    struct Job {
+        std::string problem;
+        int seed;
+    };
+
+    struct EvalRecord {
+        double f;
+        double h;
+        double evalTime;
+    };
+
+    struct RunResult {
+        Job job;
+        int dimension = 0;
+        std::vector<EvalRecord> history;
+        double wallTime = 0.0;
+        double evalTime = 0.0;
+        bool ok = false;
+    };
+
+
+    /*----------------------------------------*/
+    /*               Evaluator                */
+    /*----------------------------------------*/
+    class BenchEvaluator : public NOMAD::Evaluator {
+    private:
+        const BenchProblem& _problem;
+        mutable std::vector<EvalRecord> _history;
+
+    public:
+        BenchEvaluator(const std::shared_ptr<NOMAD::EvalParameters>& evalParams, const BenchProblem& problem)
+        : NOMAD::Evaluator(evalParams, NOMAD::EvalType::BB),
+          _problem(problem)
+        {}
+
+        const std::vector<EvalRecord>& getHistory() const { return _history; }
+
+        bool eval_x(NOMAD::EvalPoint &x, const NOMAD::Double &NOMAD_UNUSED(hMax), bool &countEval) const override {
+            const auto startTime = std::chrono::steady_clock::now();
+
+            std::vector<double> xv(x.size());
+            for (size_t i = 0; i < x.size(); ++i) {
+                xv[i] = x[i].todouble();
+            }
+            std::vector<double> outputs;
+            _problem.eval(xv, outputs);
+
+            std::ostringstream bbo;
+            bbo << std::setprecision(17);
+            double h = 0.0;
+            for (size_t i = 0; i < outputs.size(); ++i) {
+                bbo << (i > 0 ? " " : "") << outputs[i];
+                if (i > 0 && outputs[i] > 0.0) {
+                    h += outputs[i] * outputs[i];
+                }
+            }
+            x.setBBO(bbo.str());
+            countEval = true;
+
+            const std::chrono::duration<double> evalTime = std::chrono::steady_clock::now() - startTime;
+            _history.push_back({outputs[0], h, evalTime.count()});
+            return true;
+        }
+    };
+
+
+    std::string jobFileName(const BenchOptions& options, const Job& job, const std::string& extension) {
+        return options.outDir + "/" + job.problem + ".s" + std::to_string(job.seed) + extension;
+    }
+
+
+    void initAllParams(const std::shared_ptr<NOMAD::AllParameters>& allParams, const BenchProblem& problem,
+                       int seed, const BenchOptions& options) {
+        const int N = problem.dimension();
+        const int nbEvals = N * options.nbEvalsPerVariable;
+        const int nbEvalsLHS = static_cast<int>(nbEvals * options.lhsRatio);
+
+        allParams->setAttributeValue("DIMENSION", static_cast<size_t>(N));
+        allParams->setAttributeValue("MAX_BB_EVAL", static_cast<size_t>(nbEvals));
+        std::string budgetLHsFormat = std::to_string(nbEvalsLHS) + " 0";
+        allParams->setAttributeValue("LH_SEARCH", NOMAD::LHSearchType(budgetLHsFormat.c_str()));
+
+        // Categorical variables are integers 0, ..., L-1
+        auto lb = NOMAD::ArrayOfDouble(N, 0.0);
+        auto ub = NOMAD::ArrayOfDouble(N, 0.0);
+        NOMAD::BBInputTypeList bbinput;
+        for (int i = 0; i < problem.Ncat; ++i) {
+            ub[i] = problem.nbCategories[i] - 1;
+            bbinput.push_back(NOMAD::BBInputType::INTEGER);
+        }
+        for (int i = problem.Ncat; i < N; ++i) {
+            lb[i] = problem.lowerBound[i - problem.Ncat];
+            ub[i] = problem.upperBound[i - problem.Ncat];
+            bbinput.push_back(i < problem.Ncat + problem.Nint ? NOMAD::BBInputType::INTEGER : NOMAD::BBInputType::CONTINUOUS);
+        }
+        allParams->setAttributeValue("LOWER_BOUND", lb);
+        allParams->setAttributeValue("UPPER_BOUND", ub);
+        allParams->setAttributeValue("BB_INPUT_TYPE", bbinput);
+        allParams->setAttributeValue("BB_OUTPUT_TYPE", problem.bbOutputTypes);
+
+        if (options.useCatMads) {
+            // Same setup as the CatMADS problems: categorical user poll,
+            // Ortho 2N on the quantitative variables, quad model search
+            // with the categorical variables fixed, speculative user search.
+            NOMAD::VariableGroup vgCat, vgQuant;
+            for (int i = 0; i < N; ++i) {
+                (i < problem.Ncat ? vgCat : vgQuant).insert(static_cast<size_t>(i));
+            }
+            allParams->setAttributeValue("VARIABLE_GROUP", NOMAD::ListOfVariableGroup({vgCat, vgQuant}));
+            allParams->setAttributeValue("DIRECTION_TYPE", NOMAD::DirectionTypeList({NOMAD::DirectionType::USER_FREE_POLL,
+                                                                                     NOMAD::DirectionType::ORTHO_2N}));
+            allParams->setAttributeValue("QUAD_MODEL_SEARCH", true);
+            allParams->setAttributeValue("NM_SEARCH", false);
+            allParams->setAttributeValue("SPECULATIVE_SEARCH", false);
+            allParams->setAttributeValue("USER_SEARCH", true);
+        }
+
+        allParams->setAttributeValue("DISPLAY_DEGREE", 0);
+        allParams->setAttributeValue("SEED", seed);
+        allParams->setAttributeValue("RNG_ALT_SEEDING", true);
+
+        allParams->checkAndComply();
+    }
+
+
+    // Run a single optimization. Called in a worker process.
+    int runJob(const BenchOptions& options, const Job& job) {
+        const auto& problem = getBenchProblem(job.problem);
+
+        NOMAD::MainStep TheMainStep;
+        auto params = std::make_shared<NOMAD::AllParameters>();
+        initAllParams(params, problem, job.seed, options);
+        TheMainStep.setAllParameters(params);
+
+        auto ev = std::make_shared<BenchEvaluator>(params->getEvalParams(), problem);
+        TheMainStep.setEvaluator(ev);
+
+        const auto startTime = std::chrono::steady_clock::now();
+        TheMainStep.start();
+
+        std::shared_ptr<NOMAD::Mads> mads;
+        if (options.useCatMads) {
+            NOMAD::VariableGroup vgCat, vgQuant;
+            for (int i = 0; i < problem.dimension(); ++i) {
+                (i < problem.Ncat ? vgCat : vgQuant).insert(static_cast<size_t>(i));
+            }
+            auto catMadsProblem = CatMadsProblem::fromParameters(*params, vgCat);
+            // Do not use the files of a previous job.
+            std::remove(catMadsProblem->fileCache().c_str());
+            std::remove(catMadsProblem->fileCatDirections().c_str());
+            std::remove(catMadsProblem->fileParams().c_str());
+            if (!options.pythonEnv.empty()) {
+                catMadsProblem->pythonEnv = options.pythonEnv;
+            }
+            catMadsProblem->nbEvalsPerVariable = options.nbEvalsPerVariable;
+            catMadsProblem->ratioEvalsLHS = options.lhsRatio;
+
+            NOMAD::EvcInterface::getEvaluatorControl()->setUserCompMethod(std::make_shared<CustomOrder>());
+            NOMAD::EvalCallbackFunc<NOMAD::CallbackType::POST_EVAL_UPDATE> cbPostEvalUpdate =
+                [catMadsProblem](NOMAD::EvalQueuePointPtr& evalQueuePoint) { customPostEvalUpdateCB(*catMadsProblem, evalQueuePoint); };
+            NOMAD::EvcInterface::getEvaluatorControl()->addEvalCallback<NOMAD::CallbackType::POST_EVAL_UPDATE>(cbPostEvalUpdate);
+
+            mads = std::dynamic_pointer_cast<NOMAD::Mads>(TheMainStep.getAlgo(NOMAD::StepType::ALGORITHM_MADS));
+            if (nullptr == mads) {
+                throw NOMAD::Exception(__FILE__, __LINE__, "Cannot access to Mads algorithm");
+            }
+            registerCatMadsProblem(mads.get(), catMadsProblem);
+            mads->addCallback(NOMAD::CallbackType::USER_METHOD_SEARCH, userSearchMethodCallbackSpeculative);
+            mads->addCallback(NOMAD::CallbackType::USER_METHOD_FREE_POLL, userPollMethodCallback);
+            params->getRunParams()->setListFixVGForQuadModelSearch(params->getPbParams(), {vgCat});
+            std::map<NOMAD::DirectionType, NOMAD::ListOfVariableGroup> mapDirTypeToVG =
+                {{NOMAD::DirectionType::USER_FREE_POLL, {vgCat}}, {NOMAD::DirectionType::ORTHO_2N, {vgQuant}}};
+            params->getRunParams()->setMapDirTypeToVG(params->getPbParams(), mapDirTypeToVG);
+            std::shared_ptr<NOMAD::Evaluator> evBase = ev;
+            mads->setExtendedPollMethod(std::make_unique<MyExtendedPollMethod2>(mads, evBase));
+        }
+
+        TheMainStep.run();
+        TheMainStep.end();
+        if (nullptr != mads) {
+            unregisterCatMadsProblem(mads.get());
+        }
+        const std::chrono::duration<double> wallTime = std::chrono::steady_clock::now() - startTime;
+
+        double evalTime = 0.0;
+        std::ofstream hist(jobFileName(options, job, ".hist"));
+        hist << std::setprecision(17);
+        for (const auto& record : ev->getHistory()) {
+            hist << record.f << " " << record.h << " " << record.evalTime << "\n";
+            evalTime += record.evalTime;
+        }
+        hist.close();
+
+        // The run file is written last: its presence means the job completed.
+        std::ofstream run(jobFileName(options, job, ".run"));
+        run << std::setprecision(17);
+        run << "dimension " << problem.dimension() << "\n";
+        run << "wall_time " << wallTime.count() << "\n";
+        run << "eval_time " << evalTime << "\n";
+        run.close();
+
+        return (hist.fail() || run.fail()) ? 1 : 0;
+    }
+
+
+    // Run the jobs, at most nbJobs at the same time.
+    void runAllJobs(const BenchOptions& options, const std::vector<Job>& jobs) {
+#ifndef _WIN32
+        std::map<pid_t, size_t> running;
+        size_t next = 0;
+        while (next < jobs.size() || !running.empty()) {
+            while (running.size() < options.nbJobs && next < jobs.size()) {
+                const pid_t pid = fork();
+                if (pid < 0) {
+                    throw std::runtime_error("catmads_bench: fork failed");
+                }
+                if (0 == pid) {
+                    // Worker: keep NOMAD messages in a log file.
+                    const std::string logFile = jobFileName(options, jobs[next], ".log");
+                    if (nullptr == std::freopen(logFile.c_str(), "w", stdout)) {
+                        _exit(2);
+                    }
+                    dup2(fileno(stdout), fileno(stderr));
+                    int status = 1;
+                    try {
+                        status = runJob(options, jobs[next]);
+                    }
+                    catch (std::exception& e) {
+                        std::cerr << "catmads_bench: " << e.what() << std::endl;
+                    }
+                    std::fflush(stdout);
+                    _exit(status);
+                }
+                std::cerr << "Started " << jobs[next].problem << " seed " << jobs[next].seed << std::endl;
+                running[pid] = next++;
+            }
+
+            int status = 0;
+            const pid_t pid = waitpid(-1, &status, 0);
+            if (pid < 0) {
+                throw std::runtime_error("catmads_bench: waitpid failed");
+            }
+            auto it = running.find(pid);
+            if (it != running.end()) {
+                const auto& job = jobs[it->second];
+                if (!WIFEXITED(status) || 0 != WEXITSTATUS(status)) {
+                    std::cerr << "Job " << job.problem << " seed " << job.seed << " failed. See "
+                              << jobFileName(options, job, ".log") << std::endl;
+                }
+                running.erase(it);
+            }
+        }
+#else
+        // No fork: jobs are run one after the other in this process.
+        for (const auto& job : jobs) {
+            std::cerr << "Running " << job.problem << " seed " << job.seed << std::endl;
+            runJob(options, job);
+        }
+#endif
+    }
+
+
+    RunResult readRunResult(const BenchOptions& options, const Job& job) {
+        RunResult result;
+        result.job = job;
+
+        std::ifstream run(jobFileName(options, job, ".run"));
+        std::string key;
+        double value;
+        while (run >> key >> value) {
+            if ("dimension" == key) {
+                result.dimension = static_cast<int>(value);
+            } else if ("wall_time" == key) {
+                result.wallTime = value;
+            } else if ("eval_time" == key) {
+                result.evalTime = value;
+            }
+        }
+        if (0 == result.dimension) {
+            return result;
+        }
+
+        std::ifstream hist(jobFileName(options, job, ".hist"));
+        EvalRecord record;
+        while (hist >> record.f >> record.h >> record.evalTime) {
+            result.history.push_back(record);
+        }
+        result.ok = true;
+        return result;
+    }
+
+
+    // Best feasible value after each evaluation (INF while no feasible point)
+    std::vector<double> bestFeasibleTrajectory(const RunResult& result) {
+        std::vector<double> best;
+        double current = INFINITY;
+        for (const auto& record : result.history) {
+            if (0.0 == record.h && record.f < current) {
+                current = record.f;
+            }
+            best.push_back(current);
+        }
+        return best;
+    }
+
+
+    // Number of evaluations to satisfy f <= fL + tau (f0 - fL), or -1.
+    // f0 is the first feasible value of the run.
+    int evalsToTarget(const std::vector<double>& best, double fL, double tau) {
+        double f0 = INFINITY;
+        for (size_t k = 0; k < best.size(); ++k) {
+            if (best[k] < INFINITY) {
+                if (f0 == INFINITY) {
+                    f0 = best[k];
+                }
+                if (best[k] <= fL + tau * (f0 - fL)) {
+                    return static_cast<int>(k + 1);
+                }
+            }
+        }
+        return -1;
+    }
+
+
+    void writeResults(const BenchOptions& options, const std::vector<RunResult>& results) {
+        // Reference value per problem: best feasible value over all seeds
+        std::map<std::string, double> fL;
+        std::vector<std::vector<double>> bestTrajectories;
+        for (const auto& result : results) {
+            bestTrajectories.push_back(bestFeasibleTrajectory(result));
+            const double best = bestTrajectories.back().empty() ? INFINITY : bestTrajectories.back().back();
+            auto it = fL.find(result.job.problem);
+            if (it == fL.end() || best < it->second) {
+                fL[result.job.problem] = best;
+            }
+        }
+
+        // Evaluations to target for all runs and tolerances
+        std::vector<std::vector<int>> nbEvalsToTarget(results.size());
+        for (size_t r = 0; r < results.size(); ++r) {
+            for (auto tau : TAUS) {
+                nbEvalsToTarget[r].push_back(evalsToTarget(bestTrajectories[r], fL[results[r].job.problem], tau));
+            }
+        }
+
+        std::ofstream out(options.outDir + "/results.csv");
+        out << std::setprecision(10);
+        out << "problem,seed,dimension,nb_evals,best_feasible_f,wall_time,eval_time,overhead";
+        for (auto tau : TAUS) {
+            out << ",evals_to_target_" << tau;
+        }
+        out << "\n";
+        for (size_t r = 0; r < results.size(); ++r) {
+            const auto& result = results[r];
+            const double best = bestTrajectories[r].empty() ? INFINITY : bestTrajectories[r].back();
+            out << result.job.problem << "," << result.job.seed << "," << result.dimension << ","
+                << result.history.size() << "," << best << "," << result.wallTime << ","
+                << result.evalTime << "," << result.wallTime - result.evalTime;
+            for (auto nbEvals : nbEvalsToTarget[r]) {
+                out << "," << nbEvals;
+            }
+            out << "\n";
+        }
+        out.close();
+
+        // Data profiles: fraction of (problem, seed) runs solved within
+        // alpha simplex gradients, i.e. alpha (n+1) evaluations.
+        int maxAlpha = 0;
+        for (const auto& result : results) {
+            maxAlpha = std::max(maxAlpha, static_cast<int>(result.history.size()) / (result.dimension + 1) + 1);
+        }
+        std::ofstream profile(options.outDir + "/data_profile.csv");
+        profile << "tau,alpha,fraction\n";
+        for (size_t t = 0; t < TAUS.size(); ++t) {
+            for (int alpha = 0; alpha <= maxAlpha; ++alpha) {
+                size_t nbSolved = 0;
+                for (size_t r = 0; r < results.size(); ++r) {
+                    const int nbEvals = nbEvalsToTarget[r][t];
+                    if (nbEvals > 0 && nbEvals <= alpha * (results[r].dimension + 1)) {
+                        nbSolved++;
+                    }
+                }
+                profile << TAUS[t] << "," << alpha << ","
+                        << static_cast<double>(nbSolved) / static_cast<double>(results.size()) << "\n";
+            }
+        }
+        profile.close();
+
+        // Summary on the console
+        double totalWall = 0.0, totalOverhead = 0.0;
+        for (const auto& result : results) {
+            totalWall += result.wallTime;
+            totalOverhead += result.wallTime - result.evalTime;
+        }
+        std::cout << results.size() << " runs. Total optimization time " << totalWall
+                  << " s, optimizer overhead " << totalOverhead << " s." << std::endl;
+        std::cout << "Results written in " << options.outDir << "/results.csv and "
+                  << options.outDir << "/data_profile.csv" << std::endl;
+    }
+
+
+    std::vector<std::string> splitString(const std::string& s, char sep) {
+        std::vector<std::string> items;
+        std::istringstream iss(s);
+        std::string item;
+        while (std::getline(iss, item, sep)) {
+            if (!item.empty()) {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+
+    bool startsWith(const std::string& s, const std::string& prefix, std::string& value) {
+        if (0 == s.compare(0, prefix.size(), prefix)) {
+            value = s.substr(prefix.size());
+            return true;
+        }
+        return false;
+    }
+
+
+    void displayUsage(const char* exeName) {
+        std::cerr << "Usage: " << exeName << " [--problems=name1,name2] [--seeds=n | --seeds=first-last]"
+                  << " [--jobs=n] [--out=dir] [--evals-per-var=n] [--solver=mads|catmads] [--python=path] [--list]"
+                  << std::endl;
+    }
+}
+
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    options.nbJobs = std::max(1u, std::thread::hardware_concurrency());
+    for (int s = 0; s < 10; ++s) {
+        options.seeds.push_back(s);
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        std::string value;
+        if (startsWith(arg, "--problems=", value)) {
+            options.problems = splitString(value, ',');
+        } else if (startsWith(arg, "--seeds=", value)) {
+            options.seeds.clear();
+            const auto dash = value.find('-');
+            const int first = (std::string::npos == dash) ? 0 : std::stoi(value.substr(0, dash));
+            const int last = (std::string::npos == dash) ? std::stoi(value) - 1 : std::stoi(value.substr(dash + 1));
+            for (int s = first; s <= last; ++s) {
+                options.seeds.push_back(s);
+            }
+        } else if (startsWith(arg, "--jobs=", value)) {
+            options.nbJobs = std::max(1, std::stoi(value));
+        } else if (startsWith(arg, "--out=", value)) {
+            options.outDir = value;
+        } else if (startsWith(arg, "--evals-per-var=", value)) {
+            options.nbEvalsPerVariable = std::max(1, std::stoi(value));
+        } else if (startsWith(arg, "--solver=", value)) {
+            if ("catmads" != value && "mads" != value) {
+                displayUsage(argv[0]);
+                return 1;
+            }
+            options.useCatMads = ("catmads" == value);
+        } else if (startsWith(arg, "--python=", value)) {
+            options.pythonEnv = value;
+        } else if ("--list" == arg) {
+            for (const auto& problem : getBenchProblems()) {
+                std::cout << problem.name << " (Ncat=" << problem.Ncat << ", Nint=" << problem.Nint
+                          << ", Ncon=" << problem.Ncon << ", Lcat=" << problem.nbCategoriesTotal()
+                          << (problem.isConstrained() ? ", constrained" : "") << ")" << std::endl;
+            }
+            return 0;
+        } else {
+            displayUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (options.problems.empty()) {
+        for (const auto& problem : getBenchProblems()) {
+            options.problems.push_back(problem.name);
+        }
+    }
+
+    std::vector<Job> jobs;
+    try {
+        for (const auto& name : options.problems) {
+            getBenchProblem(name);  // Check the name before starting any job
+            for (auto seed : options.seeds) {
+                jobs.push_back({name, seed});
+            }
+        }
+    }
+    catch (std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    if (jobs.empty()) {
+        displayUsage(argv[0]);
+        return 1;
+    }
+    if (options.useCatMads && options.nbJobs > 1) {
+        // All CatMADS jobs share the files of CatMADS/readwrite_files.
+        std::cerr << "CatMADS jobs share the files of readwrite_files: running 1 job at a time." << std::endl;
+        options.nbJobs = 1;
+    }
+
+#ifndef _WIN32
+    mkdir(options.outDir.c_str(), 0755);
+#endif
+    // Remove the results of a previous run, so that a failed job is not mistaken for a completed one.
+    for (const auto& job : jobs) {
+        std::remove(jobFileName(options, job, ".run").c_str());
+    }
+
+    const auto startTime = std::chrono::steady_clock::now();
+    runAllJobs(options, jobs);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+    std::vector<RunResult> results;
+    for (const auto& job : jobs) {
+        auto result = readRunResult(options, job);
+        if (result.ok) {
+            results.push_back(result);
+        }
+    }
+    if (results.empty()) {
+        std::cerr << "No job completed." << std::endl;
+        return 1;
+    }
+    writeResults(options, results);
+    std::cout << "Elapsed time with " << options.nbJobs << " jobs: " << elapsed.count() << " s" << std::endl;
+
+    return (results.size() == jobs.size()) ? 0 : 1;
+}
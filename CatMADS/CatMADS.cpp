@@ -14,26 +14,113 @@
 #include "Util/AllStopReasons.hpp"
 #include "Math/MatrixUtils.hpp"
 #include "Math/RNG.hpp"
+#ifdef TIME_STATS
+#include "Util/Instrumentation.hpp"
+#endif
 
-// Setup variables for all problems
-std::string basePath = "/home/edhal/CatMADS_prototype_Porifera/CatMADS/";  // MUST BE HARDCODED FOR PROTOTYPE IMPLEMENTATION
-std::string pythonEnv = "/home/edhal/gp-catmads-env/bin/python"; // MUST BE HARDCODED FOR PROTOTYPE IMPLEMENTATION
-const int nbEvalsPerVariable=10; //250
-const int nbEvals = N*nbEvalsPerVariable; // N is initialized in a problem specific folder
-const int nbEvalsLHS=static_cast<int>(nbEvals*0.2); //0.2 for GPCatMADS 
-int nbCatNeighbors = std::max(2, static_cast<int>(std::sqrt(Lcat)));
-const int seedSetup = 0; 
+#include <cmath>
+#include <mutex>
 
 
-// Paths
-std::string fileCache = basePath + "readwrite_files/cachePts.txt";
-std::string fileCatDirections = basePath + "readwrite_files/catDirections.txt";
-std::string fileParams = basePath + "readwrite_files/params.pkl";
+// --------------------- Problem description ---------------------- //
+CatMadsProblem::CatMadsProblem(int ncat, int nint, int ncon, int lcat, const NOMAD::BBOutputTypeList& bbot)
+    : Ncat(ncat), Nint(nint), Ncon(ncon), Lcat(lcat), bbOutputTypeList(bbot)
+{
+    if (Ncat < 0 || Nint < 0 || Ncon < 0 || N() == 0) {
+        throw NOMAD::Exception(__FILE__, __LINE__, "CatMadsProblem: invalid number of variables.");
+    }
+    for (int i = 0; i < Ncat; ++i) {
+        catVariables.insert(static_cast<size_t>(i));
+    }
+    nbCatNeighbors = std::max(2, static_cast<int>(std::sqrt(Lcat)));
+}
+
+
+std::shared_ptr<CatMadsProblem> CatMadsProblem::fromParameters(const NOMAD::AllParameters& allParams,
+                                                               const NOMAD::VariableGroup& catVariables)
+{
+    const auto pbParams = allParams.getPbParams();
+    const auto n = pbParams->getAttributeValue<size_t>("DIMENSION");
+    const auto lb = pbParams->getAttributeValue<NOMAD::ArrayOfDouble>("LOWER_BOUND");
+    const auto ub = pbParams->getAttributeValue<NOMAD::ArrayOfDouble>("UPPER_BOUND");
+    const auto bbInputTypes = pbParams->getAttributeValue<NOMAD::BBInputTypeList>("BB_INPUT_TYPE");
+    const auto bbot = allParams.getEvalParams()->getAttributeValue<NOMAD::BBOutputTypeList>("BB_OUTPUT_TYPE");
+
+    // Number of categories of each categorical variable is given by its bounds
+    int lcat = 0;
+    for (auto i : catVariables) {
+        if (i >= n || !lb[i].isDefined() || !ub[i].isDefined()) {
+            throw NOMAD::Exception(__FILE__, __LINE__, "CatMadsProblem: categorical variables must have bounds.");
+        }
+        lcat += static_cast<int>(ub[i].todouble() - lb[i].todouble()) + 1;
+    }
+    int nint = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (catVariables.end() == catVariables.find(i) && NOMAD::BBInputType::INTEGER == bbInputTypes[i]) {
+            nint++;
+        }
+    }
+    const int ncat = static_cast<int>(catVariables.size());
+    auto problem = std::make_shared<CatMadsProblem>(ncat, nint, static_cast<int>(n) - ncat - nint, lcat, bbot);
+    problem->catVariables = catVariables;
+    problem->seed = allParams.getAttributeValue<int>("SEED");
+    return problem;
+}
+
+
+bool CatMadsProblem::isQuantitativeDirection(const NOMAD::Direction& dir) const
+{
+    for (auto i : catVariables) {
+        if (dir[i] != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void CatMadsProblem::resetRunState()
+{
+    LastSuccessIsQuantitative = false;
+    LastSuccessIsCategorical = false;
+    isCatDistanceUpdated = true;
+}
 
-// Python scripts
-//std::string simpleCategoricalDist = basePath + "python_scripts/simple_cat_distance.py";
-std::string simpleCategoricalDist = basePath + "python_scripts/Porifera_cat_distance.py";
-std::string catPoll = basePath + "python_scripts/cat_neighbors.py";
+
+namespace {
+    std::mutex catMadsProblemsMutex;
+    std::map<const NOMAD::Mads*, std::shared_ptr<CatMadsProblem>> catMadsProblems;
+}
+
+
+void registerCatMadsProblem(const NOMAD::Mads* mads, const std::shared_ptr<CatMadsProblem>& problem)
+{
+    if (nullptr == mads || nullptr == problem) {
+        throw NOMAD::Exception(__FILE__, __LINE__, "registerCatMadsProblem: null Mads or problem.");
+    }
+    std::lock_guard<std::mutex> lock(catMadsProblemsMutex);
+    catMadsProblems[mads] = problem;
+}
+
+
+void unregisterCatMadsProblem(const NOMAD::Mads* mads)
+{
+    std::lock_guard<std::mutex> lock(catMadsProblemsMutex);
+    catMadsProblems.erase(mads);
+}
+
+
+CatMadsProblem& getCatMadsProblem(const NOMAD::Step& step)
+{
+    auto mads = dynamic_cast<const NOMAD::Mads*>(step.getRootAlgorithm());
+    std::lock_guard<std::mutex> lock(catMadsProblemsMutex);
+    auto it = catMadsProblems.find(mads);
+    if (nullptr == mads || it == catMadsProblems.end()) {
+        throw NOMAD::Exception(__FILE__, __LINE__, "No CatMADS problem registered for this Mads.");
+    }
+    return *(it->second);
+}
+// --------------------- Problem description ---------------------- //
 
 
 // Comparison with comp function
@@ -121,8 +208,10 @@ bool userPollMethodCallback(const NOMAD::Step& step, std::list<NOMAD::Direction>
     // Reset directions
     dirs.clear();
 
+    auto& problem = getCatMadsProblem(step);
+
     // Rrun this script only if nbCatNeighbors is nonzero
-    if (nbCatNeighbors == 0) {
+    if (problem.nbCatNeighbors == 0) {
         // Skip execution if no neighbors are defined
         return false; 
     }
@@ -143,27 +232,28 @@ bool userPollMethodCallback(const NOMAD::Step& step, std::list<NOMAD::Direction>
     }
     
     // Problem information for computing categorical neighbors below
-    writeCacheToFile(step, fileCache, nbCatNeighbors);
+    writeCacheToFile(step, problem);
 
 
     // Construct distance
-    if (isCatDistanceUpdated){
+    if (problem.isCatDistanceUpdated){
 
         // This is constructs the categorical distance 
         // For prototype implementation, it is done once after the DoE (first poll)
-        int exitCode = runPythonScript(pythonEnv, simpleCategoricalDist);  
+        int exitCode = runPythonScript(problem.pythonEnv, problem.simpleCategoricalDist());  
         
         // Stop updating model/distance 
         if (exitCode==1){
-            isCatDistanceUpdated = false;
+            problem.isCatDistanceUpdated = false;
         }
     }
 
     // Generates a text file with directions for cat directions 
-    runPythonScript(pythonEnv, catPoll);   
+    runPythonScript(problem.pythonEnv, problem.catPoll());   
 
     // Read categorical neighbors
-    auto catDirections = readTextFile(fileCatDirections, FileType::CatDirections);
+    auto catDirections = readTextFile(problem.fileCatDirections(), FileType::CatDirections);
+    const size_t N = problem.N();
 
     // -- Store directions -- //
     for (const auto& direction : catDirections) {
@@ -187,7 +277,9 @@ bool userSearchMethodCallbackSpeculative(const NOMAD::Step& step, NOMAD::EvalPoi
 
     trialPoints.clear();
 
-    if (LastSuccessIsQuantitative)
+    const auto& problem = getCatMadsProblem(step);
+
+    if (problem.LastSuccessIsQuantitative)
     {
 
         NOMAD::SpeculativeSearchMethod speculativeSearch(&step);
@@ -204,14 +296,7 @@ bool userSearchMethodCallbackSpeculative(const NOMAD::Step& step, NOMAD::EvalPoi
                 {
                     // Safety check that categorical variables aren't modified
                     auto dir = NOMAD::EvalPoint::vectorize(*(tp.getX()), *(tp.getPointFrom()->getX()));
-                    bool allCatDirectionsZeros = true;
-                    for (int i = 0; i < Ncat; ++i){
-                        if (dir[i] != 0){
-                            allCatDirectionsZeros = false;
-                            break;
-                        }
-                    }
-                    if (allCatDirectionsZeros)
+                    if (problem.isQuantitativeDirection(dir))
                     {
                         trialPoints.insert(tp);
                     }
@@ -230,11 +315,11 @@ bool userSearchMethodCallbackSpeculative(const NOMAD::Step& step, NOMAD::EvalPoi
 
 
 // Post evaluation callback: keep track of the type of success (either quantitative or categorical)      
-void customPostEvalUpdateCB(NOMAD::EvalQueuePointPtr& evaluatedQueuePoint)
+void customPostEvalUpdateCB(CatMadsProblem& problem, NOMAD::EvalQueuePointPtr& evaluatedQueuePoint)
 {
-    // Reset global variables to false 
-    LastSuccessIsQuantitative = false;
-    LastSuccessIsCategorical = false;
+    // Reset run state to false 
+    problem.LastSuccessIsQuantitative = false;
+    problem.LastSuccessIsCategorical = false;
 
     if (nullptr != evaluatedQueuePoint->getEval(NOMAD::EvalType::BB) && evaluatedQueuePoint->getEvalStatus(NOMAD::EvalType::BB) == NOMAD::EvalStatusType::EVAL_OK )
     {
@@ -250,21 +335,12 @@ void customPostEvalUpdateCB(NOMAD::EvalQueuePointPtr& evaluatedQueuePoint)
                 // Retrieve successful direction
                 auto dir = NOMAD::EvalPoint::vectorize(*(evaluatedQueuePoint->getX()), *(evaluatedQueuePoint->getPointFrom()));                
 
-                // We could access to the variable group here by using step pbParam.
-                // Workaround for now is to use a global variable.
-                bool allCatDirectionsZeros = true;
-                for (int i = 0; i < Ncat; ++i){
-                    if (dir[i] != 0){
-                        allCatDirectionsZeros = false;
-                        break;
-                    }
-                }
-                if (allCatDirectionsZeros){
-                    LastSuccessIsQuantitative = true;
+                if (problem.isQuantitativeDirection(dir)){
+                    problem.LastSuccessIsQuantitative = true;
                 }
                 else
                 {
-                    LastSuccessIsCategorical = true;
+                    problem.LastSuccessIsCategorical = true;
                 }
             }
             
@@ -279,7 +355,7 @@ void customPostEvalUpdateCB(NOMAD::EvalQueuePointPtr& evaluatedQueuePoint)
 
 // --------------------- Utility functions ---------------------- //
 // Write NOMAD cache into a text file
-void writeCacheToFile(const NOMAD::Step& step, const std::string& filePathWriteCache, int nbCatNeighbors) {
+void writeCacheToFile(const NOMAD::Step& step, const CatMadsProblem& problem) {
     auto mads = dynamic_cast<const NOMAD::Mads*>(step.getRootAlgorithm());
     if (nullptr == mads) {
         throw NOMAD::Exception(__FILE__, __LINE__, "No Mads available.");
@@ -322,7 +398,7 @@ void writeCacheToFile(const NOMAD::Step& step, const std::string& filePathWriteC
 
         pointToPrint = barrier->getCurrentIncumbentFeas();
 
-        if (IsConstrained){
+        if (problem.isConstrained()){
             pointToPrint2 = barrier->getCurrentIncumbentInf();
         }
         else{
@@ -349,7 +425,7 @@ void writeCacheToFile(const NOMAD::Step& step, const std::string& filePathWriteC
     }
     
     NOMAD::Double bestInfVal;
-    if (IsConstrained & !(pointToPrint2==nullptr)){
+    if (problem.isConstrained() && !(pointToPrint2==nullptr)){
             bestInfVal = pointToPrint2->getF(computeType);
         }
     else{
@@ -364,13 +440,13 @@ void writeCacheToFile(const NOMAD::Step& step, const std::string& filePathWriteC
     // -- Evaluated points -- //
 
     // -- Print pb info state and points -- //
-    std::ofstream ptsCache(filePathWriteCache);
+    std::ofstream ptsCache(problem.fileCache());
     if (!ptsCache.is_open()) {
         std::cerr << "Unable to open cache file for writing." << std::endl;
         return;
     }
     ptsCache << "Variable types: " << bbInputTypes << "\n";
-    ptsCache << "Number of cat, int and cont: " << Ncat << " " << Nint << " " << Ncon << "\n";
+    ptsCache << "Number of cat, int and cont: " << problem.Ncat << " " << problem.Nint << " " << problem.Ncon << "\n";
     ptsCache << "Lower bounds: " << lowerBound << "\n";
     ptsCache << "Upper bounds: " << upperBound << "\n";
     ptsCache << "Current step: " << stepStr << "\n";
@@ -378,7 +454,7 @@ void writeCacheToFile(const NOMAD::Step& step, const std::string& filePathWriteC
         ptsCache << "Current frame (poll) or feasible (search) : " << *(pointToPrint->getX()) << "\n";
     }
     else{
-        ptsCache << "Current frame (poll) or feasible (search) : " << NOMAD::ArrayOfDouble(N) << "\n";
+        ptsCache << "Current frame (poll) or feasible (search) : " << NOMAD::ArrayOfDouble(problem.N()) << "\n";
     }
     if (!(pointToPrint2==nullptr))
     {
@@ -386,12 +462,12 @@ void writeCacheToFile(const NOMAD::Step& step, const std::string& filePathWriteC
 
     }
     else{
-        ptsCache << "Current frame (poll) or infeasible (search): " << NOMAD::ArrayOfDouble(N) << "\n";
+        ptsCache << "Current frame (poll) or infeasible (search): " << NOMAD::ArrayOfDouble(problem.N()) << "\n";
     }
     ptsCache << "Best current function values: " << bestFeasVal << " " << bestInfVal << " " << hMax << "\n";
-    ptsCache << "Nb of cat neighbors: " << nbCatNeighbors << "\n";
-    ptsCache << "Seed: " << seedSetup << "\n";
-    ptsCache << "Budget per variables: " << nbEvalsPerVariable << "\n";
+    ptsCache << "Nb of cat neighbors: " << problem.nbCatNeighbors << "\n";
+    ptsCache << "Seed: " << problem.seed << "\n";
+    ptsCache << "Budget per variables: " << problem.nbEvalsPerVariable << "\n";
 
 
     for (const auto& evalPoint : evalPointList) {
@@ -409,6 +485,10 @@ void writeCacheToFile(const NOMAD::Step& step, const std::string& filePathWriteC
 int runPythonScript(const std::string& pythonEnv, const std::string& scriptPath) {
     std::string command = pythonEnv + " " + scriptPath;
 
+#ifdef TIME_STATS
+    NOMAD::Instrumentation::incCounter(NOMAD::InstrumentationCounter::EXTERNAL_CALL);
+#endif
+
     // Execute the command and capture the exit code
     int exitCode = system(command.c_str());
 
@@ -2,52 +2,89 @@
 #define CATMADS_HPP
 
 #include "Nomad/nomad.hpp"
+#include "Algos/Mads/Mads.hpp"
 #include <vector>
 #include <list>
 #include <string>
 #include <map>
+#include <memory>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 
-// Global setup variables fix or same formula for all problems: initialized in GPCatMADS.cpp
-extern std::string basePath;
-extern std::string pythonEnv;
-extern const int nbEvalsPerVariable;
-extern const int nbEvals; // formula based on nbEvalsPerVariable in GPCatMADS.cpp
-extern const int nbEvalsLHS; // formula based on nbEvals in GPCatMADS.cpp
-extern int nbCatNeighbors; // formula based on the number of categories Lcat
-extern const int seedSetup; // to automize the optimization runs on the seed-based instances
-
-// Global variables specific for each problem: initialized in problem file
-extern const int Ncat;
-extern const int Nint;
-extern const int Ncon;
-extern const int N;
-extern const int Lcat; // total nb of categories 
-extern bool LastSuccessIsQuantitative;
-extern bool LastSuccessIsCategorical;
-extern bool isCatDistanceUpdated;
-extern const NOMAD::BBOutputTypeList bbOutputTypeListSetup;
-extern const bool IsConstrained;
-
-
-
-// Path variables
-extern std::string fileCache;
-extern std::string fileCatDirections;
-extern std::string fileParams;
+// Description of a CatMADS problem, built at runtime.
+// The categorical variables are coded as integers 0, ..., L-1 and form a group
+// of variables. The run state (type of last success, distance update flag) is
+// also kept here, so that a process can solve several problems one after the other.
+class CatMadsProblem {
+public:
+    // Setup of the problem
+    int Ncat;
+    int Nint;
+    int Ncon;
+    int Lcat; // total nb of categories
+    NOMAD::BBOutputTypeList bbOutputTypeList;
+    NOMAD::VariableGroup catVariables; // indices of the categorical variables
+
+    // Setup variables fix or same formula for all problems
+    int nbEvalsPerVariable = 10; //250
+    double ratioEvalsLHS = 0.2; //0.2 for GPCatMADS
+    int nbCatNeighbors; // formula based on the number of categories Lcat
+    int seed = 0; // to automize the optimization runs on the seed-based instances
+
+    // Paths
+#ifdef CATMADS_BASE_PATH
+    std::string basePath = CATMADS_BASE_PATH;
+#else
+    std::string basePath = "/home/edhal/CatMADS_prototype_Porifera/CatMADS/";  // MUST BE SET FOR PROTOTYPE IMPLEMENTATION
+#endif
+    std::string pythonEnv = "/home/edhal/gp-catmads-env/bin/python"; // MUST BE SET FOR PROTOTYPE IMPLEMENTATION
+
+    // Run state
+    bool LastSuccessIsQuantitative = false;
+    bool LastSuccessIsCategorical = false;
+    bool isCatDistanceUpdated = true; // only update once, it is toggle to false after first categorical poll
+
+    // The categorical variables are the first Ncat variables
+    CatMadsProblem(int ncat, int nint, int ncon, int lcat, const NOMAD::BBOutputTypeList& bbot);
+
+    // Build from the parameters: categorical group, bounds (category counts), input and output types.
+    // Parameters must have been checked.
+    static std::shared_ptr<CatMadsProblem> fromParameters(const NOMAD::AllParameters& allParams,
+                                                          const NOMAD::VariableGroup& catVariables);
+
+    int N() const { return Ncat + Nint + Ncon; }
+    int nbEvals() const { return N() * nbEvalsPerVariable; }
+    int nbEvalsLHS() const { return static_cast<int>(nbEvals() * ratioEvalsLHS); }
+    bool isConstrained() const { return bbOutputTypeList.size() > 1; }
+
+    // Is the direction zero on all categorical variables
+    bool isQuantitativeDirection(const NOMAD::Direction& dir) const;
+
+    // Read/write files and Python scripts
+    std::string fileCache() const { return basePath + "readwrite_files/cachePts.txt"; }
+    std::string fileCatDirections() const { return basePath + "readwrite_files/catDirections.txt"; }
+    std::string fileParams() const { return basePath + "readwrite_files/params.pkl"; }
+    //std::string simpleCategoricalDist() const { return basePath + "python_scripts/simple_cat_distance.py"; }
+    std::string simpleCategoricalDist() const { return basePath + "python_scripts/Porifera_cat_distance.py"; }
+    std::string catPoll() const { return basePath + "python_scripts/cat_neighbors.py"; }
+
+    // Reset the run state before a new optimization
+    void resetRunState();
+};
 
-// Python scripts paths
-extern std::string simpleCategoricalDist;
-extern std::string catPoll;
+// The CatMADS callbacks find the problem through the root Mads of the calling step.
+void registerCatMadsProblem(const NOMAD::Mads* mads, const std::shared_ptr<CatMadsProblem>& problem);
+void unregisterCatMadsProblem(const NOMAD::Mads* mads);
+CatMadsProblem& getCatMadsProblem(const NOMAD::Step& step);
 
 
 // Callback for CAT-MADS
 bool userPollMethodCallback(const NOMAD::Step& step, std::list<NOMAD::Direction>& dirs, const size_t& n);
 bool userSearchMethodCallbackSpeculative(const NOMAD::Step& step, NOMAD::EvalPointSet & trialPoints);
-void customPostEvalUpdateCB(NOMAD::EvalQueuePointPtr& evaluatedQueuePoint);
+// Post eval callback has no step: bind the problem, ex. with a lambda
+void customPostEvalUpdateCB(CatMadsProblem& problem, NOMAD::EvalQueuePointPtr& evaluatedQueuePoint);
 
 
 class CustomOrder : public NOMAD::OrderByEval {
@@ -64,7 +101,7 @@ public:
 
 
 // Utility functions
-void writeCacheToFile(const NOMAD::Step& step, const std::string& filePathWriteCache, int nbCatNeighbors);
+void writeCacheToFile(const NOMAD::Step& step, const CatMadsProblem& problem);
 int runPythonScript(const std::string& pythonEnv, const std::string& scriptPath);
 enum class FileType { CatDirections, EGODirection, PollPtsSurrogateEval, CatImprovement };
 std::vector<std::vector<double>> readTextFile(const std::string& filePath, FileType fileType);
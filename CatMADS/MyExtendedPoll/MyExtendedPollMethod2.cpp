@@ -6,7 +6,7 @@
 
 #include "MyExtendedPollMethod2.hpp"
 #include "MySimpleMads.hpp"
-#include "../CatMADS/CatMADS.hpp"  // for global variables in CatMADS
+#include "../CatMADS/CatMADS.hpp"  // for the CatMADS problem description
 
 
 void MyExtendedPollMethod2::init()
@@ -117,23 +117,19 @@ bool MyExtendedPollMethod2::runOptim(const NOMAD::EvalPoint & pp, NOMAD::EvalPoi
     //
     // Set optim parameters
     //
-    auto optPbParams = std::make_shared<NOMAD::PbParameters>(*_pbParams);
-    auto optRunParams = std::make_shared<NOMAD::RunParameters>(*_runParams);
+    // The parameters common to all sub-optimizations are set once, when the pool is created.
+    if (nullptr == _subsolveParamsPool)
+    {
+        auto evcParams = evc->getEvaluatorControlGlobalParams();
+        _subsolveParamsPool = std::make_unique<NOMAD::SubsolveParametersPool>(_pbParams, _runParams, evcParams,
+            [](NOMAD::PbParameters&, NOMAD::RunParameters& runParams)
+            {
+                // No need for anisotropic mesh changes.
+                // Keep the current anisotropy in the mesh/frame
+                runParams.setAttributeValue("ANISOTROPIC_MESH", false);
+            });
+    }
 
-    // Set min mesh size.
-    optPbParams->setAttributeValue("MIN_FRAME_SIZE", currentIterationFrameSize);
-    
-    // Set initial frame size.
-    // Need to reset initial mesh size.
-    // When undefined, initial mesh size is computed from initial frame size
-    // in checkAndComply
-    optPbParams->setAttributeValue("INITIAL_FRAME_SIZE", currentIterationFrameSize);
-    optPbParams->resetToDefaultValue("INITIAL_MESH_SIZE");
-    
-    // No need for anisotropic mesh changes.
-    // Keep the current anisotropy in the mesh/frame
-    optRunParams->setAttributeValue("ANISOTROPIC_MESH", false);
-    
     // What variables need to be fixed in optim -> categorical variables are in group 1
     auto lvg = _pbParams->getAttributeValue<NOMAD::ListOfVariableGroup>("VARIABLE_GROUP");
     auto it_front = lvg.begin(); // Cat variables are in first group. Otherwise use std::advance(it_front, xxx);
@@ -144,18 +140,13 @@ bool MyExtendedPollMethod2::runOptim(const NOMAD::EvalPoint & pp, NOMAD::EvalPoi
     {
         fixedVar[*it_ind] = pp[*it_ind];
     }
-    optPbParams->setAttributeValue("FIXED_VARIABLE", fixedVar);
     
     NOMAD::ArrayOfPoint x0s{*pp.getX()};
-    optPbParams->setAttributeValue("X0", x0s);
 
-    // We do not want certain warnings appearing in sub-optimization.
-    optPbParams->doNotShowWarnings();
-    optPbParams->checkAndComply();
-    
-    // Check and comply for run params
-    auto evcParams = evc->getEvaluatorControlGlobalParams();
-    optRunParams->checkAndComply(evcParams, optPbParams);
+    // Set min and initial frame sizes. Initial mesh size is computed from initial frame size.
+    // Only these attributes, X0 and fixed variables are updated: the other parameters are already checked.
+    auto optPbParams = _subsolveParamsPool->acquirePbParams(x0s, fixedVar, currentIterationFrameSize, currentIterationFrameSize);
+    auto optRunParams = _subsolveParamsPool->getRunParams();
     
     // Bb output type list is passed to MySimpleMads -> needed for eval
     auto bbot = evc->getCurrentEvalParams()->getAttributeValue<NOMAD::BBOutputTypeList>("BB_OUTPUT_TYPE");
@@ -166,7 +157,7 @@ bool MyExtendedPollMethod2::runOptim(const NOMAD::EvalPoint & pp, NOMAD::EvalPoi
     
     // Find remaining budget of evaluations to avoid extra evaluations by the Extended Poll
     auto nbEvalsDone = evc->getBbEval();
-    auto budgetTotal = _pbParams->getAttributeValue<size_t>("DIMENSION") * nbEvalsPerVariable;
+    auto budgetTotal = getCatMadsProblem(*this).nbEvals();
     int  remainingBudget = budgetTotal - nbEvalsDone;
 
 
@@ -2,6 +2,7 @@
 #include "Algos/AlgoStopReasons.hpp"
 #include "Algos/Mads/ExtendedPollMethod.hpp"
 #include "Eval/Evaluator.hpp"
+#include "Param/SubsolveParametersPool.hpp"
 
 
 /// Class to perform a custom extended poll method.
@@ -11,6 +12,9 @@ TODO explain custom method
 class MyExtendedPollMethod2 : public NOMAD::ExtendedPollMethod
 {
     shared_ptr<NOMAD::Evaluator> _my_evaluator ;
+
+    // Parameters of the sub-optimizations: copied and checked once, updated in place for each sub-optimization.
+    std::unique_ptr<NOMAD::SubsolveParametersPool> _subsolveParamsPool;
     
 public:
     /// Constructor
@@ -16,34 +16,18 @@
 #include "../CatMADS/MyExtendedPoll/MyExtendedPollMethod2.hpp"
 
 
-// Setup of the problem
-const int Ncat=2;
-const int Nint=0;
-const int Ncon=2;
-const int N=Ncat+Nint+Ncon;
-const int Lcat=81;
-const NOMAD::BBOutputTypeList bbOutputTypeListSetup = {NOMAD::BBOutputType::OBJ, 
-                                                        NOMAD::BBOutputType::PB, NOMAD::BBOutputType::EB,
-                                                        NOMAD::BBOutputType::PB, NOMAD::BBOutputType::PB,
-                                                        NOMAD::BBOutputType::PB, NOMAD::BBOutputType::PB,
-                                                        NOMAD::BBOutputType::PB, NOMAD::BBOutputType::PB};
-const bool IsConstrained = true;
-
-// Global variables
-bool LastSuccessIsQuantitative = false;
-bool LastSuccessIsCategorical = false;
-bool isCatDistanceUpdated = true; // only update once, it is toggle to false after first categorical poll
-
 /*----------------------------------------*/
 /*               The problem              */
 /*----------------------------------------*/
 class My_Evaluator : public NOMAD::Evaluator
 {
 private:
+    const size_t _n;
 
 public:
-    My_Evaluator(const std::shared_ptr<NOMAD::EvalParameters>& evalParams)
-    : NOMAD::Evaluator(evalParams, NOMAD::EvalType::BB)
+    My_Evaluator(const std::shared_ptr<NOMAD::EvalParameters>& evalParams, size_t n)
+    : NOMAD::Evaluator(evalParams, NOMAD::EvalType::BB),
+      _n(n)
     {}
 
     ~My_Evaluator() {}
@@ -60,7 +44,7 @@ bool My_Evaluator::eval_x(NOMAD::EvalPoint &x,
                           bool &countEval) const
 {
     // Ensure the input dimension matches the expected size
-    if (x.size() != (N)) // n_cat + n_int + n_con
+    if (x.size() != _n) // n_cat + n_int + n_con
     {
         throw NOMAD::Exception(__FILE__, __LINE__, "Dimension mismatch: Ensure the number of variables matches n_cat + n_int + n_con.");
     }
@@ -102,17 +86,18 @@ bool My_Evaluator::eval_x(NOMAD::EvalPoint &x,
 }
 
 
-void initAllParams( std::shared_ptr<NOMAD::AllParameters> allParams, std::map<NOMAD::DirectionType,NOMAD::ListOfVariableGroup> & myMapDirTypeToVG, NOMAD::ListOfVariableGroup & myListFixVGForQMS)
+void initAllParams( std::shared_ptr<NOMAD::AllParameters> allParams, const CatMadsProblem& problem, std::map<NOMAD::DirectionType,NOMAD::ListOfVariableGroup> & myMapDirTypeToVG, NOMAD::ListOfVariableGroup & myListFixVGForQMS)
 {
 
     // Parameters creation
+    const int N = problem.N();
     allParams->setAttributeValue("DIMENSION", N);
     // Black-box evaluations
-    allParams->setAttributeValue("MAX_BB_EVAL", nbEvals);
+    allParams->setAttributeValue("MAX_BB_EVAL", problem.nbEvals());
     // Starting point
     //allParams->setAttributeValue("X0", NOMAD::Point(N, 0.0) );
     // LHS
-    std::string budgetLHsFormat = std::to_string(nbEvalsLHS) + " 0";
+    std::string budgetLHsFormat = std::to_string(problem.nbEvalsLHS()) + " 0";
     allParams->setAttributeValue("LH_SEARCH", NOMAD::LHSearchType(budgetLHsFormat.c_str()));
 
     // Bounds for all variables 
@@ -153,7 +138,7 @@ void initAllParams( std::shared_ptr<NOMAD::AllParameters> allParams, std::map<NO
     myMapDirTypeToVG = {{dtList[0],{vg0}},{dtList[1],{vg1}}};
     
     // Constraints and objective
-    allParams->setAttributeValue("BB_OUTPUT_TYPE", bbOutputTypeListSetup);
+    allParams->setAttributeValue("BB_OUTPUT_TYPE", problem.bbOutputTypeList);
 
     // Quad search where the first group of variables is fixed
     allParams->setAttributeValue("QUAD_MODEL_SEARCH", true);
@@ -172,7 +157,7 @@ void initAllParams( std::shared_ptr<NOMAD::AllParameters> allParams, std::map<NO
     allParams->setAttributeValue("DISPLAY_ALL_EVAL", true);
 
     // Fix seed for duplicity of results
-    allParams->setAttributeValue("SEED", seedSetup);
+    allParams->setAttributeValue("SEED", problem.seed);
     allParams->setAttributeValue("RNG_ALT_SEEDING", true);
 
     // File history for convergence plots and profiles
@@ -190,12 +175,19 @@ void initAllParams( std::shared_ptr<NOMAD::AllParameters> allParams, std::map<NO
 int main ( int argc , char ** argv )
 {
 
-    
+    // Setup of the problem: Ncat=2, Nint=0, Ncon=2, Lcat=81
+    const NOMAD::BBOutputTypeList bbOutputTypeList = {NOMAD::BBOutputType::OBJ, 
+                                                      NOMAD::BBOutputType::PB, NOMAD::BBOutputType::EB,
+                                                      NOMAD::BBOutputType::PB, NOMAD::BBOutputType::PB,
+                                                      NOMAD::BBOutputType::PB, NOMAD::BBOutputType::PB,
+                                                      NOMAD::BBOutputType::PB, NOMAD::BBOutputType::PB};
+    auto problem = std::make_shared<CatMadsProblem>(2, 0, 2, 81, bbOutputTypeList);
+
     // List of files to clear
     std::vector<std::string> filesToClear = {
-        fileCache,
-        fileCatDirections,
-        fileParams
+        problem->fileCache(),
+        problem->fileCatDirections(),
+        problem->fileParams()
     };
 
     // Clear the files at the start
@@ -213,11 +205,11 @@ int main ( int argc , char ** argv )
     // List of fix variable group for Quad model search
     NOMAD::ListOfVariableGroup myListFixVGForQMS;
 
-    initAllParams(params, myMapDirTypeToVG, myListFixVGForQMS);
+    initAllParams(params, *problem, myMapDirTypeToVG, myListFixVGForQMS);
     TheMainStep.setAllParameters(params);
 
     // Custom Evaluator
-    std::shared_ptr<NOMAD::Evaluator> ev(new My_Evaluator(params->getEvalParams()));
+    std::shared_ptr<NOMAD::Evaluator> ev(new My_Evaluator(params->getEvalParams(), problem->N()));
     TheMainStep.setEvaluator(std::move(ev));
     
     // Main step start initializes Mads (default algorithm)
@@ -229,7 +221,8 @@ int main ( int argc , char ** argv )
 
 
     // Define post eval callback
-    NOMAD::EvalCallbackFunc<NOMAD::CallbackType::POST_EVAL_UPDATE> cbPostEvalUpdate = customPostEvalUpdateCB;
+    NOMAD::EvalCallbackFunc<NOMAD::CallbackType::POST_EVAL_UPDATE> cbPostEvalUpdate =
+        [problem](NOMAD::EvalQueuePointPtr& evalQueuePoint) { customPostEvalUpdateCB(*problem, evalQueuePoint); };
     NOMAD::EvcInterface::getEvaluatorControl()->addEvalCallback<NOMAD::CallbackType::POST_EVAL_UPDATE>(cbPostEvalUpdate);
 
     // Registering the callback functions
@@ -238,6 +231,9 @@ int main ( int argc , char ** argv )
     {
         throw NOMAD::Exception(__FILE__,__LINE__,"Cannot access to Mads algorithm");
     }    
+
+    // The callbacks access the problem through Mads
+    registerCatMadsProblem(mads.get(), problem);
     
     // Callbacks for search
     mads->addCallback(NOMAD::CallbackType::USER_METHOD_SEARCH, userSearchMethodCallbackSpeculative);
@@ -262,5 +258,7 @@ int main ( int argc , char ** argv )
     TheMainStep.run();
     TheMainStep.end();
 
+    unregisterCatMadsProblem(mads.get());
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,266 @@
+/**
+ \file   BenchHarness.hpp
+ \brief  Minimal microbenchmark harness used by nomad_bench
+ \see    nomad_bench.cpp
+
+ A benchmark is a function receiving a BenchState. Setup is done first,
+ then the kernel runs in a while (state.keepRunning()) loop: only the loop
+ is measured. Setup work inside the loop can be excluded from the measure
+ with pauseTiming()/resumeTiming().\n
+ The harness calibrates the number of iterations so that a repetition
+ lasts at least minTime, runs a few repetitions, and reports the median
+ time per iteration. Output is a table, JSON or CSV.
+ */
+#ifndef __NOMAD_BENCH_HARNESS__
+#define __NOMAD_BENCH_HARNESS__
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace NOMAD_BENCH {
+
+/// Prevent the compiler from optimizing away a computed value.
+template<typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+
+/// State given to a benchmark function.
+class BenchState
+{
+private:
+    using Clock = std::chrono::steady_clock;
+
+    const size_t        _iterations;
+    size_t              _remaining;
+    Clock::duration     _elapsed;
+    Clock::time_point   _start;
+    bool                _running;
+    size_t              _itemsPerIteration;
+
+public:
+    explicit BenchState(size_t iterations)
+      : _iterations(iterations),
+        _remaining(iterations),
+        _elapsed(Clock::duration::zero()),
+        _start(),
+        _running(false),
+        _itemsPerIteration(1)
+    {}
+
+    size_t iterations() const { return _iterations; }
+
+    /// Loop condition. The first call starts the measure, the last one stops it.
+    bool keepRunning()
+    {
+        if (_remaining == _iterations)
+        {
+            resumeTiming();
+        }
+        if (0 == _remaining)
+        {
+            pauseTiming();
+            return false;
+        }
+        _remaining--;
+        return true;
+    }
+
+    /// Index of the current iteration, starting at 0.
+    size_t iteration() const { return _iterations - _remaining - 1; }
+
+    /// Exclude the following code from the measure.
+    void pauseTiming()
+    {
+        if (_running)
+        {
+            _elapsed += Clock::now() - _start;
+            _running = false;
+        }
+    }
+
+    /// Resume the measure.
+    void resumeTiming()
+    {
+        if (!_running)
+        {
+            _start = Clock::now();
+            _running = true;
+        }
+    }
+
+    /// Number of elementary items processed by one iteration (ex. points inserted). Reported as is.
+    void setItemsPerIteration(size_t items) { _itemsPerIteration = items; }
+    size_t getItemsPerIteration() const { return _itemsPerIteration; }
+
+    /// Elapsed measured time (s).
+    double elapsed()
+    {
+        pauseTiming();
+        return std::chrono::duration<double>(_elapsed).count();
+    }
+};
+
+
+/// Result of a single benchmark.
+struct BenchResult
+{
+    std::string name;
+    size_t      iterations = 0;         ///< Iterations per repetition
+    size_t      repetitions = 0;
+    size_t      itemsPerIteration = 1;
+    double      medianNs = 0.0;         ///< Median time per iteration (ns)
+    double      minNs = 0.0;
+    double      maxNs = 0.0;
+};
+
+
+/// Registry and runner of benchmarks.
+class BenchRunner
+{
+public:
+    using BenchFunction = std::function<void(BenchState&)>;
+
+private:
+    std::vector<std::pair<std::string, BenchFunction>> _benchmarks;
+
+public:
+    void add(const std::string& name, const BenchFunction& f)
+    {
+        _benchmarks.emplace_back(name, f);
+    }
+
+    const std::vector<std::pair<std::string, BenchFunction>>& getBenchmarks() const { return _benchmarks; }
+
+    /// Run the benchmarks whose name contains filter.
+    std::vector<BenchResult> run(const std::string& filter,
+                                 double minTime,
+                                 size_t repetitions,
+                                 std::ostream& progress) const
+    {
+        std::vector<BenchResult> results;
+        for (const auto& bench : _benchmarks)
+        {
+            if (!filter.empty() && std::string::npos == bench.first.find(filter))
+            {
+                continue;
+            }
+            progress << "Running " << bench.first << std::endl;
+            results.push_back(runOne(bench.first, bench.second, minTime, repetitions));
+        }
+        return results;
+    }
+
+    static BenchResult runOne(const std::string& name,
+                              const BenchFunction& f,
+                              double minTime,
+                              size_t repetitions)
+    {
+        // Calibration: grow the number of iterations until a repetition lasts minTime.
+        size_t iterations = 1;
+        size_t items = 1;
+        while (true)
+        {
+            BenchState state(iterations);
+            f(state);
+            const double t = state.elapsed();
+            items = state.getItemsPerIteration();
+            if (t >= minTime || iterations >= 1000000000)
+            {
+                break;
+            }
+            // Aim 20% over minTime, at most x10 per step.
+            double factor = (t > 0.0) ? 1.2 * minTime / t : 10.0;
+            factor = std::min(10.0, std::max(2.0, factor));
+            iterations = static_cast<size_t>(static_cast<double>(iterations) * factor);
+        }
+
+        std::vector<double> nsPerIteration;
+        for (size_t r = 0; r < repetitions; r++)
+        {
+            BenchState state(iterations);
+            f(state);
+            nsPerIteration.push_back(1e9 * state.elapsed() / static_cast<double>(iterations));
+        }
+        std::sort(nsPerIteration.begin(), nsPerIteration.end());
+
+        BenchResult result;
+        result.name = name;
+        result.iterations = iterations;
+        result.repetitions = repetitions;
+        result.itemsPerIteration = items;
+        result.medianNs = nsPerIteration[nsPerIteration.size() / 2];
+        result.minNs = nsPerIteration.front();
+        result.maxNs = nsPerIteration.back();
+        return result;
+    }
+
+    static void writeTable(std::ostream& out, const std::vector<BenchResult>& results)
+    {
+        out << std::left << std::setw(60) << "benchmark"
+            << std::right << std::setw(16) << "median ns/iter"
+            << std::setw(16) << "min ns/iter"
+            << std::setw(12) << "iterations" << std::endl;
+        for (const auto& r : results)
+        {
+            out << std::left << std::setw(60) << r.name
+                << std::right << std::fixed << std::setprecision(1)
+                << std::setw(16) << r.medianNs
+                << std::setw(16) << r.minNs
+                << std::setw(12) << r.iterations << std::endl;
+        }
+    }
+
+    static void writeJSON(std::ostream& out,
+                          const std::vector<BenchResult>& results,
+                          const std::vector<std::pair<std::string, std::string>>& context)
+    {
+        out << "{" << std::endl << "  \"context\": {";
+        for (size_t i = 0; i < context.size(); i++)
+        {
+            out << (i > 0 ? "," : "") << std::endl
+                << "    \"" << context[i].first << "\": \"" << context[i].second << "\"";
+        }
+        out << std::endl << "  }," << std::endl << "  \"benchmarks\": [";
+        for (size_t i = 0; i < results.size(); i++)
+        {
+            const auto& r = results[i];
+            out << (i > 0 ? "," : "") << std::endl << std::setprecision(10)
+                << "    { \"name\": \"" << r.name << "\""
+                << ", \"iterations\": " << r.iterations
+                << ", \"repetitions\": " << r.repetitions
+                << ", \"items_per_iteration\": " << r.itemsPerIteration
+                << ", \"median_ns\": " << r.medianNs
+                << ", \"min_ns\": " << r.minNs
+                << ", \"max_ns\": " << r.maxNs << " }";
+        }
+        out << std::endl << "  ]" << std::endl << "}" << std::endl;
+    }
+
+    static void writeCSV(std::ostream& out, const std::vector<BenchResult>& results)
+    {
+        out << "name,iterations,repetitions,items_per_iteration,median_ns,min_ns,max_ns" << std::endl;
+        for (const auto& r : results)
+        {
+            out << "\"" << r.name << "\"," << r.iterations << "," << r.repetitions << ","
+                << r.itemsPerIteration << "," << std::setprecision(10) << r.medianNs << ","
+                << r.minNs << "," << r.maxNs << std::endl;
+        }
+    }
+};
+
+} // namespace NOMAD_BENCH
+
+#endif // __NOMAD_BENCH_HARNESS__
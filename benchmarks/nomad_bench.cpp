@@ -0,0 +1,1414 @@
+/**
+ \file   nomad_bench.cpp
+ \brief  Microbenchmarks of the NOMAD and sgtelib hot paths
+
+ Usage: nomad_bench [--filter=substring] [--format=table|json|csv]
+                    [--out=file] [--min-time=seconds] [--repetitions=n] [--list]
+                    [--check-linalg] [--check-quad-sld] [--check-record-replay]
+
+ Each benchmark runs an isolated kernel on synthetic data with a fixed seed.
+ The JSON and CSV outputs are meant to be archived per commit to detect
+ performance regressions.
+
+ The LinAlg benchmarks run with the in-tree kernels and with the dense linear
+ algebra backend selected at configure time (USE_LAPACK), if any.
+ --check-linalg only checks the accuracy of both backends.
+
+ QuadModelSld is not part of the NOMAD libraries (its search is disabled):
+ it is compiled in nomad_bench. --check-quad-sld only checks that its
+ incremental regression gives the coefficients of the full construction.
+
+ The Mads/run benchmarks run a seeded Mads with the blackbox, or replayed
+ from a log recorded by RecordReplayEvaluator: the replay measures the time
+ spent in the algorithm only. --check-record-replay only checks that a
+ replay answers every evaluation from the log and finds the recorded best
+ point.
+ */
+
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <thread>
+
+#include "BenchHarness.hpp"
+
+#include "Algos/MainStep.hpp"
+#include "Algos/Mads/GMesh.hpp"
+#include "Algos/Mads/Mads.hpp"
+#include "Algos/Mads/Ortho2NPollMethod.hpp"
+#include "Algos/QPSolverAlgo/AugLagSolver.hpp"
+#include "Algos/QPSolverAlgo/TRIPMSolver.hpp"
+#include "Algos/QuadModelSLD/QuadModelSld.hpp"
+#include "Cache/CacheBase.hpp"
+#include "Cache/CacheSet.hpp"
+#include "Eval/Evaluator.hpp"
+#include "Eval/EvaluatorControl.hpp"
+#include "Eval/ProgressiveBarrier.hpp"
+#include "Eval/RecordReplayEvaluator.hpp"
+#include "Math/MatrixUtils.hpp"
+#include "Math/MatrixWorkspace.hpp"
+#include "Math/RNG.hpp"
+#include "Output/OutputQueue.hpp"
+#include "Param/AllParameters.hpp"
+#include "Param/SubsolveParametersPool.hpp"
+#include "nomad_version.hpp"
+
+#include "../ext/sgtelib/src/Linear_Algebra.hpp"
+#include "../ext/sgtelib/src/Matrix.hpp"
+#include "../ext/sgtelib/src/Surrogate_Factory.hpp"
+#include "../ext/sgtelib/src/Tests.hpp"
+#include "../ext/sgtelib/src/TrainingSet.hpp"
+
+#ifndef NOMAD_BENCH_GIT_REVISION
+#define NOMAD_BENCH_GIT_REVISION "unknown"
+#endif
+
+using NOMAD_BENCH::BenchState;
+using NOMAD_BENCH::doNotOptimize;
+
+namespace {
+
+    const unsigned int BENCH_SEED = 1234;
+
+    // Blackbox outputs: objective and one progressive barrier constraint.
+    const NOMAD::BBOutputTypeList BENCH_BBOT = { NOMAD::BBOutputType::Type::OBJ,
+                                                 NOMAD::BBOutputType::Type::PB };
+
+
+    /// Evaluator that is never called. It is only needed to accept points in the queue.
+    class NoEvaluator : public NOMAD::Evaluator
+    {
+    public:
+        explicit NoEvaluator(const std::shared_ptr<NOMAD::EvalParameters>& evalParams)
+          : NOMAD::Evaluator(evalParams, NOMAD::EvalType::BB, NOMAD::EvalXDefined::EVAL_X_DEFINED_BY_USER)
+        {}
+
+        bool eval_x(NOMAD::EvalPoint&, const NOMAD::Double&, bool&) const override { return false; }
+    };
+
+
+    std::shared_ptr<NOMAD::AllParameters> makeParameters(size_t n)
+    {
+        auto allParams = std::make_shared<NOMAD::AllParameters>();
+        allParams->setAttributeValue("DIMENSION", n);
+        allParams->setAttributeValue("X0", NOMAD::Point(n, 0.0));
+        allParams->setAttributeValue("LOWER_BOUND", NOMAD::ArrayOfDouble(n, -10.0));
+        allParams->setAttributeValue("UPPER_BOUND", NOMAD::ArrayOfDouble(n, 10.0));
+        allParams->setAttributeValue("BB_OUTPUT_TYPE", BENCH_BBOT);
+        allParams->setAttributeValue("DISPLAY_DEGREE", 0);
+        allParams->checkAndComply();
+        return allParams;
+    }
+
+
+    void initCache(const std::shared_ptr<NOMAD::AllParameters>& allParams)
+    {
+        NOMAD::CacheBase::resetInstance();
+        NOMAD::CacheSet::setInstance(allParams->getCacheParams(), BENCH_BBOT);
+    }
+
+
+    /// Random evaluated points. About half of them are feasible.
+    std::vector<NOMAD::EvalPoint> makeEvalPoints(size_t nbPoints, size_t n, std::mt19937& gen)
+    {
+        std::uniform_real_distribution<double> unif(-10.0, 10.0);
+        std::vector<NOMAD::EvalPoint> points;
+        points.reserve(nbPoints);
+        for (size_t k = 0; k < nbPoints; k++)
+        {
+            NOMAD::Point x(n);
+            double f = 0.0;
+            for (size_t i = 0; i < n; i++)
+            {
+                x[i] = unif(gen);
+                f += x[i].todouble() * x[i].todouble();
+            }
+            const double c = x[0].todouble();
+            NOMAD::EvalPoint evalPoint(x);
+            evalPoint.setBBO(std::to_string(f) + " " + std::to_string(c), BENCH_BBOT, NOMAD::EvalType::BB);
+            evalPoint.setEvalStatus(NOMAD::EvalStatusType::EVAL_OK, NOMAD::EvalType::BB);
+            evalPoint.updateTag();
+            points.push_back(evalPoint);
+        }
+        return points;
+    }
+
+
+    SGTELIB::Matrix makeRandomMatrix(const std::string& name, int nbRows, int nbCols)
+    {
+        SGTELIB::Matrix M(name, nbRows, nbCols);
+        M.set_random(-1.0, 1.0, false);
+        return M;
+    }
+
+
+    /*---------------*/
+    /* Parameters    */
+    /*---------------*/
+    void benchParamsAccess(BenchState& state, bool useSnapshot)
+    {
+        auto allParams = makeParameters(10);
+        const auto& runParams = allParams->getRunParams();
+        const auto& evcGlobalParams = allParams->getEvaluatorControlGlobalParams();
+
+        state.setItemsPerIteration(3);
+        while (state.keepRunning())
+        {
+            if (useSnapshot)
+            {
+                doNotOptimize(runParams->getSnapshot().MEGA_SEARCH_POLL);
+                doNotOptimize(runParams->getSnapshot().FRAME_CENTER_USE_CACHE);
+                doNotOptimize(evcGlobalParams->getSnapshot().EVAL_SURROGATE_COST);
+            }
+            else
+            {
+                doNotOptimize(runParams->getAttributeValue<bool>("MEGA_SEARCH_POLL"));
+                doNotOptimize(runParams->getAttributeValue<bool>("FRAME_CENTER_USE_CACHE"));
+                doNotOptimize(evcGlobalParams->getAttributeValue<size_t>("EVAL_SURROGATE_COST"));
+            }
+        }
+    }
+
+
+    // Parameters of a nested optimization: X0, fixed variables and frame sizes change at each sub-solve.
+    void benchSubsolveParams(BenchState& state, bool usePool)
+    {
+        const size_t n = 10;
+        auto allParams = makeParameters(n);
+        const auto& pbParams = allParams->getPbParams();
+        const auto& runParams = allParams->getRunParams();
+        const auto& evcGlobalParams = allParams->getEvaluatorControlGlobalParams();
+
+        NOMAD::SubsolveParametersPool pool(pbParams, runParams, evcGlobalParams);
+
+        NOMAD::Point fixedVariable(n);
+        NOMAD::ArrayOfDouble frameSize(n, 0.5);
+        size_t k = 0;
+        while (state.keepRunning())
+        {
+            // Alternate two sub-solves
+            k++;
+            fixedVariable[0] = static_cast<double>(k % 2);
+            NOMAD::Point x0(n, 1.0);
+            x0[0] = fixedVariable[0];
+            frameSize[1] = (k % 2) ? 0.5 : 0.25;
+
+            if (usePool)
+            {
+                auto optPbParams = pool.acquirePbParams(NOMAD::ArrayOfPoint{x0}, fixedVariable, frameSize, frameSize);
+                doNotOptimize(optPbParams->getSnapshot().INITIAL_MESH_SIZE);
+            }
+            else
+            {
+                auto optPbParams = std::make_shared<NOMAD::PbParameters>(*pbParams);
+                auto optRunParams = std::make_shared<NOMAD::RunParameters>(*runParams);
+                optPbParams->setAttributeValue("MIN_FRAME_SIZE", frameSize);
+                optPbParams->setAttributeValue("INITIAL_FRAME_SIZE", frameSize);
+                optPbParams->resetToDefaultValue("INITIAL_MESH_SIZE");
+                optPbParams->setAttributeValue("FIXED_VARIABLE", fixedVariable);
+                optPbParams->setAttributeValue("X0", NOMAD::ArrayOfPoint{x0});
+                optPbParams->doNotShowWarnings();
+                optPbParams->checkAndComply();
+                optRunParams->checkAndComply(evcGlobalParams, optPbParams);
+                doNotOptimize(optPbParams->getSnapshot().INITIAL_MESH_SIZE);
+            }
+        }
+    }
+
+
+    /*---------------*/
+    /* Cache         */
+    /*---------------*/
+    void benchCacheSmartInsert(BenchState& state, size_t nbPoints)
+    {
+        const size_t n = 10;
+        auto allParams = makeParameters(n);
+        initCache(allParams);
+        std::mt19937 gen(BENCH_SEED);
+        const auto points = makeEvalPoints(nbPoints, n, gen);
+        auto& cache = NOMAD::CacheBase::getInstance();
+
+        state.setItemsPerIteration(nbPoints);
+        while (state.keepRunning())
+        {
+            state.pauseTiming();
+            cache->clear();
+            state.resumeTiming();
+            for (const auto& evalPoint : points)
+            {
+                doNotOptimize(cache->smartInsert(evalPoint, 1, NOMAD::EvalType::BB));
+            }
+        }
+    }
+
+    void benchCacheFind(BenchState& state, size_t nbPoints)
+    {
+        const size_t n = 10;
+        auto allParams = makeParameters(n);
+        initCache(allParams);
+        std::mt19937 gen(BENCH_SEED);
+        const auto points = makeEvalPoints(nbPoints, n, gen);
+        auto& cache = NOMAD::CacheBase::getInstance();
+        for (const auto& evalPoint : points)
+        {
+            cache->smartInsert(evalPoint, 1, NOMAD::EvalType::BB);
+        }
+
+        NOMAD::EvalPoint foundEvalPoint;
+        while (state.keepRunning())
+        {
+            const auto& x = *points[state.iteration() % nbPoints].getX();
+            doNotOptimize(cache->find(x, foundEvalPoint, NOMAD::EvalType::BB, false));
+        }
+    }
+
+    void benchCacheFindBestFeas(BenchState& state, size_t nbPoints)
+    {
+        const size_t n = 10;
+        auto allParams = makeParameters(n);
+        initCache(allParams);
+        std::mt19937 gen(BENCH_SEED);
+        for (const auto& evalPoint : makeEvalPoints(nbPoints, n, gen))
+        {
+            NOMAD::CacheBase::getInstance()->smartInsert(evalPoint, 1, NOMAD::EvalType::BB);
+        }
+
+        std::vector<NOMAD::EvalPoint> bestFeas;
+        while (state.keepRunning())
+        {
+            bestFeas.clear();
+            doNotOptimize(NOMAD::CacheBase::getInstance()->findBestFeas(bestFeas));
+        }
+    }
+
+
+    /*------------------*/
+    /* EvaluatorControl */
+    /*------------------*/
+    void benchEvcAddToQueueAndSort(BenchState& state, size_t nbPoints)
+    {
+        const size_t n = 10;
+        auto allParams = makeParameters(n);
+        initCache(allParams);
+
+        auto evc = std::make_unique<NOMAD::EvaluatorControl>(
+                                std::make_shared<NoEvaluator>(allParams->getEvalParams()),
+                                allParams->getEvaluatorControlGlobalParams(),
+                                allParams->getEvaluatorControlParams());
+
+        // Default sort is by direction of last success.
+        NOMAD::Direction lastSuccessDir(n, 1.0);
+        evc->setLastSuccessfulFeasDir(std::make_shared<NOMAD::Direction>(lastSuccessDir));
+
+        std::mt19937 gen(BENCH_SEED);
+        auto frameCenter = std::make_shared<NOMAD::EvalPoint>(makeEvalPoints(1, n, gen)[0]);
+        std::vector<NOMAD::EvalQueuePointPtr> queuePoints;
+        for (const auto& evalPoint : makeEvalPoints(nbPoints, n, gen))
+        {
+            auto queuePoint = std::make_shared<NOMAD::EvalQueuePoint>(evalPoint, NOMAD::EvalType::BB);
+            queuePoint->setPointFrom(frameCenter, NOMAD::Point());
+            queuePoints.push_back(queuePoint);
+        }
+
+        state.setItemsPerIteration(nbPoints);
+        while (state.keepRunning())
+        {
+            evc->lockQueue();
+            for (const auto& queuePoint : queuePoints)
+            {
+                evc->addToQueue(queuePoint);
+            }
+            evc->unlockQueue(true);
+            state.pauseTiming();
+            evc->clearQueue(-1);
+            state.resumeTiming();
+        }
+    }
+
+
+    /*---------------*/
+    /* Mads          */
+    /*---------------*/
+    void benchGMeshScaleAndProject(BenchState& state, size_t n)
+    {
+        auto allParams = makeParameters(n);
+        NOMAD::GMesh mesh(allParams->getPbParams(), allParams->getRunParams());
+        // A few refinements to get a non trivial mesh.
+        for (size_t r = 0; r < 5; r++)
+        {
+            mesh.refineDeltaFrameSize();
+        }
+
+        NOMAD::Direction dir(n, 0.0);
+        NOMAD::Direction::computeDirOnUnitSphere(dir);
+
+        while (state.keepRunning())
+        {
+            doNotOptimize(mesh.scaleAndProjectOnMesh(dir));
+        }
+    }
+
+    void benchPollDirections(BenchState& state, size_t n)
+    {
+        auto allParams = makeParameters(n);
+        initCache(allParams);
+
+        auto mainStep = std::make_unique<NOMAD::MainStep>();
+        auto stopReasons = std::make_shared<NOMAD::AlgoStopReasons<NOMAD::MadsStopType>>();
+        NOMAD::Mads mads(mainStep.get(), stopReasons, allParams->getRunParams(), allParams->getPbParams());
+
+        auto mesh = std::make_shared<NOMAD::GMesh>(allParams->getPbParams(), allParams->getRunParams());
+        std::mt19937 gen(BENCH_SEED);
+        auto frameCenter = std::make_shared<NOMAD::EvalPoint>(makeEvalPoints(1, n, gen)[0]);
+        NOMAD::Ortho2NPollMethod pollMethod(&mads, frameCenter);
+
+        state.setItemsPerIteration(2 * n);
+        while (state.keepRunning())
+        {
+            doNotOptimize(pollMethod.generateFullSpaceScaledDirections(false, mesh));
+        }
+    }
+
+
+    /*--------------------*/
+    /* ProgressiveBarrier */
+    /*--------------------*/
+    void benchBarrierUpdateWithPoints(BenchState& state, size_t nbPoints)
+    {
+        const size_t n = 10;
+        auto allParams = makeParameters(n);
+        initCache(allParams);
+        std::mt19937 gen(BENCH_SEED);
+        const auto initPoints = makeEvalPoints(10, n, gen);
+        const auto points = makeEvalPoints(nbPoints, n, gen);
+
+        state.setItemsPerIteration(nbPoints);
+        while (state.keepRunning())
+        {
+            state.pauseTiming();
+            NOMAD::ProgressiveBarrier barrier(NOMAD::INF, NOMAD::Point(n), NOMAD::EvalType::BB,
+                                              NOMAD::defaultFHComputeTypeS, initPoints,
+                                              false /* barrierInitializedFromCache */);
+            state.resumeTiming();
+            doNotOptimize(barrier.updateWithPoints(points, false, true));
+        }
+    }
+
+
+    /*---------------*/
+    /* EvalPoint     */
+    /*---------------*/
+    /// Outputs of model evaluations, given as text (as the model evaluators did) or as numbers.
+    void benchEvalPointSetBBO(BenchState& state, size_t nbPoints, bool asText)
+    {
+        const size_t n = 10;
+        std::mt19937 gen(BENCH_SEED);
+        std::uniform_real_distribution<double> unif(-10.0, 10.0);
+        std::vector<NOMAD::EvalPoint> points(nbPoints, NOMAD::EvalPoint(NOMAD::Point(n, 0.0)));
+        std::vector<NOMAD::ArrayOfDouble> bbos(nbPoints, NOMAD::ArrayOfDouble(BENCH_BBOT.size()));
+        for (auto& bbo : bbos)
+        {
+            bbo[0] = unif(gen);
+            bbo[1] = unif(gen);
+        }
+
+        state.setItemsPerIteration(nbPoints);
+        while (state.keepRunning())
+        {
+            for (size_t k = 0; k < nbPoints; k++)
+            {
+                if (asText)
+                {
+                    points[k].setBBO(bbos[k].tostring(), BENCH_BBOT, NOMAD::EvalType::MODEL);
+                }
+                else
+                {
+                    points[k].setBBO(bbos[k], BENCH_BBOT, NOMAD::EvalType::MODEL);
+                }
+            }
+            doNotOptimize(points[0].getF(NOMAD::FHComputeType{NOMAD::EvalType::MODEL, NOMAD::defaultFHComputeTypeS}));
+        }
+    }
+
+
+    /*---------------*/
+    /* sgtelib       */
+    /*---------------*/
+    void benchMatrixProduct(BenchState& state, int n)
+    {
+        const auto A = makeRandomMatrix("A", n, n);
+        const auto B = makeRandomMatrix("B", n, n);
+        while (state.keepRunning())
+        {
+            auto C = SGTELIB::Matrix::product(A, B);
+            doNotOptimize(C.get(0, 0));
+        }
+    }
+
+    void benchMatrixTransposeAProduct(BenchState& state, int n)
+    {
+        const auto A = makeRandomMatrix("A", 4 * n, n);
+        while (state.keepRunning())
+        {
+            auto C = SGTELIB::Matrix::transposeA_product(A, A);
+            doNotOptimize(C.get(0, 0));
+        }
+    }
+
+    /// Symmetric positive definite matrix A'A + nI
+    SGTELIB::Matrix makeSPDMatrix(int n)
+    {
+        const auto A = makeRandomMatrix("A", n, n);
+        return SGTELIB::Matrix::transposeA_product(A, A) + static_cast<double>(n) * SGTELIB::Matrix::identity(n);
+    }
+
+    void benchMatrixLUInverse(BenchState& state, int n)
+    {
+        const auto A = makeSPDMatrix(n);
+        while (state.keepRunning())
+        {
+            auto Ai = A.lu_inverse();
+            doNotOptimize(Ai.get(0, 0));
+        }
+    }
+
+    void benchMatrixCholeskyInverse(BenchState& state, int n)
+    {
+        const auto A = makeSPDMatrix(n);
+        while (state.keepRunning())
+        {
+            auto Ai = A.cholesky_inverse();
+            doNotOptimize(Ai.get(0, 0));
+        }
+    }
+
+    void benchMatrixCholeskyFactor(BenchState& state, int n)
+    {
+        const auto A = makeSPDMatrix(n);
+        SGTELIB::Matrix L;
+        while (state.keepRunning())
+        {
+            doNotOptimize(A.cholesky_factor(L));
+        }
+    }
+
+    /*---------------------------------*/
+    /* Dense linear algebra backends   */
+    /*---------------------------------*/
+    /// Select the backend for the duration of a benchmark.
+    class BackendScope
+    {
+    private:
+        const bool _enabled;
+    public:
+        explicit BackendScope(bool useBackend)
+          : _enabled(SGTELIB::linalg::backend_enabled())
+        {
+            SGTELIB::linalg::backend_enabled() = useBackend;
+        }
+        ~BackendScope() { SGTELIB::linalg::backend_enabled() = _enabled; }
+    };
+
+    void benchLinAlgProduct(BenchState& state, int n, bool useBackend)
+    {
+        BackendScope scope(useBackend);
+        benchMatrixProduct(state, n);
+    }
+
+    void benchLinAlgCholesky(BenchState& state, int n, bool useBackend)
+    {
+        BackendScope scope(useBackend);
+        benchMatrixCholeskyFactor(state, n);
+    }
+
+    void benchLinAlgLU(BenchState& state, int n, bool useBackend)
+    {
+        BackendScope scope(useBackend);
+        const auto A = makeRandomMatrix("A", n, n);
+        SGTELIB::Matrix LU;
+        std::vector<int> P;
+        while (state.keepRunning())
+        {
+            doNotOptimize(A.lu_factor(LU, P));
+        }
+    }
+
+    /// SVD of MatrixUtils (QuadModelSld, QP solvers) on a 2n x n matrix.
+    void benchLinAlgSVD(BenchState& state, int n, bool useBackend)
+    {
+        BackendScope scope(useBackend);
+        const auto A = makeRandomMatrix("A", 2 * n, n);
+        NOMAD::MatrixWorkspace ws;
+        std::string error_msg;
+        while (state.keepRunning())
+        {
+            NOMAD::MatrixWorkspace::Frame frame(ws);
+            double** U = ws.getMatrix(2 * n, n);
+            double** V = ws.getMatrix(n, n);
+            double* W = ws.getVector(n);
+            for (int i = 0; i < 2 * n; i++)
+            {
+                std::copy(A.get_data() + i * n, A.get_data() + (i + 1) * n, U[i]);
+            }
+            doNotOptimize(NOMAD::SVD_decomposition(error_msg, U, W, V, 2 * n, n, -1, &ws));
+        }
+    }
+
+    /// QR of MatrixUtils (Dogleg and TRIPM solvers) on a 2n x n matrix.
+    void benchLinAlgQR(BenchState& state, int n, bool useBackend)
+    {
+        BackendScope scope(useBackend);
+        const auto A = makeRandomMatrix("A", 2 * n, n);
+        NOMAD::MatrixWorkspace ws;
+        std::string error_msg;
+        while (state.keepRunning())
+        {
+            NOMAD::MatrixWorkspace::Frame frame(ws);
+            double** M = ws.getMatrix(2 * n, n);
+            double** Q = ws.getMatrix(2 * n, 2 * n);
+            double** R = ws.getMatrix(2 * n, n);
+            for (int i = 0; i < 2 * n; i++)
+            {
+                std::copy(A.get_data() + i * n, A.get_data() + (i + 1) * n, M[i]);
+            }
+            doNotOptimize(NOMAD::qr_factorization(error_msg, M, Q, R, 2 * n, n, -1));
+        }
+    }
+
+    /// Smooth function of the sgtelib models benchmarks.
+    SGTELIB::Matrix makeSurrogateOutputs(const SGTELIB::Matrix& X)
+    {
+        const int n = X.get_nb_cols();
+        SGTELIB::Matrix Z("Z", X.get_nb_rows(), 1);
+        for (int p = 0; p < X.get_nb_rows(); p++)
+        {
+            double f = 0.0;
+            for (int i = 0; i < n; i++)
+            {
+                f += std::sin(3.0 * X.get(p, i)) + X.get(p, i) * X.get(p, (i + 1) % n);
+            }
+            Z.set(p, 0, f);
+        }
+        return Z;
+    }
+
+    /// Build of a sgtelib model on a smooth function of 4 variables.
+    void benchSurrogateBuild(BenchState& state, const std::string& modelDef, int nbPoints)
+    {
+        const int n = 4;
+        auto X = makeRandomMatrix("X", nbPoints, n);
+        const auto Z = makeSurrogateOutputs(X);
+
+        while (state.keepRunning())
+        {
+            SGTELIB::TrainingSet trainingSet(X, Z);
+            std::unique_ptr<SGTELIB::Surrogate> model(SGTELIB::Surrogate_Factory(trainingSet, modelDef));
+            doNotOptimize(model->build());
+            // Leave-one-out values use the factorization too
+            doNotOptimize(model->get_metric(SGTELIB::METRIC_RMSECV, 0));
+        }
+    }
+
+    /// Build of a sgtelib model on a given number of threads (parameter optimization, ensembles).
+    void benchSurrogateBuildOnThreads(BenchState& state, const std::string& modelDef, int nbPoints, int nbThreads)
+    {
+        SGTELIB::set_nb_threads(nbThreads);
+        benchSurrogateBuild(state, modelDef, nbPoints);
+        SGTELIB::set_nb_threads(0);
+    }
+
+    /// Prediction of a block of candidates, with the statistical criteria used by SgtelibModelEvaluator.
+    void benchSurrogatePredict(BenchState& state, const std::string& modelDef, int nbCandidates)
+    {
+        const int n = 4;
+        auto X = makeRandomMatrix("X", 100, n);
+        const auto Z = makeSurrogateOutputs(X);
+        SGTELIB::TrainingSet trainingSet(X, Z);
+        std::unique_ptr<SGTELIB::Surrogate> model(SGTELIB::Surrogate_Factory(trainingSet, modelDef));
+        model->build();
+
+        const auto XX = makeRandomMatrix("XX", nbCandidates, n);
+        SGTELIB::Matrix ZZ("ZZ", nbCandidates, 1);
+        SGTELIB::Matrix std("std", nbCandidates, 1);
+        SGTELIB::Matrix ei("ei", nbCandidates, 1);
+        SGTELIB::Matrix cdf("cdf", nbCandidates, 1);
+
+        state.setItemsPerIteration(nbCandidates);
+        while (state.keepRunning())
+        {
+            model->predict(XX, &ZZ, &std, &ei, &cdf);
+            doNotOptimize(ZZ.get(0, 0));
+        }
+    }
+
+    /// Prediction of a block of candidates split between threads sharing the same model,
+    /// as done by parallel QuadModelEvaluator and SgtelibModelEvaluator.
+    void benchSurrogatePredictOnThreads(BenchState& state, const std::string& modelDef, int nbCandidates, int nbThreads)
+    {
+        const int n = 4;
+        auto X = makeRandomMatrix("X", 100, n);
+        const auto Z = makeSurrogateOutputs(X);
+        SGTELIB::TrainingSet trainingSet(X, Z);
+        std::unique_ptr<SGTELIB::Surrogate> model(SGTELIB::Surrogate_Factory(trainingSet, modelDef));
+        model->build();
+
+        const int blockSize = nbCandidates / nbThreads;
+        std::vector<SGTELIB::Matrix> XX;
+        for (int t = 0; t < nbThreads; t++)
+        {
+            XX.push_back(makeRandomMatrix("XX", blockSize, n));
+        }
+        std::vector<SGTELIB::Matrix> ZZ(nbThreads);
+
+        state.setItemsPerIteration(blockSize * nbThreads);
+        while (state.keepRunning())
+        {
+            std::vector<std::thread> threads;
+            for (int t = 0; t < nbThreads; t++)
+            {
+                threads.emplace_back([&, t]() { model->predict(XX[t], &ZZ[t]); });
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+            doNotOptimize(ZZ[0].get(0, 0));
+        }
+    }
+
+    /// Outputs of the quadratic models benchmarks.
+    SGTELIB::Matrix makeQuadModelOutputs(const SGTELIB::Matrix& X)
+    {
+        const int n = X.get_nb_cols();
+        SGTELIB::Matrix Z("Z", X.get_nb_rows(), 2);
+        for (int p = 0; p < X.get_nb_rows(); p++)
+        {
+            double f = 0.0;
+            for (int i = 0; i < n; i++)
+            {
+                f += (i + 1) * X.get(p, i) * X.get(p, i) + X.get(p, i) * X.get(p, (i + 1) % n);
+            }
+            Z.set(p, 0, f);
+            Z.set(p, 1, X.get(p, 0) - 0.5);
+        }
+        return Z;
+    }
+
+    /// Degree 2 PRS model, as built by QuadModelUpdate.
+    void benchQuadModelBuild(BenchState& state, int nbPoints)
+    {
+        const int n = 10;
+        auto X = makeRandomMatrix("X", nbPoints, n);
+        const auto Z = makeQuadModelOutputs(X);
+
+        while (state.keepRunning())
+        {
+            SGTELIB::TrainingSet trainingSet(X, Z);
+            std::unique_ptr<SGTELIB::Surrogate> model(SGTELIB::Surrogate_Factory(trainingSet, "TYPE PRS DEGREE 2 RIDGE 0"));
+            doNotOptimize(model->build());
+        }
+    }
+
+
+    /// Prediction of a block of trial points on a degree 2 PRS model, as done by QuadModelEvaluator.
+    void benchQuadModelPredict(BenchState& state, int nbCandidates)
+    {
+        const int n = 10;
+        auto X = makeRandomMatrix("X", 100, n);
+        const auto Z = makeQuadModelOutputs(X);
+        SGTELIB::TrainingSet trainingSet(X, Z);
+        std::unique_ptr<SGTELIB::Surrogate> model(SGTELIB::Surrogate_Factory(trainingSet, "TYPE PRS DEGREE 2 RIDGE 0"));
+        model->build();
+
+        const auto XX = makeRandomMatrix("XX", nbCandidates, n);
+        SGTELIB::Matrix ZZ("ZZ", nbCandidates, 2);
+        state.setItemsPerIteration(nbCandidates);
+        while (state.keepRunning())
+        {
+            model->predict(XX, &ZZ);
+            doNotOptimize(ZZ.get(0, 0));
+        }
+    }
+
+    /// Gradient and Hessians of a degree 2 PRS model at a point, as used by QPSolverOptimize.
+    void benchQuadModelDerivatives(BenchState& state)
+    {
+        const int n = 10;
+        auto X = makeRandomMatrix("X", 100, n);
+        const auto Z = makeQuadModelOutputs(X);
+        SGTELIB::TrainingSet trainingSet(X, Z);
+        auto model = std::unique_ptr<SGTELIB::Surrogate_PRS>(
+            static_cast<SGTELIB::Surrogate_PRS*>(SGTELIB::Surrogate_Factory(trainingSet, "TYPE PRS DEGREE 2 RIDGE 0")));
+        model->build();
+
+        const auto x = makeRandomMatrix("x", 1, n);
+        while (state.keepRunning())
+        {
+            const auto G = model->getModelGrad(x);
+            const auto H = model->getModelHessian(x, 0);
+            doNotOptimize(G.get(0, 0) + H.get(0, 0));
+        }
+    }
+
+    /// Update of a degree 2 PRS model when one point is added to its training set.
+    void benchQuadModelUpdate(BenchState& state, int nbPoints)
+    {
+        const int n = 10;
+        const auto XB = makeRandomMatrix("X", nbPoints + 1, n);
+        const auto ZB = makeQuadModelOutputs(XB);
+        const auto XA = XB.get_rows(0, nbPoints);
+        const auto ZA = ZB.get_rows(0, nbPoints);
+
+        SGTELIB::TrainingSet trainingSet(n, 2);
+        std::unique_ptr<SGTELIB::Surrogate> model(SGTELIB::Surrogate_Factory(trainingSet, "TYPE PRS DEGREE 2 RIDGE 0"));
+        while (state.keepRunning())
+        {
+            // Back to the nbPoints first points (full build, not measured)
+            state.pauseTiming();
+            trainingSet.partial_reset_and_add_points(XA, ZA);
+            model->build();
+            state.resumeTiming();
+
+            trainingSet.partial_reset_and_add_points(XB, ZB);
+            doNotOptimize(model->build());
+        }
+    }
+
+
+    /*---------------*/
+    /* Record/replay */
+    /*---------------*/
+    /// Analytical blackbox of the record/replay runs: Rosenbrock with one constraint.
+    class RosenbrockEvaluator : public NOMAD::Evaluator
+    {
+    public:
+        explicit RosenbrockEvaluator(const std::shared_ptr<NOMAD::EvalParameters>& evalParams)
+          : NOMAD::Evaluator(evalParams, NOMAD::EvalType::BB)
+        {}
+
+        bool eval_x(NOMAD::EvalPoint& x, const NOMAD::Double& NOMAD_UNUSED(hMax), bool& countEval) const override
+        {
+            double f = 0.0, c = -1.0;
+            for (size_t i = 0; i < x.size(); i++)
+            {
+                const double xi = x[i].todouble();
+                if (i + 1 < x.size())
+                {
+                    const double xj = x[i + 1].todouble();
+                    f += 100.0 * (xj - xi * xi) * (xj - xi * xi) + (1.0 - xi) * (1.0 - xi);
+                }
+                c += xi * xi / static_cast<double>(x.size());
+            }
+            x.setBBO(NOMAD::ArrayOfDouble(std::vector<double>{f, c}).tostring());
+            countEval = true;
+            return true;
+        }
+    };
+
+    /// Recorded log of the record/replay benchmarks.
+    std::string recordReplayLogFileName(size_t n)
+    {
+        return (std::filesystem::temp_directory_path() / ("nomad_bench_replay_" + std::to_string(n) + ".log")).string();
+    }
+
+    /// Seeded Mads run. The evaluator is built from the evaluation parameters of the run.
+    /// Return the best feasible (or else the best infeasible) point.
+    NOMAD::EvalPoint runSeededMads(size_t n,
+                                   const std::function<NOMAD::EvaluatorPtr(const std::shared_ptr<NOMAD::EvalParameters>&)>& makeEvaluator)
+    {
+        NOMAD::MainStep::resetComponentsBetweenOptimization();
+
+        auto allParams = std::make_shared<NOMAD::AllParameters>();
+        allParams->setAttributeValue("DIMENSION", n);
+        allParams->setAttributeValue("X0", NOMAD::Point(n, 0.5));
+        allParams->setAttributeValue("LOWER_BOUND", NOMAD::ArrayOfDouble(n, -2.0));
+        allParams->setAttributeValue("UPPER_BOUND", NOMAD::ArrayOfDouble(n, 2.0));
+        allParams->setAttributeValue("BB_OUTPUT_TYPE", BENCH_BBOT);
+        allParams->setAttributeValue("MAX_BB_EVAL", 20 * n);
+        allParams->setAttributeValue("DISPLAY_DEGREE", 0);
+        allParams->setAttributeValue("SEED", static_cast<int>(BENCH_SEED));
+        allParams->setAttributeValue("RNG_ALT_SEEDING", true);
+        allParams->checkAndComply();
+
+        NOMAD::MainStep mainStep;
+        mainStep.setAllParameters(allParams);
+        mainStep.setEvaluator(makeEvaluator(allParams->getEvalParams()));
+        mainStep.start();
+        mainStep.run();
+        mainStep.end();
+
+        std::vector<NOMAD::EvalPoint> bestPoints;
+        if (0 == NOMAD::CacheBase::getInstance()->findBestFeas(bestPoints))
+        {
+            NOMAD::CacheBase::getInstance()->findBestInf(bestPoints);
+        }
+        NOMAD::MainStep::resetComponentsBetweenOptimization();
+        if (bestPoints.empty())
+        {
+            throw NOMAD::Exception(__FILE__, __LINE__, "nomad_bench: the Mads run has no best point.");
+        }
+        return bestPoints[0];
+    }
+
+    /// Record a seeded run, then replay it: every evaluation must come from the log
+    /// and the replayed run must find the recorded best point.
+    bool checkRecordReplayRoundTrip(size_t n, std::ostream& out)
+    {
+        const std::string logFileName = recordReplayLogFileName(n);
+        const auto recordedBest = runSeededMads(n, [&](const std::shared_ptr<NOMAD::EvalParameters>& evalParams)
+        {
+            auto bb = std::make_shared<RosenbrockEvaluator>(evalParams);
+            return std::make_shared<NOMAD::RecordReplayEvaluator>(evalParams, bb, NOMAD::RecordReplayMode::RECORD, logFileName);
+        });
+        const size_t nbRecorded = NOMAD::RecordReplayEvaluator::readLog(logFileName).size();
+
+        std::shared_ptr<NOMAD::RecordReplayEvaluator> replay;
+        const auto replayedBest = runSeededMads(n, [&](const std::shared_ptr<NOMAD::EvalParameters>& evalParams)
+        {
+            replay = std::make_shared<NOMAD::RecordReplayEvaluator>(evalParams, nullptr, NOMAD::RecordReplayMode::REPLAY,
+                                                                    logFileName, NOMAD::ReplayMissPolicy::EXCEPTION);
+            return replay;
+        });
+
+        const bool sameBest = (*recordedBest.getX() == *replayedBest.getX());
+        out << "Record/replay n=" << n << ": recorded " << nbRecorded << " evaluations, replay hits "
+            << replay->getNbReplayHits() << ", misses " << replay->getNbReplayMisses()
+            << ", best point " << (sameBest ? "identical" : "different") << std::endl;
+        return sameBest && nbRecorded > 0 && replay->getNbReplayHits() == nbRecorded && 0 == replay->getNbReplayMisses();
+    }
+
+    /// Seeded Mads run with the blackbox, or replayed from its log (algorithm-only time).
+    void benchMadsRun(BenchState& state, size_t n, bool replayed)
+    {
+        const std::string logFileName = recordReplayLogFileName(n);
+        std::shared_ptr<NOMAD::RecordReplayEvaluator> replay;
+        if (replayed)
+        {
+            runSeededMads(n, [&](const std::shared_ptr<NOMAD::EvalParameters>& evalParams)
+            {
+                auto bb = std::make_shared<RosenbrockEvaluator>(evalParams);
+                return std::make_shared<NOMAD::RecordReplayEvaluator>(evalParams, bb, NOMAD::RecordReplayMode::RECORD, logFileName);
+            });
+        }
+
+        while (state.keepRunning())
+        {
+            const auto best = runSeededMads(n, [&](const std::shared_ptr<NOMAD::EvalParameters>& evalParams) -> NOMAD::EvaluatorPtr
+            {
+                if (replayed)
+                {
+                    return std::make_shared<NOMAD::RecordReplayEvaluator>(evalParams, nullptr, NOMAD::RecordReplayMode::REPLAY,
+                                                                          logFileName, NOMAD::ReplayMissPolicy::EXCEPTION);
+                }
+                return std::make_shared<RosenbrockEvaluator>(evalParams);
+            });
+            doNotOptimize(best.getTag());
+        }
+    }
+
+
+    /*---------------*/
+    /* QuadModelSld  */
+    /*---------------*/
+    const int QUAD_SLD_NB_CONSTRUCTIONS = 30;
+
+    /// Evaluated point for the QuadModelSld regression. The outputs are not quadratic: the
+    /// coefficients depend on the interpolation set.
+    NOMAD::EvalPoint makeQuadSldPoint(const NOMAD::Point& x, double shift)
+    {
+        double f = shift, c = 1.0;
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            const double xi = x[i].todouble();
+            f += xi * xi + std::sin(3.0 * xi);
+            c *= (i < 3) ? xi : 1.0;
+        }
+        NOMAD::EvalPoint evalPoint(x);
+        evalPoint.setBBO(NOMAD::ArrayOfDouble(std::vector<double>{f, c}), BENCH_BBOT, NOMAD::EvalType::BB);
+        evalPoint.setEvalStatus(NOMAD::EvalStatusType::EVAL_OK, NOMAD::EvalType::BB);
+        return evalPoint;
+    }
+
+    /// Interpolation sets of successive constructions, as in a Mads run: each set differs from
+    /// the previous one by 1 or 2 points. Every fifth set, the outputs of a point are changed.
+    std::vector<std::vector<NOMAD::EvalPoint>> makeQuadSldSequence(int n)
+    {
+        const int nAlpha = (n + 1) * (n + 2) / 2;
+        const int p1 = 2 * nAlpha;
+        std::mt19937 gen(BENCH_SEED);
+        std::uniform_real_distribution<double> unif(-1.0, 1.0);
+        auto randomPoint = [&]()
+        {
+            NOMAD::Point x(n);
+            for (int i = 0; i < n; i++)
+            {
+                x[i] = unif(gen);
+            }
+            return x;
+        };
+
+        std::vector<NOMAD::EvalPoint> Y;
+        for (int k = 0; k < p1; k++)
+        {
+            Y.push_back(makeQuadSldPoint(randomPoint(), 0.0));
+        }
+        std::vector<std::vector<NOMAD::EvalPoint>> sequence(1, Y);
+        for (int t = 1; t <= QUAD_SLD_NB_CONSTRUCTIONS; t++)
+        {
+            for (int c = 0; c <= t % 2; c++)
+            {
+                Y[gen() % p1] = makeQuadSldPoint(randomPoint(), 0.0);
+            }
+            if (0 == t % 5)
+            {
+                const size_t k = gen() % p1;
+                Y[k] = makeQuadSldPoint(*Y[k].getX(), 0.5);
+            }
+            sequence.push_back(Y);
+        }
+        return sequence;
+    }
+
+    /// Regression model of Y. With a regression state, the previous normal equations are updated.
+    std::unique_ptr<NOMAD::QuadModelSld> constructQuadSld(const std::vector<NOMAD::EvalPoint>& Y,
+                                                          const std::shared_ptr<NOMAD::QuadModelSld::RegressionState>& state)
+    {
+        auto model = std::make_unique<NOMAD::QuadModelSld>(BENCH_BBOT, Y[0].size());
+        model->set_regression_state(state);
+        model->setY(Y);
+        model->define_scaling(2.0);
+        model->construct(false, 1e-13, 1500, static_cast<int>(Y.size()), nullptr != state);
+        return model;
+    }
+
+    /// Max relative difference between the coefficients of the incremental and of the full
+    /// constructions, over the sequence of interpolation sets. Negative if a construction failed.
+    double checkQuadSldIncremental(int n)
+    {
+        const auto sequence = makeQuadSldSequence(n);
+        auto state = std::make_shared<NOMAD::QuadModelSld::RegressionState>();
+        double maxRelDiff = 0.0;
+        for (const auto& Y : sequence)
+        {
+            const auto incremental = constructQuadSld(Y, state);
+            const auto full = constructQuadSld(Y, nullptr);
+            if (!incremental->check() || !full->check())
+            {
+                return -1.0;
+            }
+            for (size_t i = 0; i < BENCH_BBOT.size(); i++)
+            {
+                const NOMAD::Point& a = *incremental->get_alpha()[i];
+                const NOMAD::Point& b = *full->get_alpha()[i];
+                double diff = 0.0, norm = 0.0;
+                for (size_t j = 0; j < b.size(); j++)
+                {
+                    diff = std::max(diff, std::fabs(a[j].todouble() - b[j].todouble()));
+                    norm = std::max(norm, std::fabs(b[j].todouble()));
+                }
+                maxRelDiff = std::max(maxRelDiff, diff / norm);
+            }
+        }
+        return maxRelDiff;
+    }
+
+    /// Successive regression constructions of a Mads run (1 or 2 points of Y change each time).
+    void benchQuadModelSldConstruct(BenchState& state, int n, bool incremental)
+    {
+        const auto sequence = makeQuadSldSequence(n);
+        auto regressionState = (incremental) ? std::make_shared<NOMAD::QuadModelSld::RegressionState>() : nullptr;
+        size_t t = 0;
+        while (state.keepRunning())
+        {
+            if (0 == t)
+            {
+                // Back to the first set (full construction, not measured)
+                state.pauseTiming();
+                constructQuadSld(sequence[0], regressionState);
+                t = 1;
+                state.resumeTiming();
+            }
+            doNotOptimize(constructQuadSld(sequence[t], regressionState)->get_cond());
+            t = (t + 1) % sequence.size();
+        }
+    }
+
+    /// QP model matrix (see QPModelUtils) of a convex objective and nbCons quadratic constraints.
+    SGTELIB::Matrix makeQPModel(int n, int nbCons)
+    {
+        const int q = (n + 1) + n * (n + 1) / 2;
+        auto QPModel = makeRandomMatrix("QPModel", nbCons + 1, q);
+        QPModel.multiply(0.1);
+        for (int i = 0; i < n; i++)
+        {
+            QPModel.set(0, n + 1 + i, 1.0 + i);
+        }
+        for (int j = 1; j <= nbCons; j++)
+        {
+            // Feasible at x = 0
+            QPModel.set(j, 0, -1.0);
+        }
+        return QPModel;
+    }
+
+    /// Resolution of the QP subproblem of the QP model search by TRIPM (QP_SelectAlgo 1),
+    /// from x = 0 in the box [-5, 5].
+    void benchQPSolveTRIPM(BenchState& state, int n, int nbCons)
+    {
+        const NOMAD::TRIPMSolver solver{0.1, 10.0, 1e-12, 80, 200, 0};
+        const auto QPModel = makeQPModel(n, nbCons);
+        SGTELIB::Matrix lb("lb", n, 1), ub("ub", n, 1);
+        lb.fill(-5.0);
+        ub.fill(5.0);
+        SGTELIB::Matrix x("x", n, 1);
+        while (state.keepRunning())
+        {
+            x.fill(0.0);
+            doNotOptimize(solver.solve(x, QPModel, lb, ub));
+            doNotOptimize(x.get(0, 0));
+        }
+    }
+
+    /// Resolution by the augmented Lagrangian solver (QP_SelectAlgo 0) of a QP model perturbed
+    /// after a first resolution, as between two QP model searches around the same center.
+    /// Without warm start, only the previous solution is reused as initial point.
+    void benchQPSolveAugLagPerturbed(BenchState& state, int n, int nbCons, bool warm)
+    {
+        const NOMAD::AugLagSolver solver{0.1, 10.0, 1.0, 1.0, 1e-12, 80, 600, 100, 0};
+        auto QPModel = makeQPModel(n, nbCons);
+        // Make the constraints active at the solution: objective pulled away from x = 0,
+        // convex constraints of the form x' D x <= 1.
+        for (int i = 0; i < n; i++)
+        {
+            QPModel.set(0, 1 + i, -3.0);
+            for (int j = 1; j <= nbCons; j++)
+            {
+                QPModel.set(j, n + 1 + i, 1.0 + 0.1 * j);
+            }
+        }
+        auto QPModelPerturbed = makeRandomMatrix("dQPModel", QPModel.get_nb_rows(), QPModel.get_nb_cols());
+        QPModelPerturbed.multiply(0.01);
+        QPModelPerturbed.add(QPModel);
+        SGTELIB::Matrix lb("lb", n, 1), ub("ub", n, 1);
+        lb.fill(-5.0);
+        ub.fill(5.0);
+
+        // First resolution (not measured)
+        SGTELIB::Matrix x0("x", n, 1);
+        x0.fill(0.0);
+        NOMAD::AugLagWarmStart warmStart;
+        solver.solve(x0, QPModel, lb, ub, &warmStart);
+
+        SGTELIB::Matrix x("x", n, 1);
+        while (state.keepRunning())
+        {
+            state.pauseTiming();
+            x = x0;
+            NOMAD::AugLagWarmStart ws(warmStart);
+            state.resumeTiming();
+
+            doNotOptimize(solver.solve(x, QPModelPerturbed, lb, ub, warm ? &ws : nullptr));
+            doNotOptimize(x.get(0, 0));
+        }
+    }
+
+
+    void registerBenchmarks(NOMAD_BENCH::BenchRunner& runner)
+    {
+        runner.add("Parameters/getAttributeValue", [](BenchState& st) { benchParamsAccess(st, false); });
+        runner.add("Parameters/getSnapshot", [](BenchState& st) { benchParamsAccess(st, true); });
+        runner.add("Parameters/subsolve/copyAndCheck", [](BenchState& st) { benchSubsolveParams(st, false); });
+        runner.add("Parameters/subsolve/pool", [](BenchState& st) { benchSubsolveParams(st, true); });
+        for (size_t nbPoints : {1000, 10000})
+        {
+            const std::string s = "/" + std::to_string(nbPoints);
+            runner.add("CacheSet/smartInsert" + s, [nbPoints](BenchState& st) { benchCacheSmartInsert(st, nbPoints); });
+            runner.add("CacheSet/find" + s, [nbPoints](BenchState& st) { benchCacheFind(st, nbPoints); });
+            runner.add("CacheSet/findBestFeas" + s, [nbPoints](BenchState& st) { benchCacheFindBestFeas(st, nbPoints); });
+        }
+        for (size_t nbPoints : {20, 100, 500})
+        {
+            runner.add("EvaluatorControl/addToQueueAndSort/" + std::to_string(nbPoints),
+                       [nbPoints](BenchState& st) { benchEvcAddToQueueAndSort(st, nbPoints); });
+        }
+        for (size_t n : {10, 50, 200})
+        {
+            runner.add("GMesh/scaleAndProjectOnMesh/" + std::to_string(n),
+                       [n](BenchState& st) { benchGMeshScaleAndProject(st, n); });
+        }
+        for (size_t n : {10, 50})
+        {
+            runner.add("PollMethodBase/generateFullSpaceScaledDirections/Ortho2N/" + std::to_string(n),
+                       [n](BenchState& st) { benchPollDirections(st, n); });
+        }
+        for (size_t nbPoints : {100, 1000})
+        {
+            runner.add("ProgressiveBarrier/updateWithPoints/" + std::to_string(nbPoints),
+                       [nbPoints](BenchState& st) { benchBarrierUpdateWithPoints(st, nbPoints); });
+        }
+        for (bool asText : {true, false})
+        {
+            runner.add(std::string("EvalPoint/setBBO/") + (asText ? "text" : "numeric") + "/1000",
+                       [asText](BenchState& st) { benchEvalPointSetBBO(st, 1000, asText); });
+        }
+        for (int n : {50, 100, 200, 400})
+        {
+            const std::string s = "/" + std::to_string(n);
+            runner.add("SGTELIB/Matrix/product" + s, [n](BenchState& st) { benchMatrixProduct(st, n); });
+            runner.add("SGTELIB/Matrix/transposeA_product" + s, [n](BenchState& st) { benchMatrixTransposeAProduct(st, n); });
+            runner.add("SGTELIB/Matrix/lu_inverse" + s, [n](BenchState& st) { benchMatrixLUInverse(st, n); });
+            runner.add("SGTELIB/Matrix/cholesky_inverse" + s, [n](BenchState& st) { benchMatrixCholeskyInverse(st, n); });
+            runner.add("SGTELIB/Matrix/cholesky_factor" + s, [n](BenchState& st) { benchMatrixCholeskyFactor(st, n); });
+        }
+        for (int nbPoints : {50, 200})
+        {
+            const std::string s = "/" + std::to_string(nbPoints);
+            runner.add("SGTELIB/build/KRIGING" + s,
+                       [nbPoints](BenchState& st) { benchSurrogateBuild(st, "TYPE KRIGING", nbPoints); });
+            runner.add("SGTELIB/build/RBF_R" + s,
+                       [nbPoints](BenchState& st) { benchSurrogateBuild(st, "TYPE RBF PRESET R", nbPoints); });
+            runner.add("SGTELIB/build/LOWESS_DEN" + s,
+                       [nbPoints](BenchState& st) { benchSurrogateBuild(st, "TYPE LOWESS PRESET DEN", nbPoints); });
+            runner.add("SGTELIB/build/KS" + s,
+                       [nbPoints](BenchState& st) { benchSurrogateBuild(st, "TYPE KS", nbPoints); });
+        }
+        for (int nbThreads : {1, 4})
+        {
+            const std::string s = "/" + std::to_string(nbThreads) + "threads/100";
+            runner.add("SGTELIB/optimize/KRIGING" + s,
+                       [nbThreads](BenchState& st) { benchSurrogateBuildOnThreads(st, "TYPE KRIGING", 100, nbThreads); });
+            runner.add("SGTELIB/optimize/RBF" + s,
+                       [nbThreads](BenchState& st) {
+                           benchSurrogateBuildOnThreads(st, "TYPE RBF KERNEL_TYPE OPTIM KERNEL_COEF OPTIM RIDGE OPTIM", 100, nbThreads);
+                       });
+            runner.add("SGTELIB/build/ENSEMBLE/" + std::to_string(nbThreads) + "threads/200",
+                       [nbThreads](BenchState& st) { benchSurrogateBuildOnThreads(st, "TYPE ENSEMBLE", 200, nbThreads); });
+        }
+        for (const std::string modelType : {"KRIGING", "ENSEMBLE_STAT"})
+        {
+            runner.add("SGTELIB/predict/" + modelType + "/1000",
+                       [modelType](BenchState& st) { benchSurrogatePredict(st, "TYPE " + modelType, 1000); });
+        }
+        for (int nbThreads : {1, 4})
+        {
+            runner.add("SGTELIB/predict/PRS2/" + std::to_string(nbThreads) + "threads/20000",
+                       [nbThreads](BenchState& st) { benchSurrogatePredictOnThreads(st, "TYPE PRS DEGREE 2", 20000, nbThreads); });
+        }
+        for (int nbPoints : {100, 500})
+        {
+            runner.add("QuadModel/build/PRS2/" + std::to_string(nbPoints),
+                       [nbPoints](BenchState& st) { benchQuadModelBuild(st, nbPoints); });
+            runner.add("QuadModel/update/PRS2/" + std::to_string(nbPoints),
+                       [nbPoints](BenchState& st) { benchQuadModelUpdate(st, nbPoints); });
+        }
+        for (bool useBackend : {false, true})
+        {
+            if (useBackend && !SGTELIB::linalg::has_backend())
+            {
+                continue;
+            }
+            const std::string backend = (useBackend) ? SGTELIB::linalg::backend_name() : "internal";
+            for (int n : {32, 128, 256})
+            {
+                const std::string s = "/" + backend + "/" + std::to_string(n);
+                runner.add("LinAlg/product" + s, [n, useBackend](BenchState& st) { benchLinAlgProduct(st, n, useBackend); });
+                runner.add("LinAlg/cholesky" + s, [n, useBackend](BenchState& st) { benchLinAlgCholesky(st, n, useBackend); });
+                runner.add("LinAlg/lu" + s, [n, useBackend](BenchState& st) { benchLinAlgLU(st, n, useBackend); });
+                runner.add("LinAlg/svd" + s, [n, useBackend](BenchState& st) { benchLinAlgSVD(st, n, useBackend); });
+                runner.add("LinAlg/qr" + s, [n, useBackend](BenchState& st) { benchLinAlgQR(st, n, useBackend); });
+            }
+        }
+        runner.add("QuadModel/predict/PRS2/2000", [](BenchState& st) { benchQuadModelPredict(st, 2000); });
+        runner.add("QuadModel/derivatives/PRS2", [](BenchState& st) { benchQuadModelDerivatives(st); });
+        runner.add("Mads/run/blackbox/5", [](BenchState& st) { benchMadsRun(st, 5, false); });
+        runner.add("Mads/run/replay/5", [](BenchState& st) { benchMadsRun(st, 5, true); });
+        for (int n : {5, 10, 15})
+        {
+            runner.add("QuadModelSld/construct/full/" + std::to_string(n),
+                       [n](BenchState& st) { benchQuadModelSldConstruct(st, n, false); });
+            runner.add("QuadModelSld/construct/incremental/" + std::to_string(n),
+                       [n](BenchState& st) { benchQuadModelSldConstruct(st, n, true); });
+        }
+        for (int n : {10, 30})
+        {
+            runner.add("QPSolver/TRIPM/" + std::to_string(n), [n](BenchState& st) { benchQPSolveTRIPM(st, n, 3); });
+            runner.add("QPSolver/AugLag/restart/" + std::to_string(n), [n](BenchState& st) { benchQPSolveAugLagPerturbed(st, n, 3, false); });
+            runner.add("QPSolver/AugLag/warmStart/" + std::to_string(n), [n](BenchState& st) { benchQPSolveAugLagPerturbed(st, n, 3, true); });
+        }
+    }
+
+
+    bool startsWith(const std::string& s, const std::string& prefix, std::string& value)
+    {
+        if (0 == s.compare(0, prefix.size(), prefix))
+        {
+            value = s.substr(prefix.size());
+            return true;
+        }
+        return false;
+    }
+
+    void displayUsage(const char* exeName)
+    {
+        std::cerr << "Usage: " << exeName
+                  << " [--filter=substring] [--format=table|json|csv] [--out=file]"
+                  << " [--min-time=seconds] [--repetitions=n] [--list] [--check-linalg] [--check-quad-sld]"
+                  << " [--check-record-replay]" << std::endl;
+    }
+}
+
+
+int main(int argc, char** argv)
+{
+    std::string filter, format = "table", outFileName;
+    double minTime = 0.2;
+    size_t repetitions = 5;
+    bool listOnly = false;
+    bool checkLinAlg = false;
+    bool checkQuadSld = false;
+    bool checkRecordReplay = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        std::string value;
+        if (startsWith(arg, "--filter=", value))
+        {
+            filter = value;
+        }
+        else if (startsWith(arg, "--format=", value))
+        {
+            format = value;
+        }
+        else if (startsWith(arg, "--out=", value))
+        {
+            outFileName = value;
+        }
+        else if (startsWith(arg, "--min-time=", value))
+        {
+            minTime = std::stod(value);
+        }
+        else if (startsWith(arg, "--repetitions=", value))
+        {
+            repetitions = std::max<size_t>(1, std::stoul(value));
+        }
+        else if ("--list" == arg)
+        {
+            listOnly = true;
+        }
+        else if ("--check-linalg" == arg)
+        {
+            checkLinAlg = true;
+        }
+        else if ("--check-quad-sld" == arg)
+        {
+            checkQuadSld = true;
+        }
+        else if ("--check-record-replay" == arg)
+        {
+            checkRecordReplay = true;
+        }
+        else
+        {
+            displayUsage(argv[0]);
+            return 1;
+        }
+    }
+    if ("table" != format && "json" != format && "csv" != format)
+    {
+        displayUsage(argv[0]);
+        return 1;
+    }
+
+    NOMAD::RNG::setSeed(BENCH_SEED);
+    NOMAD::OutputQueue::getInstance()->setMaxOutputLevel(NOMAD::OutputLevel::LEVEL_NOTHING);
+
+    if (checkLinAlg)
+    {
+        try
+        {
+            SGTELIB::test_linear_algebra();
+        }
+        catch (const SGTELIB::Exception& e)
+        {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (checkQuadSld)
+    {
+        // The incremental regression must give the coefficients of the full construction.
+        bool ok = true;
+        for (int n : {5, 10, 15})
+        {
+            const double maxRelDiff = checkQuadSldIncremental(n);
+            std::cout << "QuadModelSld n=" << n << ": max relative difference incremental/full = " << maxRelDiff << std::endl;
+            ok = ok && (maxRelDiff >= 0.0) && (maxRelDiff < 1e-8);
+        }
+        return (ok) ? 0 : 1;
+    }
+
+    if (checkRecordReplay)
+    {
+        bool ok = true;
+        for (size_t n : {5, 10})
+        {
+            ok = checkRecordReplayRoundTrip(n, std::cout) && ok;
+        }
+        return (ok) ? 0 : 1;
+    }
+
+    NOMAD_BENCH::BenchRunner runner;
+    registerBenchmarks(runner);
+
+    if (listOnly)
+    {
+        for (const auto& bench : runner.getBenchmarks())
+        {
+            std::cout << bench.first << std::endl;
+        }
+        return 0;
+    }
+
+    std::ofstream outFile;
+    if (!outFileName.empty())
+    {
+        outFile.open(outFileName, std::ofstream::out | std::ios::trunc);
+        if (outFile.fail())
+        {
+            std::cerr << "Cannot open output file " << outFileName << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = outFileName.empty() ? std::cout : outFile;
+
+    const auto results = runner.run(filter, minTime, repetitions, std::cerr);
+
+    if ("json" == format)
+    {
+        char date[32];
+        const std::time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+        NOMAD_BENCH::BenchRunner::writeJSON(out, results,
+                                            { { "nomad_version", NOMAD_VERSION_NUMBER },
+                                              { "git_revision", NOMAD_BENCH_GIT_REVISION },
+                                              { "linalg_backend", SGTELIB::linalg::backend_name() },
+                                              { "date", date } });
+    }
+    else if ("csv" == format)
+    {
+        NOMAD_BENCH::BenchRunner::writeCSV(out, results);
+    }
+    else
+    {
+        NOMAD_BENCH::BenchRunner::writeTable(out, results);
+    }
+
+    return 0;
+}
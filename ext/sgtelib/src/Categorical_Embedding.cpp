@@ -0,0 +1,170 @@
+/*-------------------------------------------------------------------------------------*/
+/*  sgtelib - A surrogate model library for derivative-free optimization               */
+/*  Version 2.0.3                                                                      */
+/*                                                                                     */
+/*  Copyright (C) 2012-2017  Sebastien Le Digabel - Ecole Polytechnique, Montreal      */ 
+/*                           Bastien Talgorn - McGill University, Montreal             */
+/*                                                                                     */
+/*  Author: Bastien Talgorn                                                            */
+/*  email: bastientalgorn@fastmail.com                                                 */
+/*                                                                                     */
+/*  This program is free software: you can redistribute it and/or modify it under the  */
+/*  terms of the GNU Lesser General Public License as published by the Free Software   */
+/*  Foundation, either version 3 of the License, or (at your option) any later         */
+/*  version.                                                                           */
+/*                                                                                     */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT ANY    */
+/*  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A    */
+/*  PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.   */
+/*                                                                                     */
+/*  You should have received a copy of the GNU Lesser General Public License along     */
+/*  with this program. If not, see <http://www.gnu.org/licenses/>.                     */
+/*                                                                                     */
+/*  You can find information on sgtelib at https://github.com/bastientalgorn/sgtelib   */
+/*-------------------------------------------------------------------------------------*/
+
+#include "Categorical_Embedding.hpp"
+#include <cmath>
+
+/*--------------------------------------*/
+/*              constructor             */
+/*--------------------------------------*/
+SGTELIB::Categorical_Embedding::Categorical_Embedding ( const int n ) :
+  _n            ( n ) ,
+  _cat_index    (   ) ,
+  _embedding    (   ) ,
+  _cat_of_var   ( std::max(n,0) , -1  ) ,
+  _weight       ( std::max(n,0) , 1.0 ) ,
+  _embedded_dim ( std::max(n,0) ) {
+  if (n<0){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+             "Categorical_Embedding: invalid dimension" );
+  }
+}//
+
+/*--------------------------------------*/
+/*    declare a categorical variable    */
+/*--------------------------------------*/
+void SGTELIB::Categorical_Embedding::add_categorical_variable ( const int j ,
+                                                                const SGTELIB::Matrix & E ) {
+  if ( (j<0) || (j>=_n) ){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+             "Categorical_Embedding::add_categorical_variable: index error" );
+  }
+  if ( (E.get_nb_rows()<1) || (E.get_nb_cols()<1) ){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+             "Categorical_Embedding::add_categorical_variable: empty embedding" );
+  }
+  if (_cat_of_var[j]>=0){
+    // Replace the embedding of the variable
+    const int k = _cat_of_var[j];
+    _embedded_dim += E.get_nb_cols()-_embedding[k].get_nb_cols();
+    _embedding[k] = E;
+  }
+  else{
+    _cat_of_var[j] = static_cast<int>(_cat_index.size());
+    _cat_index.push_back(j);
+    _embedding.push_back(E);
+    _embedded_dim += E.get_nb_cols()-1;
+  }
+}//
+
+/*--------------------------------------*/
+/*              weights                 */
+/*--------------------------------------*/
+void SGTELIB::Categorical_Embedding::set_weight ( const int j , const double w ) {
+  if ( (j<0) || (j>=_n) ){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+             "Categorical_Embedding::set_weight: index error" );
+  }
+  if ( ! (w>=0) ){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+             "Categorical_Embedding::set_weight: weights must be non-negative" );
+  }
+  _weight[j] = w;
+}//
+
+void SGTELIB::Categorical_Embedding::set_weights ( const SGTELIB::Matrix & W ) {
+  if ( (W.get_nb_rows()!=1) || (W.get_nb_cols()!=_n) ){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+             "Categorical_Embedding::set_weights: dimension error" );
+  }
+  for (int j=0 ; j<_n ; j++) set_weight(j,W.get(0,j));
+}//
+
+/*--------------------------------------*/
+/*               clear                  */
+/*--------------------------------------*/
+void SGTELIB::Categorical_Embedding::clear ( void ) {
+  _cat_index.clear();
+  _embedding.clear();
+  _cat_of_var.assign(_n,-1);
+  _weight.assign(_n,1.0);
+  _embedded_dim = _n;
+}//
+
+/*--------------------------------------*/
+/*         nb of categories             */
+/*--------------------------------------*/
+int SGTELIB::Categorical_Embedding::get_nb_categories ( const int j ) const {
+  if ( (j<0) || (j>=_n) ){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+             "Categorical_Embedding::get_nb_categories: index error" );
+  }
+  const int k = _cat_of_var[j];
+  return (k<0) ? 0 : _embedding[k].get_nb_rows();
+}//
+
+/*--------------------------------------*/
+/*         embedded points              */
+/*--------------------------------------*/
+SGTELIB::Matrix SGTELIB::Categorical_Embedding::embed ( const SGTELIB::Matrix & Xs ,
+                                                        const SGTELIB::Matrix & C ) const {
+
+  const int p = Xs.get_nb_rows();
+  if ( (Xs.get_nb_cols()!=_n) || (C.get_nb_cols()!=_n) || (C.get_nb_rows()!=p) ){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+             "Categorical_Embedding::embed: dimension error" );
+  }
+
+  // The weights are applied to the coordinates: sqrt(w)*(x-y) gives w*(x-y)^2 in the norm 2.
+  std::vector<double> sw (_n);
+  for (int j=0 ; j<_n ; j++) sw[j] = std::sqrt(_weight[j]);
+
+  SGTELIB::Matrix Y ("Y",p,_embedded_dim);
+  int i, j, k, c, l, jy;
+  for (i=0 ; i<p ; i++){
+    jy = 0;
+    for (j=0 ; j<_n ; j++){
+      k = _cat_of_var[j];
+      if (k<0){
+        Y.set(i,jy++,sw[j]*Xs.get(i,j));
+      }
+      else{
+        const SGTELIB::Matrix & E = _embedding[k];
+        c = static_cast<int>(std::lround(C.get(i,j)));
+        c = std::min(std::max(c,0),E.get_nb_rows()-1);
+        for (l=0 ; l<E.get_nb_cols() ; l++){
+          Y.set(i,jy++,sw[j]*E.get(c,l));
+        }
+      }
+    }
+  }
+  return Y;
+}//
+
+/*--------------------------------------*/
+/*               display                */
+/*--------------------------------------*/
+void SGTELIB::Categorical_Embedding::display ( std::ostream & out ) const {
+  out << "Categorical embedding:\n";
+  out << "  input dim: " << _n << ", embedded dim: " << _embedded_dim << "\n";
+  for (int j=0 ; j<_n ; j++){
+    out << "  var " << j << ": weight " << _weight[j];
+    const int k = _cat_of_var[j];
+    if (k>=0){
+      out << ", " << _embedding[k].get_nb_rows() << " categories in dim " << _embedding[k].get_nb_cols();
+    }
+    out << "\n";
+  }
+}//
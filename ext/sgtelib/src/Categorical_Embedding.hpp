@@ -0,0 +1,95 @@
+/*-------------------------------------------------------------------------------------*/
+/*  sgtelib - A surrogate model library for derivative-free optimization               */
+/*  Version 2.0.3                                                                      */
+/*                                                                                     */
+/*  Copyright (C) 2012-2017  Sebastien Le Digabel - Ecole Polytechnique, Montreal      */ 
+/*                           Bastien Talgorn - McGill University, Montreal             */
+/*                                                                                     */
+/*  Author: Bastien Talgorn                                                            */
+/*  email: bastientalgorn@fastmail.com                                                 */
+/*                                                                                     */
+/*  This program is free software: you can redistribute it and/or modify it under the  */
+/*  terms of the GNU Lesser General Public License as published by the Free Software   */
+/*  Foundation, either version 3 of the License, or (at your option) any later         */
+/*  version.                                                                           */
+/*                                                                                     */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT ANY    */
+/*  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A    */
+/*  PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.   */
+/*                                                                                     */
+/*  You should have received a copy of the GNU Lesser General Public License along     */
+/*  with this program. If not, see <http://www.gnu.org/licenses/>.                     */
+/*                                                                                     */
+/*  You can find information on sgtelib at https://github.com/bastientalgorn/sgtelib   */
+/*-------------------------------------------------------------------------------------*/
+
+#ifndef __SGTELIB_CATEGORICAL_EMBEDDING__
+#define __SGTELIB_CATEGORICAL_EMBEDDING__
+
+#include "Defines.hpp"
+#include "Exception.hpp"
+#include "Matrix.hpp"
+#include <vector>
+
+namespace SGTELIB {
+
+  /*--------------------------------------*/
+  /*    Categorical embedding class       */
+  /*--------------------------------------*/
+  // Descriptor of the mixed variables, used by the distance DISTANCE_NORM2_EMB.
+  // A categorical variable j takes the values 0, 1, ..., nb_categories(j)-1,
+  // and the category c is represented by the row c of a matrix of embedding
+  // vectors (nb_categories x dim). Each variable j also has a weight w_j.
+  // The distance between two points x and y is then
+  //
+  //    d(x,y)^2 = sum_{j categorical} w_j * || E_j(x_j,:) - E_j(y_j,:) ||_2^2
+  //             + sum_{j other}       w_j * ( xs_j - ys_j )^2
+  //
+  // where xs and ys are the scaled points.
+  // Without any categorical variable and with unit weights, this is the NORM2 distance.
+  class DLL_API Categorical_Embedding {
+
+  private:
+
+    int _n; // Input dimension
+    std::vector<int> _cat_index; // Index of the categorical variables
+    std::vector<SGTELIB::Matrix> _embedding; // Embedding vectors (one matrix per categorical variable)
+    std::vector<int> _cat_of_var; // Rank of variable j in _cat_index, or -1 if j is not categorical
+    std::vector<double> _weight; // One weight per variable
+    int _embedded_dim; // Nb of columns of the embedded points
+
+  public:
+
+    // constructor: n variables, none of them categorical, unit weights
+    explicit Categorical_Embedding ( const int n = 0 );
+
+    // Declare the variable j as categorical. E (nb_categories x dim) contains
+    // the embedding vectors of its categories.
+    void add_categorical_variable ( const int j , const SGTELIB::Matrix & E );
+    // Weights of the variables
+    void set_weight  ( const int j , const double w );
+    void set_weights ( const SGTELIB::Matrix & W ); // W is a row vector (1 x n)
+    // Remove all the categorical variables and reset the weights to 1
+    void clear ( void );
+
+    // Get
+    int get_input_dim     ( void ) const { return _n; };
+    int get_embedded_dim  ( void ) const { return _embedded_dim; };
+    int get_nb_categorical ( void ) const { return static_cast<int>(_cat_index.size()); };
+    bool is_categorical   ( const int j ) const { return _cat_of_var[j]>=0; };
+    int get_nb_categories ( const int j ) const;
+    double get_weight     ( const int j ) const { return _weight[j]; };
+    bool is_defined       ( void ) const { return _n>0; };
+
+    // Embedded points (p x embedded_dim), such that the norm 2 distance between
+    // two rows is the distance defined above. Xs contains the scaled points and
+    // C the categories (ie the unscaled categorical columns; the other columns
+    // of C are ignored). The categories are rounded and projected in
+    // [0,nb_categories-1].
+    SGTELIB::Matrix embed ( const SGTELIB::Matrix & Xs , const SGTELIB::Matrix & C ) const;
+
+    void display ( std::ostream & out ) const;
+  };
+}
+
+#endif
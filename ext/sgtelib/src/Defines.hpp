@@ -47,6 +47,15 @@
 #define DLL_API
 #endif
 
+// Non aliasing pointers (vectorized kernels)
+#if defined(__GNUC__) || defined(__clang__)
+#define SGTELIB_RESTRICT __restrict__
+#elif defined(_MSC_VER)
+#define SGTELIB_RESTRICT __restrict
+#else
+#define SGTELIB_RESTRICT
+#endif
+
 // debug flag:
 //#define SGTELIB_DEBUG
 //#define ENSEMBLE_DEBUG
@@ -88,6 +97,10 @@ namespace SGTELIB {
   // 1: threshold = (Z_UB+Z_LB)/2;
   // 2: threshold = mean(Z)
   //const scaling_t scaling_method = SCALING_NONE;
+  // When points are added to a training set, the current scaling is kept
+  // (and only the new points are processed) if the new scaling constants
+  // differ by less than this tolerance. Otherwise, all the points are rescaled.
+  const double incremental_scaling_tol = 0.05;
 
 
   // model output type:
@@ -222,98 +222,164 @@ SGTELIB::kernel_t SGTELIB::int_to_kernel_type ( const int i ) {
   }
 }//
 
+namespace {
+
+  /*----------------------------------------------*/
+  /*   Kernel functions (one functor per type)    */
+  /*----------------------------------------------*/
+  // The coefficients that only depend on the kernel shape ks are computed
+  // once, in the same order of operations as in the expression of the kernel.
+  // The value at r is then a branch-free expression (apart from the support
+  // of the compact kernels), so that the loop of apply() can be vectorized.
+
+  // Gaussian
+  struct kernel_D1 {
+    const double c;
+    explicit kernel_D1 ( const double ks ) : c ( SGTELIB::PI*ks*ks ) {}
+    double operator() ( const double r ) const { return exp(-c*r*r); }
+  };
+  // Inverse Quadratic
+  struct kernel_D2 {
+    const double c;
+    explicit kernel_D2 ( const double ks ) : c ( SGTELIB::PI*SGTELIB::PI*ks*ks ) {}
+    double operator() ( const double r ) const { return 1.0/(1.0+c*r*r); }
+  };
+  // Inverse Multiquadratic
+  struct kernel_D3 {
+    const double c;
+    explicit kernel_D3 ( const double ks ) : c ( 52.015*ks*ks ) {}
+    double operator() ( const double r ) const { return 1.0/sqrt(1.0+c*r*r); }
+  };
+  // Bi-quadratic
+  struct kernel_D4 {
+    const double ks;
+    explicit kernel_D4 ( const double k ) : ks ( k ) {}
+    double operator() ( const double r ) const {
+      const double ksr = fabs(ks*r)*16.0/15.0;
+      const double d = (1-ksr*ksr);
+      return (ksr<=1) ? d*d : 0.0;
+    }
+  };
+  // Tri-cubic
+  struct kernel_D5 {
+    const double ks;
+    explicit kernel_D5 ( const double k ) : ks ( k ) {}
+    double operator() ( const double r ) const {
+      const double ksr = fabs(ks*r)*162.0/140.0;
+      const double d = (1-ksr*ksr*ksr);
+      return (ksr<=1.0) ? d*d*d : 0.0;
+    }
+  };
+  // Exp-Root
+  struct kernel_D6 {
+    const double c;
+    explicit kernel_D6 ( const double ks ) : c ( 4*ks ) {}
+    double operator() ( const double r ) const { return exp(-sqrt(c*r)); }
+  };
+  // Epanechnikov
+  // nb: 3/4 and 16/9 are integer divisions (0 and 1), so that this
+  // kernel is 1 for r=0 and 0 elsewhere. This is the historical behavior.
+  struct kernel_D7 {
+    const double ks;
+    explicit kernel_D7 ( const double k ) : ks ( k ) {}
+    double operator() ( const double r ) const {
+      const double ksr = fabs(ks*r);
+      return (ksr<=3/4) ? (1-(16/9)*ksr*ksr) : 0.0;
+    }
+  };
+  // Multiquadratic
+  struct kernel_I0 {
+    const double c;
+    explicit kernel_I0 ( const double ks ) : c ( ks*ks ) {}
+    double operator() ( const double r ) const { return sqrt(1.0+c*r*r); }
+  };
+  // Polyharmonique spline (k=1)
+  struct kernel_I1 {
+    explicit kernel_I1 ( const double ) {}
+    double operator() ( const double r ) const { return r; }
+  };
+  // Polyharmonique spline (k=2) (Thin Plate Splin)
+  struct kernel_I2 {
+    explicit kernel_I2 ( const double ) {}
+    double operator() ( const double r ) const { return (r==0.0) ? 0.0 : log(r)*r*r; }
+  };
+  // Polyharmonique spline (k=3)
+  struct kernel_I3 {
+    explicit kernel_I3 ( const double ) {}
+    double operator() ( const double r ) const { return r*r*r; }
+  };
+  // Polyharmonique spline (k=4)
+  struct kernel_I4 {
+    explicit kernel_I4 ( const double ) {}
+    double operator() ( const double r ) const {
+      const double r2 = r*r;
+      return (r==0.0) ? 0.0 : r2*r2*log(r);
+    }
+  };
+
+  // Apply the kernel phi to the n values of v
+  template <class K>
+  void apply ( const K phi , double * v , const int n ){
+    for (int k=0 ; k<n ; k++) v[k] = phi(v[k]);
+  }
+
+}
+
 /*----------------------------------------------*/
-/*       Compute the value of the kernel        */
+/*    Compute the value of the kernel (array)   */
 /*----------------------------------------------*/
-double SGTELIB::kernel (  const SGTELIB::kernel_t kt , 
-                          const double ks ,
-                          const double r ){
+void SGTELIB::apply_kernel ( const SGTELIB::kernel_t kt ,
+                             const double ks ,
+                             double * v ,
+                             const int n ){
   // kt : kernel type
   // ks : kernel shape
-  // r : radius
+  // v : radius (replaced by the value of the kernel)
 
+  // The kernel type is resolved once for the n values.
   switch (kt){
-    case SGTELIB::KERNEL_D1:
-      // Gaussian
-      return exp(-PI*ks*ks*r*r);
-    case SGTELIB::KERNEL_D2:
-      // Inverse Quadratic
-      return 1.0/(1.0+PI*PI*ks*ks*r*r);
-    case SGTELIB::KERNEL_D3:
-      // Inverse Multiquadratic
-      return 1.0/sqrt(1.0+52.015*ks*ks*r*r);
-    case SGTELIB::KERNEL_D4:
-      // Bi-quadratic 
-      {
-        double ksr = fabs(ks*r)*16.0/15.0;
-        if (ksr<=1){
-          double d = (1-ksr*ksr);
-          return d*d;
-        }
-      }
-      return 0.0;
-    case SGTELIB::KERNEL_D5:
-      // Tri-cubic
-      {
-        double ksr = fabs(ks*r)*162.0/140.0;
-        if (ksr<=1.0){
-          double d = (1-ksr*ksr*ksr);
-          return d*d*d;
-        }   
-      }
-      return 0.0;
-    case SGTELIB::KERNEL_D6:
-      // Exp-Root
-      return exp(-sqrt(4*ks*r));
-    case SGTELIB::KERNEL_D7:
-      // Epanechnikov
-      {
-        double ksr = fabs(ks*r);
-        if (ksr<=3/4) return (1-(16/9)*ksr*ksr);
-      }
-      return 0.0;
-    case SGTELIB::KERNEL_I0:
-      // Multiquadratic
-      return sqrt(1.0+ks*ks*r*r);
-    case SGTELIB::KERNEL_I1:
-      // Polyharmonique spline (k=1)
-      return r;
-    case SGTELIB::KERNEL_I2:
-      // Polyharmonique spline (k=2) (Thin Plate Splin)
-      if (r==0.0) return 0.0;
-      return log(r)*r*r;
-    case SGTELIB::KERNEL_I3:
-      // Polyharmonique spline (k=3)
-      return r*r*r;
-    case SGTELIB::KERNEL_I4:
-      // Polyharmonique spline (k=4)
-      if (r==0.0) return 0.0;
-      {
-        double r2 = r*r;
-        return r2*r2*log(r);
-      }
+    case SGTELIB::KERNEL_D1: apply(kernel_D1(ks),v,n); break;
+    case SGTELIB::KERNEL_D2: apply(kernel_D2(ks),v,n); break;
+    case SGTELIB::KERNEL_D3: apply(kernel_D3(ks),v,n); break;
+    case SGTELIB::KERNEL_D4: apply(kernel_D4(ks),v,n); break;
+    case SGTELIB::KERNEL_D5: apply(kernel_D5(ks),v,n); break;
+    case SGTELIB::KERNEL_D6: apply(kernel_D6(ks),v,n); break;
+    case SGTELIB::KERNEL_D7: apply(kernel_D7(ks),v,n); break;
+    case SGTELIB::KERNEL_I0: apply(kernel_I0(ks),v,n); break;
+    case SGTELIB::KERNEL_I1: apply(kernel_I1(ks),v,n); break;
+    case SGTELIB::KERNEL_I2: apply(kernel_I2(ks),v,n); break;
+    case SGTELIB::KERNEL_I3: apply(kernel_I3(ks),v,n); break;
+    case SGTELIB::KERNEL_I4: apply(kernel_I4(ks),v,n); break;
     default:
       throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
                "kernel: undefined kernel type" );
-      return 0.0;
   } // end switch
 }//
 
+void SGTELIB::apply_kernel ( const SGTELIB::kernel_t kt ,
+                             const double ks ,
+                             SGTELIB::Matrix & R ){
+  apply_kernel(kt,ks,R.get_data(),R.get_numel());
+}//
+
+/*----------------------------------------------*/
+/*       Compute the value of the kernel        */
+/*----------------------------------------------*/
+double SGTELIB::kernel (  const SGTELIB::kernel_t kt , 
+                          const double ks ,
+                          const double r ){
+  double v = r;
+  apply_kernel(kt,ks,&v,1);
+  return v;
+}//
+
 /*----------------------------------------------*/
 /*       Compute the value of the kernel        */
 /*----------------------------------------------*/
 SGTELIB::Matrix SGTELIB::kernel (  const SGTELIB::kernel_t kt , 
                                    const double ks ,
                                    SGTELIB::Matrix R ){
-
-  const int nbRows = R.get_nb_rows();
-  const int nbCols = R.get_nb_cols();
-  int i,j;
-  for (i=0 ; i<nbRows ; i++){
-    for (j=0 ; j<nbCols ; j++){
-      R.set(i,j,kernel(kt,ks,R.get(i,j)));
-    }
-  }
+  apply_kernel(kt,ks,R);
   return R;
 }//
 
@@ -52,6 +52,9 @@ namespace SGTELIB {
   // kernel
   double kernel ( const SGTELIB::kernel_t kt , const double ks ,const double r );
   SGTELIB::Matrix kernel ( const SGTELIB::kernel_t kt , const double ks , SGTELIB::Matrix R );
+  // kernel, applied in place to a matrix of distances (resp. to n values)
+  void apply_kernel ( const SGTELIB::kernel_t kt , const double ks , SGTELIB::Matrix & R );
+  void apply_kernel ( const SGTELIB::kernel_t kt , const double ks , double * v , const int n );
   // kernel is decreasing ?
   bool kernel_is_decreasing ( const SGTELIB::kernel_t kt );
   // kernel has a shape parameter ?
@@ -0,0 +1,270 @@
+/*-------------------------------------------------------------------------------------*/
+/*  sgtelib - A surrogate model library for derivative-free optimization               */
+/*  Version 2.0.3                                                                      */
+/*                                                                                     */
+/*  Copyright (C) 2012-2017  Sebastien Le Digabel - Ecole Polytechnique, Montreal      */
+/*                           Bastien Talgorn - McGill University, Montreal             */
+/*                                                                                     */
+/*  Author: Bastien Talgorn                                                            */
+/*  email: bastientalgorn@fastmail.com                                                 */
+/*                                                                                     */
+/*  This program is free software: you can redistribute it and/or modify it under the  */
+/*  terms of the GNU Lesser General Public License as published by the Free Software   */
+/*  Foundation, either version 3 of the License, or (at your option) any later         */
+/*  version.                                                                           */
+/*                                                                                     */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT ANY    */
+/*  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A    */
+/*  PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.   */
+/*                                                                                     */
+/*  You should have received a copy of the GNU Lesser General Public License along     */
+/*  with this program. If not, see <http://www.gnu.org/licenses/>.                     */
+/*                                                                                     */
+/*  You can find information on sgtelib at https://github.com/bastientalgorn/sgtelib   */
+/*-------------------------------------------------------------------------------------*/
+
+#ifndef __SGTELIB_LINEAR_ALGEBRA__
+#define __SGTELIB_LINEAR_ALGEBRA__
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Dense linear algebra backend.
+//
+// The backend is selected at configure time: the in-tree kernels of
+// SGTELIB::Matrix and NOMAD MatrixUtils by default, or the system BLAS/LAPACK
+// when compiled with USE_LAPACK (cmake -DUSE_LAPACK=ON).
+//
+// All the matrices are dense, row-major, with contiguous rows: element (i,j)
+// of A is A[i*lda+j]. This is the storage of SGTELIB::Matrix (get_data()) and
+// of the matrices of NOMAD::MatrixWorkspace.
+//
+// Each function returns LINALG_NOT_USED when the backend is not available,
+// disabled, or when the problem is too small to benefit from it. The caller
+// then runs its own in-tree code. The functions are inline so that the NOMAD
+// libraries can use the backend without linking sgtelib.
+
+#ifdef USE_LAPACK
+// Fortran BLAS/LAPACK. The trailing size_t are the hidden lengths of the
+// character arguments (gfortran convention, ignored by the other ABIs).
+extern "C" {
+  void dgemm_  ( const char * transa , const char * transb ,
+                 const int * m , const int * n , const int * k ,
+                 const double * alpha , const double * A , const int * lda ,
+                 const double * B , const int * ldb ,
+                 const double * beta , double * C , const int * ldc ,
+                 std::size_t , std::size_t );
+  void dpotrf_ ( const char * uplo , const int * n , double * A , const int * lda ,
+                 int * info , std::size_t );
+  void dgetrf_ ( const int * m , const int * n , double * A , const int * lda ,
+                 int * ipiv , int * info );
+  void dgesdd_ ( const char * jobz , const int * m , const int * n ,
+                 double * A , const int * lda , double * S ,
+                 double * U , const int * ldu , double * VT , const int * ldvt ,
+                 double * work , const int * lwork , int * iwork , int * info ,
+                 std::size_t );
+  void dgeqrf_ ( const int * m , const int * n , double * A , const int * lda ,
+                 double * tau , double * work , const int * lwork , int * info );
+  void dorgqr_ ( const int * m , const int * n , const int * k ,
+                 double * A , const int * lda , const double * tau ,
+                 double * work , const int * lwork , int * info );
+}
+#endif
+
+namespace SGTELIB {
+
+  namespace linalg {
+
+    enum linalg_status_t {
+      LINALG_NOT_USED , // The caller must use its own code
+      LINALG_SUCCESS  ,
+      LINALG_FAILURE    // Not positive definite, singular, no convergence
+    };
+
+    // Smallest dimension for which the factorizations go to the backend.
+    // The products go to the backend above BACKEND_MIN_SIZE^3 flops.
+    // The LU factorization works on a transposed copy, which only pays
+    // off on larger matrices.
+    const int BACKEND_MIN_SIZE = 32;
+    const int BACKEND_MIN_SIZE_LU = 128;
+
+    inline bool has_backend ( void ) {
+#ifdef USE_LAPACK
+      return true;
+#else
+      return false;
+#endif
+    }//
+
+    inline const char * backend_name ( void ) {
+      return (has_backend()) ? "lapack" : "internal";
+    }//
+
+    // Switch to compare the backends in the same run (tests, benchmarks).
+    // Not meant to be changed while other threads do linear algebra.
+    inline bool & backend_enabled ( void ) {
+      static bool enabled = true;
+      return enabled;
+    }//
+
+    inline bool use_backend ( const int size , const int min_size = BACKEND_MIN_SIZE ) {
+      return has_backend() && backend_enabled() && (size >= min_size);
+    }//
+
+    /*---------------------------------------------------*/
+    /*  C = op(A)*op(B), C is m x n, inner dimension p.  */
+    /*  op(A) is A' if transA (A is then p x m).         */
+    /*---------------------------------------------------*/
+    inline linalg_status_t gemm ( const bool transA , const bool transB ,
+                                  const int m , const int n , const int p ,
+                                  const double * A , const int lda ,
+                                  const double * B , const int ldb ,
+                                  double * C , const int ldc ) {
+      if ( (m==0) || (n==0) || (p==0) ) return LINALG_NOT_USED;
+      const double flops = static_cast<double>(m)*n*p;
+      const double min_flops = static_cast<double>(BACKEND_MIN_SIZE)*BACKEND_MIN_SIZE*BACKEND_MIN_SIZE;
+      if ( ! use_backend((flops>=min_flops) ? BACKEND_MIN_SIZE : 0) ) return LINALG_NOT_USED;
+#ifdef USE_LAPACK
+      // Row-major C = op(A)*op(B) is column-major C' = op(B)'*op(A)'
+      const char ta = (transB) ? 'T' : 'N';
+      const char tb = (transA) ? 'T' : 'N';
+      const double one = 1.0, zero = 0.0;
+      dgemm_(&ta,&tb,&n,&m,&p,&one,B,&ldb,A,&lda,&zero,C,&ldc,1,1);
+      return LINALG_SUCCESS;
+#else
+      (void)transA; (void)transB; (void)A; (void)lda; (void)B; (void)ldb; (void)C; (void)ldc;
+      return LINALG_NOT_USED;
+#endif
+    }//
+
+    /*---------------------------------------------------*/
+    /*  Cholesky A = L*L', A is n x n symmetric.         */
+    /*  A is replaced by L (the upper part is zeroed).   */
+    /*---------------------------------------------------*/
+    inline linalg_status_t cholesky ( const int n , double * A , const int lda ) {
+      if ( ! use_backend(n) ) return LINALG_NOT_USED;
+#ifdef USE_LAPACK
+      // Row-major lower = column-major upper, A = U'*U with U = L'
+      const char uplo = 'U';
+      int info = 0;
+      dpotrf_(&uplo,&n,A,&lda,&info,1);
+      if (info!=0) return LINALG_FAILURE;
+      for (int i=0 ; i<n ; i++) std::fill(A+i*lda+i+1,A+i*lda+n,0.0);
+      return LINALG_SUCCESS;
+#else
+      (void)A; (void)lda;
+      return LINALG_NOT_USED;
+#endif
+    }//
+
+    /*---------------------------------------------------*/
+    /*  LU with partial pivoting: P*A = L*U, A is n x n. */
+    /*  A is replaced by L (unit diagonal) and U.        */
+    /*  P[i] is the row of A that is in row i of P*A.    */
+    /*  sign is the sign of the permutation.             */
+    /*---------------------------------------------------*/
+    inline linalg_status_t lu ( const int n , double * A , const int lda , int * P , double * sign ) {
+      if ( ! use_backend(n,BACKEND_MIN_SIZE_LU) ) return LINALG_NOT_USED;
+#ifdef USE_LAPACK
+      std::vector<double> T (static_cast<std::size_t>(n)*n);
+      for (int i=0 ; i<n ; i++)
+        for (int j=0 ; j<n ; j++) T[j*n+i] = A[i*lda+j];
+      std::vector<int> ipiv (n);
+      int info = 0;
+      dgetrf_(&n,&n,T.data(),&n,ipiv.data(),&info);
+      if (info!=0) return LINALG_FAILURE;
+      for (int i=0 ; i<n ; i++)
+        for (int j=0 ; j<n ; j++) A[i*lda+j] = T[j*n+i];
+      double s = 1;
+      for (int i=0 ; i<n ; i++) P[i] = i;
+      for (int k=0 ; k<n ; k++){
+        if (ipiv[k]-1!=k){
+          std::swap(P[k],P[ipiv[k]-1]);
+          s = -s;
+        }
+      }
+      if (sign) *sign = s;
+      return LINALG_SUCCESS;
+#else
+      (void)A; (void)lda; (void)P; (void)sign;
+      return LINALG_NOT_USED;
+#endif
+    }//
+
+    /*---------------------------------------------------*/
+    /*  Thin SVD A = U*diag(W)*V', A is m x n, m >= n.   */
+    /*  U is m x n, W has n values, V is n x n (V, not   */
+    /*  V'). U may be A itself.                          */
+    /*---------------------------------------------------*/
+    inline linalg_status_t svd ( const int m , const int n ,
+                                 const double * A , const int lda ,
+                                 double * U , const int ldu ,
+                                 double * W ,
+                                 double * V , const int ldv ) {
+      if ( (m<n) || ! use_backend(n) ) return LINALG_NOT_USED;
+#ifdef USE_LAPACK
+      // The row-major A is the column-major A' (n x m) = U2*S*VT2,
+      // so that A = VT2'*S*U2': U is VT2 read row-major, V is U2'.
+      std::vector<double> T (static_cast<std::size_t>(m)*n);
+      for (int i=0 ; i<m ; i++) std::copy(A+i*lda,A+i*lda+n,T.begin()+static_cast<std::size_t>(i)*n);
+      std::vector<double> U2 (static_cast<std::size_t>(n)*n);
+      std::vector<double> VT2 (static_cast<std::size_t>(m)*n);
+      std::vector<int> iwork (8*static_cast<std::size_t>(n));
+      const char jobz = 'S';
+      int info = 0, lwork = -1;
+      double wsize = 0;
+      dgesdd_(&jobz,&n,&m,T.data(),&n,W,U2.data(),&n,VT2.data(),&n,&wsize,&lwork,iwork.data(),&info,1);
+      lwork = static_cast<int>(wsize);
+      std::vector<double> work (std::max(1,lwork));
+      dgesdd_(&jobz,&n,&m,T.data(),&n,W,U2.data(),&n,VT2.data(),&n,work.data(),&lwork,iwork.data(),&info,1);
+      if (info!=0) return LINALG_FAILURE;
+      for (int i=0 ; i<m ; i++) std::copy(VT2.begin()+static_cast<std::size_t>(i)*n,VT2.begin()+static_cast<std::size_t>(i+1)*n,U+i*ldu);
+      for (int i=0 ; i<n ; i++)
+        for (int j=0 ; j<n ; j++) V[i*ldv+j] = U2[j*n+i];
+      return LINALG_SUCCESS;
+#else
+      (void)A; (void)lda; (void)U; (void)ldu; (void)W; (void)V; (void)ldv;
+      return LINALG_NOT_USED;
+#endif
+    }//
+
+    /*---------------------------------------------------*/
+    /*  QR A = Q*R, A is m x n, m >= n. Q is m x m       */
+    /*  orthogonal, R is m x n upper triangular.         */
+    /*---------------------------------------------------*/
+    inline linalg_status_t qr ( const int m , const int n ,
+                                const double * A , const int lda ,
+                                double * Q , const int ldq ,
+                                double * R , const int ldr ) {
+      if ( (m<n) || (n==0) || ! use_backend(n) ) return LINALG_NOT_USED;
+#ifdef USE_LAPACK
+      // Column-major copy of A in the first n columns of the m x m buffer
+      std::vector<double> T (static_cast<std::size_t>(m)*m,0.0);
+      for (int i=0 ; i<m ; i++)
+        for (int j=0 ; j<n ; j++) T[static_cast<std::size_t>(j)*m+i] = A[i*lda+j];
+      std::vector<double> tau (n);
+      int info = 0, lwork = -1;
+      double wsize = 0;
+      dgeqrf_(&m,&n,T.data(),&m,tau.data(),&wsize,&lwork,&info);
+      lwork = std::max(static_cast<int>(wsize),m);
+      std::vector<double> work (lwork);
+      dgeqrf_(&m,&n,T.data(),&m,tau.data(),work.data(),&lwork,&info);
+      if (info!=0) return LINALG_FAILURE;
+      for (int i=0 ; i<m ; i++)
+        for (int j=0 ; j<n ; j++) R[i*ldr+j] = (j>=i) ? T[static_cast<std::size_t>(j)*m+i] : 0.0;
+      dorgqr_(&m,&m,&n,T.data(),&m,tau.data(),work.data(),&lwork,&info);
+      if (info!=0) return LINALG_FAILURE;
+      for (int i=0 ; i<m ; i++)
+        for (int j=0 ; j<m ; j++) Q[i*ldq+j] = T[static_cast<std::size_t>(j)*m+i];
+      return LINALG_SUCCESS;
+#else
+      (void)A; (void)lda; (void)Q; (void)ldq; (void)R; (void)ldr;
+      return LINALG_NOT_USED;
+#endif
+    }//
+
+  }
+}
+
+#endif
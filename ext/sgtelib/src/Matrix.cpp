@@ -24,6 +24,270 @@
 /*-------------------------------------------------------------------------------------*/
 
 #include "Matrix.hpp"
+#include "Linear_Algebra.hpp"
+#include <new>
+
+// The elements are stored row by row in a single buffer aligned on
+// SGTELIB_MATRIX_ALIGN bytes. _X[i] points to the first element of row i,
+// so that the historical _X[i][j] access is kept. The buffer may hold more
+// rows than _nbRows (_capacity) so that adding rows one by one, as done
+// when the training set grows, does not reallocate each time.
+
+namespace {
+
+  const std::size_t SGTELIB_MATRIX_ALIGN = 64;
+
+  // Cache blocking of the products: a BLOCK_K x BLOCK_J block of B
+  // (128 x 256 doubles = 256 kB) is reused for all the rows of A.
+  const int BLOCK_K = 128;
+  const int BLOCK_J = 256;
+
+  double * aligned_alloc_doubles ( std::size_t n ) {
+    if (n==0) return nullptr;
+    return static_cast<double*>(::operator new(n*sizeof(double),std::align_val_t(SGTELIB_MATRIX_ALIGN)));
+  }
+
+  void aligned_free_doubles ( double * p ) {
+    if (p) ::operator delete(p,std::align_val_t(SGTELIB_MATRIX_ALIGN));
+  }
+
+  /*---------------------------------------------------*/
+  /*  C(0:m,j0:j1) += A(0:m,k0:k1) * B(k0:k1,j0:j1)    */
+  /*  Rows of A are read 4 at a time, so that each     */
+  /*  row of B is loaded once for 4 rows of C. The     */
+  /*  inner loop is contiguous and vectorized.         */
+  /*---------------------------------------------------*/
+  void gemm_nn_block ( double * const * C ,
+                       const double * const * A ,
+                       const double * const * B ,
+                       const int m ,
+                       const int k0 , const int k1 ,
+                       const int j0 , const int j1 ) {
+    const int len = j1-j0;
+    int i = 0;
+    for ( ; i+4 <= m ; i+=4 ) {
+      double * SGTELIB_RESTRICT c0 = C[i  ]+j0;
+      double * SGTELIB_RESTRICT c1 = C[i+1]+j0;
+      double * SGTELIB_RESTRICT c2 = C[i+2]+j0;
+      double * SGTELIB_RESTRICT c3 = C[i+3]+j0;
+      for ( int k = k0 ; k < k1 ; ++k ) {
+        const double a0 = A[i  ][k];
+        const double a1 = A[i+1][k];
+        const double a2 = A[i+2][k];
+        const double a3 = A[i+3][k];
+        const double * SGTELIB_RESTRICT b = B[k]+j0;
+        for ( int j = 0 ; j < len ; ++j ) {
+          const double bj = b[j];
+          c0[j] += a0*bj;
+          c1[j] += a1*bj;
+          c2[j] += a2*bj;
+          c3[j] += a3*bj;
+        }
+      }
+    }
+    for ( ; i < m ; ++i ) {
+      double * SGTELIB_RESTRICT c = C[i]+j0;
+      for ( int k = k0 ; k < k1 ; ++k ) {
+        const double a = A[i][k];
+        const double * SGTELIB_RESTRICT b = B[k]+j0;
+        for ( int j = 0 ; j < len ; ++j ) {
+          c[j] += a*b[j];
+        }
+      }
+    }
+  }//
+
+  /*---------------------------------------------------*/
+  /*  C = A*B, C is m x n, A is m x p, B is p x n      */
+  /*---------------------------------------------------*/
+  void gemm_nn ( double * const * C ,
+                 const double * const * A ,
+                 const double * const * B ,
+                 const int m , const int n , const int p ) {
+    for ( int i = 0 ; i < m ; ++i ) {
+      std::fill(C[i],C[i]+n,0.0);
+    }
+    for ( int k0 = 0 ; k0 < p ; k0+=BLOCK_K ) {
+      const int k1 = std::min(p,k0+BLOCK_K);
+      for ( int j0 = 0 ; j0 < n ; j0+=BLOCK_J ) {
+        gemm_nn_block(C,A,B,m,k0,k1,j0,std::min(n,j0+BLOCK_J));
+      }
+    }
+  }//
+
+  /*---------------------------------------------------*/
+  /*  C = A'*B, C is m x n, A is p x m, B is p x n     */
+  /*  Sum of the rank one updates A(k,:)' * B(k,:),    */
+  /*  the transpose of A is never formed.              */
+  /*---------------------------------------------------*/
+  void gemm_tn ( double * const * C ,
+                 const double * const * A ,
+                 const double * const * B ,
+                 const int m , const int n , const int p ) {
+    for ( int i = 0 ; i < m ; ++i ) {
+      std::fill(C[i],C[i]+n,0.0);
+    }
+    for ( int j0 = 0 ; j0 < n ; j0+=BLOCK_J ) {
+      const int len = std::min(n,j0+BLOCK_J)-j0;
+      for ( int k = 0 ; k < p ; ++k ) {
+        const double * SGTELIB_RESTRICT a = A[k];
+        const double * SGTELIB_RESTRICT b = B[k]+j0;
+        int i = 0;
+        for ( ; i+4 <= m ; i+=4 ) {
+          double * SGTELIB_RESTRICT c0 = C[i  ]+j0;
+          double * SGTELIB_RESTRICT c1 = C[i+1]+j0;
+          double * SGTELIB_RESTRICT c2 = C[i+2]+j0;
+          double * SGTELIB_RESTRICT c3 = C[i+3]+j0;
+          const double a0 = a[i], a1 = a[i+1], a2 = a[i+2], a3 = a[i+3];
+          for ( int j = 0 ; j < len ; ++j ) {
+            const double bj = b[j];
+            c0[j] += a0*bj;
+            c1[j] += a1*bj;
+            c2[j] += a2*bj;
+            c3[j] += a3*bj;
+          }
+        }
+        for ( ; i < m ; ++i ) {
+          double * SGTELIB_RESTRICT c = C[i]+j0;
+          const double ai = a[i];
+          for ( int j = 0 ; j < len ; ++j ) {
+            c[j] += ai*b[j];
+          }
+        }
+      }
+    }
+  }//
+
+  /*---------------------------------------------------*/
+  /*  C = A*B', C is m x n, A is m x p, B is n x p     */
+  /*  Each term is a dot product of two contiguous     */
+  /*  rows. Four rows of B are processed at a time.    */
+  /*---------------------------------------------------*/
+  void gemm_nt ( double * const * C ,
+                 const double * const * A ,
+                 const double * const * B ,
+                 const int m , const int n , const int p ) {
+    for ( int i = 0 ; i < m ; ++i ) {
+      const double * SGTELIB_RESTRICT a = A[i];
+      double * SGTELIB_RESTRICT c = C[i];
+      int j = 0;
+      for ( ; j+4 <= n ; j+=4 ) {
+        const double * SGTELIB_RESTRICT b0 = B[j  ];
+        const double * SGTELIB_RESTRICT b1 = B[j+1];
+        const double * SGTELIB_RESTRICT b2 = B[j+2];
+        const double * SGTELIB_RESTRICT b3 = B[j+3];
+        double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for ( int k = 0 ; k < p ; ++k ) {
+          const double ak = a[k];
+          s0 += ak*b0[k];
+          s1 += ak*b1[k];
+          s2 += ak*b2[k];
+          s3 += ak*b3[k];
+        }
+        c[j] = s0; c[j+1] = s1; c[j+2] = s2; c[j+3] = s3;
+      }
+      for ( ; j < n ; ++j ) {
+        const double * SGTELIB_RESTRICT b = B[j];
+        double s = 0;
+        for ( int k = 0 ; k < p ; ++k ) {
+          s += a[k]*b[k];
+        }
+        c[j] = s;
+      }
+    }
+  }//
+
+  /*---------------------------------------------------*/
+  /*  D(i,j) = norm of A(i,:)-B(j,:), D is m x n,      */
+  /*  A is m x p, B is n x p. Same blocking as         */
+  /*  gemm_nt: four rows of B are processed at a time. */
+  /*  The coordinates are accumulated in the same      */
+  /*  order as the plain loop.                         */
+  /*---------------------------------------------------*/
+  struct norm1_t {
+    static inline double add ( const double s , const double d ) { return s+std::fabs(d); }
+    static inline double end ( const double s ) { return s; }
+  };
+  struct norm2_t {
+    static inline double add ( const double s , const double d ) { return s+d*d; }
+    static inline double end ( const double s ) { return std::sqrt(s); }
+  };
+  struct norminf_t {
+    static inline double add ( const double s , const double d ) { return std::max(s,std::fabs(d)); }
+    static inline double end ( const double s ) { return s; }
+  };
+
+  template <class N>
+  void distances ( double * const * D ,
+                   const double * const * A ,
+                   const double * const * B ,
+                   const int m , const int n , const int p ) {
+    for ( int i = 0 ; i < m ; ++i ) {
+      const double * SGTELIB_RESTRICT a = A[i];
+      double * SGTELIB_RESTRICT d = D[i];
+      int j = 0;
+      for ( ; j+4 <= n ; j+=4 ) {
+        const double * SGTELIB_RESTRICT b0 = B[j  ];
+        const double * SGTELIB_RESTRICT b1 = B[j+1];
+        const double * SGTELIB_RESTRICT b2 = B[j+2];
+        const double * SGTELIB_RESTRICT b3 = B[j+3];
+        double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+        for ( int k = 0 ; k < p ; ++k ) {
+          const double ak = a[k];
+          s0 = N::add(s0,ak-b0[k]);
+          s1 = N::add(s1,ak-b1[k]);
+          s2 = N::add(s2,ak-b2[k]);
+          s3 = N::add(s3,ak-b3[k]);
+        }
+        d[j] = N::end(s0); d[j+1] = N::end(s1); d[j+2] = N::end(s2); d[j+3] = N::end(s3);
+      }
+      for ( ; j < n ; ++j ) {
+        const double * SGTELIB_RESTRICT b = B[j];
+        double s = 0;
+        for ( int k = 0 ; k < p ; ++k ) {
+          s = N::add(s,a[k]-b[k]);
+        }
+        d[j] = N::end(s);
+      }
+    }
+  }//
+
+}
+
+/*---------------------------*/
+/*   storage management      */
+/*---------------------------*/
+void SGTELIB::Matrix::allocate ( const int nbRows , const int nbCols , const int capacity ) {
+  _nbRows   = nbRows;
+  _nbCols   = nbCols;
+  _capacity = std::max(capacity,nbRows);
+  _data = aligned_alloc_doubles(static_cast<std::size_t>(_capacity)*static_cast<std::size_t>(_nbCols));
+  _X = new double * [_capacity];
+  for ( int i = 0 ; i < _capacity ; ++i )
+    _X[i] = _data + static_cast<std::size_t>(i)*_nbCols;
+}//
+
+void SGTELIB::Matrix::release ( void ) {
+  aligned_free_doubles(_data);
+  delete [] _X;
+  _data = nullptr;
+  _X = nullptr;
+  _capacity = 0;
+}//
+
+// Grow the buffer so that it holds at least capacity rows, keeping the content.
+void SGTELIB::Matrix::reserve_rows ( const int capacity ) {
+  if ( capacity <= _capacity )
+    return;
+  double *  old_data   = _data;
+  double ** old_X      = _X;
+  const int old_nbRows = _nbRows;
+  allocate(_nbRows,_nbCols,capacity);
+  if ( old_data )
+    std::copy(old_data,old_data+static_cast<std::size_t>(old_nbRows)*_nbCols,_data);
+  aligned_free_doubles(old_data);
+  delete [] old_X;
+}//
 
 /*---------------------------*/
 /*        constructor 1      */
@@ -33,21 +297,17 @@ SGTELIB::Matrix::Matrix ( const std::string & name ,
                           int                 nbCols    ) :
                _name   ( name ) ,
                _nbRows ( nbRows    ) ,
-               _nbCols ( nbCols    )   {
+               _nbCols ( nbCols    ) ,
+               _capacity ( 0 ) ,
+               _data   ( nullptr ) ,
+               _X      ( nullptr ) {
 
   if ( _nbRows < 0 || _nbCols < 0 )
     throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
              "Matrix::constructor 1: bad dimensions" );
 
-
-  int i , j;
-
-  _X = new double * [_nbRows];
-  for ( i = 0 ; i < _nbRows ; ++i ) {
-    _X[i] = new double [_nbCols];
-    for ( j = 0 ; j < _nbCols ; ++j )
-      _X[i][j] = 0.0;
-  }
+  allocate(nbRows,nbCols,nbRows);
+  std::fill(_data,_data+get_numel(),0.0);
 }//
 
 /*---------------------------*/
@@ -59,19 +319,17 @@ SGTELIB::Matrix::Matrix ( const std::string & name ,
                           double           ** A      ) :
                _name ( name ) ,
                _nbRows    ( nbRows    ) ,
-               _nbCols    ( nbCols    )   {
+               _nbCols    ( nbCols    ) ,
+               _capacity  ( 0 ) ,
+               _data      ( nullptr ) ,
+               _X         ( nullptr ) {
   if ( _nbRows < 0 || _nbCols < 0 )
     throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
               "Matrix::constructor 2: bad dimensions" );
 
-  int i , j;
-
-  _X = new double * [_nbRows];
-  for ( i = 0 ; i < _nbRows ; ++i ) {
-    _X[i] = new double [_nbCols];
-    for ( j = 0 ; j < _nbCols ; ++j )
-      _X[i][j] = A[i][j];
-  }
+  allocate(nbRows,nbCols,nbRows);
+  for ( int i = 0 ; i < _nbRows ; ++i )
+    std::copy(A[i],A[i]+_nbCols,_X[i]);
 }//
 
 /*---------------------------*/
@@ -81,7 +339,9 @@ SGTELIB::Matrix::Matrix ( const std::string & file_name ) :
                   _name ( "no_name" ) ,
                   _nbRows    ( 0         ) ,
                   _nbCols    ( 0         ) ,
-                  _X    ( NULL      )   {
+                  _capacity  ( 0         ) ,
+                  _data ( nullptr   ) ,
+                  _X    ( nullptr   )   {
   *this = import_data(file_name);
 }//
 
@@ -92,8 +352,10 @@ SGTELIB::Matrix::Matrix ( const std::string & file_name ) :
 SGTELIB::Matrix::Matrix (void) :
                _name ( "" ) ,
                _nbRows    ( 0   ) ,
-               _nbCols    ( 0   ) {
-  _X = new double * [0];
+               _nbCols    ( 0   ) ,
+               _capacity  ( 0   ) ,
+               _data ( nullptr  ) ,
+               _X    ( nullptr  ) {
 }//
 
 /*---------------------------*/
@@ -102,12 +364,14 @@ SGTELIB::Matrix::Matrix (void) :
 SGTELIB::Matrix::Matrix (double v) :
                _name ( "double" ) ,
                _nbRows    ( 1   ) ,
-               _nbCols    ( 1   ) {
+               _nbCols    ( 1   ) ,
+               _capacity  ( 0   ) ,
+               _data ( nullptr  ) ,
+               _X    ( nullptr  ) {
   #ifdef SGTELIB_DEBUG
     std::cout << "Matrix Constructor 5\n";
   #endif
-  _X = new double * [1];
-  _X[0] = new double [1];
+  allocate(1,1,1);
   _X[0][0] = v;
 }//
 
@@ -118,18 +382,34 @@ SGTELIB::Matrix::Matrix (double v) :
 SGTELIB::Matrix::Matrix ( const SGTELIB::Matrix & A ) :
                           _name ( A._name ) ,
                           _nbRows    ( A._nbRows    ) ,
-                          _nbCols    ( A._nbCols    ) {
+                          _nbCols    ( A._nbCols    ) ,
+                          _capacity  ( 0 ) ,
+                          _data      ( nullptr ) ,
+                          _X         ( nullptr ) {
 
   if ( _nbRows < 0 || _nbCols < 0 )
     throw SGTELIB::Exception ( __FILE__ , __LINE__ ,"Matrix::constructor copy : bad dimensions" );
 
-  int i , j;
-  _X = new double * [_nbRows];
-  for ( i = 0 ; i < _nbRows ; ++i ) {
-    _X[i] = new double [_nbCols];
-    for ( j = 0 ; j < _nbCols ; ++j )
-      _X[i][j] = A._X[i][j];
-  }
+  allocate(A._nbRows,A._nbCols,A._nbRows);
+  if ( _data )
+    std::copy(A._data,A._data+get_numel(),_data);
+}//
+
+/*---------------------------*/
+/*      move constructor     */
+/*---------------------------*/
+SGTELIB::Matrix::Matrix ( SGTELIB::Matrix && A ) noexcept :
+                          _name ( std::move(A._name) ) ,
+                          _nbRows    ( A._nbRows    ) ,
+                          _nbCols    ( A._nbCols    ) ,
+                          _capacity  ( A._capacity  ) ,
+                          _data      ( A._data      ) ,
+                          _X         ( A._X         ) {
+  A._nbRows   = 0;
+  A._nbCols   = 0;
+  A._capacity = 0;
+  A._data     = nullptr;
+  A._X        = nullptr;
 }//
 
 
@@ -143,35 +423,40 @@ SGTELIB::Matrix & SGTELIB::Matrix::operator = ( const SGTELIB::Matrix & A ) {
   if ( this == &A )
     return *this;
 
-  int i , j;
-
-  if ( _nbRows != A._nbRows || _nbCols != A._nbCols ) {
-
-    for ( i = 0 ; i < _nbRows ; ++i )
-      delete [] _X[i];
-    delete [] _X;
-
-    _nbRows = A._nbRows;
-    _nbCols = A._nbCols;
-
-    _X = new double * [_nbRows];
-    for ( i = 0 ; i < _nbRows ; ++i ) {
-      _X[i] = new double [_nbCols];
-      for ( j = 0 ; j < _nbCols ; ++j )
-        _X[i][j] = A._X[i][j];
-    }
+  // Reuse the buffer when it is large enough
+  if ( _nbCols != A._nbCols || _capacity < A._nbRows ) {
+    release();
+    allocate(A._nbRows,A._nbCols,A._nbRows);
   }
   else {
-    for ( i = 0 ; i < _nbRows ; ++i )
-      for ( j = 0 ; j < _nbCols ; ++j )
-        _X[i][j] = A._X[i][j];
+    _nbRows = A._nbRows;
   }
+  if ( _data )
+    std::copy(A._data,A._data+get_numel(),_data);
 
   _name = A._name;
 
   return *this;
 }//
 
+/*---------------------------*/
+/*  move affectation operator */
+/*---------------------------*/
+SGTELIB::Matrix & SGTELIB::Matrix::operator = ( SGTELIB::Matrix && A ) noexcept {
+
+  if ( this == &A )
+    return *this;
+
+  std::swap(_name    ,A._name);
+  std::swap(_nbRows  ,A._nbRows);
+  std::swap(_nbCols  ,A._nbCols);
+  std::swap(_capacity,A._capacity);
+  std::swap(_data    ,A._data);
+  std::swap(_X       ,A._X);
+
+  return *this;
+}//
+
 
 
 /*---------------------------*/
@@ -280,15 +565,9 @@ SGTELIB::Matrix operator * (const SGTELIB::Matrix & A , const SGTELIB::Matrix &
   return SGTELIB::Matrix::product(A,B);
 }
 SGTELIB::Matrix operator * (const SGTELIB::Matrix & A , const double v) {
-  int nbCols = A.get_nb_rows();
-  int nbRows = A.get_nb_cols();
-  SGTELIB::Matrix B(SGTELIB::dtos(v)+"*"+A.get_name(),nbCols,nbRows);
-  int i,j;
-  for ( i = 0 ; i < nbCols ; ++i ) {
-    for ( j = 0 ; j < nbRows ; ++j ) {
-      B.set(i,j,v*A.get(i,j));
-    }
-  }
+  SGTELIB::Matrix B(A);
+  B.multiply(v);
+  B.set_name(SGTELIB::dtos(v)+"*"+A.get_name());
   return B;
 }
 SGTELIB::Matrix operator * (const double v , const SGTELIB::Matrix & A) {
@@ -298,15 +577,15 @@ SGTELIB::Matrix operator + (const SGTELIB::Matrix & A , const SGTELIB::Matrix &
   return SGTELIB::Matrix::add(A,B);
 }//
 SGTELIB::Matrix operator + (const SGTELIB::Matrix & A , const double v) {
-  const int nbCols = A.get_nb_rows();
-  const int nbRows = A.get_nb_cols();
-  SGTELIB::Matrix B(SGTELIB::dtos(v)+"+"+A.get_name(),nbCols,nbRows);
-  int i,j;
-  for ( i = 0 ; i < nbCols ; ++i ) {
-    for ( j = 0 ; j < nbRows ; ++j ) {
-      B.set(i,j,v+A.get(i,j));
+  SGTELIB::Matrix B(A);
+  const int nbRows = B.get_nb_rows();
+  const int nbCols = B.get_nb_cols();
+  for ( int i = 0 ; i < nbRows ; ++i ) {
+    for ( int j = 0 ; j < nbCols ; ++j ) {
+      B.add(i,j,v);
     }
   }
+  B.set_name(SGTELIB::dtos(v)+"+"+A.get_name());
   return B;
 }//
 
@@ -344,21 +623,7 @@ SGTELIB::Matrix operator / (const SGTELIB::Matrix & A , const double v) {
 /*         destructor        */
 /*---------------------------*/
 SGTELIB::Matrix::~Matrix ( void ) {
-  /*
-  #ifdef SGTELIB_DEBUG
-    std::cout << "Delete " << _name << " of size (" << _nbCols << "," << _nbRows << ")...";
-    display(std::cout);
-    std::cout.flush();
-  #endif
-  */
-  for ( int i = 0 ; i < _nbRows ; ++i )
-    delete [] _X[i];
-  delete [] _X;
-  /*
-  #ifdef SGTELIB_DEBUG
-    std::cout << "Deleted.\n";
-  #endif
-  */
+  release();
 }//
 
 /*---------------------------*/
@@ -366,17 +631,10 @@ SGTELIB::Matrix::~Matrix ( void ) {
 /*---------------------------*/
 void SGTELIB::Matrix::add_row  ( const double * row ) {
 
-  double ** new_X = new double * [_nbRows+1];
-
-  for ( int i = 0 ; i < _nbRows ; ++i )
-    new_X[i] = _X[i];
-
-  new_X[_nbRows] = new double [_nbCols];
-  for ( int j = 0 ; j < _nbCols ; ++j )
-    new_X[_nbRows][j] = row[j];
+  if ( _nbRows == _capacity )
+    reserve_rows(std::max(4,2*_capacity));
 
-  delete [] _X;
-  _X = new_X;
+  std::copy(row,row+_nbCols,_X[_nbRows]);
   ++_nbRows;
 }//
 
@@ -389,22 +647,12 @@ void SGTELIB::Matrix::add_rows ( const Matrix & A ) {
     throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
              "Matrix::add_rows(): bad dimensions" );
 
-  int i , j;
-  int new_nbRows = _nbRows + A._nbRows;
-
-  double ** new_X = new double * [new_nbRows];
-
-  for ( i = 0 ; i < _nbRows ; ++i )
-    new_X[i] = _X[i];
-
-  for ( i = _nbRows ; i < new_nbRows ; ++i ) {
-    new_X[i] = new double [_nbCols];
-    for ( j = 0 ; j < _nbCols ; ++j )
-      new_X[i][j] = A._X[i-_nbRows][j];
-  }
+  const int new_nbRows = _nbRows + A._nbRows;
+  if ( new_nbRows > _capacity )
+    reserve_rows(std::max(new_nbRows,2*_capacity));
 
-  delete [] _X;
-  _X = new_X;
+  if ( A._data )
+    std::copy(A._data,A._data+A.get_numel(),_X[_nbRows]);
   _nbRows = new_nbRows;
 }//
 
@@ -417,26 +665,21 @@ void SGTELIB::Matrix::add_cols ( const Matrix & A ) {
     throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
              "Matrix::add_cols(): bad dimensions" );
 
-  int i , j;
-  int new_nbCols = _nbCols + A._nbCols;
-  double * x;
+  // The rows get longer: new buffer
+  double *  old_data = _data;
+  double ** old_X    = _X;
+  const int old_nbCols = _nbCols;
+  allocate(_nbRows,_nbCols + A._nbCols,_capacity);
 
-  for ( i = 0 ; i < _nbRows ; ++i ) {
-    // Complete line
-    x = new double [new_nbCols];
+  for ( int i = 0 ; i < _nbRows ; ++i ) {
     // Original columns
-    for ( j = 0 ; j < _nbCols ; ++j )
-      x[j] = _X[i][j];
+    std::copy(old_X[i],old_X[i]+old_nbCols,_X[i]);
     // Additional columns
-    for ( j = _nbCols ; j < new_nbCols ; ++j )
-      x[j] = A._X[i][j-_nbCols];
-    // Remove original line
-    delete [] _X[i];
-    // Put new line
-    _X[i] = x;
+    std::copy(A._X[i],A._X[i]+A._nbCols,_X[i]+old_nbCols);
   }
 
-  _nbCols = new_nbCols;
+  aligned_free_doubles(old_data);
+  delete [] old_X;
 }//
 
 /*---------------------------------*/
@@ -444,23 +687,12 @@ void SGTELIB::Matrix::add_cols ( const Matrix & A ) {
 /*---------------------------------*/
 void SGTELIB::Matrix::add_rows ( const int p ) {
 
-  int i , j;
-  int new_nbRows = _nbRows + p;
-
-  double ** new_X = new double * [new_nbRows];
-
-  for ( i = 0 ; i < _nbRows ; ++i )
-    new_X[i] = _X[i];
+  const int new_nbRows = _nbRows + p;
+  if ( new_nbRows > _capacity )
+    reserve_rows(std::max(new_nbRows,2*_capacity));
 
-  for ( i = _nbRows ; i < new_nbRows ; ++i ) {
-    new_X[i] = new double [_nbCols];
-    for ( j = 0 ; j < _nbCols ; ++j )
-      new_X[i][j] = 0.0;
-  }
-
-  delete [] _X;
-
-  _X = new_X;
+  for ( int i = _nbRows ; i < new_nbRows ; ++i )
+    std::fill(_X[i],_X[i]+_nbCols,0.0);
   _nbRows = new_nbRows;
 }//
 
@@ -469,20 +701,8 @@ void SGTELIB::Matrix::add_rows ( const int p ) {
 /*---------------------------------*/
 void SGTELIB::Matrix::remove_rows ( const int p ) {
 
-  int i;
-  int new_nbRows = _nbRows - p;
-
-  double ** new_X = new double * [new_nbRows];
-
-  for ( i = 0 ; i < new_nbRows ; ++i )
-    new_X[i] = _X[i];
-
-  for ( i = new_nbRows ; i < _nbRows ; ++i )
-    delete [] _X[i];
-
-  delete [] _X;
-  _X = new_X;
-  _nbRows = new_nbRows;
+  // The buffer is kept for the rows added later
+  _nbRows = std::max(0,_nbRows - p);
 }//
 
 /*---------------------------------*/
@@ -490,22 +710,18 @@ void SGTELIB::Matrix::remove_rows ( const int p ) {
 /*---------------------------------*/
 void SGTELIB::Matrix::add_cols ( const int p ) {
 
-  int i , j;
-  int new_nbCols = _nbCols + p;
-
-  double * x;
+  double *  old_data = _data;
+  double ** old_X    = _X;
+  const int old_nbCols = _nbCols;
+  allocate(_nbRows,_nbCols + p,_capacity);
 
-  for ( i = 0 ; i < _nbRows ; ++i ) {
-    x = new double [new_nbCols];
-    for ( j = 0 ; j < _nbCols ; ++j )
-      x[j] = _X[i][j];
-    for ( j = _nbCols ; j < new_nbCols ; ++j )
-      x[j] = 0.0;
-    delete [] _X[i];
-    _X[i] = x;
+  for ( int i = 0 ; i < _nbRows ; ++i ) {
+    std::copy(old_X[i],old_X[i]+old_nbCols,_X[i]);
+    std::fill(_X[i]+old_nbCols,_X[i]+_nbCols,0.0);
   }
 
-  _nbCols = new_nbCols;
+  aligned_free_doubles(old_data);
+  delete [] old_X;
 }//
 
 /*-----------------------------------------*/
@@ -554,12 +770,7 @@ void SGTELIB::Matrix::set_random ( double l , double u , bool round ) {
 /*  fill with value v        */
 /*---------------------------*/
 void SGTELIB::Matrix::fill ( double v ) {
-  int i , j;
-  for ( i = 0 ; i < _nbRows ; ++i ){
-    for ( j = 0 ; j < _nbCols ; ++j ){
-      _X[i][j] = v;
-    }
-  }
+  std::fill(_data,_data+get_numel(),v);
 }//
 
 /*---------------------------*/
@@ -633,10 +844,9 @@ void SGTELIB::Matrix::swap (const int i1 , const int j1 , const int i2 , const i
 }//
 
 void SGTELIB::Matrix::multiply (const double &v){
-    for (int i=0 ; i<_nbRows ; i++){
-        for (int j=0 ; j<_nbCols ; j++){
-            _X[i][j] *= v;
-        }
+    const int numel = get_numel();
+    for (int k=0 ; k<numel ; k++){
+        _data[k] *= v;
     }
 }//
 
@@ -935,21 +1145,42 @@ void SGTELIB::Matrix::inplace_product(
         throw SGTELIB::Exception ( __FILE__ , __LINE__ , "Matrix::product(A,B): dimension error" );
     }
 
-    // Compute
-    int i,j,k;
-    const int nb_rows = C.get_nb_rows();
-    const int nb_cols = C.get_nb_cols();
-    const int nb_inter= A.get_nb_cols();
-    //double v;
-    for ( i = 0 ; i < nb_rows ; ++i ) {
-        for ( j = 0 ; j < nb_cols ; ++j ){
-            C._X[i][j] = 0;
-        }
-        for ( k = 0 ; k < nb_inter; ++k ){
-            for ( j = 0 ; j < nb_cols ; ++j ){
-                C._X[i][j] += A._X[i][k]*B._X[k][j];
-            }
-        }
+    if ( (C.get_nb_rows()!=A.get_nb_rows()) || (C.get_nb_cols()!=B.get_nb_cols()) ){
+        throw SGTELIB::Exception ( __FILE__ , __LINE__ , "Matrix::inplace_product(C,A,B): dimension error" );
+    }
+
+    if ( (&C==&A) || (&C==&B) ){
+        // C is read while written, compute in a temporary
+        C = product(A,B);
+        return;
+    }
+
+    if ( SGTELIB::linalg::gemm(false,false,A._nbRows,B._nbCols,A._nbCols,
+                               A._data,A._nbCols,B._data,B._nbCols,C._data,C._nbCols) != SGTELIB::linalg::LINALG_SUCCESS ){
+      gemm_nn(C._X,A._X,B._X,A.get_nb_rows(),B.get_nb_cols(),A.get_nb_cols());
+    }
+}//
+
+/*---------------------------*/
+/*  in place product A'*B    */
+/*---------------------------*/
+void SGTELIB::Matrix::inplace_transposeA_product(
+    SGTELIB::Matrix & C,
+    const SGTELIB::Matrix & A,
+    const SGTELIB::Matrix & B )
+{
+    if ( (A.get_nb_rows()!=B.get_nb_rows()) || (C.get_nb_rows()!=A.get_nb_cols()) || (C.get_nb_cols()!=B.get_nb_cols()) ){
+        throw SGTELIB::Exception ( __FILE__ , __LINE__ , "Matrix::inplace_transposeA_product(C,A,B): dimension error" );
+    }
+
+    if ( (&C==&A) || (&C==&B) ){
+        C = transposeA_product(A,B);
+        return;
+    }
+
+    if ( SGTELIB::linalg::gemm(true,false,A._nbCols,B._nbCols,A._nbRows,
+                               A._data,A._nbCols,B._data,B._nbCols,C._data,C._nbCols) != SGTELIB::linalg::LINALG_SUCCESS ){
+      gemm_tn(C._X,A._X,B._X,A.get_nb_cols(),B.get_nb_cols(),A.get_nb_rows());
     }
 }//
 
@@ -1028,13 +1259,22 @@ double SGTELIB::Matrix::dot ( const SGTELIB::Matrix & A,
 
 bool SGTELIB::Matrix::testNull() const
 {
-    return (_X[0] == nullptr);
+    return (_data == nullptr);
 }
 
 /*---------------------------*/
 SGTELIB::Matrix SGTELIB::Matrix::product ( const SGTELIB::Matrix & A,
                                            const SGTELIB::Matrix & B,
                                            const SGTELIB::Matrix & C){
+  // Choose the cheapest association: (A*B)*C costs na*ma*mb+na*mb*mc,
+  // A*(B*C) costs nb*mb*mc+na*ma*mc.
+  const double costLeft  = double(A.get_nb_rows())*A.get_nb_cols()*B.get_nb_cols()
+                         + double(A.get_nb_rows())*B.get_nb_cols()*C.get_nb_cols();
+  const double costRight = double(B.get_nb_rows())*B.get_nb_cols()*C.get_nb_cols()
+                         + double(A.get_nb_rows())*A.get_nb_cols()*C.get_nb_cols();
+  if (costLeft<costRight){
+    return product(product(A,B),C);
+  }
   return product(A,product(B,C));
 }//
 /*---------------------------*/
@@ -1092,12 +1332,9 @@ SGTELIB::Matrix SGTELIB::Matrix::subset_product (const SGTELIB::Matrix & A,
   }
 
   SGTELIB::Matrix C("A*B",p,r);
-  for (int i=0 ; i<p ; i++){
-    for (int j=0 ; j<r ; j++){
-      for (int k=0 ; k<q ; k++){
-        C._X[i][j] += A._X[i][k]*B._X[k][j];
-      }
-    }
+  // The kernel only reads the first q columns of A and r columns of B
+  if ( SGTELIB::linalg::gemm(false,false,p,r,q,A._data,A._nbCols,B._data,B._nbCols,C._data,r) != SGTELIB::linalg::LINALG_SUCCESS ){
+    gemm_nn(C._X,A._X,B._X,p,r,q);
   }
   return C;
 
@@ -1123,11 +1360,9 @@ SGTELIB::Matrix SGTELIB::Matrix::hadamard_product ( const SGTELIB::Matrix & A,
   SGTELIB::Matrix C(A.get_name()+".*"+B.get_name(),nb_rows,nb_cols);
 
   // Compute
-  int i,j;
-  for ( i = 0 ; i < nb_rows ; ++i ) {
-    for ( j = 0 ; j < nb_cols ; ++j ){
-      C.set(i,j,A.get(i,j)*B.get(i,j));
-    }
+  const int numel = C.get_numel();
+  for ( int k = 0 ; k < numel ; ++k ) {
+    C._data[k] = A._data[k]*B._data[k];
   }
   return C;
 }//
@@ -1372,20 +1607,47 @@ SGTELIB::Matrix SGTELIB::Matrix::transposeA_product ( const SGTELIB::Matrix & A,
 
   // Init matrix
   SGTELIB::Matrix C(A.get_name()+"'*"+B.get_name(),A.get_nb_cols(),B.get_nb_cols());
+  if ( SGTELIB::linalg::gemm(true,false,A._nbCols,B._nbCols,A._nbRows,
+                             A._data,A._nbCols,B._data,B._nbCols,C._data,C._nbCols) != SGTELIB::linalg::LINALG_SUCCESS ){
+    gemm_tn(C._X,A._X,B._X,A.get_nb_cols(),B.get_nb_cols(),A.get_nb_rows());
+  }
+  return C;
 
-  // Compute
-  int i,j,k;
-  const int nb_rows = C.get_nb_rows();
-  const int nb_cols = C.get_nb_cols();
-  const int nb_inter= A.get_nb_rows();
-  //double v;
-  for ( i = 0 ; i < nb_rows ; ++i ) {
-    for ( j = 0 ; j < nb_cols ; ++j ){
-      C._X[i][j] = 0;
-      for ( k = 0 ; k < nb_inter; ++k ){
-        C._X[i][j] += A._X[k][i]*B._X[k][j];
-      }
-    }
+}//
+
+/*-------------------------------------*/
+/*      transposeA_product             */
+/*        Product A'*B*C               */
+/*-------------------------------------*/
+SGTELIB::Matrix SGTELIB::Matrix::transposeA_product ( const SGTELIB::Matrix & A,
+                                                      const SGTELIB::Matrix & B,
+                                                      const SGTELIB::Matrix & C )  {
+  // Same association rule as product(A,B,C), A' is never formed.
+  const double costLeft  = double(A.get_nb_cols())*A.get_nb_rows()*B.get_nb_cols()
+                         + double(A.get_nb_cols())*B.get_nb_cols()*C.get_nb_cols();
+  const double costRight = double(B.get_nb_rows())*B.get_nb_cols()*C.get_nb_cols()
+                         + double(A.get_nb_cols())*A.get_nb_rows()*C.get_nb_cols();
+  if (costLeft<costRight){
+    return product(transposeA_product(A,B),C);
+  }
+  return transposeA_product(A,product(B,C));
+}//
+
+/*-------------------------------------*/
+/*      transposeB_product             */
+/*        Product A*B'                 */
+/*-------------------------------------*/
+SGTELIB::Matrix SGTELIB::Matrix::transposeB_product ( const SGTELIB::Matrix & A,
+                                                      const SGTELIB::Matrix & B )  {
+
+  if (A.get_nb_cols()!=B.get_nb_cols()){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ , "Matrix::transposeB_product(A,B): dimension error" );
+  }
+
+  SGTELIB::Matrix C(A.get_name()+"*"+B.get_name()+"'",A.get_nb_rows(),B.get_nb_rows());
+  if ( SGTELIB::linalg::gemm(false,true,A._nbRows,B._nbRows,A._nbCols,
+                             A._data,A._nbCols,B._data,B._nbCols,C._data,C._nbCols) != SGTELIB::linalg::LINALG_SUCCESS ){
+    gemm_nt(C._X,A._X,B._X,A.get_nb_rows(),B.get_nb_rows(),A.get_nb_cols());
   }
   return C;
 
@@ -1533,11 +1795,9 @@ SGTELIB::Matrix SGTELIB::Matrix::add ( const SGTELIB::Matrix & A,
   SGTELIB::Matrix C(A.get_name()+"+"+B.get_name(),nb_rows,nb_cols);
 
   // Compute
-  int i,j;
-  for ( i = 0 ; i < nb_rows ; ++i ) {
-    for ( j = 0 ; j < nb_cols ; ++j ){
-      C._X[i][j] = A._X[i][j]+B._X[i][j];
-    }
+  const int numel = C.get_numel();
+  for ( int k = 0 ; k < numel ; ++k ) {
+    C._data[k] = A._data[k]+B._data[k];
   }
   return C;
 }//
@@ -1555,11 +1815,9 @@ void SGTELIB::Matrix::add ( const SGTELIB::Matrix & B ) {
   }
 
   // Compute
-  int i,j;
-  for ( i = 0 ; i < _nbRows ; ++i ) {
-    for ( j = 0 ; j < _nbCols ; ++j ){
-      _X[i][j] += B.get(i,j);
-    }
+  const int numel = get_numel();
+  for ( int k = 0 ; k < numel ; ++k ) {
+    _data[k] += B._data[k];
   }
 }//
 
@@ -1612,11 +1870,9 @@ SGTELIB::Matrix SGTELIB::Matrix::sub ( const SGTELIB::Matrix & A,
   SGTELIB::Matrix C(A.get_name()+"-"+B.get_name(),nb_rows,nb_cols);
 
   // Compute
-  int i,j;
-  for ( i = 0 ; i < nb_rows ; ++i ) {
-    for ( j = 0 ; j < nb_cols ; ++j ){
-      C.set(i,j,A.get(i,j)-B.get(i,j));
-    }
+  const int numel = C.get_numel();
+  for ( int k = 0 ; k < numel ; ++k ) {
+    C._data[k] = A._data[k]-B._data[k];
   }
   return C;
 }//
@@ -1634,11 +1890,9 @@ void SGTELIB::Matrix::sub ( const SGTELIB::Matrix & B ) {
   }
 
   // Compute
-  int i,j;
-  for ( i = 0 ; i < _nbRows ; ++i ) {
-    for ( j = 0 ; j < _nbCols ; ++j ){
-      _X[i][j] -= B._X[i][j];
-    }
+  const int numel = get_numel();
+  for ( int k = 0 ; k < numel ; ++k ) {
+    _data[k] -= B._data[k];
   }
 }//
 
@@ -1674,36 +1928,42 @@ SGTELIB::Matrix SGTELIB::Matrix::ones ( const int nbRows , const int nbCols ) {
 /*---------------------------*/
 SGTELIB::Matrix SGTELIB::Matrix::rank ( void ) const {
 
-  // TODO: use faster method...
   if ((_nbRows>1) && (_nbCols>1))
     throw SGTELIB::Exception ( __FILE__ , __LINE__ ,"Matrix::rank: dimension error" );
 
-  SGTELIB::Matrix R;
-  if (_nbRows>1){
-    R = this->transpose().rank();
-    R = R.transpose();
-  }
-  else{
-    const int m = _nbCols;
-    SGTELIB::Matrix D = *this;
-    R = SGTELIB::Matrix("R",1,m);
-    double dmin;
-    int i,j,jmin=0;
-    for (i=0 ; i<m ; i++){
-      dmin = +INF;
-      for (j=0 ; j<m ; j++){
-        if (D._X[0][j]<dmin){
-          jmin = j;
-          dmin = D._X[0][j];
-        }
-      }
-      R.set(0,jmin,double(i));
-      D.set(0,jmin,INF);
-    }
+  // Indexes sorted by value. Equal values are ranked by index, NaN last.
+  const int m = _nbRows*_nbCols;
+  std::vector<int> index (m);
+  for (int k=0 ; k<m ; k++) index[k] = k;
+  const double * v = _data;
+  std::stable_sort(index.begin(),index.end(),[v](const int k1, const int k2){
+    return (v[k1]<v[k2]) || ( (v[k2]!=v[k2]) && (v[k1]==v[k1]) );
+  });
+
+  SGTELIB::Matrix R ("R",_nbRows,_nbCols);
+  for (int i=0 ; i<m ; i++){
+    R._data[index[i]] = double(i);
   }
   return R;
 }//
 
+/*---------------------------*/
+/*   k-th smallest value     */
+/*---------------------------*/
+double SGTELIB::Matrix::get_kth_smallest ( const int k ) const {
+
+  if ((_nbRows>1) && (_nbCols>1))
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,"Matrix::get_kth_smallest: dimension error" );
+  const int m = _nbRows*_nbCols;
+  if ( (k<0) || (k>=m) )
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,"Matrix::get_kth_smallest: bad index" );
+
+  // Partial sort (linear time) instead of the ranks of all the values
+  std::vector<double> v (_data,_data+m);
+  std::nth_element(v.begin(),v.begin()+k,v.end());
+  return v[k];
+}//
+
 /*---------------------------*/
 /*        Trace              */
 /*---------------------------*/
@@ -2066,18 +2326,21 @@ SGTELIB::Matrix SGTELIB::Matrix::triu_solve( const SGTELIB::Matrix & U ,
     throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
              "Matrix::triu_solve(): dimension error" );
   }
-  if (1!=b.get_nb_cols()){
-    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
-             "Matrix::triu_solve(): dimension error" );
-  }
 
+  // b may have several columns (right-hand sides). The rows of x are
+  // updated as a whole, so that the inner loop is contiguous.
   SGTELIB::Matrix x = b;
+  const int m = b.get_nb_cols();
 
   for (int i=n-1 ; i>=0 ; i--){
+    double * xi = x._X[i];
     for (int j=i+1 ; j<n ; j++){
-      x._X[i][0] -= U._X[i][j]*x._X[j][0];
+      const double u = U._X[i][j];
+      const double * xj = x._X[j];
+      for (int k=0 ; k<m ; k++) xi[k] -= u*xj[k];
     }
-    x._X[i][0] /= U._X[i][i];
+    const double d = 1.0/U._X[i][i];
+    for (int k=0 ; k<m ; k++) xi[k] *= d;
   }
 
   return x;
@@ -2087,17 +2350,8 @@ SGTELIB::Matrix SGTELIB::Matrix::triu_solve( const SGTELIB::Matrix & U ,
 /*    Inverse Lower Triangular Matrix      */
 /*-----------------------------------------*/
 SGTELIB::Matrix SGTELIB::Matrix::tril_inverse( const SGTELIB::Matrix & L ){
-  const int n = L.get_nb_rows();
-  SGTELIB::Matrix Li = L;
-  SGTELIB::Matrix b ("b",n,1);
-
-  for (int i=0 ; i<n ; i++){
-    b.set(i,0,1.0);
-    Li.set_col( SGTELIB::Matrix::tril_solve(L,b) , i);
-    b.set(i,0,0.0);
-  }
-
-  return Li;
+  // All the columns of the identity are solved at once.
+  return SGTELIB::Matrix::tril_solve(L,SGTELIB::Matrix::identity(L.get_nb_rows()));
 }//
 
 /*-----------------------------------------*/
@@ -2114,32 +2368,267 @@ SGTELIB::Matrix SGTELIB::Matrix::tril_solve( const SGTELIB::Matrix & L ,
     throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
              "Matrix::tril_solve(): dimension error" );
   }
-  if (1!=b.get_nb_cols()){
+
+  SGTELIB::Matrix x = b;
+  const int m = b.get_nb_cols();
+
+  for (int i=0 ; i<n ; i++){
+    double * xi = x._X[i];
+    for (int j=0 ; j<i ; j++){
+      const double l = L._X[i][j];
+      const double * xj = x._X[j];
+      for (int k=0 ; k<m ; k++) xi[k] -= l*xj[k];
+    }
+    const double d = 1.0/L._X[i][i];
+    for (int k=0 ; k<m ; k++) xi[k] *= d;
+  }
+
+  return x;
+}//
+
+/*-----------------------------------------*/
+/*  Solve L'*x = b, L Lower Triangular     */
+/*  (L' is not formed)                     */
+/*-----------------------------------------*/
+SGTELIB::Matrix SGTELIB::Matrix::tril_transpose_solve( const SGTELIB::Matrix & L ,
+                                                       const SGTELIB::Matrix & b ){
+  const int n = L.get_nb_rows();
+  if ( (n!=L.get_nb_cols()) || (n!=b.get_nb_rows()) ){
     throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
-             "Matrix::tril_solve(): dimension error" );
+             "Matrix::tril_transpose_solve(): dimension error" );
   }
 
   SGTELIB::Matrix x = b;
+  const int m = b.get_nb_cols();
 
-  for (int i=0 ; i<n ; i++){
+  // Column oriented back substitution: once x_i is known,
+  // it is removed from the rows above (L'(j,i) = L(i,j)).
+  for (int i=n-1 ; i>=0 ; i--){
+    double * xi = x._X[i];
+    const double d = 1.0/L._X[i][i];
+    for (int k=0 ; k<m ; k++) xi[k] *= d;
     for (int j=0 ; j<i ; j++){
-      x._X[i][0] -= L._X[i][j]*x._X[j][0];
+      const double l = L._X[i][j];
+      double * xj = x._X[j];
+      for (int k=0 ; k<m ; k++) xj[k] -= l*xi[k];
     }
-    x._X[i][0] /= L._X[i][i];
   }
 
   return x;
 }//
 
+/*-----------------------------------------*/
+/*  Cholesky factorization A = L*L'        */
+/*  Return false if A is not (numerically) */
+/*  positive definite.                     */
+/*-----------------------------------------*/
+bool SGTELIB::Matrix::cholesky_factor ( SGTELIB::Matrix & L , double * det ) const {
+  L = SGTELIB::Matrix ("L",0,0);
+  return cholesky_factor_append(L,det);
+}//
+
+/*-----------------------------------------*/
+/*  Cholesky factor of a bordered matrix:  */
+/*  L is the factor of the leading block   */
+/*  of this matrix. The rows of the other  */
+/*  points are appended to L.              */
+/*-----------------------------------------*/
+bool SGTELIB::Matrix::cholesky_factor_append ( SGTELIB::Matrix & L , double * det ) const {
+
+  if (get_nb_rows()!=get_nb_cols()){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+             "Matrix::cholesky_factor_append(): dimension error" );
+  }
+
+  const int n = get_nb_rows();
+  const int n0 = L.get_nb_rows();
+  if ( (n0>n) || (n0!=L.get_nb_cols()) ){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+             "Matrix::cholesky_factor_append(): dimension error" );
+  }
+  if (n0==0){
+    SGTELIB::Matrix F (*this);
+    const SGTELIB::linalg::linalg_status_t status = SGTELIB::linalg::cholesky(n,F._data,n);
+    if (status==SGTELIB::linalg::LINALG_FAILURE){
+      if (det) *det = 0;
+      return false;
+    }
+    if (status==SGTELIB::linalg::LINALG_SUCCESS){
+      F.set_name(L.get_name());
+      L = std::move(F);
+      if (det){
+        double logdet = 0;
+        for (int i = 0; i < n; i++) logdet += 2*log(L._X[i][i]);
+        *det = exp(logdet);
+        if ( isnan(*det) ) *det = +INF;
+      }
+      return true;
+    }
+  }
+
+  L.add_rows(n-n0);
+  L.add_cols(n-n0);
+
+  // Row-by-row (Cholesky-Banachiewicz): both L rows are contiguous,
+  // and row i only depends on the previous rows.
+  double s;
+  int i,j,k;
+  for (i = n0; i < n; i++) {
+    const double * Li = L._X[i];
+    for (j = 0; j <= i; j++) {
+      const double * Lj = L._X[j];
+      s = _X[i][j];
+      for (k = 0; k < j; k++){
+        s -= Li[k] * Lj[k];
+      }
+      if (i == j){
+        if ( ! (s > 0) ) {
+          if (det) *det = 0;
+          return false;
+        }
+        L._X[i][i] = sqrt(s);
+      }
+      else{
+        L._X[i][j] = s / L._X[j][j];
+      }
+    }
+  }
+
+  if (det){
+    double logdet = 0;
+    for (i = 0; i < n; i++) logdet += 2*log(L._X[i][i]);
+    *det = exp(logdet);
+    if ( isnan(*det) ) *det = +INF;
+  }
+  return true;
+}//
+
+/*-----------------------------------------*/
+/*  Solve A*x = b with A = L*L'            */
+/*-----------------------------------------*/
+SGTELIB::Matrix SGTELIB::Matrix::cholesky_factor_solve ( const SGTELIB::Matrix & L ,
+                                                         const SGTELIB::Matrix & b ) {
+  return tril_transpose_solve(L,tril_solve(L,b));
+}//
+
+/*-----------------------------------------*/
+/*  LU factorization with partial pivoting */
+/*  P*A = L*U, L (unit diag) and U are     */
+/*  stored in LU. P[i] is the row of A     */
+/*  that is in row i of P*A.               */
+/*  Return false if A is singular.         */
+/*-----------------------------------------*/
+bool SGTELIB::Matrix::lu_factor ( SGTELIB::Matrix & LU ,
+                                  std::vector<int> & P ,
+                                  double * det ) const {
+
+  if (get_nb_rows()!=get_nb_cols()){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+             "Matrix::lu_factor(): dimension error" );
+  }
+
+  const int n = get_nb_rows();
+  LU = *this;
+  P.resize(n);
+  for (int i=0 ; i<n ; i++) P[i]=i;
+
+  double sign = 1;
+  const SGTELIB::linalg::linalg_status_t status = SGTELIB::linalg::lu(n,LU._data,n,P.data(),&sign);
+  if (status==SGTELIB::linalg::LINALG_FAILURE){
+    if (det) *det = 0;
+    return false;
+  }
+  if (status==SGTELIB::linalg::LINALG_SUCCESS){
+    if (det){
+      double v = sign;
+      for (int i=0 ; i<n ; i++) v *= LU._X[i][i];
+      *det = v;
+    }
+    return true;
+  }
+
+  for (int k=0 ; k<n ; k++){
+
+    // Pivot: largest term of column k
+    int ip = k;
+    double pmax = fabs(LU._X[k][k]);
+    for (int i=k+1 ; i<n ; i++){
+      if (fabs(LU._X[i][k])>pmax){
+        pmax = fabs(LU._X[i][k]);
+        ip = i;
+      }
+    }
+    if ( ! (pmax > 0) ){
+      if (det) *det = 0;
+      return false;
+    }
+    if (ip!=k){
+      LU.swap_rows(ip,k);
+      std::swap(P[ip],P[k]);
+      sign = -sign;
+    }
+
+    // Elimination, row by row
+    const double * Uk = LU._X[k];
+    const double d = 1.0/Uk[k];
+    for (int i=k+1 ; i<n ; i++){
+      double * Ui = LU._X[i];
+      const double l = Ui[k]*d;
+      Ui[k] = l;
+      if (l!=0){
+        for (int j=k+1 ; j<n ; j++) Ui[j] -= l*Uk[j];
+      }
+    }
+  }
+
+  if (det){
+    double v = sign;
+    for (int i=0 ; i<n ; i++) v *= LU._X[i][i];
+    *det = v;
+  }
+  return true;
+}//
+
+/*-----------------------------------------*/
+/*  Solve A*x = b with P*A = L*U           */
+/*-----------------------------------------*/
+SGTELIB::Matrix SGTELIB::Matrix::lu_factor_solve ( const SGTELIB::Matrix & LU ,
+                                                   const std::vector<int> & P ,
+                                                   const SGTELIB::Matrix & b ) {
+  const int n = LU.get_nb_rows();
+  if ( (n!=b.get_nb_rows()) || (n!=static_cast<int>(P.size())) ){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+             "Matrix::lu_factor_solve(): dimension error" );
+  }
+  const int m = b.get_nb_cols();
+
+  // x = P*b
+  SGTELIB::Matrix x ("x",n,m);
+  for (int i=0 ; i<n ; i++){
+    std::copy(b._X[P[i]],b._X[P[i]]+m,x._X[i]);
+  }
+
+  // Forward substitution, unit diagonal
+  for (int i=0 ; i<n ; i++){
+    double * xi = x._X[i];
+    for (int j=0 ; j<i ; j++){
+      const double l = LU._X[i][j];
+      const double * xj = x._X[j];
+      for (int k=0 ; k<m ; k++) xi[k] -= l*xj[k];
+    }
+  }
+
+  // Back substitution
+  return triu_solve(LU,x);
+}//
+
 /*-----------------------------------------*/
 /*  Solve System with Cholesky             */
 /*-----------------------------------------*/
 SGTELIB::Matrix SGTELIB::Matrix::cholesky_solve ( const SGTELIB::Matrix & A ,
                                                   const SGTELIB::Matrix & b ) {
   SGTELIB::Matrix L = A.cholesky();
-  SGTELIB::Matrix y = tril_solve(L,b);
-  SGTELIB::Matrix x = triu_solve(L.transpose(),y);
-  return x;
+  return cholesky_factor_solve(L,b);
 }//
 
 /*---------------------------*/
@@ -2254,9 +2743,18 @@ SGTELIB::Matrix SGTELIB::Matrix::solve_least_squares_SVD ( const SGTELIB::Matrix
 /*---------------------------*/
 SGTELIB::Matrix SGTELIB::Matrix::transpose ( void ) const{
   SGTELIB::Matrix A (_name+"'",_nbCols,_nbRows);
-  for (int i=0 ; i<_nbCols ; i++){
-    for (int j=0 ; j<_nbRows ; j++){
-      A.set(i,j,_X[j][i]);
+  // Tiles of 32x32 so that the source and destination lines stay in cache
+  const int TILE = 32;
+  for (int i0=0 ; i0<_nbCols ; i0+=TILE){
+    const int i1 = std::min(_nbCols,i0+TILE);
+    for (int j0=0 ; j0<_nbRows ; j0+=TILE){
+      const int j1 = std::min(_nbRows,j0+TILE);
+      for (int j=j0 ; j<j1 ; j++){
+        const double * x = _X[j];
+        for (int i=i0 ; i<i1 ; i++){
+          A._X[i][j] = x[i];
+        }
+      }
     }
   }
   return A;
@@ -2383,6 +2881,23 @@ bool SGTELIB::Matrix::SVD_decomposition ( std::string & error_msg ,
     return false;
   }
 
+  if ( SGTELIB::linalg::use_backend(nbCols) && (nbRows>=nbCols) ) {
+    std::vector<double> bU (static_cast<size_t>(nbRows)*nbCols), bV (static_cast<size_t>(nbCols)*nbCols);
+    const SGTELIB::linalg::linalg_status_t status =
+      SGTELIB::linalg::svd(nbRows,nbCols,_data,nbCols,bU.data(),nbCols,W,bV.data(),nbCols);
+    if (status==SGTELIB::linalg::LINALG_FAILURE) {
+      error_msg = "SVD_decomposition() error: no convergence of the backend";
+      return false;
+    }
+    if (status==SGTELIB::linalg::LINALG_SUCCESS) {
+      for ( int i = 0 ; i < nbRows ; ++i )
+        std::copy(bU.begin()+static_cast<size_t>(i)*nbCols,bU.begin()+static_cast<size_t>(i+1)*nbCols,U[i]);
+      for ( int i = 0 ; i < nbCols ; ++i )
+        std::copy(bV.begin()+static_cast<size_t>(i)*nbCols,bV.begin()+static_cast<size_t>(i+1)*nbCols,V[i]);
+      return true;
+    }
+  }
+
   double * rv1   = new double[nbCols];
   double   scale = 0.0;
   double   g     = 0.0;
@@ -2910,20 +3425,7 @@ SGTELIB::Matrix SGTELIB::Matrix::get_distances_norm2 ( const SGTELIB::Matrix & A
   const int pa = A.get_nb_rows();
   const int pb = B.get_nb_rows();
   SGTELIB::Matrix D = SGTELIB::Matrix("D",pa,pb);
-  double v,d;
-  int ia, ib, j;
-
-  for (ia=0 ; ia < pa ; ia++){
-    for (ib=0 ; ib < pb ; ib++){
-      // Distance between the point ia of the cache and the point ib of the matrix XXs
-      v = 0;
-      for (j=0 ; j < n ; j++){
-        d = A._X[ia][j]-B._X[ib][j];
-        v += d*d;
-      }
-      D._X[ia][ib] = sqrt(v);
-    }
-  }
+  distances<norm2_t>(D._X,A._X,B._X,pa,pb,n);
   return D;
 }//
 
@@ -2934,25 +3436,13 @@ SGTELIB::Matrix SGTELIB::Matrix::get_distances_norm1 ( const SGTELIB::Matrix & A
                                                        const SGTELIB::Matrix & B ){
   const int n = A.get_nb_cols();
   if ( B.get_nb_cols()!=n ){
-    throw SGTELIB::Exception ( __FILE__ , __LINE__ , "get_distances_norm2: dimension error" );
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ , "get_distances_norm1: dimension error" );
   }
 
   const int pa = A.get_nb_rows();
   const int pb = B.get_nb_rows();
   SGTELIB::Matrix D = SGTELIB::Matrix("D",pa,pb);
-  double v;
-  int ia, ib, j;
-
-  for (ia=0 ; ia < pa ; ia++){
-    for (ib=0 ; ib < pb ; ib++){
-      // Distance between the point ia of the cache and the point ib of the matrix XXs
-      v = 0;
-      for (j=0 ; j < n ; j++){
-        v += fabs(A._X[ia][j]-B._X[ib][j]);
-      }
-      D._X[ia][ib] = v;
-    }
-  }
+  distances<norm1_t>(D._X,A._X,B._X,pa,pb,n);
   return D;
 }//
 
@@ -2963,25 +3453,13 @@ SGTELIB::Matrix SGTELIB::Matrix::get_distances_norminf ( const SGTELIB::Matrix &
                                                          const SGTELIB::Matrix & B ){
   const int n = A.get_nb_cols();
   if ( B.get_nb_cols()!=n ){
-    throw SGTELIB::Exception ( __FILE__ , __LINE__ , "get_distances_norm2: dimension error" );
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ , "get_distances_norminf: dimension error" );
   }
 
   const int pa = A.get_nb_rows();
   const int pb = B.get_nb_rows();
   SGTELIB::Matrix D = SGTELIB::Matrix("D",pa,pb);
-  double v;
-  int ia, ib, j;
-
-  for (ia=0 ; ia < pa ; ia++){
-    for (ib=0 ; ib < pb ; ib++){
-      // Distance between the point ia of the cache and the point ib of the matrix XXs
-      v = 0;
-      for (j=0 ; j < n ; j++){
-        v = std::max( v , fabs(A._X[ia][j]-B._X[ib][j]) );
-      }
-      D._X[ia][ib] = v;
-    }
-  }
+  distances<norminf_t>(D._X,A._X,B._X,pa,pb,n);
   return D;
 }//
 
@@ -3160,12 +3638,7 @@ SGTELIB::Matrix SGTELIB::Matrix::get_poll_directions ( const SGTELIB::Matrix& sc
 /* Swap two rows                                   */
 /*-------------------------------------------------*/
 void SGTELIB::Matrix::swap_rows(const int i1 , const int i2){
-  double buffer;
-  for (int j=0 ; j<_nbCols ; j++){
-    buffer    = _X[i1][j];
-    _X[i1][j] = _X[i2][j];
-    _X[i2][j] = buffer;
-  }
+  std::swap_ranges(_X[i1],_X[i1]+_nbCols,_X[i2]);
 }//
 
 /*-------------------------------------------------*/
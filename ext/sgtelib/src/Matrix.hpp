@@ -47,8 +47,14 @@ namespace SGTELIB {
 
     int _nbRows; // nbRows x nbCols matrix
     int _nbCols;
+    int _capacity; // nb of rows allocated (>= _nbRows)
 
-    double ** _X;
+    double *  _data; // contiguous row-major storage, aligned
+    double ** _X;    // _X[i] = _data + i*_nbCols
+
+    void allocate     ( const int nbRows , const int nbCols , const int capacity );
+    void release      ( void );
+    void reserve_rows ( const int capacity );
 
   public:
 
@@ -75,8 +81,12 @@ namespace SGTELIB {
     // copy constructor:
     Matrix ( const Matrix & );
 
+    // move constructor:
+    Matrix ( Matrix && ) noexcept;
+
     // affectation operator:
     Matrix & operator = ( const Matrix & A );
+    Matrix & operator = ( Matrix && A ) noexcept;
 
     //Matrix & operator * ( const Matrix & B);
 
@@ -101,6 +111,9 @@ namespace SGTELIB {
     inline int get_nb_rows ( void ) const { return _nbRows; }
     inline int get_nb_cols ( void ) const { return _nbCols; }
     inline int get_numel   ( void ) const { return _nbRows*_nbCols; }
+    // contiguous row-major storage (get_numel() values)
+    inline double       * get_data ( void )       { return _data; }
+    inline const double * get_data ( void ) const { return _data; }
 
       bool testNull()const;
 
@@ -222,6 +235,11 @@ namespace SGTELIB {
                             const SGTELIB::Matrix & A,
                             const SGTELIB::Matrix & B);
 
+    // C = A'*B, C must have the right dimensions
+    static void inplace_transposeA_product ( SGTELIB::Matrix & C,
+                                       const SGTELIB::Matrix & A,
+                                       const SGTELIB::Matrix & B);
+
     static double dot ( const SGTELIB::Matrix & A,
                                      const SGTELIB::Matrix & B);
 
@@ -255,6 +273,15 @@ namespace SGTELIB {
     static SGTELIB::Matrix transposeA_product ( const SGTELIB::Matrix & A,
                                                 const SGTELIB::Matrix & B);
 
+    // A'*B*C
+    static SGTELIB::Matrix transposeA_product ( const SGTELIB::Matrix & A,
+                                                const SGTELIB::Matrix & B,
+                                                const SGTELIB::Matrix & C);
+
+    // A*B'
+    static SGTELIB::Matrix transposeB_product ( const SGTELIB::Matrix & A,
+                                                const SGTELIB::Matrix & B);
+
 
     static SGTELIB::Matrix hadamard_product ( const SGTELIB::Matrix & A,
                                               const SGTELIB::Matrix & B);
@@ -299,6 +326,8 @@ namespace SGTELIB {
 
     // Rank of the values
     SGTELIB::Matrix rank ( void ) const;
+    // k-th smallest value of a vector (k=0 for the min)
+    double get_kth_smallest ( const int k ) const;
 
     // solve under-determined least squares via SVD
     static SGTELIB::Matrix solve_least_squares_SVD ( const SGTELIB::Matrix & A ,
@@ -327,11 +356,30 @@ namespace SGTELIB {
     // Triangular matrix
     static SGTELIB::Matrix tril_inverse (const SGTELIB::Matrix & L );
 
+    // b can have several columns
     static SGTELIB::Matrix triu_solve ( const SGTELIB::Matrix & U ,
                                         const SGTELIB::Matrix & b );
 
     static SGTELIB::Matrix tril_solve ( const SGTELIB::Matrix & L ,
                                         const SGTELIB::Matrix & b );
+
+    // Solve L'*x = b
+    static SGTELIB::Matrix tril_transpose_solve ( const SGTELIB::Matrix & L ,
+                                                  const SGTELIB::Matrix & b );
+
+    // Factorizations kept by the surrogates. Return false if the
+    // matrix is not positive definite (cholesky) or singular (lu).
+    bool cholesky_factor ( SGTELIB::Matrix & L , double * det = NULL ) const;
+    // Same, when L already holds the factor of the leading block
+    bool cholesky_factor_append ( SGTELIB::Matrix & L , double * det = NULL ) const;
+    bool lu_factor ( SGTELIB::Matrix & LU , std::vector<int> & P , double * det = NULL ) const;
+
+    // Solve with the factors
+    static SGTELIB::Matrix cholesky_factor_solve ( const SGTELIB::Matrix & L ,
+                                                   const SGTELIB::Matrix & b );
+    static SGTELIB::Matrix lu_factor_solve ( const SGTELIB::Matrix & LU ,
+                                             const std::vector<int> & P ,
+                                             const SGTELIB::Matrix & b );
     // SVD decomposition:
     bool SVD_decomposition ( std::string & error_msg ,
                              SGTELIB::Matrix &MAT_U,  // OUT, nbRows x nbCols
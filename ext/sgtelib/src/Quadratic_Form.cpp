@@ -0,0 +1,188 @@
+/*-------------------------------------------------------------------------------------*/
+/*  sgtelib - A surrogate model library for derivative-free optimization               */
+/*  Version 2.0.3                                                                      */
+/*                                                                                     */
+/*  Copyright (C) 2012-2017  Sebastien Le Digabel - Ecole Polytechnique, Montreal      */ 
+/*                           Bastien Talgorn - McGill University, Montreal             */
+/*                                                                                     */
+/*  Author: Bastien Talgorn                                                            */
+/*  email: bastientalgorn@fastmail.com                                                 */
+/*                                                                                     */
+/*  This program is free software: you can redistribute it and/or modify it under the  */
+/*  terms of the GNU Lesser General Public License as published by the Free Software   */
+/*  Foundation, either version 3 of the License, or (at your option) any later         */
+/*  version.                                                                           */
+/*                                                                                     */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT ANY    */
+/*  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A    */
+/*  PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.   */
+/*                                                                                     */
+/*  You should have received a copy of the GNU Lesser General Public License along     */
+/*  with this program. If not, see <http://www.gnu.org/licenses/>.                     */
+/*                                                                                     */
+/*  You can find information on sgtelib at https://github.com/bastientalgorn/sgtelib   */
+/*-------------------------------------------------------------------------------------*/
+#include "Quadratic_Form.hpp"
+
+namespace {
+  // Nb of points evaluated together by Quadratic_Form::eval. The points of a
+  // block are transposed so that the inner loops run over the points.
+  const int QF_BLOCK = 8;
+}
+
+/*--------------------------------------*/
+/*              constructor             */
+/*--------------------------------------*/
+SGTELIB::Quadratic_Form::Quadratic_Form ( void ) :
+  _n    ( 0 ) ,
+  _m    ( 0 ) ,
+  _coef ( "coef" , 0 , 0 ) {
+}//
+
+/*--------------------------------------*/
+/*                clear                 */
+/*--------------------------------------*/
+void SGTELIB::Quadratic_Form::clear ( void ) {
+  _n = 0;
+  _m = 0;
+  _coef = SGTELIB::Matrix("coef",0,0);
+}//
+
+/*--------------------------------------*/
+/*      extract from a PRS model        */
+/*--------------------------------------*/
+bool SGTELIB::Quadratic_Form::set_from_monomes ( const SGTELIB::Matrix & M ,
+                                                 const SGTELIB::Matrix & alpha ) {
+  clear();
+  const int q = M.get_nb_rows();
+  const int n = M.get_nb_cols();
+  const int m = alpha.get_nb_cols();
+  if ( (q==0) || (m==0) || (alpha.get_nb_rows()!=q) ) return false;
+
+  _n = n;
+  SGTELIB::Matrix coef ("coef",m,1+n+(n*(n+1))/2);
+  int i1,i2,d,e,j,k;
+  for (k=0 ; k<q ; k++){
+    // Degree of the monome and its (at most 2) variables
+    d = 0;
+    i1 = -1;
+    i2 = -1;
+    for (j=0 ; j<n ; j++){
+      e = static_cast<int>(M.get(k,j));
+      if (e==0) continue;
+      d += e;
+      if (d>2){
+        clear();
+        return false;
+      }
+      if (i1<0){
+        i1 = j;
+        if (e==2) i2 = j;
+      }
+      else i2 = j;
+    }
+    for (j=0 ; j<m ; j++){
+      const double a = alpha.get(k,j);
+      if (d==0)       coef.add(j,0,a);
+      else if (i2<0)  coef.add(j,1+i1,a);
+      // Monome xi^2 has coefficient H(i,i)/2, monome xi*xj has coefficient H(i,j)
+      else if (i1==i2) coef.add(j,index_H(i1,i1),2.0*a);
+      else            coef.add(j,index_H(i1,i2),a);
+    }
+  }
+  _coef = coef;
+  _m = m;
+  return true;
+}//
+
+/*--------------------------------------*/
+/*         H_j(i1,i2)                   */
+/*--------------------------------------*/
+double SGTELIB::Quadratic_Form::get_hessian ( const int j , const int i1 , const int i2 ) const {
+  return (i1<=i2) ? _coef.get(j,index_H(i1,i2)) : _coef.get(j,index_H(i2,i1));
+}//
+
+SGTELIB::Matrix SGTELIB::Quadratic_Form::get_hessian ( const int j ) const {
+  SGTELIB::Matrix H ("H",_n,_n);
+  for (int i1=0 ; i1<_n ; i1++){
+    for (int i2=i1 ; i2<_n ; i2++){
+      const double h = _coef.get(j,index_H(i1,i2));
+      H.set(i1,i2,h);
+      H.set(i2,i1,h);
+    }
+  }
+  return H;
+}//
+
+/*--------------------------------------*/
+/*       gradient: g_j + H_j x          */
+/*--------------------------------------*/
+void SGTELIB::Quadratic_Form::eval_gradient ( const int j , const double * x , double * g ) const {
+  const double * c = _coef.get_data()+j*_coef.get_nb_cols();
+  int i1,i2;
+  for (i1=0 ; i1<_n ; i1++) g[i1] = c[1+i1];
+  const double * h = c+1+_n;
+  for (i1=0 ; i1<_n ; i1++){
+    g[i1] += h[0]*x[i1];
+    for (i2=i1+1 ; i2<_n ; i2++){
+      g[i1] += h[i2-i1]*x[i2];
+      g[i2] += h[i2-i1]*x[i1];
+    }
+    h += _n-i1;
+  }
+}//
+
+/*--------------------------------------*/
+/*       evaluation on a set of points  */
+/*--------------------------------------*/
+// z_j(x) = c_j + sum_i x_i * ( g_j(i) + H_j(i,i)/2 x_i + sum_{i2>i} H_j(i,i2) x_i2 )
+// All the outputs are computed from the same transposed block of points.
+void SGTELIB::Quadratic_Form::eval ( const SGTELIB::Matrix & X , SGTELIB::Matrix * Z ) const {
+  if (_m==0){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+             "Quadratic_Form::eval: the form is not defined" );
+  }
+  const int p = X.get_nb_rows();
+  if (X.get_nb_cols()<_n){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+             "Quadratic_Form::eval: dimension error" );
+  }
+  if ( (Z->get_nb_rows()!=p) || (Z->get_nb_cols()!=_m) ){
+    *Z = SGTELIB::Matrix("Z",p,_m);
+  }
+
+  const int nc = _coef.get_nb_cols();
+  std::vector<double> xt (std::max(_n,1)*QF_BLOCK,0.0);
+  double acc[QF_BLOCK];
+  double t[QF_BLOCK];
+  int i,i2,j,l,nl;
+
+  for (int i0=0 ; i0<p ; i0+=QF_BLOCK){
+    nl = std::min(QF_BLOCK,p-i0);
+    // Transpose the block (the missing points of the last block are 0)
+    for (i=0 ; i<_n ; i++){
+      double * SGTELIB_RESTRICT xi = xt.data()+i*QF_BLOCK;
+      for (l=0 ; l<nl ; l++) xi[l] = X.get(i0+l,i);
+      for ( ; l<QF_BLOCK ; l++) xi[l] = 0.0;
+    }
+    for (j=0 ; j<_m ; j++){
+      const double * c = _coef.get_data()+j*nc;
+      const double * h = c+1+_n;
+      for (l=0 ; l<QF_BLOCK ; l++) acc[l] = c[0];
+      for (i=0 ; i<_n ; i++){
+        const double * SGTELIB_RESTRICT xi = xt.data()+i*QF_BLOCK;
+        const double gi = c[1+i];
+        const double hii = 0.5*h[0];
+        for (l=0 ; l<QF_BLOCK ; l++) t[l] = gi+hii*xi[l];
+        for (i2=i+1 ; i2<_n ; i2++){
+          const double hi2 = h[i2-i];
+          const double * SGTELIB_RESTRICT xi2 = xt.data()+i2*QF_BLOCK;
+          for (l=0 ; l<QF_BLOCK ; l++) t[l] += hi2*xi2[l];
+        }
+        for (l=0 ; l<QF_BLOCK ; l++) acc[l] += xi[l]*t[l];
+        h += _n-i;
+      }
+      for (l=0 ; l<nl ; l++) Z->set(i0+l,j,acc[l]);
+    }
+  }
+}//
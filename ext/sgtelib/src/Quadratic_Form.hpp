@@ -0,0 +1,89 @@
+/*-------------------------------------------------------------------------------------*/
+/*  sgtelib - A surrogate model library for derivative-free optimization               */
+/*  Version 2.0.3                                                                      */
+/*                                                                                     */
+/*  Copyright (C) 2012-2017  Sebastien Le Digabel - Ecole Polytechnique, Montreal      */ 
+/*                           Bastien Talgorn - McGill University, Montreal             */
+/*                                                                                     */
+/*  Author: Bastien Talgorn                                                            */
+/*  email: bastientalgorn@fastmail.com                                                 */
+/*                                                                                     */
+/*  This program is free software: you can redistribute it and/or modify it under the  */
+/*  terms of the GNU Lesser General Public License as published by the Free Software   */
+/*  Foundation, either version 3 of the License, or (at your option) any later         */
+/*  version.                                                                           */
+/*                                                                                     */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT ANY    */
+/*  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A    */
+/*  PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.   */
+/*                                                                                     */
+/*  You should have received a copy of the GNU Lesser General Public License along     */
+/*  with this program. If not, see <http://www.gnu.org/licenses/>.                     */
+/*                                                                                     */
+/*  You can find information on sgtelib at https://github.com/bastientalgorn/sgtelib   */
+/*-------------------------------------------------------------------------------------*/
+#ifndef __SGTELIB_QUADRATIC_FORM__
+#define __SGTELIB_QUADRATIC_FORM__
+
+#include "Defines.hpp"
+#include "Exception.hpp"
+#include "Matrix.hpp"
+
+namespace SGTELIB {
+
+  /*--------------------------------------*/
+  /*        Quadratic form class          */
+  /*--------------------------------------*/
+  // Polynomial of degree 2 in n variables for each of the m outputs:
+  //
+  //    z_j(x) = c_j + g_j' x + 1/2 x' H_j x
+  //
+  // The coefficients of output j are stored in row j of a m x (1+n+n(n+1)/2)
+  // matrix: c_j, then g_j, then the upper triangle of H_j row by row
+  // (H_j(0,0), H_j(0,1), ..., H_j(0,n-1), H_j(1,1), ..., H_j(n-1,n-1)).
+  // It is extracted from the monomes and coefficients of a PRS model of
+  // degree 2 or less, and evaluates a block of points without the design matrix.
+  class DLL_API Quadratic_Form {
+
+  private:
+
+    int _n; // Nb of variables
+    int _m; // Nb of outputs
+    SGTELIB::Matrix _coef; // Coefficients (one row per output)
+
+    // Index of H(i,j) (i<=j) in a row of _coef
+    int index_H ( const int i , const int j ) const { return 1+_n+i*_n-(i*(i-1))/2+(j-i); };
+
+  public:
+
+    // constructor (empty form)
+    Quadratic_Form ( void );
+
+    // Extract the form from the monomes M (q x n, exponents of each basis
+    // function) and the coefficients alpha (q x m) of a PRS model.
+    // Returns false (and clears the form) if a monome has a degree larger
+    // than 2 or if alpha does not match M.
+    bool set_from_monomes ( const SGTELIB::Matrix & M , const SGTELIB::Matrix & alpha );
+    void clear ( void );
+
+    // Get
+    bool is_defined       ( void ) const { return _m>0; };
+    int  get_nb_variables ( void ) const { return _n; };
+    int  get_nb_outputs   ( void ) const { return _m; };
+    const SGTELIB::Matrix & get_coefficients ( void ) const { return _coef; };
+    double get_constant ( const int j ) const { return _coef.get(j,0); };
+    double get_linear   ( const int j , const int i ) const { return _coef.get(j,1+i); };
+    double get_hessian  ( const int j , const int i1 , const int i2 ) const;
+
+    // Values of the outputs on the points of X (p x n', n'>=n: only the n
+    // first columns are read). Z is p x m.
+    void eval ( const SGTELIB::Matrix & X , SGTELIB::Matrix * Z ) const;
+    // Gradient of output j at x (n values): g_j + H_j x
+    void eval_gradient ( const int j , const double * x , double * g ) const;
+    // Hessian of output j (n x n)
+    SGTELIB::Matrix get_hessian ( const int j ) const;
+
+  };
+}
+
+#endif
@@ -0,0 +1,481 @@
+/*-------------------------------------------------------------------------------------*/
+/*  sgtelib - A surrogate model library for derivative-free optimization               */
+/*  Version 2.0.3                                                                      */
+/*                                                                                     */
+/*  Copyright (C) 2012-2017  Sebastien Le Digabel - Ecole Polytechnique, Montreal      */ 
+/*                           Bastien Talgorn - McGill University, Montreal             */
+/*                                                                                     */
+/*  Author: Bastien Talgorn                                                            */
+/*  email: bastientalgorn@fastmail.com                                                 */
+/*                                                                                     */
+/*  This program is free software: you can redistribute it and/or modify it under the  */
+/*  terms of the GNU Lesser General Public License as published by the Free Software   */
+/*  Foundation, either version 3 of the License, or (at your option) any later         */
+/*  version.                                                                           */
+/*                                                                                     */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT ANY    */
+/*  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A    */
+/*  PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.   */
+/*                                                                                     */
+/*  You should have received a copy of the GNU Lesser General Public License along     */
+/*  with this program. If not, see <http://www.gnu.org/licenses/>.                     */
+/*                                                                                     */
+/*  You can find information on sgtelib at https://github.com/bastientalgorn/sgtelib   */
+/*-------------------------------------------------------------------------------------*/
+
+#include "Server.hpp"
+#include "Surrogate_Factory.hpp"
+#include "Surrogate_Utils.hpp"
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <thread>
+
+#ifdef _MSC_VER
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+  // Larger frame accepted by the server (the connection is closed beyond).
+  const uint32_t SERVER_MAX_FRAME = 1u << 30;
+
+  /*--------------------------------------*/
+  /*       encoding of the payloads       */
+  /*--------------------------------------*/
+  template <typename T>
+  void put ( std::string & s , const T v ){
+    s.append(reinterpret_cast<const char *>(&v),sizeof(T));
+  }//
+
+  void put_string ( std::string & s , const std::string & v ){
+    put<uint32_t>(s,static_cast<uint32_t>(v.size()));
+    s.append(v);
+  }//
+
+  void put_matrix ( std::string & s , const SGTELIB::Matrix & M ){
+    const int nbRows = M.get_nb_rows();
+    const int nbCols = M.get_nb_cols();
+    put<int32_t>(s,nbRows);
+    put<int32_t>(s,nbCols);
+    s.reserve(s.size()+sizeof(double)*nbRows*nbCols);
+    for (int i=0 ; i<nbRows ; i++){
+      for (int j=0 ; j<nbCols ; j++){
+        put<double>(s,M.get(i,j));
+      }
+    }
+  }//
+
+  template <typename T>
+  T get ( const std::string & s , size_t & pos ){
+    if (pos+sizeof(T)>s.size()){
+      throw SGTELIB::Exception(__FILE__,__LINE__,"Server: truncated request");
+    }
+    T v;
+    std::memcpy(&v,s.data()+pos,sizeof(T));
+    pos += sizeof(T);
+    return v;
+  }//
+
+  std::string get_string ( const std::string & s , size_t & pos ){
+    const uint32_t length = get<uint32_t>(s,pos);
+    if (pos+length>s.size()){
+      throw SGTELIB::Exception(__FILE__,__LINE__,"Server: truncated request");
+    }
+    std::string v = s.substr(pos,length);
+    pos += length;
+    return v;
+  }//
+
+  SGTELIB::Matrix get_matrix ( const std::string & s , size_t & pos , const std::string & name ){
+    const int32_t nbRows = get<int32_t>(s,pos);
+    const int32_t nbCols = get<int32_t>(s,pos);
+    if ( (nbRows<0) || (nbCols<0) || (pos+sizeof(double)*nbRows*nbCols>s.size()) ){
+      throw SGTELIB::Exception(__FILE__,__LINE__,"Server: truncated request");
+    }
+    SGTELIB::Matrix M (name,nbRows,nbCols);
+    for (int i=0 ; i<nbRows ; i++){
+      for (int j=0 ; j<nbCols ; j++){
+        M.set(i,j,get<double>(s,pos));
+      }
+    }
+    return M;
+  }//
+
+  /*--------------------------------------*/
+  /*       blocking read and write        */
+  /*--------------------------------------*/
+  bool read_all ( const int fd , char * buffer , size_t size ){
+    while (size>0){
+#ifdef _MSC_VER
+      const int k = _read(fd,buffer,static_cast<unsigned int>(size));
+#else
+      const ssize_t k = ::read(fd,buffer,size);
+#endif
+      if (k<0 && errno==EINTR) continue;
+      if (k<=0) return false;
+      buffer += k;
+      size -= static_cast<size_t>(k);
+    }
+    return true;
+  }//
+
+  bool write_all ( const int fd , const char * buffer , size_t size ){
+    while (size>0){
+#ifdef _MSC_VER
+      const int k = _write(fd,buffer,static_cast<unsigned int>(size));
+#else
+      const ssize_t k = ::write(fd,buffer,size);
+#endif
+      if (k<0 && errno==EINTR) continue;
+      if (k<=0) return false;
+      buffer += k;
+      size -= static_cast<size_t>(k);
+    }
+    return true;
+  }//
+
+}
+
+
+/*--------------------------------------*/
+/*              constructor             */
+/*--------------------------------------*/
+SGTELIB::Server::Server ( const std::string & model , const bool verbose ):
+  _model        ( model   ),
+  _display      ( verbose ),
+  _TS           ( NULL    ),
+  _S            ( NULL    ),
+  _m            ( 0       ),
+  _built        ( false   ),
+  _ready        ( false   ),
+  _quit         ( false   ){
+}//
+
+/*--------------------------------------*/
+/*              destructor              */
+/*--------------------------------------*/
+SGTELIB::Server::~Server ( void ){
+  reset();
+}//
+
+/*--------------------------------------*/
+/*        delete model and data         */
+/*--------------------------------------*/
+void SGTELIB::Server::reset ( void ){
+  SGTELIB::surrogate_delete(_S);
+  delete _TS;
+  _S  = NULL;
+  _TS = NULL;
+  _m  = 0;
+  _built = false;
+  _ready = false;
+}//
+
+/*--------------------------------------*/
+/*              build model             */
+/*--------------------------------------*/
+bool SGTELIB::Server::build ( void ){
+  if ( ! _S) return false;
+  if ( ! _built){
+    if (_display) std::cerr << "Build Sgte (" << _TS->get_nb_points() << " pts)\n";
+    _ready = _S->build();
+    _built = true;
+  }
+  return _ready;
+}//
+
+/*--------------------------------------*/
+/*        process one request           */
+/*--------------------------------------*/
+bool SGTELIB::Server::process ( const std::string & request , std::string & answer ){
+
+  std::lock_guard<std::mutex> lock (_model_mutex);
+  answer.clear();
+  bool go_on = true;
+
+  try {
+    size_t pos = 0;
+    const int command = get<uint8_t>(request,pos);
+    switch (command){
+
+      case SERVER_NEW_DATA:{
+        const SGTELIB::Matrix X = get_matrix(request,pos,"X");
+        const SGTELIB::Matrix Z = get_matrix(request,pos,"Z");
+        if (X.get_nb_rows()!=Z.get_nb_rows()){
+          throw SGTELIB::Exception(__FILE__,__LINE__,"Server: X and Z have different number of rows");
+        }
+        if (_display) std::cerr << X.get_nb_rows() << " new data points...\n";
+        if ( ! _S){
+          _TS = new SGTELIB::TrainingSet(X,Z);
+          _S = SGTELIB::Surrogate_Factory(*_TS,_model);
+          _m = _TS->get_output_dim();
+        }
+        else{
+          if ( (X.get_nb_cols()!=_TS->get_input_dim()) || (Z.get_nb_cols()!=_m) ){
+            throw SGTELIB::Exception(__FILE__,__LINE__,"Server: dimension mismatch with the training set");
+          }
+          _TS->add_points(X,Z);
+        }
+        _built = false;
+        put<uint8_t>(answer,SERVER_OK);
+        break;
+      }
+
+      case SERVER_PREDICT:{
+        const SGTELIB::Matrix X = get_matrix(request,pos,"X");
+        if ( _TS && (X.get_nb_cols()!=_TS->get_input_dim()) ){
+          throw SGTELIB::Exception(__FILE__,__LINE__,"Server: dimension mismatch with the training set");
+        }
+        const bool ready = build();
+        const int pxx = X.get_nb_rows();
+        SGTELIB::Matrix Z   ("Z"  ,pxx,_m);
+        SGTELIB::Matrix std ("std",pxx,_m);
+        SGTELIB::Matrix ei  ("ei" ,pxx,_m);
+        SGTELIB::Matrix cdf ("cdf",pxx,_m);
+        if (ready){
+          _S->predict(X,&Z,&std,&ei,&cdf);
+        }
+        else{
+          if (_display) std::cerr << "Surrogate not ready\n";
+          Z.fill(+SGTELIB::INF);
+        }
+        put<uint8_t>(answer,(ready)?SERVER_OK:SERVER_NOT_READY);
+        put_matrix(answer,Z);
+        put_matrix(answer,std);
+        put_matrix(answer,ei);
+        put_matrix(answer,cdf);
+        break;
+      }
+
+      case SERVER_CV:{
+        const bool ready = build();
+        SGTELIB::Matrix Zh, Sh, Zv, Sv;
+        if (ready){
+          Zh = _S->get_matrix_Zh();
+          Sh = _S->get_matrix_Sh();
+          Zv = _S->get_matrix_Zv();
+          Sv = _S->get_matrix_Sv();
+        }
+        put<uint8_t>(answer,(ready)?SERVER_OK:SERVER_NOT_READY);
+        put_matrix(answer,Zh);
+        put_matrix(answer,Sh);
+        put_matrix(answer,Zv);
+        put_matrix(answer,Sv);
+        break;
+      }
+
+      case SERVER_METRIC:{
+        const SGTELIB::metric_t mt = SGTELIB::str_to_metric_type(get_string(request,pos));
+        const bool ready = build();
+        SGTELIB::Matrix metric_value;
+        if (ready) metric_value = _S->get_metric(mt);
+        put<uint8_t>(answer,(ready)?SERVER_OK:SERVER_NOT_READY);
+        put_matrix(answer,metric_value);
+        break;
+      }
+
+      case SERVER_INFO:{
+        const bool ready = build();
+        std::ostringstream oss;
+        if (ready) _S->display(oss);
+        else oss << "Not ready.";
+        put<uint8_t>(answer,(ready)?SERVER_OK:SERVER_NOT_READY);
+        put_string(answer,oss.str());
+        break;
+      }
+
+      case SERVER_RESET:
+        reset();
+        put<uint8_t>(answer,SERVER_OK);
+        break;
+
+      case SERVER_PING:
+        put<uint8_t>(answer,(build())?SERVER_OK:SERVER_NOT_READY);
+        break;
+
+      case SERVER_QUIT:
+        put<uint8_t>(answer,SERVER_OK);
+        go_on = false;
+        break;
+
+      default:
+        throw SGTELIB::Exception(__FILE__,__LINE__,"Server: unknown command "+SGTELIB::itos(command));
+    }
+  }
+  catch (const std::exception & e){
+    if (_display) std::cerr << e.what() << "\n";
+    answer.clear();
+    put<uint8_t>(answer,SERVER_ERROR);
+    put_string(answer,e.what());
+  }
+
+  return go_on;
+}//
+
+/*--------------------------------------*/
+/*          serve a connection          */
+/*--------------------------------------*/
+void SGTELIB::Server::serve ( const int fd_in , const int fd_out ){
+
+  std::string request, answer, frame;
+  while ( ! _quit){
+    uint32_t length;
+    if ( ! read_all(fd_in,reinterpret_cast<char *>(&length),sizeof(length))) break;
+    if (length>SERVER_MAX_FRAME) break;
+    request.resize(length);
+    if ( (length>0) && ( ! read_all(fd_in,&request[0],length)) ) break;
+
+    const bool go_on = process(request,answer);
+
+    // Header and payload in one write
+    frame.clear();
+    put<uint32_t>(frame,static_cast<uint32_t>(answer.size()));
+    frame.append(answer);
+    if ( ! write_all(fd_out,frame.data(),frame.size())) break;
+
+    if ( ! go_on){
+      _quit = true;
+      shutdown_connections();
+    }
+  }
+
+}//
+
+/*--------------------------------------*/
+/*   stop the other connections (QUIT)  */
+/*--------------------------------------*/
+void SGTELIB::Server::shutdown_connections ( void ){
+#ifndef _MSC_VER
+  std::lock_guard<std::mutex> lock (_connections_mutex);
+  for (const int fd : _connections){
+    ::shutdown(fd,SHUT_RDWR);
+  }
+#endif
+}//
+
+/*--------------------------------------*/
+/*        serve on stdin/stdout         */
+/*--------------------------------------*/
+void SGTELIB::Server::run_pipe ( void ){
+#ifdef _MSC_VER
+  _setmode(_fileno(stdin) ,_O_BINARY);
+  _setmode(_fileno(stdout),_O_BINARY);
+  serve(_fileno(stdin),_fileno(stdout));
+#else
+  std::signal(SIGPIPE,SIG_IGN);
+  serve(STDIN_FILENO,STDOUT_FILENO);
+#endif
+}//
+
+/*--------------------------------------*/
+/*     serve on a Unix domain socket    */
+/*--------------------------------------*/
+void SGTELIB::Server::run_socket ( const std::string & path ){
+#ifdef _MSC_VER
+  throw SGTELIB::Exception(__FILE__,__LINE__,"Server: Unix domain sockets are not available on this platform");
+#else
+  std::signal(SIGPIPE,SIG_IGN);
+
+  sockaddr_un addr;
+  std::memset(&addr,0,sizeof(addr));
+  if (path.size()>=sizeof(addr.sun_path)){
+    throw SGTELIB::Exception(__FILE__,__LINE__,"Server: socket path is too long");
+  }
+  addr.sun_family = AF_UNIX;
+  std::strcpy(addr.sun_path,path.c_str());
+
+  ::unlink(path.c_str());
+  const int listen_fd = ::socket(AF_UNIX,SOCK_STREAM,0);
+  if ( (listen_fd<0) ||
+       (::bind(listen_fd,reinterpret_cast<sockaddr *>(&addr),sizeof(addr))<0) ||
+       (::listen(listen_fd,SOMAXCONN)<0) ){
+    const std::string msg = "Server: cannot listen on "+path+" ("+std::strerror(errno)+")";
+    if (listen_fd>=0) ::close(listen_fd);
+    throw SGTELIB::Exception(__FILE__,__LINE__,msg);
+  }
+  if (_display) std::cerr << "Listen on " << path << "\n";
+
+  // One thread per connection. Finished threads are joined in the loop.
+  struct Connection {
+    std::thread thread;
+    std::shared_ptr<std::atomic<bool> > done;
+  };
+  std::list<Connection> connections;
+
+  while ( ! _quit){
+    for (std::list<Connection>::iterator it=connections.begin() ; it!=connections.end() ; ){
+      if (*(it->done)){
+        it->thread.join();
+        it = connections.erase(it);
+      }
+      else ++it;
+    }
+
+    // Wait for a connection (with a timeout to check _quit)
+    pollfd pfd;
+    pfd.fd = listen_fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (::poll(&pfd,1,100)<=0) continue;
+
+    const int fd = ::accept(listen_fd,NULL,NULL);
+    if (fd<0) continue;
+    {
+      std::lock_guard<std::mutex> lock (_connections_mutex);
+      _connections.insert(fd);
+    }
+    if (_display) std::cerr << "New connection\n";
+
+    Connection c;
+    c.done = std::make_shared<std::atomic<bool> >(false);
+    std::shared_ptr<std::atomic<bool> > done = c.done;
+    c.thread = std::thread([this,fd,done](){
+      serve(fd,fd);
+      {
+        std::lock_guard<std::mutex> lock (_connections_mutex);
+        _connections.erase(fd);
+      }
+      ::close(fd);
+      *done = true;
+    });
+    connections.push_back(std::move(c));
+  }
+
+  shutdown_connections();
+  for (Connection & c : connections){
+    c.thread.join();
+  }
+  ::close(listen_fd);
+  ::unlink(path.c_str());
+#endif
+}//
+
+
+/*--------------------------------------*/
+/*     sgtelib server (stdin/stdout)    */
+/*--------------------------------------*/
+void SGTELIB::sgtelib_server_pipe ( const std::string & model , const bool verbose ){
+  if (verbose) std::cerr << "Start server on stdin/stdout\n";
+  SGTELIB::Server server (model,verbose);
+  server.run_pipe();
+  if (verbose) std::cerr << "Quit server\n";
+}//
+
+/*--------------------------------------*/
+/*     sgtelib server (socket)          */
+/*--------------------------------------*/
+void SGTELIB::sgtelib_server_socket ( const std::string & model , const std::string & path , const bool verbose ){
+  if (verbose) std::cerr << "Start server on " << path << "\n";
+  SGTELIB::Server server (model,verbose);
+  server.run_socket(path);
+  if (verbose) std::cerr << "Quit server\n";
+}//
@@ -0,0 +1,138 @@
+/*-------------------------------------------------------------------------------------*/
+/*  sgtelib - A surrogate model library for derivative-free optimization               */
+/*  Version 2.0.3                                                                      */
+/*                                                                                     */
+/*  Copyright (C) 2012-2017  Sebastien Le Digabel - Ecole Polytechnique, Montreal      */ 
+/*                           Bastien Talgorn - McGill University, Montreal             */
+/*                                                                                     */
+/*  Author: Bastien Talgorn                                                            */
+/*  email: bastientalgorn@fastmail.com                                                 */
+/*                                                                                     */
+/*  This program is free software: you can redistribute it and/or modify it under the  */
+/*  terms of the GNU Lesser General Public License as published by the Free Software   */
+/*  Foundation, either version 3 of the License, or (at your option) any later         */
+/*  version.                                                                           */
+/*                                                                                     */
+/*  This program is distributed in the hope that it will be useful, but WITHOUT ANY    */
+/*  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A    */
+/*  PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.   */
+/*                                                                                     */
+/*  You should have received a copy of the GNU Lesser General Public License along     */
+/*  with this program. If not, see <http://www.gnu.org/licenses/>.                     */
+/*                                                                                     */
+/*  You can find information on sgtelib at https://github.com/bastientalgorn/sgtelib   */
+/*-------------------------------------------------------------------------------------*/
+
+#ifndef __SGTELIB_SERVER__
+#define __SGTELIB_SERVER__
+
+#include "Defines.hpp"
+#include "Surrogate.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace SGTELIB {
+
+  /*--------------------------------------*/
+  /*   Stream protocol of the server      */
+  /*--------------------------------------*/
+  // Each message is a frame: a uint32 (payload length) followed by the payload.
+  // A request payload starts with a uint8 command, followed by its arguments.
+  // An answer payload starts with a uint8 status, followed by its results.
+  // Integers and doubles are in the byte order of the host.
+  // A matrix is an int32 (nb rows), an int32 (nb cols) and the values row by row.
+  // A string is a uint32 (length) and the characters.
+  //
+  //  command      arguments   results
+  //  NEW_DATA     X Z         -
+  //  PREDICT      X           Z std ei cdf
+  //  CV           -           Zh Sh Zv Sv
+  //  METRIC       string      metric (row)
+  //  INFO         -           string
+  //  RESET        -           -
+  //  PING         -           -
+  //  QUIT         -           -
+  //
+  // Requests may be pipelined: the answers are sent in the order of the requests.
+  enum server_command_t {
+    SERVER_NEW_DATA = 1 ,
+    SERVER_PREDICT  = 2 ,
+    SERVER_CV       = 3 ,
+    SERVER_METRIC   = 4 ,
+    SERVER_INFO     = 5 ,
+    SERVER_RESET    = 6 ,
+    SERVER_PING     = 7 ,
+    SERVER_QUIT     = 8
+  };
+
+  enum server_status_t {
+    SERVER_OK        = 0 ,
+    SERVER_NOT_READY = 1 , // The model is not ready. Matrices are filled with +INF or empty.
+    SERVER_ERROR     = 2   // Unknown command or malformed request. The result is a string.
+  };
+
+  /*--------------------------------------*/
+  /*             Server class             */
+  /*--------------------------------------*/
+  // One model shared by all the connections of the server.
+  class DLL_API Server {
+
+  private:
+
+    const std::string _model;
+    const bool _display;
+
+    // Model and training set. Created with the first data.
+    SGTELIB::TrainingSet * _TS;
+    SGTELIB::Surrogate * _S;
+    int _m;
+    // The model is only rebuilt when the data have changed since the last build.
+    bool _built;
+    bool _ready;
+    // Protects _TS and _S: the requests of all the connections are processed one at a time.
+    std::mutex _model_mutex;
+
+    // Set when a QUIT request has been received.
+    std::atomic<bool> _quit;
+    // Open connections (to be shut down on QUIT)
+    std::set<int> _connections;
+    std::mutex _connections_mutex;
+
+    // Build the model if there is one and if it is not up to date.
+    // Called with _model_mutex locked.
+    bool build ( void );
+    void reset ( void );
+    void shutdown_connections ( void );
+
+    // forbid copy
+    Server ( const Server & );
+    Server & operator = ( const Server & );
+
+  public:
+
+    Server ( const std::string & model , const bool verbose );
+    ~Server ( void );
+
+    // Process one request payload and fill the answer payload.
+    // Returns false if the request is QUIT.
+    bool process ( const std::string & request , std::string & answer );
+
+    // Read requests from fd_in and write the answers to fd_out, until QUIT or end of stream.
+    void serve ( const int fd_in , const int fd_out );
+
+    // Serve on stdin/stdout. The display goes to stderr.
+    void run_pipe ( void );
+
+    // Serve on a Unix domain socket, one thread per connection.
+    void run_socket ( const std::string & path );
+
+  };
+
+  DLL_API void sgtelib_server_pipe   ( const std::string & model , const bool verbose );
+  DLL_API void sgtelib_server_socket ( const std::string & model , const std::string & path , const bool verbose );
+}
+
+#endif
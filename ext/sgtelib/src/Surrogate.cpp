@@ -24,6 +24,9 @@
 /*-------------------------------------------------------------------------------------*/
 
 #include "Surrogate.hpp"
+#include "Surrogate_Factory.hpp"
+#include <atomic>
+#include <mutex>
 
 using namespace SGTELIB;
 
@@ -296,6 +299,16 @@ bool SGTELIB::Surrogate::init_private (void) {
 }
 
 
+/*--------------------------------------*/
+/*               is_appended            */
+/*--------------------------------------*/
+bool SGTELIB::Surrogate::is_appended ( const int build_index , const int p0 ) const {
+  // A subset of the points may not keep the order of the training set
+  if ( ! ( (_selected_points.size()==1) && (_selected_points.front()==-1) ) ) return false;
+  return (p0>0) && (p0<=_p) && (build_index==_trainingset.get_build_index());
+}//
+
+
 /*--------------------------------------*/
 /*               check_ready            */
 /*--------------------------------------*/
@@ -379,7 +392,7 @@ void SGTELIB::Surrogate::predict ( const SGTELIB::Matrix & XX ,
                                          SGTELIB::Matrix * ZZ ,
                                          SGTELIB::Matrix * std,
                                          SGTELIB::Matrix * ei ,
-                                         SGTELIB::Matrix * cdf) {
+                                         SGTELIB::Matrix * cdf) const {
 
   // Prediction requires that the model is ready.
   check_ready(__FILE__,__FUNCTION__,__LINE__);
@@ -450,10 +463,10 @@ void SGTELIB::Surrogate::predict ( const SGTELIB::Matrix & XX ,
     }
   #endif
 
-  ZZ->replace_nan (+INF);
-  std->replace_nan (+INF);
-  ei->replace_nan (-INF);
-  cdf->replace_nan (0);
+  if (ZZ)   ZZ->replace_nan (+INF);
+  if (std) std->replace_nan (+INF);
+  if (ei)   ei->replace_nan (-INF);
+  if (cdf) cdf->replace_nan (0);
 
   // UnScale the output
   // Note that ZZ is unscaled with Z_unscale:
@@ -511,7 +524,7 @@ void SGTELIB::Surrogate::predict_private (const SGTELIB::Matrix & XXs,
                                                 SGTELIB::Matrix * ZZs,
                                                 SGTELIB::Matrix * std,
                                                 SGTELIB::Matrix * ei ,
-                                                SGTELIB::Matrix * cdf) {
+                                                SGTELIB::Matrix * cdf) const {
   check_ready(__FILE__,__FUNCTION__,__LINE__);
 
 
@@ -528,8 +541,13 @@ void SGTELIB::Surrogate::predict_private (const SGTELIB::Matrix & XXs,
   // Prediction of statistical data
   if ( (std) || (ei) || (cdf) ){
 
+    // If std is not required, it is computed in a local matrix
+    SGTELIB::Matrix std_local;
     if (std) std->fill(-SGTELIB::INF);
-    else std = new SGTELIB::Matrix("std",pxx,_m);
+    else{
+      std_local = SGTELIB::Matrix("std",pxx,_m);
+      std = &std_local;
+    }
 
     if (ei)   ei->fill(-SGTELIB::INF);
     if (cdf) cdf->fill(-SGTELIB::INF);
@@ -540,7 +558,7 @@ void SGTELIB::Surrogate::predict_private (const SGTELIB::Matrix & XXs,
 
     for (j=0 ; j<_m ; j++){
       // Set std (use a proxy)
-      double s = get_metric(SGTELIB::METRIC_RMSE,j);
+      double s = get_metric_shared(SGTELIB::METRIC_RMSE,j);
       std->set_col( dtc+s , j );
 
       if (_trainingset.get_bbo(j)==SGTELIB::BBO_OBJ){
@@ -581,7 +599,7 @@ void SGTELIB::Surrogate::predict_private (const SGTELIB::Matrix & XXs,
 /*               predict                */
 /*--------------------------------------*/
 void SGTELIB::Surrogate::predict ( const SGTELIB::Matrix & XX ,
-                                         SGTELIB::Matrix * ZZ ) {
+                                         SGTELIB::Matrix * ZZ ) const {
 
   check_ready(__FILE__,__FUNCTION__,__LINE__);
 
@@ -695,7 +713,7 @@ const SGTELIB::Matrix * SGTELIB::Surrogate::get_matrix_Svs (void){
 /* Returns the scaled input for all     */
 /* the selected data points selected    */
 /*--------------------------------------*/
-const SGTELIB::Matrix SGTELIB::Surrogate::get_matrix_Xs (void){
+const SGTELIB::Matrix SGTELIB::Surrogate::get_matrix_Xs (void) const {
   _trainingset.build();
   return _trainingset.get_matrix_Xs().get_rows(_selected_points);
 }//
@@ -706,7 +724,7 @@ const SGTELIB::Matrix SGTELIB::Surrogate::get_matrix_Xs (void){
 /* Returns the scaled output for all    */
 /* the selected data points selected    */
 /*--------------------------------------*/
-const SGTELIB::Matrix SGTELIB::Surrogate::get_matrix_Zs (void){
+const SGTELIB::Matrix SGTELIB::Surrogate::get_matrix_Zs (void) const {
   _trainingset.build();
   return _trainingset.get_matrix_Zs().get_rows(_selected_points);
 }//
@@ -718,11 +736,24 @@ const SGTELIB::Matrix SGTELIB::Surrogate::get_matrix_Zs (void){
 /* contains the scaled distance between any pair */
 /* of data points                                */
 /*-----------------------------------------------*/
-const SGTELIB::Matrix SGTELIB::Surrogate::get_matrix_Ds (void){
+const SGTELIB::Matrix SGTELIB::Surrogate::get_matrix_Ds (void) const {
   _trainingset.build();
   return _trainingset.get_matrix_Ds().get( _selected_points , _selected_points );
 }//
 
+/*-----------------------------------------------*/
+/*       get_Ds (distance type dt)               */
+/* Distances between the selected data points,   */
+/* derived from the distances of the training    */
+/* set instead of being recomputed by each model */
+/*-----------------------------------------------*/
+const SGTELIB::Matrix SGTELIB::Surrogate::get_matrix_Ds ( const SGTELIB::distance_t dt ) const {
+  _trainingset.build();
+  if ( (_selected_points.size()==1) && (_selected_points.front()==-1) )
+    return _trainingset.get_distances(dt);
+  return _trainingset.get_distances(dt).get( _selected_points , _selected_points );
+}//
+
 
 
 
@@ -915,6 +946,7 @@ bool SGTELIB::Surrogate::compute_metric ( const metric_t mt ){
 double SGTELIB::Surrogate::get_metric (SGTELIB::metric_t mt , int j){
   // If the model is not ready, return +INF
   if (!_ready) return SGTELIB::INF;
+  std::lock_guard<std::recursive_mutex> lock(_metrics_mutex);
   // If the metric is defined, return it
   if ( is_defined(mt,j) ) return _metrics[mt][j];
   // Compute the metric,
@@ -933,6 +965,7 @@ double SGTELIB::Surrogate::get_metric (SGTELIB::metric_t mt , int j){
 SGTELIB::Matrix SGTELIB::Surrogate::get_metric (SGTELIB::metric_t mt){
   // If the model is not ready, return +INF
   if (!_ready) return SGTELIB::Matrix(SGTELIB::INF);
+  std::lock_guard<std::recursive_mutex> lock(_metrics_mutex);
   // If the metric is defined, return it
   if ( is_defined(mt) ) return _metrics[mt];
   // Compute the metric,
@@ -943,8 +976,64 @@ SGTELIB::Matrix SGTELIB::Surrogate::get_metric (SGTELIB::metric_t mt){
   return SGTELIB::Matrix(SGTELIB::INF);
 }//
 
+/*--------------------------------------*/
+/*       get metric (from predict)      */
+/*--------------------------------------*/
+// The metrics are computed on demand and cached in the model. get_metric
+// holds _metrics_mutex while doing so, so a const prediction may trigger the
+// computation: concurrent predictions compute the cache only once.
+double SGTELIB::Surrogate::get_metric_shared (SGTELIB::metric_t mt , int j) const {
+  return const_cast<SGTELIB::Surrogate *>(this)->get_metric(mt,j);
+}//
+
+
+
+
+
+/*--------------------------------------------------*/
+/*  predict the objective on sets of points         */
+/*--------------------------------------------------*/
+// XXd[i] is of dimension nbd * _n, and row i of ZZsurr_around is set to
+// [f(x_i + d_1) , ... , f(x_i + d_nbd)]. The sets are stacked in one
+// block of pxx*nbd points, so that the design (or kernel) matrix of the
+// model is computed and multiplied once for all the points.
+void SGTELIB::Surrogate::predict_private_objective ( const std::vector<SGTELIB::Matrix *> & XXd,
+                                                     SGTELIB::Matrix * ZZsurr_around            ) const {
+  check_ready(__FILE__,__FUNCTION__,__LINE__);
+
+  const int pxx = static_cast<int>(XXd.size());
+  if (pxx==0) return;
+  const int nbd = XXd[0]->get_nb_rows();
+  int i,d,j;
+
+  // Index of the objective (first output if there is no objective, for tests only)
+  int jobj = 0;
+  for (j=0 ; j<_m ; j++){
+    if (_trainingset.get_bbo(j)==SGTELIB::BBO_OBJ){
+      jobj = j;
+      break;
+    }
+  }
+
+  SGTELIB::Matrix XXs ("XXs",pxx*nbd,_n);
+  for (i=0 ; i<pxx ; i++){
+    for (d=0 ; d<nbd ; d++){
+      for (j=0 ; j<_n ; j++){
+        XXs.set(i*nbd+d,j,XXd[i]->get(d,j));
+      }
+    }
+  }
 
+  SGTELIB::Matrix ZZs ("ZZs",pxx*nbd,_m);
+  predict_private(XXs,&ZZs);
 
+  for (i=0 ; i<pxx ; i++){
+    for (d=0 ; d<nbd ; d++){
+      ZZsurr_around->set(i,d,ZZs.get(i*nbd+d,jobj));
+    }
+  }
+
+}//
 
 
 /*----------------------------------------------------------*/
@@ -1387,6 +1476,17 @@ bool SGTELIB::Surrogate::optimize_parameters ( void ) {
   SGTELIB::Matrix CACHE ("CACHE",0,N);
   bool cache_hit;
 
+  // Workers for the concurrent evaluation of the candidates.
+  // Ensembles are evaluated sequentially, as they drive their own sub-models.
+  std::vector<SGTELIB::Surrogate *> workers;
+  if ( (get_type()!=SGTELIB::ENSEMBLE) && (get_type()!=SGTELIB::ENSEMBLE_STAT) ){
+    const int nb_workers = std::min(SGTELIB::get_nb_threads(),X0.get_nb_rows());
+    if (nb_workers>1) workers = create_workers(nb_workers);
+  }
+  // Candidates of the current POLL evaluated by the workers
+  SGTELIB::Matrix BATCH;
+  std::vector<double> fbatch, pbatch;
+
   //------------------------
   // LOOP
   //------------------------
@@ -1430,20 +1530,11 @@ bool SGTELIB::Surrogate::optimize_parameters ( void ) {
 
 
 
-    // Evaluate POLL
+    // Snap POLL to bounds
     for (i=0 ; i<POLL.get_nb_rows() ; i++){
 
       // Candidate
       xtry = POLL.get_row(i);
-      xtry.set_name("xtry");
-
-      // Display candidate
-      if (display){
-        if (iter) std::cout << "X = [ " ;
-        else std::cout << "X0= [ " ;
-        for (j=0 ; j<N ; j++) std::cout << xtry[j] << " ";
-        std::cout << "] => ";
-      }
 
       // Snap to bounds
       for (j=0 ; j<N ; j++){
@@ -1476,6 +1567,26 @@ bool SGTELIB::Surrogate::optimize_parameters ( void ) {
         }
         xtry.set(0,j,d);
       }
+      POLL.set_row(xtry,i);
+    }
+
+    // Evaluate POLL
+    BATCH = SGTELIB::Matrix ("BATCH",0,N);
+    fbatch.clear();
+    pbatch.clear();
+    for (i=0 ; i<POLL.get_nb_rows() ; i++){
+
+      // Candidate
+      xtry = POLL.get_row(i);
+      xtry.set_name("xtry");
+
+      // Display candidate
+      if (display){
+        if (iter) std::cout << "X = [ " ;
+        else std::cout << "X0= [ " ;
+        for (j=0 ; j<N ; j++) std::cout << xtry[j] << " ";
+        std::cout << "] => ";
+      }
 
       // Check Cache
       cache_hit = (CACHE.find_row(xtry)!=-1);
@@ -1483,17 +1594,45 @@ bool SGTELIB::Surrogate::optimize_parameters ( void ) {
         if (display) std::cout << "Cache hit\n";
       }
       else{
-        // --------------------------------------
-        // EVALUATION of metric and penalty
-        // --------------------------------------
-        // Register the xtry values in the parameter of the model
-        _param.set_x(xtry);
-        // Check that the parameters are consistent.
-        _param.check();
-        // Eval the objective (metric of the model)
-        ftry = eval_objective();
-        // Call the parameter class to get the penalty value.
-        ptry = _param.get_x_penalty();
+        k = BATCH.find_row(xtry);
+        if ( (k==-1) && ( ! workers.empty() ) ){
+          // Evaluate concurrently xtry and the next candidates of POLL that are
+          // not in the cache (one per worker). The results are then processed in
+          // the order of POLL, exactly as in the sequential evaluation, so that
+          // the budget, the cache and the opportunistic success do not depend on
+          // the number of threads.
+          SGTELIB::Matrix CHUNK ("CHUNK",0,N);
+          SGTELIB::Matrix xnext;
+          for (k=i ; (k<POLL.get_nb_rows()) && (CHUNK.get_nb_rows()<static_cast<int>(workers.size())) ; k++){
+            xnext = POLL.get_row(k);
+            if ( (CACHE.find_row(xnext)==-1) && (BATCH.find_row(xnext)==-1) && (CHUNK.find_row(xnext)==-1) )
+              CHUNK.add_rows(xnext);
+          }
+          std::vector<double> fchunk, pchunk;
+          eval_objective_batch(workers,CHUNK,fchunk,pchunk);
+          BATCH.add_rows(CHUNK);
+          fbatch.insert(fbatch.end(),fchunk.begin(),fchunk.end());
+          pbatch.insert(pbatch.end(),pchunk.begin(),pchunk.end());
+          k = BATCH.find_row(xtry);
+        }
+        if (k!=-1){
+          // Already evaluated by a worker
+          ftry = fbatch[k];
+          ptry = pbatch[k];
+        }
+        else{
+          // --------------------------------------
+          // EVALUATION of metric and penalty
+          // --------------------------------------
+          // Register the xtry values in the parameter of the model
+          _param.set_x(xtry);
+          // Check that the parameters are consistent.
+          _param.check();
+          // Eval the objective (metric of the model)
+          ftry = eval_objective();
+          // Call the parameter class to get the penalty value.
+          ptry = _param.get_x_penalty();
+        }
         // Reduce evaluation budget
         budget--;
         // Add the current point to the CACHE.
@@ -1541,6 +1680,9 @@ bool SGTELIB::Surrogate::optimize_parameters ( void ) {
 
   }// End of optimization
 
+  for (i=0 ; i<static_cast<int>(workers.size()) ; i++) delete workers[i];
+  workers.clear();
+
 
   // Set param to optimal value
   _param.set_x(xmin);
@@ -1567,6 +1709,117 @@ bool SGTELIB::Surrogate::optimize_parameters ( void ) {
 }//
 
 
+/*--------------------------------------*/
+/*  build the surrogates of an ensemble */
+/*--------------------------------------*/
+int SGTELIB::Surrogate::build_surrogates ( const std::vector<SGTELIB::Surrogate *> & surrogates ,
+                                           const SGTELIB::metric_t mt ){
+
+  const int kmax = static_cast<int>(surrogates.size());
+  std::vector<int> ready (kmax,0);
+
+  // Build surrogate k and compute its metric (for the weights of the ensemble)
+  auto build_k = [&] ( const int k ){
+    SGTELIB::Surrogate * S = surrogates[k];
+    if (S->build()){
+      ready[k] = 1;
+      S->get_metric(mt);
+    }
+  };
+
+  // The surrogates with parameter optimization are built first, in their
+  // order, as the optimization draws random numbers (and is itself parallel).
+  // The others are independent given the training set: they are built
+  // concurrently on the worker pool of parallel_run, with at most
+  // get_nb_threads() tasks (sequentially unless set_nb_threads was called).
+  std::vector<int> others;
+  int k;
+  for (k=0 ; k<kmax ; k++){
+    if (surrogates[k]->_param.get_nb_parameter_optimization()>0) build_k(k);
+    else others.push_back(k);
+  }
+
+  const int nb_others = static_cast<int>(others.size());
+  const int nb_threads = std::min(SGTELIB::get_nb_threads(),nb_others);
+  if (nb_threads>1){
+    std::atomic<int> next (0);
+    SGTELIB::parallel_run ( nb_threads , [&] ( const int ){
+      int i;
+      while ( (i=next++)<nb_others ) build_k(others[i]);
+    });
+  }
+  else{
+    for (k=0 ; k<nb_others ; k++) build_k(others[k]);
+  }
+
+  int kready = 0;
+  for (k=0 ; k<kmax ; k++){
+    if (ready[k]) kready++;
+  }
+  return kready;
+
+}//
+
+
+/*--------------------------------------*/
+/*  create the workers used for the     */
+/*  concurrent parameter optimization   */
+/*--------------------------------------*/
+std::vector<SGTELIB::Surrogate *> SGTELIB::Surrogate::create_workers ( const int nb_workers ){
+
+  // Each worker is a clone of the model (same type and parameters, same
+  // selection of points) built on the same training set, which is only read.
+  std::vector<SGTELIB::Surrogate *> workers;
+  for (int w=0 ; w<nb_workers ; w++){
+    SGTELIB::Surrogate * S = SGTELIB::Surrogate_Factory(_trainingset,_param);
+    S->_selected_points = _selected_points;
+    S->_p_ts = _p_ts;
+    S->_p = _p;
+    if ( ! S->init_private() ){
+      // Fall back to the sequential evaluation
+      delete S;
+      for (size_t i=0 ; i<workers.size() ; i++) delete workers[i];
+      workers.clear();
+      break;
+    }
+    workers.push_back(S);
+  }
+  return workers;
+
+}//
+
+
+/*--------------------------------------*/
+/*  Evaluation of the error metric and  */
+/*  penalty for each row of X           */
+/*--------------------------------------*/
+void SGTELIB::Surrogate::eval_objective_batch ( const std::vector<SGTELIB::Surrogate *> & workers ,
+                                                const SGTELIB::Matrix & X ,
+                                                std::vector<double> & f ,
+                                                std::vector<double> & p ){
+
+  const int nx = X.get_nb_rows();
+  f.assign(nx,+INF);
+  p.assign(nx,+INF);
+  if (nx==0) return;
+
+  // The candidates are dispatched dynamically, but the result of a candidate
+  // only depends on the candidate, not on the worker that evaluates it.
+  std::atomic<int> next (0);
+  SGTELIB::parallel_run ( std::min(static_cast<int>(workers.size()),nx) , [&] ( const int w ){
+    SGTELIB::Surrogate * S = workers[w];
+    int i;
+    while ( (i=next++)<nx ){
+      S->_param.set_x(X.get_row(i));
+      S->_param.check();
+      f[i] = S->eval_objective();
+      p[i] = S->_param.get_x_penalty();
+    }
+  });
+
+}//
+
+
 /*--------------------------------------*/
 /*    Evaluation of the error metric    */
 /*       for a set of parameters        */
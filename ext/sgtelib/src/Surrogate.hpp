@@ -31,6 +31,8 @@
 #include "Kernel.hpp"
 #include "Surrogate_Parameters.hpp"
 #include <map>
+#include <mutex>
+#include <vector>
 namespace SGTELIB {
 
   /*--------------------------------------*/
@@ -82,6 +84,9 @@ namespace SGTELIB {
 
     // Map to store all the metrics
     std::map< metric_t , SGTELIB::Matrix > _metrics;
+    // Protects the lazy computation of the metrics (and of _Zhs, _Shs, _Zvs,
+    // _Svs) so that predict can be called concurrently on a ready model.
+    mutable std::recursive_mutex _metrics_mutex;
 
     // psize_max : Larger value of psize that led to a success
     // in the previous parameter optimization.
@@ -98,8 +103,14 @@ namespace SGTELIB {
     virtual bool build_private (void) = 0;
     virtual bool init_private  (void);
 
+    // True if the points used by the model are the p0 points of the training
+    // set at build index build_index, followed by new points. Then, the data
+    // computed from these p0 points (covariance, design matrix, factors) still hold.
+    bool is_appended ( const int build_index , const int p0 ) const;
+
     // Compute metrics
     bool compute_metric ( const metric_t mt );
+    double get_metric_shared ( SGTELIB::metric_t mt , int j ) const;
     virtual void compute_metric_linv (void);
 
     // Function used to compute "_metric_oe" and "_metric_oecv"
@@ -116,23 +127,25 @@ namespace SGTELIB {
                                          SGTELIB::Matrix * ZZs,
                                          SGTELIB::Matrix * std, 
                                          SGTELIB::Matrix * ei ,
-                                         SGTELIB::Matrix * cdf ); 
+                                         SGTELIB::Matrix * cdf ) const; 
  
     virtual void predict_private ( const SGTELIB::Matrix & XXs,
-                                         SGTELIB::Matrix * ZZs) = 0; 
+                                         SGTELIB::Matrix * ZZs) const = 0; 
     
     // Predict only objectives (used in Surrogate Ensemble Stat)
+    // By default, all the sets of points are predicted in one block.
     virtual void predict_private_objective ( const std::vector<SGTELIB::Matrix *> & XXd,
-                                             SGTELIB::Matrix * ZZsurr_around            ) = 0;
+                                             SGTELIB::Matrix * ZZsurr_around            ) const;
 
     // Display private 
     virtual void display_private ( std::ostream & out ) const = 0;
 
     // get matrices (these matrices are unscaled before being returned)
     // (That's why these functions cant be public)
-    const SGTELIB::Matrix get_matrix_Xs (void);
-    const SGTELIB::Matrix get_matrix_Zs (void);
-    const SGTELIB::Matrix get_matrix_Ds (void);
+    const SGTELIB::Matrix get_matrix_Xs (void) const;
+    const SGTELIB::Matrix get_matrix_Zs (void) const;
+    const SGTELIB::Matrix get_matrix_Ds (void) const;
+    const SGTELIB::Matrix get_matrix_Ds ( const SGTELIB::distance_t dt ) const;
 
     // Compute scaled data
     // Compute the cross-validation matrix
@@ -178,10 +191,10 @@ namespace SGTELIB {
                          SGTELIB::Matrix * ZZ , // nb : ZZ is a ptr
                          SGTELIB::Matrix * std, 
                          SGTELIB::Matrix * ei , 
-                         SGTELIB::Matrix * cdf); 
+                         SGTELIB::Matrix * cdf) const; 
 
     void predict ( const SGTELIB::Matrix & XX ,
-                         SGTELIB::Matrix * ZZ ); 
+                         SGTELIB::Matrix * ZZ ) const; 
 
     // Compute unscaled data
     const SGTELIB::Matrix get_matrix_Zh (void);
@@ -213,6 +226,16 @@ namespace SGTELIB {
     // Parameter optimization
     bool optimize_parameters ( void );
     double eval_objective ( void );
+    // Build a list of surrogates (used by the ensembles) and compute their
+    // metric mt. Returns the number of surrogates that are ready.
+    static int build_surrogates ( const std::vector<SGTELIB::Surrogate *> & surrogates ,
+                                  const SGTELIB::metric_t mt );
+    // Concurrent evaluation of a set of parameters (one clone of the model per worker)
+    std::vector<SGTELIB::Surrogate *> create_workers ( const int nb_workers );
+    void eval_objective_batch ( const std::vector<SGTELIB::Surrogate *> & workers ,
+                                const SGTELIB::Matrix & X ,
+                                std::vector<double> & f ,
+                                std::vector<double> & p );
 
   };
 }
@@ -40,10 +40,8 @@ namespace SGTELIB {
     virtual bool build_private (void) override;
  
     virtual void predict_private ( const SGTELIB::Matrix & XXs,
-                                         SGTELIB::Matrix * ZZs) override;
+                                         SGTELIB::Matrix * ZZs) const override;
 
-    virtual void predict_private_objective ( const std::vector<SGTELIB::Matrix *> & XXd,
-                                             SGTELIB::Matrix * ZZsurr_around            ) override;
     
     // Compute metrics
     virtual const SGTELIB::Matrix * get_matrix_Zvs (void) override;
@@ -81,13 +81,13 @@ namespace SGTELIB {
                                          SGTELIB::Matrix * ZZ ,
                                          SGTELIB::Matrix * std, 
                                          SGTELIB::Matrix * ei ,
-                                         SGTELIB::Matrix * cdf ) override;
+                                         SGTELIB::Matrix * cdf ) const override;
  
     virtual void predict_private ( const SGTELIB::Matrix & XXs,
-                                         SGTELIB::Matrix * ZZ ) override;
+                                         SGTELIB::Matrix * ZZ ) const override;
 
     virtual void predict_private_objective ( const std::vector<SGTELIB::Matrix *> & XXd,
-                                             SGTELIB::Matrix * ZZsurr_around           ) override {};
+                                             SGTELIB::Matrix * ZZsurr_around           ) const override {};
 
   public:
 
@@ -190,19 +190,8 @@ bool SGTELIB::Surrogate_Ensemble_Stat::init_private ( void ) {
   }
 
   // Build them & count the number of ready
-  _kready = 0;
-  int k;
-  for (k=0 ; k<_kmax ; k++){
-    #ifdef ENSEMBLE_DEBUG
-      std::cout << "Init model " << k << "/" << _kmax << ": " << _surrogates.at(k)->get_short_string();
-    #endif
-    if (_surrogates.at(k)->build()){
-      _kready++;
-      #ifdef ENSEMBLE_DEBUG
-        std::cout << " (ready)\n";
-      #endif
-    }
-  }  
+  // (the metrics used for the weights are computed with the build)
+  _kready = build_surrogates(_surrogates,_param.get_metric_type());
   #ifdef ENSEMBLE_DEBUG
     std::cout << "Surrogate_Ensemble_Stat : _kready/_kmax : " << _kready << "/" << _kmax << "\n";
   #endif
@@ -809,7 +798,7 @@ void SGTELIB::Surrogate_Ensemble_Stat::compute_W_by_wta3 ( void ) {
 /*       predict (ZZ only)              */
 /*--------------------------------------*/
 void SGTELIB::Surrogate_Ensemble_Stat::predict_private ( const SGTELIB::Matrix & XXs,
-                                                               SGTELIB::Matrix * ZZ ) {
+                                                               SGTELIB::Matrix * ZZ ) const {
   #ifdef ENSEMBLE_DEBUG
     check_ready(__FILE__,__FUNCTION__,__LINE__);
   #endif
@@ -846,7 +835,7 @@ void SGTELIB::Surrogate_Ensemble_Stat::predict_private ( const SGTELIB::Matrix &
                                                                SGTELIB::Matrix * ZZ ,
                                                                SGTELIB::Matrix * std, 
                                                                SGTELIB::Matrix * ei ,
-                                                               SGTELIB::Matrix * cdf) {
+                                                               SGTELIB::Matrix * cdf) const {
   #ifdef ENSEMBLE_DEBUG
     check_ready(__FILE__,__FUNCTION__,__LINE__);
   #endif
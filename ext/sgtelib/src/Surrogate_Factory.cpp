@@ -49,21 +49,37 @@ SGTELIB::Surrogate * SGTELIB::Surrogate_Factory ( SGTELIB::TrainingSet & TS,
 /*----------------------------------------------------------*/
 
   #ifdef SGTELIB_DEBUG
-    std::cout << "SGTELIB::Surrogate_Factory (TS,p) begin\n";
+    std::cout << "SGTELIB::Surrogate_Factory (TS,s) begin\n";
     std::cout << "s = " << s << "\n";
+  #endif
+
+  const SGTELIB::Surrogate_Parameters p ( s );
+  if ( p.get_type()==SGTELIB::SVN )
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+      "Surrogate_Factory: not implemented yet! \""+s+"\"" );
+
+  return SGTELIB::Surrogate_Factory(TS,p);
+
+}//
+
+
+/*----------------------------------------------------------*/
+SGTELIB::Surrogate * SGTELIB::Surrogate_Factory ( SGTELIB::TrainingSet & TS,
+                                                  const SGTELIB::Surrogate_Parameters & p ) {
+/*----------------------------------------------------------*/
+
+  #ifdef SGTELIB_DEBUG
+    std::cout << "SGTELIB::Surrogate_Factory (TS,p) begin\n";
     TS.info();
   #endif
 
   SGTELIB::Surrogate * S;
-  SGTELIB::Surrogate_Parameters p ( s );
-  
-
 
   switch ( p.get_type() ) {
 
   case SGTELIB::SVN: 
     throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
-      "Surrogate_Factory: not implemented yet! \""+s+"\"" );
+      "Surrogate_Factory: not implemented yet!" );
 
   case SGTELIB::PRS: 
     S = new Surrogate_PRS(TS,p);
@@ -40,11 +40,9 @@ namespace SGTELIB {
     virtual bool build_private (void) override;
  
     virtual void predict_private ( const SGTELIB::Matrix & XXs,
-                                         SGTELIB::Matrix * ZZs) override;
+                                         SGTELIB::Matrix * ZZs) const override;
 
     // Predict only objectives (used in Surrogate Ensemble Stat)
-    virtual void predict_private_objective ( const std::vector<SGTELIB::Matrix *> & XXd,
-                                             SGTELIB::Matrix * ZZsurr_around            ) override;
 
     // Compute metrics
     virtual const SGTELIB::Matrix * get_matrix_Zvs (void) override;
@@ -32,11 +32,17 @@ SGTELIB::Surrogate_Kriging::Surrogate_Kriging ( SGTELIB::TrainingSet & trainings
                                                 const SGTELIB::Surrogate_Parameters& param) :
   SGTELIB::Surrogate ( trainingset , param ),
   _R                 ( "R",0,0             ),  
-  _Ri                ( "Ri",0,0            ),  
+  _L                 ( "L",0,0             ),  
+  _RiH               ( "RiH",0,0           ),  
+  _HRiH              ( 0.0                 ),  
   _H                 ( "H",0,0             ),
   _alpha             ( "alpha",0,0         ),
   _beta              ( "beta",0,0          ),
-  _var               ( "var",0,0           ){
+  _var               ( "var",0,0           ),
+  _R_build_index     ( -1                  ),
+  _R_coef            ( "R_coef",0,0        ),
+  _R_ridge           ( 0.0                 ),
+  _R_distance_type   ( SGTELIB::DISTANCE_NORM2 ){
   #ifdef SGTELIB_DEBUG
     std::cout << "constructor Kriging\n";
   #endif
@@ -83,21 +89,55 @@ bool SGTELIB::Surrogate_Kriging::build_private ( void ) {
   const int nvar = _trainingset.get_nvar();
   const SGTELIB::Matrix & Zs = get_matrix_Zs();
 
-  _R = compute_covariance_matrix(get_matrix_Xs());
   _H = SGTELIB::Matrix::ones(_p,1);
-  _Ri = _R.lu_inverse(&_detR);
 
-  if (_detR<=0){
+  // R is kept as its Cholesky factor, R^-1 is never formed.
+  bool ok;
+  const int p0 = _R.get_nb_rows();
+  if ( is_appended(_R_build_index,p0) && same_covariance_parameters() ){
+    // Only the covariance of the new points is computed,
+    // and R and L are bordered with it.
+    if (p0<_p){
+      const SGTELIB::Matrix Rnew = compute_covariance_matrix(get_matrix_Xs().get_rows(p0,_p));
+      _R.add_rows(_p-p0);
+      _R.add_cols(_p-p0);
+      for (int i=p0 ; i<_p ; i++){
+        for (int j=0 ; j<_p ; j++){
+          _R.set(i,j,Rnew.get(i-p0,j));
+          _R.set(j,i,Rnew.get(i-p0,j));
+        }
+      }
+    }
+    ok = _R.cholesky_factor_append(_L,&_detR);
+  }
+  else{
+    _R = compute_covariance_matrix(get_matrix_Xs());
+    ok = _R.cholesky_factor(_L,&_detR);
+  }
+
+  if ( (! ok) || (_detR<=0) ){
+    // The factor is not valid, do not border it later
+    _R = SGTELIB::Matrix("R",0,0);
     _detR = +INF;
     return false;
   }
+  _R_build_index = _trainingset.get_build_index();
+  _R_coef = _param.get_covariance_coef();
+  _R_ridge = _param.get_ridge();
+  _R_distance_type = _param.get_distance_type();
 
 
   //std::cout << "detR = "<< _detR << "\n";
-  const SGTELIB::Matrix HRi  = _H.transpose()*_Ri;
-  const SGTELIB::Matrix HRiH = HRi*_H;
-  _beta = HRiH.cholesky_inverse() * HRi * Zs;
-  _alpha = _Ri*(Zs-_H*_beta);
+  // Solve R*[RiH RiZ] = [H Zs] at once
+  SGTELIB::Matrix HZ = _H;
+  HZ.add_cols(Zs);
+  const SGTELIB::Matrix RiHZ = SGTELIB::Matrix::cholesky_factor_solve(_L,HZ);
+  _RiH = RiHZ.get_col(0);
+  _HRiH = SGTELIB::Matrix::transposeA_product(_H,_RiH).get(0,0);
+  // H is a column vector, so H'*Ri*H is a scalar
+  _beta = SGTELIB::Matrix::transposeA_product(_RiH,Zs) / _HRiH;
+  // alpha = Ri*(Zs-H*beta)
+  _alpha = RiHZ.get_cols(1,_m+1) - _RiH*_beta;
 
   _beta.set_name("beta");
   _alpha.set_name("alpha");
@@ -109,7 +149,8 @@ bool SGTELIB::Surrogate_Kriging::build_private ( void ) {
   for (int j=0 ; j<_m ; j++){
     Zj = Zs.get_col(j);
     Zj = (Zj-_H*_beta.get_col(j));
-    Vj = Zj.transpose() * _Ri * Zj;
+    // Zj'*Ri*Zj, with Ri*Zj = alpha(:,j)
+    Vj = SGTELIB::Matrix::transposeA_product(Zj,_alpha.get_col(j));
     v = Vj.get(0,0) / (_p-nvar);
     if (v<0) return false;
     _var.set(0,j,v);
@@ -125,10 +166,27 @@ bool SGTELIB::Surrogate_Kriging::build_private ( void ) {
 
 
 
+/*--------------------------------------*/
+/*  Check if the covariance parameters  */
+/*  are those used to compute _R        */
+/*--------------------------------------*/
+bool SGTELIB::Surrogate_Kriging::same_covariance_parameters ( void ) const {
+  const SGTELIB::Matrix coef = _param.get_covariance_coef();
+  if ( (_R_ridge!=_param.get_ridge()) || (_R_distance_type!=_param.get_distance_type()) ) return false;
+  if ( (coef.get_nb_rows()!=_R_coef.get_nb_rows()) || (coef.get_nb_cols()!=_R_coef.get_nb_cols()) ) return false;
+  for (int i=0 ; i<coef.get_nb_rows() ; i++){
+    for (int j=0 ; j<coef.get_nb_cols() ; j++){
+      if (coef.get(i,j)!=_R_coef.get(i,j)) return false;
+    }
+  }
+  return true;
+}//
+
+
 /*--------------------------------------*/
 /*         Compute Design matrix        */
 /*--------------------------------------*/
-const SGTELIB::Matrix SGTELIB::Surrogate_Kriging::compute_covariance_matrix ( const SGTELIB::Matrix & XXs ) {
+const SGTELIB::Matrix SGTELIB::Surrogate_Kriging::compute_covariance_matrix ( const SGTELIB::Matrix & XXs ) const {
 
   // Xs can be, either the training set, to build the model, or prediction points.
   const int pxx = XXs.get_nb_rows();
@@ -160,47 +218,19 @@ const SGTELIB::Matrix SGTELIB::Surrogate_Kriging::compute_covariance_matrix ( co
 /*       predict (ZZs only)             */
 /*--------------------------------------*/
 void SGTELIB::Surrogate_Kriging::predict_private ( const SGTELIB::Matrix & XXs,
-                                                     SGTELIB::Matrix * ZZs) {
+                                                     SGTELIB::Matrix * ZZs) const {
   check_ready(__FILE__,__FUNCTION__,__LINE__);
   const int pxx = XXs.get_nb_rows();
-  const SGTELIB::Matrix r = compute_covariance_matrix(XXs).transpose();
-  *ZZs =  SGTELIB::Matrix::ones(pxx,1)*_beta + r.transpose() * _alpha;
+  *ZZs =  SGTELIB::Matrix::ones(pxx,1)*_beta + compute_covariance_matrix(XXs) * _alpha;
 }//
 
 
-// Predict only objectives (used in Surrogate Ensemble Stat)
-void SGTELIB::Surrogate_Kriging::predict_private_objective ( const std::vector<SGTELIB::Matrix *> & XXd,
-                                                             SGTELIB::Matrix * ZZsurr_around            ) {
-  check_ready(__FILE__,__FUNCTION__,__LINE__);
-
-  const size_t pxx = XXd.size();
-  const int nbd = XXd[0]->get_nb_rows();
-  SGTELIB::Matrix temp;
-
-
-  // Loop on all pxx points 
-  for (int i=0 ; i<static_cast<int>(pxx) ; i++){
-    // *(XXd[i]) is of dimension nbd * _n
-    const SGTELIB::Matrix r = compute_covariance_matrix(*(XXd[i])).transpose();
-    // Compute only objectives
-    for (int j=0 ; j<_m ; j++){
-      if (_trainingset.get_bbo(j)==SGTELIB::BBO_OBJ){
-        // Row i of ZZsurr_around is set to [f(x_i + d_1) , ... , f(x_i + d_nbd)]
-        temp = SGTELIB::Matrix::ones(nbd,1) * _beta.get_col(j) + r.transpose() * _alpha.get_col(j);
-        ZZsurr_around->set_row( temp.transpose() , i);
-        break;
-      }
-    } // end for j
-  } // end for i
-
-}
-
 
 void SGTELIB::Surrogate_Kriging::predict_private (const SGTELIB::Matrix & XXs,
                                                 SGTELIB::Matrix * ZZs,
                                                 SGTELIB::Matrix * std, 
                                                 SGTELIB::Matrix * ei ,
-                                                SGTELIB::Matrix * cdf) {
+                                                SGTELIB::Matrix * cdf) const {
   check_ready(__FILE__,__FUNCTION__,__LINE__);
 
   const int pxx = XXs.get_nb_rows();
@@ -208,6 +238,11 @@ void SGTELIB::Surrogate_Kriging::predict_private (const SGTELIB::Matrix & XXs,
   const SGTELIB::Matrix r = compute_covariance_matrix(XXs).transpose();
   int i,j;
 
+  // ri'*Ri*ri = ||L^-1*ri||^2, for all the columns of r at once
+  const SGTELIB::Matrix W = SGTELIB::Matrix::tril_solve(_L,r);
+  const SGTELIB::Matrix rRr_all = SGTELIB::Matrix::transposeA_product(SGTELIB::Matrix::ones(_p,1),
+                                                                      SGTELIB::Matrix::hadamard_square(W));
+
   // Predict ZZ
   if (ZZs) predict_private(XXs,ZZs);
 
@@ -216,13 +251,11 @@ void SGTELIB::Surrogate_Kriging::predict_private (const SGTELIB::Matrix & XXs,
   else std = new SGTELIB::Matrix ("std",pxx,_m);
 
   double rRr;
-  const double HRH = (_H.transpose()*_Ri*_H).get(0,0);
+  const double HRH = _HRiH;
 
   double v;
-  SGTELIB::Matrix ri;
   for (i=0 ; i<pxx ; i++){
-    ri = r.get_col(i);
-    rRr = (ri.transpose()*_Ri*ri).get(0,0);
+    rRr = rRr_all.get(0,i);
     if (fabs(rRr-1)<EPSILON){
       v = fabs(rRr-1);
     }
@@ -285,14 +318,24 @@ bool SGTELIB::Surrogate_Kriging::compute_cv_values (void){
   if ((_Zvs) && (_Svs)) return true;
 
   const SGTELIB::Matrix & Zs = get_matrix_Zs();
-  const SGTELIB::Matrix RiH = _Ri*_H;
-  const SGTELIB::Matrix Q = _Ri - RiH*( _H.transpose()*_Ri*_H)*RiH.transpose();
-  const SGTELIB::Matrix dQ = Q.diag_inverse();
+  // Q = Ri - RiH*HRiH*RiH'. Only diag(Q) and Q*Zs are needed:
+  // - diag(Ri) is the squared norm of the columns of L^-1,
+  // - Q*Zs is obtained with a solve.
+  const SGTELIB::Matrix Li = SGTELIB::Matrix::tril_inverse(_L);
+  SGTELIB::Matrix dQ ("dQ",_p,_p);
+  for (int i=0 ; i<_p ; i++){
+    double d = 0;
+    for (int k=i ; k<_p ; k++) d += Li.get(k,i)*Li.get(k,i);
+    d -= _RiH.get(i,0)*_HRiH*_RiH.get(i,0);
+    dQ.set(i,i,1.0/d);
+  }
   
   // Init matrices
   if ( !  _Zvs){
     _Zvs = new SGTELIB::Matrix;
-    *_Zvs = Zs - SGTELIB::Matrix::diagA_product(dQ,Q)*Zs;
+    const SGTELIB::Matrix QZs = SGTELIB::Matrix::cholesky_factor_solve(_L,Zs)
+                              - _RiH*(_HRiH*SGTELIB::Matrix::transposeA_product(_RiH,Zs));
+    *_Zvs = Zs - SGTELIB::Matrix::diagA_product(dQ,QZs);
     _Zvs->replace_nan(+INF);
     _Zvs->set_name("Zvs");
   }
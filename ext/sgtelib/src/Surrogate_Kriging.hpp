@@ -48,17 +48,26 @@ namespace SGTELIB {
     /*          Attributes                  */
     /*--------------------------------------*/
     SGTELIB::Matrix _R; // Covariance Matrix
-    SGTELIB::Matrix _Ri; // Inverte of _R
+    SGTELIB::Matrix _L; // Cholesky factor of _R
+    SGTELIB::Matrix _RiH; // _R^-1 * _H
+    double _HRiH; // _H' * _R^-1 * _H
     SGTELIB::Matrix _H; // Polynomial terms
     SGTELIB::Matrix _alpha;
     SGTELIB::Matrix _beta;
     SGTELIB::Matrix _var;
     double _detR;
 
+    // Data used to compute _R and _L
+    int _R_build_index;
+    SGTELIB::Matrix _R_coef;
+    double _R_ridge;
+    SGTELIB::distance_t _R_distance_type;
+
     /*--------------------------------------*/
     /*          Building methods            */
     /*--------------------------------------*/
-    const SGTELIB::Matrix compute_covariance_matrix ( const SGTELIB::Matrix & XXs ); 
+    const SGTELIB::Matrix compute_covariance_matrix ( const SGTELIB::Matrix & XXs ) const; 
+    bool same_covariance_parameters ( void ) const;
 
     /*--------------------------------------*/
     /*          Build model                 */
@@ -73,17 +82,15 @@ namespace SGTELIB {
     /*          predict                     */
     /*--------------------------------------*/ 
     virtual void predict_private ( const SGTELIB::Matrix & XXs,
-                                         SGTELIB::Matrix * ZZs) override;
+                                         SGTELIB::Matrix * ZZs) const override;
 
     virtual void predict_private ( const SGTELIB::Matrix & XXs,
                                          SGTELIB::Matrix * ZZs,
                                          SGTELIB::Matrix * std, 
                                          SGTELIB::Matrix * ei ,
-                                         SGTELIB::Matrix * cdf ) override;
+                                         SGTELIB::Matrix * cdf ) const override;
 
     // Predict only objectives (used in Surrogate Ensemble Stat)
-    virtual void predict_private_objective ( const std::vector<SGTELIB::Matrix *> & XXd,
-                                             SGTELIB::Matrix * ZZsurr_around            ) override;
     
     /*--------------------------------------*/
     /*          Compute matrices            */
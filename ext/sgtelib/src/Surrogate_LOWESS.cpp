@@ -49,7 +49,9 @@ SGTELIB::Surrogate_LOWESS::Surrogate_LOWESS ( SGTELIB::TrainingSet & trainingset
   _old_u             ( NULL     ),
   _old_x             ( NULL     ),
   _x_multiple        ( NULL     ),
-  _ZZsi              ("ZZsi",0,0){
+  _ZZsi              ("ZZsi",0,0),
+  _Xs                ("Xs",0,0),
+  _Zs                ("Zs",0,0){
   #ifdef SGTELIB_DEBUG
     std::cout << "constructor LOWESS\n";
   #endif
@@ -188,8 +190,8 @@ bool SGTELIB::Surrogate_LOWESS::init_private ( void ) {
     for (int i=0 ; i<_q ; i++) _u[i] = 0.0;
   }
   if ( ! _x_multiple){
-    _x_multiple = new bool [_m];
-    for (int j=0 ; j<_m ; j++) _x_multiple[j] = (_trainingset.get_X_nbdiff(j)>1);
+    _x_multiple = new bool [_n];
+    for (int j=0 ; j<_n ; j++) _x_multiple[j] = (_trainingset.get_X_nbdiff(j)>1);
   }
 
   #ifdef SGTELIB_LOWESS_DEV
@@ -205,6 +207,9 @@ bool SGTELIB::Surrogate_LOWESS::init_private ( void ) {
   #endif
 
   _ZZsi = SGTELIB::Matrix("ZZsi",1,_m);
+  // Data of the selected points, used by each single prediction
+  _Xs = get_matrix_Xs();
+  _Zs = get_matrix_Zs();
   #ifdef SGTELIB_DEBUG
     std::cout << "Line " << __LINE__ << "(End of private build)\n";
   #endif
@@ -230,9 +235,11 @@ bool SGTELIB::Surrogate_LOWESS::build_private ( void ) {
 /*       predict (ZZs only)             */
 /*--------------------------------------*/
 void SGTELIB::Surrogate_LOWESS::predict_private ( const SGTELIB::Matrix & XXs,
-                                                     SGTELIB::Matrix * ZZs ) {
+                                                     SGTELIB::Matrix * ZZs ) const {
 
   check_ready(__FILE__,__FUNCTION__,__LINE__);
+  std::lock_guard<std::mutex> lock(_predict_mutex);
+  Surrogate_LOWESS * model = const_cast<Surrogate_LOWESS *>(this);
   const int pxx = XXs.get_nb_rows();
   if (pxx>1){
     for (int i=0 ; i<XXs.get_nb_rows() ; i++){
@@ -241,12 +248,12 @@ void SGTELIB::Surrogate_LOWESS::predict_private ( const SGTELIB::Matrix & XXs,
         std::cout << "Prediction of point " << i << "/" << XXs.get_nb_rows() << "\n";
         std::cout << "============================================\n";
       #endif
-      predict_private_single ( XXs.get_row(i) );
+      model->predict_private_single ( XXs.get_row(i) );
       ZZs->set_row( _ZZsi , i );
     }
   }
   else{
-    predict_private_single ( XXs );
+    model->predict_private_single ( XXs );
     *ZZs = _ZZsi;
   }
 }//
@@ -254,8 +261,10 @@ void SGTELIB::Surrogate_LOWESS::predict_private ( const SGTELIB::Matrix & XXs,
 
 // Predict only objectives (used in Surrogate Ensemble Stat)
 void SGTELIB::Surrogate_LOWESS::predict_private_objective ( const std::vector<SGTELIB::Matrix *> & XXd,
-                                                            SGTELIB::Matrix * ZZsurr_around            ) {
+                                                            SGTELIB::Matrix * ZZsurr_around            ) const {
   check_ready(__FILE__,__FUNCTION__,__LINE__);
+  std::lock_guard<std::mutex> lock(_predict_mutex);
+  Surrogate_LOWESS * model = const_cast<Surrogate_LOWESS *>(this);
 
   const size_t pxx = XXd.size();
   const int nbd = XXd[0]->get_nb_rows();
@@ -272,12 +281,12 @@ void SGTELIB::Surrogate_LOWESS::predict_private_objective ( const std::vector<SG
           std::cout << "Prediction of point " << i << "/" << (XXd[i])->get_nb_rows() << "\n";
           std::cout << "============================================\n";
         #endif
-        predict_private_objective_single( XXd[i]->get_row(d), -1, &v );
+        model->predict_private_objective_single( XXd[i]->get_row(d), -1, &v );
         ZZsurr_around->set( i,d, v );
       }
     }
     else{
-      predict_private_objective_single( *(XXd[i]), -1, &v );
+      model->predict_private_objective_single( *(XXd[i]), -1, &v );
       ZZsurr_around->set( i,0, v );
     }
   } // end for i
@@ -309,7 +318,7 @@ void SGTELIB::Surrogate_LOWESS::predict_private_single ( const SGTELIB::Matrix X
 
   // Distance Matrix
   // D : distance between points of XXs and other points of the trainingset
-  SGTELIB::Matrix D = _trainingset.get_distances(XXs,get_matrix_Xs(),_param.get_distance_type());
+  SGTELIB::Matrix D = _trainingset.get_distances(XXs,_Xs,_param.get_distance_type());
 
   // Preset
   const std::string preset = _param.get_preset();
@@ -373,10 +382,7 @@ void SGTELIB::Surrogate_LOWESS::predict_private_single ( const SGTELIB::Matrix X
   else if (preset=="DEN"){
     // ========================================================
     // Distance, normalized with empirical method
-    const SGTELIB::Matrix R = D.rank();
-    i = 0;
-    while (R.get(i)!=_q-1) i++;
-    const double dq = 2.0*D.get(i);
+    const double dq = 2.0*D.get_kth_smallest(_q-1);
     for (i=0 ; i<_p ; i++) _W[i] = D.get(i)/dq;
   }
   else if (preset=="DGN"){
@@ -423,11 +429,9 @@ void SGTELIB::Surrogate_LOWESS::predict_private_single ( const SGTELIB::Matrix X
     //std::cout << "lambda : " << lambda << "\n";
     const SGTELIB::kernel_t kt = _param.get_kernel_type();
     // Weights
+    apply_kernel(kt,lambda,_W,_p);
     wsum = 0;
-    for (i=0 ; i<_p ; i++){
-      _W[i] = kernel(kt,lambda,_W[i]);
-      wsum += _W[i];
-    }
+    for (i=0 ; i<_p ; i++) wsum += _W[i];
   }
  
   // If a point must be excluded from the training points, set its weight to 0.
@@ -467,8 +471,8 @@ void SGTELIB::Surrogate_LOWESS::predict_private_single ( const SGTELIB::Matrix X
   double ridge = _param.get_ridge();
 
   // Build matrices
-  const SGTELIB::Matrix & Zs = get_matrix_Zs();
-  const SGTELIB::Matrix & Xs = get_matrix_Xs();
+  const SGTELIB::Matrix & Zs = _Zs;
+  const SGTELIB::Matrix & Xs = _Xs;
 
   double dx1 = 0;
 
@@ -822,7 +826,7 @@ void SGTELIB::Surrogate_LOWESS::predict_private_objective_single ( const SGTELIB
 
   // Distance Matrix
   // D : distance between points of XXs and other points of the trainingset
-  SGTELIB::Matrix D = _trainingset.get_distances(XXs, get_matrix_Xs(), _param.get_distance_type());
+  SGTELIB::Matrix D = _trainingset.get_distances(XXs,_Xs,_param.get_distance_type());
 
   // Preset
   const std::string preset = _param.get_preset();
@@ -886,10 +890,7 @@ void SGTELIB::Surrogate_LOWESS::predict_private_objective_single ( const SGTELIB
   else if (preset=="DEN"){
     // ========================================================
     // Distance, normalized with empirical method
-    const SGTELIB::Matrix R = D.rank();
-    i = 0;
-    while (R.get(i)!=_q-1) i++;
-    const double dq = 2.0*D.get(i);
+    const double dq = 2.0*D.get_kth_smallest(_q-1);
     for (i=0 ; i<_p ; i++) _W[i] = D.get(i)/dq;
   }
   else if (preset=="DGN"){
@@ -936,11 +937,9 @@ void SGTELIB::Surrogate_LOWESS::predict_private_objective_single ( const SGTELIB
     //std::cout << "lambda : " << lambda << "\n";
     const SGTELIB::kernel_t kt = _param.get_kernel_type();
     // Weights
+    apply_kernel(kt,lambda,_W,_p);
     wsum = 0;
-    for (i=0 ; i<_p ; i++){
-      _W[i] = kernel(kt,lambda,_W[i]);
-      wsum += _W[i];
-    }
+    for (i=0 ; i<_p ; i++) wsum += _W[i];
   }
 
   // If a point must be excluded from the training points, set its weight to 0.
@@ -980,8 +979,8 @@ void SGTELIB::Surrogate_LOWESS::predict_private_objective_single ( const SGTELIB
   double ridge = _param.get_ridge();
 
   // Build matrices
-  const SGTELIB::Matrix & Zs_all = get_matrix_Zs();
-  const SGTELIB::Matrix & Xs = get_matrix_Xs();
+  const SGTELIB::Matrix & Zs_all = _Zs;
+  const SGTELIB::Matrix & Xs = _Xs;
   SGTELIB::Matrix Zs ("Zs", _p, 1);
   // Get only objectives values is Zs_all
   for (int j=0 ; j<_m ; j++){
@@ -1326,7 +1325,7 @@ const SGTELIB::Matrix * SGTELIB::Surrogate_LOWESS::get_matrix_Zvs (void){
   if ( ! _Zvs){
     _Zvs = new SGTELIB::Matrix("Zvs",_p,_m);
     for (int i=0 ; i<_p ; i++){
-      predict_private_single( get_matrix_Xs().get_row(i) , i);
+      predict_private_single( _Xs.get_row(i) , i);
       _Zvs->set_row( _ZZsi ,i);
     }
   }
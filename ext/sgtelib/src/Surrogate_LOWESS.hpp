@@ -54,17 +54,22 @@ namespace SGTELIB {
     bool * _x_multiple;
 
     SGTELIB::Matrix _ZZsi; // Outputs for one point (buffer)
+    // The buffers above (and _u, which warm-starts the conjugate gradient of
+    // the next prediction) belong to the model: predictions are serialized.
+    mutable std::mutex _predict_mutex;
+    SGTELIB::Matrix _Xs; // Inputs of the selected points (set by init_private)
+    SGTELIB::Matrix _Zs; // Outputs of the selected points (set by init_private)
 
     // init and build model (private):
     virtual bool init_private (void) override;
     virtual bool build_private (void) override;
 
     void predict_private ( const SGTELIB::Matrix & XXs,
-                                 SGTELIB::Matrix * ZZs) override;
+                                 SGTELIB::Matrix * ZZs) const override;
 
     // Predict only objectives (used in Surrogate Ensemble Stat)
     virtual void predict_private_objective ( const std::vector<SGTELIB::Matrix *> & XXd,
-                                                               SGTELIB::Matrix * ZZsurr_around ) override;
+                                                               SGTELIB::Matrix * ZZsurr_around ) const override;
 
     void predict_private_objective_single ( SGTELIB::Matrix XXs , int i_exclude = -1, double * z = 0);
 
@@ -36,6 +36,10 @@ SGTELIB::Surrogate_PRS::Surrogate_PRS ( SGTELIB::TrainingSet & trainingset,
   _H                 ( "H",0,0     ),
   _Ai                ( "Ai",0,0    ),
   _alpha             ( "alpha",0,0 ),
+  _HtH               ( "HtH",0,0   ),
+  _HtZ               ( "HtZ",0,0   ),
+  _H_build_index     ( -1          ),
+  _quad              (             ),
   _preComputeForJacobianAndHessianDone( false){
   #ifdef SGTELIB_DEBUG
     std::cout << "constructor PRS\n";
@@ -82,11 +86,31 @@ bool SGTELIB::Surrogate_PRS::build_private ( void ) {
   const int pvar = _trainingset.get_pvar(); 
   const int nvar = _trainingset.get_nvar(); 
 
+  _quad.clear();
+
   // Get the number of basis functions.
   _q = Surrogate_PRS::get_nb_PRS_monomes(nvar,_param.get_degree());
+
+  // If the points were only appended since the previous build (with the same
+  // monomes), only the rows of the new points are added to the design matrix.
+  const int p0 = _H.get_nb_rows();
+  if ( is_appended(_H_build_index,p0) && (_H.get_nb_cols()==_q) && (_M.get_nb_rows()==_q) ){
+    if ( (_q>pvar) && (_param.get_ridge()==0) )
+      _param.set_ridge(0.001);
+    if (p0<_p)
+      _H.add_rows(compute_design_matrix ( _M , get_matrix_Xs().get_rows(p0,_p) ));
+    if ( ! compute_alpha(p0)){
+      _H_build_index = -1;
+      return false;
+    }
+    set_quadratic_form();
+    _ready = true;
+    return true;
+  }
     
     _M = Matrix("M",0,0);
     _H = Matrix( "H",0,0);
+    _H_build_index = -1;
     _Ai = Matrix( "Ai",0,0    );
     _alpha = Matrix( "alpha",0,0 );
 
@@ -107,16 +131,29 @@ bool SGTELIB::Surrogate_PRS::build_private ( void ) {
   // Compute alpha
   if ( !  compute_alpha())
       return false;
+  _H_build_index = _trainingset.get_build_index();
+  set_quadratic_form();
 
   _ready = true; 
   return true;
 }//
 
+/*--------------------------------------*/
+/*      quadratic form of the model     */
+/*--------------------------------------*/
+void SGTELIB::Surrogate_PRS::set_quadratic_form ( void ) {
+  // The derived classes (PRS_EDGE, PRS_CAT) add basis functions which are
+  // not monomes: their alpha has more rows than _M and no form is extracted.
+  if ( (_alpha.get_nb_rows()!=_M.get_nb_rows()) || (! _quad.set_from_monomes(_M,_alpha)) ){
+    _quad.clear();
+  }
+}//
+
 /*--------------------------------------*/
 /*          Compute PRS matrix          */
 /*--------------------------------------*/
 const SGTELIB::Matrix SGTELIB::Surrogate_PRS::compute_design_matrix ( const SGTELIB::Matrix& Monomes, 
-                                                                      const SGTELIB::Matrix & Xs ) {
+                                                                      const SGTELIB::Matrix & Xs ) const {
 
   const int n = Xs.get_nb_cols(); // Nb of points in the matrix X given in argument
   const int p = Xs.get_nb_rows(); // Nb of points in the matrix X given in argument
@@ -195,28 +232,41 @@ void SGTELIB::Surrogate_PRS::compute_dxi_matrices (
 
 /*--------------------------------------*/
 /*       compute alpha                  */
+/*  (the p0 first rows of _H are        */
+/*  already included in _HtH and _HtZ)  */
 /*--------------------------------------*/
-bool SGTELIB::Surrogate_PRS::compute_alpha ( void ){
+bool SGTELIB::Surrogate_PRS::compute_alpha ( const int p0 ){
 
-  const SGTELIB::Matrix   Ht = _H.transpose();
   const SGTELIB::Matrix & Zs = get_matrix_Zs();
 
   // Ridge
   double r = _param.get_ridge();
 
-    if (_H.has_inf() || _H.has_nan() || Ht.has_inf() || Ht.has_nan())
+    if (_H.has_inf() || _H.has_nan())
     {
         return false;
     }
+  // H'*H is formed once, without forming H'
+  if (p0==0){
+    _HtH = SGTELIB::Matrix::transposeA_product(_H,_H);
+    _HtZ = SGTELIB::Matrix::transposeA_product(_H,Zs);
+  }
+  else if (p0<_p){
+    // Rank-p-p0 update with the new rows
+    const SGTELIB::Matrix Hnew = _H.get_rows(p0,_p);
+    _HtH.add(SGTELIB::Matrix::transposeA_product(Hnew,Hnew));
+    _HtZ.add(SGTELIB::Matrix::transposeA_product(Hnew,Zs.get_rows(p0,_p)));
+  }
+  const SGTELIB::Matrix & HtH = _HtH;
   // COMPUTE COEFS
   if (r>0)
   {
-    _Ai = (Ht*_H+r*SGTELIB::Matrix::identity(_q)).SVD_inverse();
+    _Ai = (HtH+r*SGTELIB::Matrix::identity(_q)).SVD_inverse();
     //_Ai = (Ht*_H+r*SGTELIB::Matrix::identity(_q)).cholesky_inverse();
   }
   else
   {
-      _Ai = (Ht*_H).SVD_inverse();
+      _Ai = HtH.SVD_inverse();
       //_Ai = (Ht*_H).cholesky_inverse();
       
       // We may not have enough points to compute all coefficients of the monome
@@ -224,7 +274,7 @@ bool SGTELIB::Surrogate_PRS::compute_alpha ( void ){
       if (_Ai.has_nan())
       {
           r = 1E-3;
-          _Ai = (Ht*_H+r*SGTELIB::Matrix::identity(_q)).SVD_inverse();
+          _Ai = (HtH+r*SGTELIB::Matrix::identity(_q)).SVD_inverse();
           
       }
   }
@@ -233,9 +283,9 @@ bool SGTELIB::Surrogate_PRS::compute_alpha ( void ){
       return false;
   }
     
-  _alpha = _Ai * (Ht * Zs);
+  _alpha = _Ai * _HtZ;
     
-    SGTELIB::Matrix sing_val = (Ht*_H).get_singular_values();
+    SGTELIB::Matrix sing_val = HtH.get_singular_values();
     double sing_val_min = sing_val.min();
     if (sing_val_min > 0)
     {
@@ -257,8 +307,12 @@ bool SGTELIB::Surrogate_PRS::compute_alpha ( void ){
 /*       predict (ZZs only)             */
 /*--------------------------------------*/
 void SGTELIB::Surrogate_PRS::predict_private ( const SGTELIB::Matrix & XXs,
-                                                     SGTELIB::Matrix * ZZs ) {
+                                                     SGTELIB::Matrix * ZZs ) const {
   check_ready(__FILE__,__FUNCTION__,__LINE__);
+  if (_quad.is_defined()){
+    _quad.eval(XXs,ZZs);
+    return;
+  }
   *ZZs = compute_design_matrix(_M,XXs) * _alpha;
 }//
 
@@ -309,6 +363,33 @@ void SGTELIB::Surrogate_PRS::predict_grad ( const SGTELIB::Matrix & XX,
         _trainingset.X_scale(XXs);
     }
 
+    if (_quad.is_defined())
+    {
+        // Gradient of the quadratic form: g + H x
+        std::vector<double> g(_quad.get_nb_variables());
+        for (int j = 0 ; j < _m ; j++)
+        {
+            _quad.eval_gradient(j, XXs.get_data(), g.data());
+            int ii = 0;  // ii is for index of true variables in the model
+            for (int i = 0 ; i < _n ; i++ )
+            {
+                double dFdxi = 0.0;
+                if ( _trainingset.get_X_nbdiff(i) >1)
+                {
+                    // UnScaled output (dF/dX)*(sX/sF)
+                    dFdxi = g[ii];
+                    if (! forceOnEmptyTrainingSet)
+                    {
+                        dFdxi *= _trainingset.get_X_scaling_a(ii)/_trainingset.get_Z_scaling_a(j);
+                    }
+                    ii++;
+                }
+                ZZs->set(j,i,dFdxi);
+            }
+        }
+        return;
+    }
+
     Matrix dFdxi("dFdxi",1,static_cast<int>(_m));
     
     preComputeForJacobianAndHessian();
@@ -405,10 +486,38 @@ void SGTELIB::Surrogate_PRS::predict_hessian(const SGTELIB::Matrix & XX,
     {
         _trainingset.X_scale(XXs);
     }
-    
-    preComputeForJacobianAndHessian();
 
     double d2Fkdxidxj=0.0;
+    if (_quad.is_defined())
+    {
+        // The Hessian of the quadratic form does not depend on the point
+        int jj = 0 ;  //index of true variables in the model
+        for (int j = 0 ; j < _n ; j++ )
+        {
+            const bool jvar = (_trainingset.get_X_nbdiff(j) > 1);
+            int ii = 0 ;
+            for (int i = 0 ; i < _n ; i++ )
+            {
+                d2Fkdxidxj = 0.0;
+                if ( jvar && (_trainingset.get_X_nbdiff(i) > 1) )
+                {
+                    d2Fkdxidxj = _quad.get_hessian(k,ii,jj);
+                    // UnScaled output (d2F/dXi/dXj)*(sXi*sXj/sF^2)
+                    if (! forceOnEmptyTrainingSet)
+                    {
+                        d2Fkdxidxj = d2Fkdxidxj* _trainingset.get_X_scaling_a(ii)*_trainingset.get_X_scaling_a(jj)/_trainingset.get_Z_scaling_a(k) ;
+                    }
+                }
+                if (_trainingset.get_X_nbdiff(i) > 1) ii++;
+                ZZs->set(i,j,d2Fkdxidxj);
+            }
+            if (jvar) jj++;
+        }
+        return;
+    }
+
+    preComputeForJacobianAndHessian();
+
     int jj = 0 ;  //index of true variables in the model
     for (int j = 0 ; j < _n ; j++ )
     {
@@ -466,34 +575,6 @@ void SGTELIB::Surrogate_PRS::predict_hessian(const SGTELIB::Matrix & XX,
 
 
 
-// Predict only objectives (used in Surrogate Ensemble Stat)
-void SGTELIB::Surrogate_PRS::predict_private_objective ( const std::vector<SGTELIB::Matrix *> & XXd,
-                                                         SGTELIB::Matrix * ZZsurr_around            ) {
-  check_ready(__FILE__,__FUNCTION__,__LINE__);
-
-  const size_t pxx = XXd.size();
-  SGTELIB::Matrix _alpha_obj ("alpha_obj", _q, 1);
-
-  // Get only objectives values is alpha
-  for (int j=0 ; j<_m ; j++)
-  {
-    if (_trainingset.get_bbo(j)==SGTELIB::BBO_OBJ)
-    {
-      _alpha_obj = _alpha.get_col(j);
-      break;
-    }
-  } // end for j
-
-  // Loop on all pxx points 
-  for (int i=0 ; i<static_cast<int>(pxx) ; i++)
-  {
-    // XXd[i] is of dimension nbd * _n
-    ZZsurr_around->set_row( ( compute_design_matrix(_M, *(XXd[i])) * _alpha_obj ).transpose() , i );
-  } // end for i
-
-}
-
-
 
 /*--------------------------------------*/
 /*       compute Zvs                    */
@@ -891,7 +972,7 @@ void SGTELIB::Surrogate_PRS::getModelLagGrad(
   
     getModelJacobian(Jx, Mpredict_grad, X);
     SGTELIB::Matrix tmp ("JxtY", Jx->get_nb_cols(), 1);
-    SGTELIB::Matrix::inplace_product(tmp, Jx->transpose(), Y);
+    SGTELIB::Matrix::inplace_transposeA_product(tmp, *Jx, Y);
     tmp.multiply(-1);
     Gx->add(tmp);
 }
@@ -27,6 +27,7 @@
 #define __SGTELIB_SURROGATE_PRS__
 
 #include "Surrogate.hpp"
+#include "Quadratic_Form.hpp"
 
 namespace SGTELIB {
 
@@ -63,9 +64,18 @@ namespace SGTELIB {
     SGTELIB::Matrix _H; // Design matrix
     SGTELIB::Matrix _Ai; // Inverse of Ht*H
     SGTELIB::Matrix _alpha; // Coefficients
+    SGTELIB::Matrix _HtH; // H'*H
+    SGTELIB::Matrix _HtZ; // H'*Zs
+    int _H_build_index; // Build index of the training set when _H was computed
+    // Constant, gradient and Hessian of the model (scaled space) when all the
+    // monomes are of degree 2 or less. Used instead of the design matrix.
+    SGTELIB::Quadratic_Form _quad;
+
+    // Extract _quad from the monomes and alpha (after each build)
+    void set_quadratic_form ( void );
 
     virtual const SGTELIB::Matrix compute_design_matrix ( const SGTELIB::Matrix& Monomes, 
-                                                          const SGTELIB::Matrix & Xs );
+                                                          const SGTELIB::Matrix & Xs ) const;
 
     virtual void compute_dxi_matrices ( SGTELIB::Matrix& Monomes,
                                         SGTELIB::Matrix& alpha,
@@ -75,19 +85,17 @@ namespace SGTELIB {
     virtual bool build_private (void) override;
 
     void predict_private ( const SGTELIB::Matrix & XXs,
-                                 SGTELIB::Matrix * ZZs) override;
+                                 SGTELIB::Matrix * ZZs) const override;
       
     
       
-    virtual void predict_private_objective ( const std::vector<SGTELIB::Matrix *> & XXd,
-                                             SGTELIB::Matrix * ZZsurr_around            ) override;
 
 
     // Compute metrics
     const SGTELIB::Matrix * get_matrix_Zvs (void) override;
       
 
-    bool compute_alpha ( void );
+    bool compute_alpha ( const int p0 = 0 );
       
 
   public:
@@ -105,11 +113,14 @@ namespace SGTELIB {
     virtual void display_private ( std::ostream & out ) const override;
     
     SGTELIB::Matrix get_alpha() const;
+    // Quadratic form of the model, in the scaled space (not defined if the
+    // model is not ready or has monomes of degree larger than 2)
+    const SGTELIB::Quadratic_Form & get_quadratic_form ( void ) const { return _quad; };
       
     // TEMP. Uncomment for use in unittest. Alloe predict_grad to work
-      void set_alpha(const SGTELIB::Matrix & alpha) {_alpha = alpha; } // Set alpha but the model is not ready ( maybe empty _training set)
+      void set_alpha(const SGTELIB::Matrix & alpha) {_alpha = alpha; _quad.clear(); } // Set alpha but the model is not ready ( maybe empty _training set)
       
-      void set_PRS_monones(const SGTELIB::Matrix & monome ) { _M = monome; _ready = true; }
+      void set_PRS_monones(const SGTELIB::Matrix & monome ) { _M = monome; _ready = true; _quad.clear(); }
       
     void predict_obj ( const SGTELIB::Matrix & XX,
                         SGTELIB::Matrix * ZZs,
@@ -104,7 +104,7 @@ bool SGTELIB::Surrogate_PRS_CAT::build_private ( void ) {
 /*          Compute PRS_CAT design matrix          */
 /*-------------------------------------------------*/
 const SGTELIB::Matrix SGTELIB::Surrogate_PRS_CAT::compute_design_matrix ( const SGTELIB::Matrix& Monomes, 
-                                                                          const SGTELIB::Matrix & Xs ) {
+                                                                          const SGTELIB::Matrix & Xs ) const {
 
   const int p = Xs.get_nb_rows(); 
   SGTELIB::Matrix H("H",p,0);
@@ -40,7 +40,7 @@ namespace SGTELIB {
     int _nb_cat; // Number of categories
 
     virtual const SGTELIB::Matrix compute_design_matrix ( const SGTELIB::Matrix& Monomes, 
-                                                          const SGTELIB::Matrix & Xs ) override;
+                                                          const SGTELIB::Matrix & Xs ) const override;
     // build model (private):
     virtual bool build_private (void) override;
     virtual bool init_private  (void) override;
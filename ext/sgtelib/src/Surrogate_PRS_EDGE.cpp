@@ -85,7 +85,7 @@ bool SGTELIB::Surrogate_PRS_EDGE::build_private ( void ) {
 /*          Compute PRS_EDGE design matrix          */
 /*-------------------------------------------------*/
 const SGTELIB::Matrix SGTELIB::Surrogate_PRS_EDGE::compute_design_matrix ( const SGTELIB::Matrix& Monomes, 
-                                                                           const SGTELIB::Matrix & Xs ) {
+                                                                           const SGTELIB::Matrix & Xs ) const {
 
   // Call the standard design matrix
   const SGTELIB::Matrix H_prs = SGTELIB::Surrogate_PRS::compute_design_matrix ( Monomes, Xs );
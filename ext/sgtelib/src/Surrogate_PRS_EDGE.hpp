@@ -38,7 +38,7 @@ namespace SGTELIB {
   protected:
 
     virtual const SGTELIB::Matrix compute_design_matrix ( const SGTELIB::Matrix& Monomes, 
-                                                  const SGTELIB::Matrix & Xs ) override;
+                                                  const SGTELIB::Matrix & Xs ) const override;
 
     // build model (private):
     virtual bool build_private (void) override;
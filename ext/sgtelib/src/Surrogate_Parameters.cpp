@@ -1312,6 +1312,7 @@ double SGTELIB::Surrogate_Parameters::get_x_penalty ( void ){
         break;
       case DISTANCE_NORM1:
       case DISTANCE_NORMINF:
+      case DISTANCE_NORM2_EMB:
         pen += 1;
         break;
       case DISTANCE_NORM2_IS0:
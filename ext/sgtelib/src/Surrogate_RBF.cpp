@@ -38,7 +38,8 @@ SGTELIB::Surrogate_RBF::Surrogate_RBF ( SGTELIB::TrainingSet & trainingset,
   _H                 ( "H",0,0             ),
   _HtH               ( "HtH",0,0           ),
   _HtZ               ( "HtZ",0,0           ),
-  _Ai                ( "Ai",0,0            ),
+  _F                 ( "F",0,0             ),
+  _P                 (                     ),
   _Alpha             ( "alpha",0,0         ),
   _selected_kernel   (1,-1                 ){
   #ifdef SGTELIB_DEBUG
@@ -155,10 +156,14 @@ bool SGTELIB::Surrogate_RBF::build_private ( void ) {
     // =========================================
     // Build design matrix with constraints lines
     _H = compute_design_matrix(get_matrix_Xs(),true); 
-    // Inverte matrix
-    _Ai = _H.lu_inverse();
-    // Product (only the p first rows of Ai)
-    _Alpha = SGTELIB::Matrix::subset_product(_Ai,Zs,-1,_p,-1);
+    // Factorize matrix
+    if ( ! _H.lu_factor(_F,_P) ){
+      return false;
+    }
+    // Solve with [Zs;0] (the constraints lines have a null right-hand side)
+    SGTELIB::Matrix Z0 = Zs;
+    Z0.add_rows(_qprs);
+    _Alpha = SGTELIB::Matrix::lu_factor_solve(_F,_P,Z0);
   }
   else{
     // =========================================
@@ -190,8 +195,11 @@ bool SGTELIB::Surrogate_RBF::build_private ( void ) {
       // Add ridge to all radial basis function (Same as R3)
       for (int i=0 ; i<_qrbf ; i++) A.add(i,i,r);
     }
-    _Ai = A.cholesky_inverse();
-    _Alpha = _Ai*_HtZ;
+    _P.clear();
+    if ( ! A.cholesky_factor(_F) ){
+      return false;
+    }
+    _Alpha = SGTELIB::Matrix::cholesky_factor_solve(_F,_HtZ);
   }
 
   // Check for Nan  
@@ -211,7 +219,7 @@ bool SGTELIB::Surrogate_RBF::build_private ( void ) {
 /*--------------------------------------*/
 /*         Compute Design matrix        */
 /*--------------------------------------*/
-const SGTELIB::Matrix SGTELIB::Surrogate_RBF::compute_design_matrix ( const SGTELIB::Matrix & XXs , const bool constraints ) {
+const SGTELIB::Matrix SGTELIB::Surrogate_RBF::compute_design_matrix ( const SGTELIB::Matrix & XXs , const bool constraints ) const {
 
   // Xs can be, either the training set, to build the model, or prediction points.
   // To build the model, we need the orthogonality constraints, so the 2nd arg is going to be true.
@@ -227,7 +235,7 @@ const SGTELIB::Matrix SGTELIB::Surrogate_RBF::compute_design_matrix ( const SGTE
     H.set_col(kernel(_param.get_kernel_type(),_kernel_coef,H.get_col(i)),i);
   }
   */
-  H = kernel(_param.get_kernel_type(),_param.get_kernel_coef(),H);
+  apply_kernel(_param.get_kernel_type(),_param.get_kernel_coef(),H);
 
   // If there are some PRS basis functions
   if (_qprs>0){
@@ -272,34 +280,11 @@ const SGTELIB::Matrix SGTELIB::Surrogate_RBF::compute_design_matrix ( const SGTE
 /*       predict (ZZs only)             */
 /*--------------------------------------*/
 void SGTELIB::Surrogate_RBF::predict_private ( const SGTELIB::Matrix & XXs,
-                                                     SGTELIB::Matrix * ZZs) {
+                                                     SGTELIB::Matrix * ZZs) const {
   check_ready(__FILE__,__FUNCTION__,__LINE__);
   *ZZs = compute_design_matrix(XXs,false) * _Alpha;
 }//
 
-// Predict only objectives (used in Surrogate Ensemble Stat)
-void SGTELIB::Surrogate_RBF::predict_private_objective ( const std::vector<SGTELIB::Matrix *> & XXd,
-                                                         SGTELIB::Matrix * ZZsurr_around            ) {
-  check_ready(__FILE__,__FUNCTION__,__LINE__);
-
-  const size_t pxx = XXd.size();
-  SGTELIB::Matrix _Alpha_obj ("alpha_obj", _q, 1);
-
-  // Get only objectives values is alpha
-  for (int j=0 ; j<_m ; j++){
-    if (_trainingset.get_bbo(j)==SGTELIB::BBO_OBJ){
-      _Alpha_obj = _Alpha.get_col(j);
-      break;
-    }
-  } // end for j
-
-  // Loop on all pxx points 
-  for (int i=0 ; i<static_cast<int>(pxx) ; i++){
-    // XXd[i] is of dimension nbd * _n
-    ZZsurr_around->set_row( ( compute_design_matrix(*(XXd[i]), false) * _Alpha_obj ).transpose() , i );
-  } // end for i
-
-}
 
 /*--------------------------------------*/
 /*       get matrix Zvs                 */
@@ -312,20 +297,29 @@ const SGTELIB::Matrix * SGTELIB::Surrogate_RBF::get_matrix_Zvs (void){
     _Zvs = new SGTELIB::Matrix;
     const SGTELIB::Matrix & Zs = get_matrix_Zs();
 
-    if ( string_find(_param.get_preset(),"O") ){
+    if ( string_find(_param.get_preset(),"O") ||  string_find(_param.get_preset(),"0") ){
       //============================================
       // ORTHOGONALITY CONSTRAINTS
       //============================================
-      SGTELIB::Matrix dAiAlpha = SGTELIB::Matrix::diagA_product(_Ai.diag_inverse(),_Alpha);
+      // Only the p first terms of diag(H^-1) are needed,
+      // ie the p first columns of H^-1.
+      SGTELIB::Matrix E ("E",_p+_qprs,_p);
+      for (int i=0 ; i<_p ; i++) E.set(i,i,1.0);
+      const SGTELIB::Matrix Ai = SGTELIB::Matrix::lu_factor_solve(_F,_P,E);
+      SGTELIB::Matrix dAiAlpha = _Alpha;
       dAiAlpha.remove_rows(_qprs);
+      for (int i=0 ; i<_p ; i++) dAiAlpha.multiply_row(1.0/Ai.get(i,i),i);
       *_Zvs = Zs-dAiAlpha;
     }
     else{
-      //SGTELIB::Matrix dPiPZs    = SGTELIB::Matrix::get_matrix_dPiPZs(_Ai,_H,Zs);
-      SGTELIB::Matrix dPiPZs = SGTELIB::Matrix::get_matrix_dPiPZs(_Ai,_H,Zs,_Alpha);
-    
-      // dPi is the inverse of the diag of P 
+      // dPi is the inverse of the diag of P, with P = I - H*Ai*H'.
+      // diag(H*Ai*H') is the squared norm of the columns of L^-1*H'.
+      const SGTELIB::Matrix W = SGTELIB::Matrix::tril_solve(_F,_H.transpose());
+      const SGTELIB::Matrix hAih = SGTELIB::Matrix::transposeA_product(SGTELIB::Matrix::ones(_q,1),
+                                                                       SGTELIB::Matrix::hadamard_square(W));
       // Compute _Zv = Zs - dPi*P*Zs
+      SGTELIB::Matrix dPiPZs = Zs - _H*_Alpha;
+      for (int i=0 ; i<_p ; i++) dPiPZs.multiply_row(1.0/(1.0-hAih.get(0,i)),i);
       *_Zvs = Zs - dPiPZs;
     }
 
@@ -53,7 +53,8 @@ namespace SGTELIB {
     SGTELIB::Matrix _H; // Design matrix
     SGTELIB::Matrix _HtH; // H'*H
     SGTELIB::Matrix _HtZ; // H'*Z
-    SGTELIB::Matrix _Ai; // inverse of H or Ht*H+r*J
+    SGTELIB::Matrix _F; // LU factor of H, or Cholesky factor of Ht*H+r*J
+    std::vector<int> _P; // Row permutation of the LU factor
     SGTELIB::Matrix _Alpha; // Coefficients
 
     std::list<int> _selected_kernel;
@@ -62,7 +63,7 @@ namespace SGTELIB {
     /*--------------------------------------*/
     /*          Building methods            */
     /*--------------------------------------*/
-    const SGTELIB::Matrix compute_design_matrix ( const SGTELIB::Matrix & XXs , const bool constraints );
+    const SGTELIB::Matrix compute_design_matrix ( const SGTELIB::Matrix & XXs , const bool constraints ) const;
 
     /*--------------------------------------*/
     /*          Build model                 */
@@ -76,10 +77,8 @@ namespace SGTELIB {
     /*          predict                     */
     /*--------------------------------------*/ 
     virtual void predict_private ( const SGTELIB::Matrix & XXs,
-                                         SGTELIB::Matrix * ZZs) override;
+                                         SGTELIB::Matrix * ZZs) const override;
 
-    virtual void predict_private_objective ( const std::vector<SGTELIB::Matrix *> & XXd,
-                                             SGTELIB::Matrix * ZZsurr_around            ) override;
                                              
     /*--------------------------------------*/
     /*          Compute matrices            */
@@ -27,6 +27,12 @@
 
 #include <string>
 #include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 
 /*-------------------------------*/
@@ -311,6 +317,7 @@ std::string SGTELIB::distance_type_to_str ( const SGTELIB::distance_t t ) {
     case SGTELIB::DISTANCE_NORMINF    : return "NORMINF";
     case SGTELIB::DISTANCE_NORM2_IS0  : return "NORM2_IS0";
     case SGTELIB::DISTANCE_NORM2_CAT  : return "NORM2_CAT";
+    case SGTELIB::DISTANCE_NORM2_EMB  : return "NORM2_EMB";
     default:
       throw SGTELIB::Exception ( __FILE__ , __LINE__ ,"Undefined type" );
   }
@@ -485,6 +492,9 @@ SGTELIB::distance_t SGTELIB::str_to_distance_type ( const std::string & s ) {
 
   if ( ss=="CAT"      ){ return SGTELIB::DISTANCE_NORM2_CAT; }
   if ( ss=="NORM2_CAT"){ return SGTELIB::DISTANCE_NORM2_CAT; }
+
+  if ( ss=="EMB"      ){ return SGTELIB::DISTANCE_NORM2_EMB; }
+  if ( ss=="NORM2_EMB"){ return SGTELIB::DISTANCE_NORM2_EMB; }
   throw SGTELIB::Exception ( __FILE__ , __LINE__ ,"Unrecognised string \""+s+"\" ( "+ss+" )" );
 }//
 
@@ -501,6 +511,7 @@ SGTELIB::distance_t SGTELIB::int_to_distance_type ( const int i ) {
     case 2: return SGTELIB::DISTANCE_NORMINF; 
     case 3: return SGTELIB::DISTANCE_NORM2_IS0; 
     case 4: return SGTELIB::DISTANCE_NORM2_CAT; 
+    case 5: return SGTELIB::DISTANCE_NORM2_EMB; 
     default:
       throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
         "int_to_kernel_type: invalid integer "+itos(i) );
@@ -744,6 +755,123 @@ int SGTELIB::diff_ms(timeval t1, timeval t2){
   return static_cast<int>((((t1.tv_sec - t2.tv_sec) * 1000000) + (t1.tv_usec - t2.tv_usec +500))/1000);
 }//
 
+/*----------------------------------------*/
+/*  number of threads                     */
+/*----------------------------------------*/
+namespace {
+  // 0: default (sequential)
+  std::atomic<int> nb_threads_setting (0);
+  // True in the tasks run by parallel_run
+  thread_local bool in_parallel_run = false;
+
+  // Worker threads kept alive between the calls to parallel_run: the parameter
+  // optimization runs one parallel round per poll, and spawning threads at
+  // each round costs more than the round itself on small training sets.
+  class Worker_pool {
+  public:
+    ~Worker_pool ( void ){
+      {
+        std::lock_guard<std::mutex> lock (_mutex);
+        _stop = true;
+      }
+      _cv_start.notify_all();
+      for (auto & t : _threads) t.join();
+    }
+
+    // Run job(1),...,job(nb_tasks-1) on the workers and job(0) on the calling thread
+    void run ( const int nb_tasks , const std::function<void(int)> & job ){
+      // One parallel round at a time (concurrent callers share the workers)
+      std::lock_guard<std::mutex> round_lock (_round_mutex);
+      while (static_cast<int>(_threads.size())<nb_tasks-1)
+        _threads.emplace_back(&Worker_pool::work,this);
+      {
+        std::lock_guard<std::mutex> lock (_mutex);
+        _job = &job;
+        _nb_tasks = nb_tasks;
+        _next = 1;
+        _pending = nb_tasks-1;
+      }
+      _cv_start.notify_all();
+      job(0);
+      std::unique_lock<std::mutex> lock (_mutex);
+      _cv_done.wait(lock,[this]{ return _pending==0; });
+      _job = nullptr;
+    }
+
+  private:
+    void work ( void ){
+      std::unique_lock<std::mutex> lock (_mutex);
+      while (true){
+        _cv_start.wait(lock,[this]{ return _stop || (_job && _next<_nb_tasks); });
+        if (_stop) return;
+        const int w = _next++;
+        const std::function<void(int)> & job = *_job;
+        lock.unlock();
+        job(w);
+        lock.lock();
+        if (--_pending==0) _cv_done.notify_one();
+      }
+    }
+
+    std::vector<std::thread> _threads;
+    std::mutex _round_mutex;
+    std::mutex _mutex;
+    std::condition_variable _cv_start;
+    std::condition_variable _cv_done;
+    const std::function<void(int)> * _job = nullptr;
+    int _nb_tasks = 0;
+    int _next = 0;
+    int _pending = 0;
+    bool _stop = false;
+  };
+}
+
+void SGTELIB::set_nb_threads ( const int nb_threads ){
+  // A non-positive value restores the default
+  nb_threads_setting = std::max(nb_threads,0);
+}//
+
+int SGTELIB::get_nb_threads ( void ){
+  if (in_parallel_run) return 1;
+  // Sequential unless requested: the caller (NOMAD, CatMADS) may already
+  // run several evaluations or models concurrently.
+  return std::max(1,nb_threads_setting.load());
+}//
+
+/*----------------------------------------*/
+/*  run tasks concurrently                */
+/*----------------------------------------*/
+void SGTELIB::parallel_run ( const int nb_tasks , const std::function<void(int)> & task ){
+
+  std::vector<std::exception_ptr> errors (std::max(nb_tasks,0));
+
+  const std::function<void(int)> run = [&] ( const int w ){
+    const bool in_parallel_run_old = in_parallel_run;
+    in_parallel_run = true;
+    try{
+      task(w);
+    }
+    catch (...){
+      errors[w] = std::current_exception();
+    }
+    in_parallel_run = in_parallel_run_old;
+  };
+
+  if ( (nb_tasks>1) && (!in_parallel_run) ){
+    static Worker_pool pool;
+    pool.run(nb_tasks,run);
+  }
+  else{
+    // Nested calls run sequentially: the workers are busy with the outer round
+    for (int w=0 ; w<nb_tasks ; w++) run(w);
+  }
+
+  for (auto & e : errors){
+    if (e) std::rethrow_exception(e);
+  }
+
+}//
+
 /*----------------------------------------*/
 /*  uniform rand generator               */
 /*----------------------------------------*/
@@ -56,6 +56,7 @@ typedef struct timeval {
 
 #include <cstring>
 #include <cctype>
+#include <functional>
 
 namespace SGTELIB {
 
@@ -64,9 +65,10 @@ namespace SGTELIB {
     DISTANCE_NORM1 ,
     DISTANCE_NORMINF ,
     DISTANCE_NORM2_IS0,
-    DISTANCE_NORM2_CAT
+    DISTANCE_NORM2_CAT,
+    DISTANCE_NORM2_EMB
   };
-  const int NB_DISTANCE_TYPES = 5;
+  const int NB_DISTANCE_TYPES = 6;
 
   // model type:
   enum model_t {
@@ -138,6 +140,17 @@ namespace SGTELIB {
   // isdef (not nan nor inf)
   DLL_API bool isdef ( const double x );
 
+  // Number of threads used by the parameter optimization and the ensembles
+  // (default, or a non-positive value: 1, sequential build)
+  DLL_API void set_nb_threads ( const int nb_threads );
+  DLL_API int  get_nb_threads ( void );
+
+  // Run task(w) for w = 0,...,nb_tasks-1 on nb_tasks threads (task 0 runs on the
+  // calling thread, the others on a persistent pool of worker threads).
+  // The first exception thrown by a task is rethrown.
+  // Inside the tasks, get_nb_threads() returns 1 (no nested parallelism).
+  DLL_API void parallel_run ( const int nb_tasks , const std::function<void(int)> & task );
+
   // rounding:
   int round ( double d );
   double rceil (double d);
@@ -25,6 +25,7 @@
 
 #include "Tests.hpp"
 #include "Surrogate_Ensemble.hpp"
+#include "Linear_Algebra.hpp"
 
 void SGTELIB::sand_box (void){
 
@@ -1497,6 +1498,97 @@ SGTELIB::Matrix SGTELIB::test_functions_1D (const SGTELIB::Matrix & T, const int
 }//
 
 
+/*----------------------------------------------------*/
+/*       TEST linear algebra                          */
+/*----------------------------------------------------*/
+// Relative residuals of the products and factorizations, with the in-tree
+// kernels and with the backend (if any). Throws if a residual is too large.
+std::string SGTELIB::test_linear_algebra ( void ){
+
+  std::cout << "======================================================\n";
+  std::cout << "SGTELIB::test_linear_algebra (backend: " << SGTELIB::linalg::backend_name() << ")\n";
+
+  const double tol = 1e-10;
+  const bool enabled = SGTELIB::linalg::backend_enabled();
+  std::ostringstream oss;
+  oss << "test_linear_algebra\n";
+  oss << "  backend|   n|       product|      cholesky|            lu|           svd|\n";
+  oss << "---------|----|--------------|--------------|--------------|--------------|\n";
+
+  bool error = false;
+  for (int b = 0 ; b < 2 ; b++){
+    const bool use_backend = (b==1);
+    if (use_backend && ! SGTELIB::linalg::has_backend()) continue;
+    SGTELIB::linalg::backend_enabled() = use_backend;
+
+    for (const int n : {10,40,120}){
+      // Random A (2n x n) and B (n x n), S = A'*A + n*I is SPD
+      SGTELIB::Matrix A ("A",2*n,n);
+      SGTELIB::Matrix B ("B",n,n);
+      A.set_random(-1,+1,false);
+      B.set_random(-1,+1,false);
+      SGTELIB::Matrix S = SGTELIB::Matrix::transposeA_product(A,A) + SGTELIB::Matrix::identity(n)*double(n);
+
+      // Product, against the plain triple loop
+      SGTELIB::Matrix C = SGTELIB::Matrix::product(A,B);
+      SGTELIB::Matrix Cref ("Cref",2*n,n);
+      for (int i=0 ; i<2*n ; i++)
+        for (int j=0 ; j<n ; j++){
+          double v = 0;
+          for (int k=0 ; k<n ; k++) v += A.get(i,k)*B.get(k,j);
+          Cref.set(i,j,v);
+        }
+      const double e_product = (C-Cref).norm()/Cref.norm();
+
+      // Cholesky: S = L*L'
+      SGTELIB::Matrix L;
+      double e_cholesky = SGTELIB::INF;
+      if (S.cholesky_factor(L)){
+        e_cholesky = (SGTELIB::Matrix::transposeB_product(L,L)-S).norm()/S.norm();
+      }
+
+      // LU: solve B*x = b
+      SGTELIB::Matrix LU;
+      std::vector<int> P;
+      double e_lu = SGTELIB::INF;
+      if (B.lu_factor(LU,P)){
+        SGTELIB::Matrix x ("x",n,1);
+        x.set_random(-1,+1,false);
+        const SGTELIB::Matrix y = SGTELIB::Matrix::lu_factor_solve(LU,P,SGTELIB::Matrix::product(B,x));
+        e_lu = (y-x).norm()/x.norm();
+      }
+
+      // SVD: A = U*W*V'
+      SGTELIB::Matrix U ("U",2*n,n), W ("W",n,n), V ("V",n,n);
+      std::string error_msg;
+      double e_svd = SGTELIB::INF;
+      if (A.SVD_decomposition(error_msg,U,W,V,1000000000)){
+        e_svd = (SGTELIB::Matrix::transposeB_product(SGTELIB::Matrix::product(U,W),V)-A).norm()/A.norm();
+      }
+
+      oss.width(9);
+      oss << ((use_backend) ? SGTELIB::linalg::backend_name() : "internal") << "|";
+      oss.width(4);
+      oss << n << "|";
+      for (const double e : {e_product,e_cholesky,e_lu,e_svd}){
+        oss.width(14);
+        oss << e << "|";
+        if ( ! (e<tol) ) error = true;
+      }
+      oss << "\n";
+    }
+  }
+  oss << "---------|----|--------------|--------------|--------------|--------------|\n";
+  SGTELIB::linalg::backend_enabled() = enabled;
+  std::cout << oss.str();
+
+  if (error){
+    throw SGTELIB::Exception ( __FILE__ , __LINE__ ,"test_linear_algebra: residual too large" );
+  }
+  return oss.str();
+}//
+
+
 /*----------------------------------------------------*/
 /*       Check differences between two matrices       */
 /*----------------------------------------------------*/
@@ -52,6 +52,8 @@ namespace SGTELIB {
   // test_singular_data (if there are constant inputs, or outputs or Nan outputs)
   std::string test_singular_data (const std::string & s );
   std::string test_multiple_occurrences (const std::string & s );
+  // test_linear_algebra: residuals of the products and factorizations, for each backend
+  DLL_API std::string test_linear_algebra ( void );
 
   // test_scale: build 2 surrogates with a different scale on the data. 
   DLL_API void test_many_models ( const std::string & out_file , const SGTELIB::Matrix & X0 , const SGTELIB::Matrix & Z0 );
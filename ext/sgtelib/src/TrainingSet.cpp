@@ -24,6 +24,7 @@
 /*-------------------------------------------------------------------------------------*/
 
 #include "TrainingSet.hpp"
+#include <algorithm>
 using namespace SGTELIB;
 
 /*--------------------------------------*/
@@ -67,7 +68,11 @@ SGTELIB::TrainingSet::TrainingSet ( const Matrix & X ,
   _Z_std        ( new double   [_m] ) ,
   _Zs_mean      ( new double   [_m] ) , // Mean of each normalized output
   _Z_nbdiff     ( new int      [_m] ) ,
-_Ds_mean      ( 0.0               ) {
+  _Ds_mean      ( 0.0               ) ,
+  _Ds_sum       ( 0.0               ) ,
+  _cat_embedding( _n                ) ,
+  _p_built      ( 0                 ) ,
+  _build_index  ( 0                 ) {
     
     // Init bounds
     for (int i=0 ; i<_n ; i++){
@@ -127,7 +132,11 @@ SGTELIB::TrainingSet::TrainingSet ( int n, int m  ) :
         _Z_std        ( new double   [_m] ) ,
         _Zs_mean      ( new double   [_m] ) , // Mean of each normalized output
         _Z_nbdiff     ( new int      [_m] ) ,
-        _Ds_mean      ( 0.0               )
+        _Ds_mean      ( 0.0               ) ,
+        _Ds_sum       ( 0.0               ) ,
+        _cat_embedding( _n                ) ,
+        _p_built      ( 0                 ) ,
+        _build_index  ( 0                 )
       {
           
           // No training set sample -> all diff.
@@ -284,6 +293,21 @@ void SGTELIB::TrainingSet::set_bbo_type (const std::string & line){
   _ready = false;
 }//
 
+/*--------------------------------------*/
+/*     Set the categorical embedding    */
+/*--------------------------------------*/
+void SGTELIB::TrainingSet::set_categorical_embedding ( const SGTELIB::Categorical_Embedding & ce ){
+  if (ce.get_input_dim()!=_n){
+    throw Exception ( __FILE__ , __LINE__ ,
+             "TrainingSet::set_categorical_embedding(): dimension error" );
+  }
+  _cat_embedding = ce;
+  // The distances computed so far are not valid anymore:
+  // the next build rescales all the points.
+  _p_built = 0;
+  _ready = false;
+}//
+
 /*--------------------------------------*/
 /*          Construct                   */
 /*--------------------------------------*/
@@ -306,6 +330,10 @@ void SGTELIB::TrainingSet::build ( void ){
       std::cout << "TrainingSet::build BEGIN, X:(" << _p << "," << _n << ") Z:(" << _p << "," << _m << ")\n";
     #endif
 
+    // Number of varying input and output at the previous build
+    const int nvar_old = _nvar;
+    const int mvar_old = _mvar;
+
     // Compute the number of varying input and output
     compute_nbdiff(_X,_X_nbdiff,_nvar);
     compute_nbdiff(_Z,_Z_nbdiff,_mvar);
@@ -331,14 +359,25 @@ void SGTELIB::TrainingSet::build ( void ){
     // Compute bounds over columns of X and Z
     compute_bounds();
 
-    // Compute scaling values
-    compute_scaling();
+    if ( (_p_built>0) && (_p_built<=_p) && keep_scaling(nvar_old,mvar_old) ){
+      // Points were only added since the previous build, and the scaling
+      // is kept: only the new points are scaled, and their distances computed.
+      compute_scaled_matrices(_p_built);
+      compute_Ds(_p_built);
+    }
+    else{
+      // Compute scaling values
+      compute_scaling();
 
-    // Compute scaled matrices
-    compute_scaled_matrices();
+      // Compute scaled matrices
+      compute_scaled_matrices();
 
-    // Build matrix of distances between each pair of points
-    compute_Ds();
+      // Build matrix of distances between each pair of points
+      compute_Ds();
+
+      _build_index++;
+    }
+    _p_built = _p;
 
     // Compute fs_min
     compute_f_min();
@@ -353,7 +392,9 @@ void SGTELIB::TrainingSet::build ( void ){
   }
 
   // _bbo is considered as defined. It can not be modified anymore.
-  _bbo_is_def = true;
+  // (Not written again once set: the surrogates evaluated concurrently by
+  // the parameter optimization call build() on the same training set.)
+  if ( ! _bbo_is_def ) _bbo_is_def = true;
 
 }//
 
@@ -429,6 +470,17 @@ bool SGTELIB::TrainingSet::partial_reset_and_add_points ( const Matrix & Xnew ,
     if ( Xnew.get_nb_cols()!= _n || Znew.get_nb_cols() != _m)
         return false;
 
+    // Most of the time, the new points contain the current ones.
+    // In that case, the current points keep their position and
+    // only the other points are appended.
+    std::list<int> other_rows;
+    if ( _ready && find_points(Xnew,Znew,other_rows) )
+    {
+        if (other_rows.empty())
+            return true;
+        return add_points( Xnew.get_rows(other_rows) , Znew.get_rows(other_rows) );
+    }
+
     _X = Xnew ;
     _Z = Znew;
 
@@ -465,10 +517,62 @@ bool SGTELIB::TrainingSet::partial_reset_and_add_points ( const Matrix & Xnew ,
     _Zs = SGTELIB::Matrix( "TrainingSet._Zs" , _p , _m );
     _Ds = SGTELIB::Matrix( "TrainingSet._Ds" , _p , _p );
 
+    _p_built = 0;
     _ready = false;
     return true;
 }
 
+/*--------------------------------------------------*/
+/*  find the current points among the new points    */
+/*  and list the other rows (in increasing order)   */
+/*--------------------------------------------------*/
+bool SGTELIB::TrainingSet::find_points ( const Matrix & Xnew ,
+                                         const Matrix & Znew ,
+                                         std::list<int> & other_rows ) const {
+
+  const int pnew = Xnew.get_nb_rows();
+  if ( (_p==0) || (pnew<_p) ) return false;
+
+  // Lexicographic comparison of the rows [X Z]
+  auto compare = [this] ( const Matrix & XA , const Matrix & ZA , const int ia ,
+                          const Matrix & XB , const Matrix & ZB , const int ib ) {
+    for ( int j=0 ; j<_n ; j++ ){
+      if (XA.get(ia,j)<XB.get(ib,j)) return -1;
+      if (XA.get(ia,j)>XB.get(ib,j)) return +1;
+    }
+    for ( int j=0 ; j<_m ; j++ ){
+      if (ZA.get(ia,j)<ZB.get(ib,j)) return -1;
+      if (ZA.get(ia,j)>ZB.get(ib,j)) return +1;
+    }
+    return 0;
+  };
+
+  // Sort the new rows
+  std::vector<int> index (pnew);
+  for ( int i=0 ; i<pnew ; i++ ) index[i] = i;
+  std::sort(index.begin(),index.end(),[&](const int i1 , const int i2){
+    return compare(Xnew,Znew,i1,Xnew,Znew,i2)<0;
+  });
+
+  // Look for each current point
+  std::vector<bool> found (pnew,false);
+  for ( int i=0 ; i<_p ; i++ ){
+    auto it = std::lower_bound(index.begin(),index.end(),i,[&](const int inew , const int iold){
+      return compare(Xnew,Znew,inew,_X,_Z,iold)<0;
+    });
+    // Skip the duplicates already found
+    while ( (it!=index.end()) && (compare(Xnew,Znew,*it,_X,_Z,i)==0) && found[*it] ) ++it;
+    if ( (it==index.end()) || (compare(Xnew,Znew,*it,_X,_Z,i)!=0) ) return false;
+    found[*it] = true;
+  }
+
+  other_rows.clear();
+  for ( int i=0 ; i<pnew ; i++ ){
+    if ( ! found[i]) other_rows.push_back(i);
+  }
+  return true;
+}//
+
 /*--------------------------------------*/
 /*                 add_point            */
 /*--------------------------------------*/
@@ -711,17 +815,62 @@ void SGTELIB::TrainingSet::compute_scaling ( void ){
 }//
 
 
+/*---------------------------------------------------*/
+/*  check if the scaling of the points already built */
+/*  can be kept after the addition of new points     */
+/*---------------------------------------------------*/
+bool SGTELIB::TrainingSet::keep_scaling ( const int nvar_old , const int mvar_old ){
+
+  // A variable that becomes varying changes the scaling
+  if ( (_nvar!=nvar_old) || (_mvar!=mvar_old) ) return false;
+
+  // The replacement value of the undefined outputs depends on all the points
+  int i,j;
+  for ( i = 0 ; i < _p_built ; i++ ){
+    for ( j = 0 ; j < _m ; j++ ){
+      if ( ! isdef(_Z.get(i,j))) return false;
+    }
+  }
+
+  // Compute the new scaling, and compare with the current one
+  const std::vector<double> Xa (_X_scaling_a,_X_scaling_a+_n);
+  const std::vector<double> Xb (_X_scaling_b,_X_scaling_b+_n);
+  const std::vector<double> Za (_Z_scaling_a,_Z_scaling_a+_m);
+  const std::vector<double> Zb (_Z_scaling_b,_Z_scaling_b+_m);
+  compute_scaling();
+
+  bool keep = true;
+  for ( j = 0 ; j < _n ; j++ ){
+    if ( (fabs(_X_scaling_a[j]-Xa[j]) > incremental_scaling_tol*fabs(Xa[j])) ||
+         (fabs(_X_scaling_b[j]-Xb[j]) > incremental_scaling_tol) ) keep = false;
+  }
+  for ( j = 0 ; j < _m ; j++ ){
+    if ( (fabs(_Z_scaling_a[j]-Za[j]) > incremental_scaling_tol*fabs(Za[j])) ||
+         (fabs(_Z_scaling_b[j]-Zb[j]) > incremental_scaling_tol) ) keep = false;
+  }
+  if ( ! keep) return false;
+
+  // Restore the current scaling
+  std::copy(Xa.begin(),Xa.end(),_X_scaling_a);
+  std::copy(Xb.begin(),Xb.end(),_X_scaling_b);
+  std::copy(Za.begin(),Za.end(),_Z_scaling_a);
+  std::copy(Zb.begin(),Zb.end(),_Z_scaling_b);
+  return true;
+}//
+
+
 /*---------------------------------------------------*/
 /*  compute scale matrices _Xs and _Zs               */
+/*  (for the points of index i0 and more)            */
 /*---------------------------------------------------*/
-void SGTELIB::TrainingSet::compute_scaled_matrices ( void ){
+void SGTELIB::TrainingSet::compute_scaled_matrices ( const int i0 ){
 
   double v, mu;
   int i,j;
 
   // Compute _Xs
   for ( j = 0 ; j < _n ; j++ ){
-    for ( i = 0 ; i < _p ; i++ ){
+    for ( i = i0 ; i < _p ; i++ ){
       v = _X.get(i,j)*_X_scaling_a[j]+_X_scaling_b[j];
       _Xs.set(i,j,v);
     }
@@ -729,16 +878,16 @@ void SGTELIB::TrainingSet::compute_scaled_matrices ( void ){
 
   // Compute _Zs and Mean_Zs
   for ( j = 0 ; j < _m ; j++ ){
-    mu = 0;
-    for ( i = 0 ; i < _p ; i++ ){
+    for ( i = i0 ; i < _p ; i++ ){
       v = _Z.get(i,j);
       if ( ! isdef(v)){
         v = _Z_replace[j];
       }
       v = v*_Z_scaling_a[j]+_Z_scaling_b[j];
-      mu +=v;
       _Zs.set(i,j,v);
     }
+    mu = 0;
+    for ( i = 0 ; i < _p ; i++ ) mu += _Zs.get(i,j);
     _Zs_mean[j] = mu/_p;
   }
 
@@ -748,18 +897,20 @@ void SGTELIB::TrainingSet::compute_scaled_matrices ( void ){
 
 /*---------------------------------------------------*/
 /*  compute distance matrix                          */
-/*  the columns of a matrix                          */
+/*  (rows and columns of index i0 and more)          */
 /*---------------------------------------------------*/
-void SGTELIB::TrainingSet::compute_Ds ( void ){
+void SGTELIB::TrainingSet::compute_Ds ( const int i0 ){
   double d;
   double di1i2;
-  _pvar = _p;
-  _Ds_mean = 0.0;
+  if (i0==0){
+    _pvar = 0;
+    _Ds_sum = 0.0;
+  }
   bool unique;
-  for ( int i1 = 0 ; i1 < _p-1 ; i1++ ){
-    _Ds.set(i1,i1,0.0);
+  for ( int i2 = i0 ; i2 < _p ; i2++ ){
+    _Ds.set(i2,i2,0.0);
     unique = true;
-    for ( int i2 = i1+1 ; i2 < _p ; i2++ ){
+    for ( int i1 = 0 ; i1 < i2 ; i1++ ){
       d = 0;
       for ( int j = 0 ; j < _n ; j++ ){
         di1i2 = _Xs.get(i1,j)-_Xs.get(i2,j);
@@ -769,17 +920,17 @@ void SGTELIB::TrainingSet::compute_Ds ( void ){
       _Ds.set(i1,i2,d);
       _Ds.set(i2,i1,d);
       // Compute the mean distance between the points
-      _Ds_mean += d;
+      _Ds_sum += d;
       // If d==0, then the point i2 is not unique.
       if (fabs(d)<EPSILON){
         unique = false;
       }
     }
-    // If there are some points equal to the point of index i2,
-    // then reduce the number of different points.
-    if ( ! unique) _pvar--;
+    // Count only the points that are different from
+    // all the points of lower index.
+    if (unique) _pvar++;
   }
-  _Ds_mean /= double(_pvar*(_pvar-1)/2);
+  _Ds_mean = _Ds_sum/double(_pvar*(_pvar-1)/2);
 
 }//
 
@@ -971,72 +1122,140 @@ Matrix SGTELIB::TrainingSet::get_distances ( const Matrix & A ,
       return Matrix::get_distances_norminf(A,B);
 
     case DISTANCE_NORM2_IS0:
-      // Two points x and y are in the same "IS0-class" if (x_j==0 <=> y_j==0 for each j).
-      // The distance "IS0" between two points of the same IS0-class is the norm 2 distance.
-      // The distance "IS0" between two points of different IS0-class is INF.
+    case DISTANCE_NORM2_CAT:
       {
-        const int n = A.get_nb_cols();
-        const int pa = A.get_nb_rows();
-        const int pb = B.get_nb_rows();
-        double v,d;
-        int ia, ib, j;
         Matrix D = Matrix::get_distances_norm2(A,B);
-        double * x0 = new double [n];
-        for (j=0 ; j < n ; j++){
-          x0[j] = X_scale( 0.0 , j );
-        }
-        for (ia=0 ; ia < pa ; ia++){
-          for (ib=0 ; ib < pb ; ib++){
-            // For each value of D
-            d = D.get(ia,ib);
-            v = d*d;
-            for (j=0 ; j < n ; j++){
-              // If they are not in the same 0-class
-              if (  (fabs(A.get(ia,j)-x0[j])<EPSILON) ^ (fabs(B.get(ib,j)-x0[j])<EPSILON)  ){
-                v+=10000;
-              }
-            }
-            v = sqrt(v);
-            D.set(ia,ib,v);
-          }
-        }
-        delete [] x0;
+        add_class_penalty(D,A,B,dt);
         return D;
       }
 
+    case DISTANCE_NORM2_EMB:
+      if (_cat_embedding.get_nb_categorical()==0){
+        bool unit_weights = true;
+        for (int j=0 ; j<_n ; j++) unit_weights &= (_cat_embedding.get_weight(j)==1.0);
+        if (unit_weights) return Matrix::get_distances_norm2(A,B);
+      }
+      if (&A==&B){
+        const Matrix EA = embed(A);
+        return Matrix::get_distances_norm2(EA,EA);
+      }
+      return Matrix::get_distances_norm2(embed(A),embed(B));
+
+    default:
+      throw Exception ( __FILE__ , __LINE__ ,"Undefined type" );
+  }
+
+
+
+}//
+
+
+/*--------------------------------------------------*/
+/* distances between the points of the training set */
+/*--------------------------------------------------*/
+// The norm 2 distances are those of _Ds, computed once per build (and
+// updated when points are appended), so that they are shared by all the
+// surrogates built on the training set.
+Matrix SGTELIB::TrainingSet::get_distances ( const distance_t dt ) const{
+  check_ready();
+
+  switch (dt){
+
+    case DISTANCE_NORM2:
+      return _Ds;
+
+    case DISTANCE_NORM2_IS0:
     case DISTANCE_NORM2_CAT:
-      // Two points x and y are in the same "X0-class" if x_0==y_0.
-      // The distance "IS0" between two points of the same X0-class is the norm 2 distance.
-      // The distance "IS0" between two points of different X0-class is INF.
       {
-        const int pa = A.get_nb_rows();
-        const int pb = B.get_nb_rows();
-        double v,d;
-        int ia, ib, j;
-        Matrix D = Matrix::get_distances_norm2(A,B);
-        j = 0;
-        for (ib=0 ; ib < pb ; ib++){
-          for (ia=0 ; ia < pa ; ia++){
-            // For each value of D
-            d = D.get(ia,ib);
-            v = d*d;
-            // If they are not in the same 0-class
-            if (  fabs(A.get(ia,j)-B.get(ib,j))>EPSILON  ) {
-              v+=10000;
-            }
-            v = sqrt(v);
-            D.set(ia,ib,v);
-          }
-        }
+        Matrix D (_Ds);
+        add_class_penalty(D,_Xs,_Xs,dt);
         return D;
       }
 
     default:
-      throw Exception ( __FILE__ , __LINE__ ,"Undefined type" );
+      return get_distances(_Xs,_Xs,dt);
+  }
+
+}//
+
+
+/*--------------------------------------------------*/
+/* add the class penalty of the IS0 and CAT         */
+/* distances to the norm 2 distances D of (A,B)     */
+/*--------------------------------------------------*/
+void SGTELIB::TrainingSet::add_class_penalty ( Matrix & D ,
+                                               const Matrix & A ,
+                                               const Matrix & B ,
+                                               const distance_t dt ) const{
+
+  const int n = A.get_nb_cols();
+  const int pa = A.get_nb_rows();
+  const int pb = B.get_nb_rows();
+  double v,d;
+  int ia, ib, j;
+
+  if (dt==DISTANCE_NORM2_IS0){
+    // Two points x and y are in the same "IS0-class" if (x_j==0 <=> y_j==0 for each j).
+    // The distance "IS0" between two points of the same IS0-class is the norm 2 distance.
+    // The distance "IS0" between two points of different IS0-class is INF.
+    double * x0 = new double [n];
+    for (j=0 ; j < n ; j++){
+      x0[j] = X_scale( 0.0 , j );
+    }
+    for (ia=0 ; ia < pa ; ia++){
+      for (ib=0 ; ib < pb ; ib++){
+        // For each value of D
+        d = D.get(ia,ib);
+        v = d*d;
+        for (j=0 ; j < n ; j++){
+          // If they are not in the same 0-class
+          if (  (fabs(A.get(ia,j)-x0[j])<EPSILON) ^ (fabs(B.get(ib,j)-x0[j])<EPSILON)  ){
+            v+=10000;
+          }
+        }
+        v = sqrt(v);
+        D.set(ia,ib,v);
+      }
+    }
+    delete [] x0;
+  }
+  else if (dt==DISTANCE_NORM2_CAT){
+    // Two points x and y are in the same "X0-class" if x_0==y_0.
+    // The distance "IS0" between two points of the same X0-class is the norm 2 distance.
+    // The distance "IS0" between two points of different X0-class is INF.
+    j = 0;
+    for (ib=0 ; ib < pb ; ib++){
+      for (ia=0 ; ia < pa ; ia++){
+        // For each value of D
+        d = D.get(ia,ib);
+        v = d*d;
+        // If they are not in the same 0-class
+        if (  fabs(A.get(ia,j)-B.get(ib,j))>EPSILON  ) {
+          v+=10000;
+        }
+        v = sqrt(v);
+        D.set(ia,ib,v);
+      }
+    }
   }
 
+}//
 
 
+/*--------------------------------------------------*/
+/* embedded points of the distance NORM2_EMB        */
+/*--------------------------------------------------*/
+Matrix SGTELIB::TrainingSet::embed ( const Matrix & As ) const{
+  // The categories are read on the unscaled points
+  Matrix C (As);
+  const int p = As.get_nb_rows();
+  for (int j=0 ; j<_n ; j++){
+    if ( ! _cat_embedding.is_categorical(j)) continue;
+    for (int i=0 ; i<p ; i++){
+      C.set(i,j,X_unscale(As.get(i,j),j));
+    }
+  }
+  return _cat_embedding.embed(As,C);
 }//
 
 
@@ -1114,7 +1333,7 @@ double SGTELIB::TrainingSet::ZE_unscale ( double w , int j ) const {
 /*--------------------------------------*/
 /*    X scale: x->y: y = a.x + b        */
 /*--------------------------------------*/
-void SGTELIB::TrainingSet::X_scale ( Matrix & X ) {
+void SGTELIB::TrainingSet::X_scale ( Matrix & X ) const {
   int p = X.get_nb_rows();
   int n = X.get_nb_cols();
   if (n!=_n){
@@ -1136,7 +1355,7 @@ void SGTELIB::TrainingSet::X_scale ( Matrix & X ) {
 /*--------------------------------------*/
 /*    Z unscale: w->z: z = (w-b)/a      */
 /*--------------------------------------*/
-void SGTELIB::TrainingSet::Z_unscale ( Matrix * Z ) {
+void SGTELIB::TrainingSet::Z_unscale ( Matrix * Z ) const {
   int p = Z->get_nb_rows();
   int m = Z->get_nb_cols();
   if (m!=_m){
@@ -1154,7 +1373,7 @@ void SGTELIB::TrainingSet::Z_unscale ( Matrix * Z ) {
     }
   }
 }//
-Matrix SGTELIB::TrainingSet::Z_unscale ( const Matrix & Z ) {
+Matrix SGTELIB::TrainingSet::Z_unscale ( const Matrix & Z ) const {
   Matrix Z2 (Z);
   Z_unscale(&Z2);
   return Z2;
@@ -1163,7 +1382,7 @@ Matrix SGTELIB::TrainingSet::Z_unscale ( const Matrix & Z ) {
 /*--------------------------------------*/
 /*    ZE unscale: w->z: z = w/a      */
 /*--------------------------------------*/
-void SGTELIB::TrainingSet::ZE_unscale ( Matrix * ZE ) {
+void SGTELIB::TrainingSet::ZE_unscale ( Matrix * ZE ) const {
   int p = ZE->get_nb_rows();
   int m = ZE->get_nb_cols();
   if (m!=_m){
@@ -1181,7 +1400,7 @@ void SGTELIB::TrainingSet::ZE_unscale ( Matrix * ZE ) {
     }
   }
 }//
-Matrix SGTELIB::TrainingSet::ZE_unscale ( const Matrix & ZE ) {
+Matrix SGTELIB::TrainingSet::ZE_unscale ( const Matrix & ZE ) const {
   Matrix ZE2 (ZE);
   ZE_unscale(&ZE2);
   return ZE2;
@@ -28,6 +28,7 @@
 
 #include "Matrix.hpp"
 #include "Defines.hpp"
+#include "Categorical_Embedding.hpp"
 namespace SGTELIB {
 
   /*--------------------------------------*/
@@ -94,6 +95,14 @@ namespace SGTELIB {
 
     // Mean distance between points 
     double _Ds_mean;
+    double _Ds_sum;
+
+    // Mixed variables (used by the distance NORM2_EMB)
+    SGTELIB::Categorical_Embedding _cat_embedding;
+
+    // Incremental build
+    int _p_built; // Nb of points already scaled, with their distances computed
+    int _build_index; // Incremented each time all the points are scaled
 
     // private affectation operator:
     TrainingSet & operator = ( const TrainingSet & );
@@ -108,8 +117,17 @@ namespace SGTELIB {
     void compute_mean_std        (void);
     void compute_nvar_mvar       (void);
     void compute_scaling         (void);
-    void compute_Ds              (void);
-    void compute_scaled_matrices (void);
+    bool keep_scaling            (const int nvar_old , const int mvar_old);
+    void compute_Ds              (const int i0 = 0);
+    void add_class_penalty       ( SGTELIB::Matrix & D ,
+                                   const SGTELIB::Matrix & A ,
+                                   const SGTELIB::Matrix & B ,
+                                   const distance_t dt ) const;
+    SGTELIB::Matrix embed        ( const SGTELIB::Matrix & As ) const;
+    void compute_scaled_matrices (const int i0 = 0);
+    bool find_points             (const SGTELIB::Matrix & Xnew ,
+                                  const SGTELIB::Matrix & Znew ,
+                                  std::list<int> & other_rows ) const;
     void compute_f_min           (void);
     bool check_singular_data     (void);
 
@@ -132,6 +150,10 @@ namespace SGTELIB {
     // Define the bbo types
     void set_bbo_type (const std::string & s);
 
+    // Define the categorical variables, their embeddings and the variable weights
+    void set_categorical_embedding ( const SGTELIB::Categorical_Embedding & ce );
+    const SGTELIB::Categorical_Embedding & get_categorical_embedding ( void ) const { return _cat_embedding; };
+
     // construct/process the data of the TrainingSet
     void build ( void );
 
@@ -165,11 +187,11 @@ namespace SGTELIB {
     double Z_unscale    ( double w , int output_index ) const;
     double ZE_unscale   ( double w , int output_index ) const;
 
-    void   X_scale      ( SGTELIB::Matrix &X);
-    void   Z_unscale    ( SGTELIB::Matrix *Z);
-    void   ZE_unscale   ( SGTELIB::Matrix *ZE);
-    SGTELIB::Matrix Z_unscale  ( const SGTELIB::Matrix & Z  );
-    SGTELIB::Matrix ZE_unscale ( const SGTELIB::Matrix & ZE );
+    void   X_scale      ( SGTELIB::Matrix &X) const;
+    void   Z_unscale    ( SGTELIB::Matrix *Z) const;
+    void   ZE_unscale   ( SGTELIB::Matrix *ZE) const;
+    SGTELIB::Matrix Z_unscale  ( const SGTELIB::Matrix & Z  ) const;
+    SGTELIB::Matrix ZE_unscale ( const SGTELIB::Matrix & ZE ) const;
 
     // Get data
     double get_Xs       ( const int i , const int j ) const;
@@ -188,6 +210,8 @@ namespace SGTELIB {
     SGTELIB::Matrix get_distances ( const SGTELIB::Matrix & A ,
                                     const SGTELIB::Matrix & B , 
                                     const distance_t dt = SGTELIB::DISTANCE_NORM2 ) const;
+    // Distances between the (scaled) points of the training set
+    SGTELIB::Matrix get_distances ( const distance_t dt ) const;
 
     double get_d1_over_d2 ( const SGTELIB::Matrix & XXs ) const;
     double get_d1         ( const SGTELIB::Matrix & XXs ) const;
@@ -208,6 +232,9 @@ namespace SGTELIB {
     int    get_i_min       ( void ) const { check_ready(); return _i_min;  };
     double get_Ds_mean     ( void ) const { check_ready(); return _Ds_mean; };
     int    get_j_obj       ( void ) const { check_ready(); return _j_obj; };
+    // Index of the last build that scaled all the points. Between two such
+    // builds, the points are only appended to _Xs, _Zs and _Ds.
+    int    get_build_index ( void ) const { check_ready(); return _build_index; };
     //double get_Ds_min      ( void ) const ;
 
     SGTELIB::bbo_t get_bbo ( int j) const { check_ready(); return _bbo[j]; };
@@ -25,6 +25,7 @@
 #include "sgtelib.hpp"
 #include "Surrogate_Factory.hpp"
 #include "Surrogate_Utils.hpp"
+#include <cstdio>
 #include <fstream>
 #include <string>
 using namespace SGTELIB;
@@ -76,6 +77,8 @@ int main ( int argc , char ** argv ) {
   //============================================
   keyword.push_back("-model");
   keyword.push_back("-verbose");
+  keyword.push_back("-socket");
+  keyword.push_back("-pipe");
   const int NKW = static_cast<int>(keyword.size());
   // Create empty strings to store the information following each keyword.
   std::vector<std::string> info;
@@ -113,12 +116,20 @@ int main ( int argc , char ** argv ) {
  //============================================ 
   // help
   //============================================ 
+  // pipe (stdout is then reserved for the server answers)
+  bool pipe=false;
+  for (i=0 ; i<NKW ; i++) {
+    if (!strcmp(keyword.at(i).c_str(),"-pipe")) break;
+  }
+  if (info.at(i).size()){
+    pipe = true;
+  }
   bool verbose=false;
   for (i=0 ; i<NKW ; i++) {
     if (!strcmp(keyword.at(i).c_str(),"-verbose")) break;
   }
   if (info.at(i).size()){
-    std::cout << "verbose mode\n";
+    ((pipe)?std::cerr:std::cout) << "verbose mode\n";
     verbose = true;
   }
 
@@ -196,8 +207,24 @@ int main ( int argc , char ** argv ) {
   // server
   //============================================ 
   if (!strcmp(action.c_str(),"-server")){
-    std::cout << "model: " << model << "\n";
-    SGTELIB::sgtelib_server(model,verbose);
+    for (i=0 ; i<NKW ; i++) {
+      if (!strcmp(keyword.at(i).c_str(),"-socket")) break;
+    }
+    if (info.at(i).size()){
+      // Binary protocol on a Unix domain socket
+      std::cout << "model: " << model << "\n";
+      SGTELIB::sgtelib_server_socket(model,info.at(i),verbose);
+    }
+    else if (pipe){
+      // Binary protocol on stdin/stdout (nothing else must be written on stdout)
+      std::cerr << "model: " << model << "\n";
+      SGTELIB::sgtelib_server_pipe(model,verbose);
+    }
+    else{
+      // Flag files (Matlab interface)
+      std::cout << "model: " << model << "\n";
+      SGTELIB::sgtelib_server(model,verbose);
+    }
   }
 
   //============================================ 
@@ -380,6 +407,28 @@ void SGTELIB::sgtelib_best( const std::string & file_list , const bool verbose){
 }//
 
 
+/*--------------------------------------*/
+/*   flag files of the sgtelib server   */
+/*--------------------------------------*/
+// The flags are handled with rename/remove, without spawning a shell.
+static void touch_file ( const std::string & file ){
+  std::ofstream out (file.c_str(),std::ios::app);
+}//
+
+static void remove_flag_files ( void ){
+  const char * actions[] = {"new_data","predict","cv","metric","info","reset"};
+  const char * states [] = {"create","transmit","received","finished"};
+  for (const char * a : actions){
+    for (const char * s : states){
+      std::remove((std::string("flag_")+a+"_"+s).c_str());
+    }
+  }
+  std::remove("flag_ping");
+  std::remove("flag_pong");
+  std::remove("flag_quit");
+  std::remove("flag_not_ready");
+}//
+
 /*--------------------------------------*/
 /*           sgtelib server             */
 /*--------------------------------------*/
@@ -388,14 +437,13 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
   SGTELIB::TrainingSet * TS = NULL;
   SGTELIB::Surrogate * S = NULL;
   SGTELIB::Matrix X, Z, std, ei, cdf;
-  std::string dummy_str;
 
   std::cout << "========== SERVER ==========================\n";  
 
 
   std::cout << "Start server\n";
   std::cout << "Remove all flag files...\n";
-  dummy_str = system("rm flag_* 2>/dev/null");
+  remove_flag_files();
   std::cout << "Ok.\n";
 
   int dummy_k = 0;
@@ -416,7 +464,7 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
       //------------------------------
       std::cout << "============flag: new_data===================\n";
       dummy_k = 0;
-      dummy_str = system("mv flag_new_data_transmit flag_new_data_received");
+      std::rename("flag_new_data_transmit","flag_new_data_received");
       if (display) std::cout << "Read new data";
       X = SGTELIB::Matrix("new_data_x.txt");
       Z = SGTELIB::Matrix("new_data_z.txt");
@@ -429,13 +477,14 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
         TS = new SGTELIB::TrainingSet(X,Z);
         S = Surrogate_Factory(*TS,model);
         m = TS->get_output_dim();
-        dummy_str = system("rm -f flag_not_ready");
+        std::remove("flag_not_ready");
       }
       else{
         if (display) std::cout << "Add points to TS\n";
         TS->add_points(X,Z);
       }
-      dummy_str = system("rm new_data_x.txt new_data_z.txt");
+      std::remove("new_data_x.txt");
+      std::remove("new_data_z.txt");
       if (display) std::cout << "Waiting...\n";
 
     }
@@ -444,7 +493,7 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
       // PREDICT
       //------------------------------
       std::cout << "============flag: predict==================" << dummy_k++ << "\n";
-      dummy_str = system("mv flag_predict_transmit flag_predict_received");
+      std::rename("flag_predict_transmit","flag_predict_received");
 
       bool ready = false;
       if (S){
@@ -471,7 +520,7 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
       }
       else{
         if (display) std::cout << "Surrogate not ready\n";
-        dummy_str = system("touch flag_not_ready");
+        touch_file("flag_not_ready");
         Z.fill(+SGTELIB::INF);
       }
       
@@ -493,7 +542,7 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
       out.close(); 
 
       // Change flag
-      dummy_str = system("mv flag_predict_received flag_predict_finished");
+      std::rename("flag_predict_received","flag_predict_finished");
       if (display) std::cout << "Waiting...\n";
 
     }
@@ -502,13 +551,13 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
       // CV values
       //------------------------------
       std::cout << "============flag: cv values==================" << dummy_k++ << "\n";
-      dummy_str = system("mv flag_cv_transmit flag_cv_received");
+      std::rename("flag_cv_transmit","flag_cv_received");
 
       bool ready = false;
       if (S) ready = S->build();      
       if ( ! ready){
         if (display) std::cout << "Surrogate not ready\n";
-        dummy_str = system("touch flag_not_ready");
+        touch_file("flag_not_ready");
       }
       else{
         S->display(std::cout);
@@ -523,7 +572,7 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
       }
       else{
         if (display) std::cout << "Surrogate not ready\n";
-        dummy_str = system("touch flag_not_ready");
+        touch_file("flag_not_ready");
       }
       
       // Open stream and write matrices
@@ -544,7 +593,7 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
       out.close(); 
 
       // Change flag
-      dummy_str = system("mv flag_cv_received flag_cv_finished");
+      std::rename("flag_cv_received","flag_cv_finished");
       if (display) std::cout << "Waiting...\n";
 
     }
@@ -554,13 +603,13 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
       //------------------------------
 
       std::cout << "============flag: metric===================" << dummy_k++ << "\n";
-      dummy_str = system("mv flag_metric_transmit flag_metric_received");
+      std::rename("flag_metric_transmit","flag_metric_received");
 
       bool ready = false;
       if (S) ready = S->build();      
       if ( ! ready){
         if (display) std::cout << "Surrogate not ready\n";
-        dummy_str = system("touch flag_not_ready");
+        touch_file("flag_not_ready");
       }
 
 
@@ -593,7 +642,7 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
       out.close(); 
 
       // Change flag
-      dummy_str = system("mv flag_metric_received flag_metric_finished");
+      std::rename("flag_metric_received","flag_metric_finished");
       if (display) std::cout << "Waiting...\n";
 
     }
@@ -603,20 +652,20 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
       //------------------------------
 
       std::cout << "============flag: info===================" << dummy_k++ << "\n";
-      dummy_str = system("mv flag_info_transmit flag_info_received");
+      std::rename("flag_info_transmit","flag_info_received");
 
       bool ready = false;
       if (S) ready = S->build();      
       if ( ! ready){
         if (display) std::cout << "Surrogate not ready\n";
-        dummy_str = system("touch flag_not_ready");
+        touch_file("flag_not_ready");
       }
 
       // Open stream and write metric
       if (ready) S->display(std::cout);
       else std::cout << "Not ready.";
       // Change flag
-      dummy_str = system("mv flag_info_received flag_info_finished");
+      std::rename("flag_info_received","flag_info_finished");
       if (display) std::cout << "Waiting...\n";
 
     }
@@ -626,7 +675,7 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
       //------------------------------
 
       std::cout << "============flag: reset======================" << "\n";
-      dummy_str = system("mv flag_reset_transmit flag_reset_received");
+      std::rename("flag_reset_transmit","flag_reset_received");
 
       surrogate_delete(S);
       delete TS;
@@ -636,7 +685,7 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
       if (display) std::cout << "Pointers: S=" << S << ", TS=" << TS << "\n";
 
       // Change flag
-      dummy_str = system("mv flag_reset_received flag_reset_finished");
+      std::rename("flag_reset_received","flag_reset_finished");
       if (display) std::cout << "Waiting...\n";
 
     }
@@ -654,14 +703,14 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
       }
       if (ready){  
         std::cout << "pong: Model is ready.\n";
-        dummy_str = system("echo 1 >> flag_ping");
+        std::ofstream("flag_ping",std::ios::app) << "1\n";
       }
       else{
         std::cout << "pong: Model is not ready.\n";
-        dummy_str = system("echo 0 >> flag_ping");
+        std::ofstream("flag_ping",std::ios::app) << "0\n";
       }
       // Send an answer!
-      dummy_str = system("mv flag_ping flag_pong");
+      std::rename("flag_ping","flag_pong");
     }
     else if (SGTELIB::exists("flag_quit")){
       //------------------------------
@@ -669,7 +718,7 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
       //------------------------------
       surrogate_delete(S);
       delete TS;
-      dummy_str = system("rm flag_quit");
+      std::remove("flag_quit");
       std::cout << "flag: quit\n";
       break;
     }
@@ -677,7 +726,7 @@ void SGTELIB::sgtelib_server( const std::string & model , const bool verbose ){
   }
 
   std::cout << "Remove all flag files...";
-  dummy_str = system("rm    flag_* 2>/dev/null");
+  remove_flag_files();
   std::cout << "Ok.\n";
 
   std::cout << "Quit server\n";
@@ -757,6 +806,8 @@ void SGTELIB::sgtelib_test( void ){
 
     SGTELIB::sand_box();
 
+    SGTELIB::test_linear_algebra();
+
     SGTELIB::Matrix X0;
     SGTELIB::Matrix Z0;
 
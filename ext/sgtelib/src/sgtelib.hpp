@@ -34,6 +34,10 @@
 #include "Defines.hpp"
 #include "Surrogate_Utils.hpp"
 #include "sgtelib_help.hpp"
+#include "Server.hpp"
+#include "Categorical_Embedding.hpp"
+#include "Quadratic_Form.hpp"
+#include "Linear_Algebra.hpp"
 
 namespace SGTELIB {
   void sgtelib_server ( const std::string & model , const bool verbose );
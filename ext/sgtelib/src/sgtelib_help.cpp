@@ -59,6 +59,8 @@ std::string ** SGTELIB::get_help_data (void){
 " * -server: starts a server that can be interrogated to perform predictions or compute the error metric of a model. The server should be used via the Matlab interface (see SERVER). This requires the definition of a model with the option -model, see MODEL. \n"
 "      sgtelib.exe -server -model <model description>\n"
 "      sgtelib.exe -server -model TYPE LOWESS SHAPE_COEF OPTIM\n"
+"   With -socket <path> or -pipe, the server uses a binary protocol on a Unix domain socket or on stdin/stdout (see SERVER).\n"
+"      sgtelib.exe -server -model TYPE PRS -socket /tmp/sgtelib.sock\n"
 " \n"
 " * -best: returns the best type of model for a set of data points\n"
 "      sgtelib.exe -best <x file name> <z file name>\n"
@@ -102,9 +104,15 @@ std::string ** SGTELIB::get_help_data (void){
   HELP_DATA[i][0] = "SERVER";
   HELP_DATA[i][1] = "SERVER MATLAB SGTELIB";
   HELP_DATA[i][2] = "Starts a sgtelib server. See MATLAB_SERVER for more details.\n"
+"By default, the server communicates through flag files in the working directory (Matlab interface).\n"
+"With -socket <path>, the server listens on a Unix domain socket and accepts several clients, which share the same model.\n"
+"With -pipe, the server reads the requests on stdin and writes the answers on stdout.\n"
+"Both use length-prefixed binary frames and accept pipelined requests (see Server.hpp for the protocol).\n"
 " \n"
 "Example\n"
-"      sgtelib.exe -server -model TYPE LOWESS DEGREE 1 KERNEL_SHAPE OPTIM";
+"      sgtelib.exe -server -model TYPE LOWESS DEGREE 1 KERNEL_SHAPE OPTIM\n"
+"      sgtelib.exe -server -model TYPE KRIGING -socket /tmp/sgtelib.sock\n"
+"      sgtelib.exe -server -model TYPE KRIGING -pipe";
   i++;
   //================================
   //      MODEL
@@ -381,6 +389,10 @@ std::string ** SGTELIB::get_help_data (void){
 " * NORMINF: Distance based on norm infty \n"
 " * NORM2_IS0: Tailored distance for discontinuity in 0. \n"
 " * NORM2_CAT: Tailored distance for categorical models. \n"
+" * NORM2_EMB: Weighted norm 2 distance where the categorical variables are \n"
+"   replaced by embedding vectors of their categories. The categorical variables, \n"
+"   the embeddings and the weights are given to the TrainingSet (library only, \n"
+"   see Categorical_Embedding). Without them, this is the NORM2 distance. \n"
 " \n"
 "Default values Default value is NORM2. \n"
 "Example\n"
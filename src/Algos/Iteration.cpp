@@ -20,7 +20,7 @@ void NOMAD::Iteration::init()
     _userCallbackEnabled = false;
     if (nullptr != _runParams)
     {
-        _userCallbackEnabled = _runParams->getAttributeValue<bool>("USER_CALLS_ENABLED");
+        _userCallbackEnabled = _runParams->getSnapshot().USER_CALLS_ENABLED;
     }
 }
 
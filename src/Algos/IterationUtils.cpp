@@ -64,16 +64,16 @@ void NOMAD::IterationUtils::init()
     }
     if (nullptr != search && nullptr != search->getRunParams())
     {
-        _projectOnMesh = search->getRunParams()->getAttributeValue<bool>("SEARCH_METHOD_MESH_PROJECTION");
+        _projectOnMesh = search->getRunParams()->getSnapshot().SEARCH_METHOD_MESH_PROJECTION;
     }
     
     auto runParams = _parentStep->getRunParams();
     _frameCenterUseCache = false;
     if (nullptr != runParams )
     {
-        _frameCenterUseCache = _parentStep->getRunParams()->getAttributeValue<bool>("FRAME_CENTER_USE_CACHE");
+        _frameCenterUseCache = _parentStep->getRunParams()->getSnapshot().FRAME_CENTER_USE_CACHE;
     
-        _pointPrecisionFull = _parentStep->getPbParams()->getAttributeValue<NOMAD::ArrayOfDouble>("POINT_FORMAT");
+        _pointPrecisionFull = _parentStep->getPbParams()->getSnapshot().POINT_FORMAT;
     }
 
 }
@@ -503,13 +503,7 @@ void NOMAD::IterationUtils::generateTrialPoints()
     }
     
     // Update counters of generated trial points
-    auto evc = NOMAD::EvcInterface::getEvaluatorControl();
-    auto evalType = NOMAD::EvalType::BB;
-    if (nullptr != evc)
-    {
-        evalType = evc->getCurrentEvalType();
-    }
-    _trialPointStats.incrementTrialPointsGenerated(_trialPoints.size(), evalType);
+    _trialPointStats.incrementTrialPointsGenerated(_trialPoints.size(), getTrialPointsEvalType());
 }
 
 void NOMAD::IterationUtils::generateTrialPointsSecondPass()
@@ -519,13 +513,25 @@ void NOMAD::IterationUtils::generateTrialPointsSecondPass()
     generateTrialPointsSecondPassImp();
     
     // Update counters of generated trial points
+    _trialPointStats.incrementTrialPointsGenerated(_trialPoints.size(), getTrialPointsEvalType());
+}
+
+
+NOMAD::EvalType NOMAD::IterationUtils::getTrialPointsEvalType() const
+{
+    if (NOMAD::EvalType::UNDEFINED != _trialPointsEvalType)
+    {
+        return _trialPointsEvalType;
+    }
+
+    // Trial points can be generated by a worker thread (concurrent simple Mads of a multi-start quad model search).
+    // Such a thread has no evaluator control info: the eval type must be set by the parent step (setTrialPointsEvalType).
     auto evc = NOMAD::EvcInterface::getEvaluatorControl();
-    auto evalType = NOMAD::EvalType::BB;
-    if (nullptr != evc)
+    if (nullptr == evc || !evc->isMainThread(NOMAD::getThreadNum()))
     {
-        evalType = evc->getCurrentEvalType();
+        return NOMAD::EvalType::BB;
     }
-    _trialPointStats.incrementTrialPointsGenerated(_trialPoints.size(), evalType);
+    return evc->getCurrentEvalType();
 }
 
 
@@ -81,6 +81,12 @@ private:
      Used when evaluating trial points without mesh and frame center.
      */
     bool _fromAlgo;
+
+    /**
+     Eval type used to count the generated trial points.
+     Undefined: the current eval type of the evaluator control is used.
+     */
+    EvalType _trialPointsEvalType;
     
 public:
     /// Constructor
@@ -96,7 +102,8 @@ public:
         _trialPointStats( parentStep ),
         _fromAlgo(false),
         _updateIncumbentsAndHMax(true),
-        _projectOnMesh(true)
+        _projectOnMesh(true),
+        _trialPointsEvalType(EvalType::UNDEFINED)
     {
         init();
     }
@@ -117,6 +124,9 @@ public:
 
     size_t getTrialPointsCount() const              { return _trialPoints.size(); }
     const EvalPointSet& getTrialPoints() const      { return _trialPoints; }
+
+    /// Set the eval type used to count the generated trial points. Needed when trial points are generated by a worker thread.
+    void setTrialPointsEvalType(const EvalType evalType) { _trialPointsEvalType = evalType; }
     
     
     /*---------------*/
@@ -230,6 +240,9 @@ private:
     /// Helper for constructor
     void init();
 
+    /// Helper for generateTrialPoints and generateTrialPointsSecondPass: eval type of the trial points counters
+    EvalType getTrialPointsEvalType() const;
+
     
     /// Helper to update stopReason
     void updateStopReasonForIterStop(const Step* step);
@@ -13,8 +13,8 @@ private:
     bool _isEnabled = false;
     
 #ifdef TIME_STATS
-    DLL_ALGO_API static std::vector<double> _extendedPollTime;        ///< Total time spent running each extended poll
-    DLL_ALGO_API static std::vector<double> _extendedPollEvalTime;    ///< Total time spent evaluating extended poll points
+    DLL_ALGO_API static double _extendedPollTime;        ///< Total time spent running extended polls
+    DLL_ALGO_API static double _extendedPollEvalTime;    ///< Total time spent evaluating extended poll points
 #endif // TIME_STATS
 
 public:
@@ -33,8 +33,8 @@ public:
 
 #ifdef TIME_STATS
     /// Time stats
-    static std::vector<double> getExtendedPollTime()       { return _extendedPollTime; }
-    static std::vector<double> getExtendedPollEvalTime()   { return _extendedPollEvalTime; }
+    static double getExtendedPollTime()       { return _extendedPollTime; }
+    static double getExtendedPollEvalTime()   { return _extendedPollEvalTime; }
 #endif // TIME_STATS
     
     /**
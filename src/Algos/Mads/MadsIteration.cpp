@@ -18,6 +18,8 @@ double NOMAD::MadsIteration::_searchTime = 0.0;
 double NOMAD::MadsIteration::_searchEvalTime = 0.0;
 double NOMAD::MadsIteration::_pollTime = 0.0;
 double NOMAD::MadsIteration::_pollEvalTime = 0.0;
+double NOMAD::MadsIteration::_extendedPollTime = 0.0;
+double NOMAD::MadsIteration::_extendedPollEvalTime = 0.0;
 #endif // TIME_STATS
 
 
@@ -25,7 +27,7 @@ void NOMAD::MadsIteration::init()
 {
 
     // For some testing, it is possible that _runParams is null
-    if (nullptr != _runParams && _runParams->getAttributeValue<bool>("MEGA_SEARCH_POLL"))
+    if (nullptr != _runParams && _runParams->getSnapshot().MEGA_SEARCH_POLL)
     {
         _megasearchpoll = std::make_unique<NOMAD::MegaSearchPoll>(this);
     }
@@ -22,7 +22,7 @@ void NOMAD::MadsUpdate::init()
     auto evc = NOMAD::EvcInterface::getEvaluatorControl();
     if (nullptr != evc)
     {
-        _clearEvalQueue = evc->getEvaluatorControlGlobalParams()->getAttributeValue<bool>("EVAL_QUEUE_CLEAR");
+        _clearEvalQueue = evc->getEvaluatorControlGlobalParams()->getSnapshot().EVAL_QUEUE_CLEAR;
     }
 
 }
@@ -34,8 +34,8 @@ void NOMAD::Poll::init()
     if ( nullptr != _runParams)
     {
         // The direction types for primary and secondary poll centers
-        _primaryDirectionTypes = _runParams->getAttributeValue<DirectionTypeList>("DIRECTION_TYPE");
-        _secondaryDirectionTypes = _runParams->getAttributeValue<DirectionTypeList>("DIRECTION_TYPE_SECONDARY_POLL");
+        _primaryDirectionTypes = _runParams->getSnapshot().DIRECTION_TYPE;
+        _secondaryDirectionTypes = _runParams->getSnapshot().DIRECTION_TYPE_SECONDARY_POLL;
 
         // Ortho n+1 poll methods generate n trial points in a first pass and, if not successful, generate the n+1 th point (second pass)
         for (auto dirType : _primaryDirectionTypes)
@@ -60,17 +60,17 @@ void NOMAD::Poll::init()
         }
         
         // Rho parameter of the progressive barrier. Used to choose if the primary frame center is the feasible or infeasible incumbent.
-        _rho = _runParams->getAttributeValue<NOMAD::Double>("RHO");
+        _rho = _runParams->getSnapshot().RHO;
 
         // Complete the primary and secondary poll directions to reach the given target number. Only for single pass direction type (ortho 2n). Managed by checkAndComply.
-        _trialPointMaxAddUp = _runParams->getAttributeValue<size_t>("TRIAL_POINT_MAX_ADD_UP");
+        _trialPointMaxAddUp = _runParams->getSnapshot().TRIAL_POINT_MAX_ADD_UP;
 
     }
 
     // Groups of variables.
     if ( nullptr != _pbParams)
     {
-        _varGroups = _pbParams->getAttributeValue<NOMAD::ListOfVariableGroup>("VARIABLE_GROUP");
+        _varGroups = _pbParams->getSnapshot().VARIABLE_GROUP;
         if (!_varGroups.empty())
         {
             _mapDirTypeToVG = _runParams->getMapDirTypeToVG();
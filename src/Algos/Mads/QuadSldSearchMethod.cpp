@@ -52,6 +52,7 @@ void NOMAD::QuadSldSearchMethod::generateTrialPointsFinal()
             && bestXFeas->getF(computeType) < MODEL_MAX_OUTPUT)
         {
             NOMAD::QuadModelSldSinglePass singlePassFeas(this, bestXFeas, madsIteration->getMesh());
+            singlePassFeas.getModel()->set_regression_state(_regressionStateFeas);
             
             // Generate the trial points
             singlePassFeas.generateTrialPoints();
@@ -71,6 +72,7 @@ void NOMAD::QuadSldSearchMethod::generateTrialPointsFinal()
             && bestXInf->getH(computeType) < MODEL_MAX_OUTPUT)
         {
             NOMAD::QuadModelSldSinglePass singlePassInf(this, bestXInf, madsIteration->getMesh());
+            singlePassInf.getModel()->set_regression_state(_regressionStateInf);
 
             // Generate the trial points
             singlePassInf.generateTrialPoints();
@@ -18,6 +18,11 @@ class QuadSldSearchMethod final : public SearchMethodSimple
 private:
     OutputLevel _displayLevel;
 
+#ifdef USE_SGTELIB
+    /// Normal equations of the models around the feasible and infeasible frame centers, kept between iterations of this Mads.
+    std::shared_ptr<QuadModelSld::RegressionState> _regressionStateFeas, _regressionStateInf;
+#endif
+
 public:
     /// Constructor
     /**
@@ -26,6 +31,10 @@ public:
     explicit QuadSldSearchMethod(const Step* parentStep)
       : SearchMethodSimple(parentStep),
         _displayLevel(OutputLevel::LEVEL_NORMAL)
+#ifdef USE_SGTELIB
+        ,_regressionStateFeas(std::make_shared<QuadModelSld::RegressionState>()),
+        _regressionStateInf(std::make_shared<QuadModelSld::RegressionState>())
+#endif
     {
         init();
     }
@@ -9,8 +9,8 @@ void NOMAD::SearchMethodBase::init()
     
     if (nullptr != _pbParams)
     {
-        _lb = _pbParams->getAttributeValue<NOMAD::ArrayOfDouble>("LOWER_BOUND");
-        _ub = _pbParams->getAttributeValue<NOMAD::ArrayOfDouble>("UPPER_BOUND");
+        _lb = _pbParams->getSnapshot().LOWER_BOUND;
+        _ub = _pbParams->getSnapshot().UPPER_BOUND;
     }
 
 }
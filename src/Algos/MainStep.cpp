@@ -17,6 +17,9 @@
 #include "../Output/OutputQueue.hpp"
 #include "../Output/OutputDirectToFile.hpp"
 #include "../Util/Clock.hpp"
+#ifdef TIME_STATS
+#include "../Util/Instrumentation.hpp"
+#endif // TIME_STATS
 #include "../Type/EvalSortType.hpp"
 #include "../Util/Clock.hpp"
 #include "../Util/fileutils.hpp"
@@ -246,7 +249,7 @@ std::vector<std::string> NOMAD::MainStep::observe(const NOMAD::ArrayOfPoint& xs,
     for (size_t i = 0; i < xs.size(); i++)
     {
         NOMAD::EvalPoint evalPoint(xs[i]);
-        evalPoint.setBBO(fxs[i].tostring(), bbOutputType, NOMAD::EvalType::BB);
+        evalPoint.setBBO(fxs[i], bbOutputType, NOMAD::EvalType::BB);
         evalPointList.push_back(evalPoint);
     }
     observe(evalPointList);
@@ -710,6 +713,10 @@ void NOMAD::MainStep::endImp()
 
     displayDetailedStats();
 
+#ifdef TIME_STATS
+    writeProfile();
+#endif // TIME_STATS
+
     writeFinalSolutionFile();
 
     _algos.clear();
@@ -1084,6 +1091,24 @@ void NOMAD::MainStep::resetEvaluatorControl()
 }
 
 
+#ifdef TIME_STATS
+void NOMAD::MainStep::writeProfile() const
+{
+    std::string profileFile = _allParams->getAttributeValue<std::string>("PROFILE_FILE");
+
+    if (profileFile.empty() || profileFile == "-")
+    {
+        return;
+    }
+
+    if (!NOMAD::Instrumentation::writeProfile(profileFile))
+    {
+        NOMAD::OutputQueue::Add("Warning: could not write profile file " + profileFile, NOMAD::OutputLevel::LEVEL_WARNING);
+    }
+}
+#endif // TIME_STATS
+
+
 void NOMAD::MainStep::displayDetailedStats() const
 {
     // Display detailed stats
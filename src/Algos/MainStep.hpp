@@ -214,6 +214,11 @@ private:
 
     ///  Detailed stats
     void displayDetailedStats() const;
+
+#ifdef TIME_STATS
+    /// Helper for end: write the instrumentation profile in PROFILE_FILE
+    void writeProfile() const;
+#endif // TIME_STATS
     
     /// Final solution file
     void writeFinalSolutionFile() const;
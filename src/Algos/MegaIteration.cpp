@@ -22,7 +22,7 @@ NOMAD::MegaIteration::MegaIteration(const Step* parentStep,
 
 void NOMAD::MegaIteration::startImp()
 {
-    if (_runParams->getAttributeValue<bool>("USER_CALLS_ENABLED"))
+    if (_runParams->getSnapshot().USER_CALLS_ENABLED)
     {
         bool stop = false;
         runCallback(NOMAD::CallbackType::MEGA_ITERATION_START, *this, stop);
@@ -49,7 +49,7 @@ std::string NOMAD::MegaIteration::getName() const
 
 void NOMAD::MegaIteration::endImp()
 {
-    if (_runParams->getAttributeValue<bool>("USER_CALLS_ENABLED"))
+    if (_runParams->getSnapshot().USER_CALLS_ENABLED)
     {
         // Run callback and set stop reason if overall stop is requested
         bool stop = false;
@@ -88,7 +88,7 @@ void NOMAD::MegaIteration::endImp()
 
 void NOMAD::MegaIteration::computeMaxXFeasXInf(size_t &maxXFeas, size_t &maxXInf)
 {
-    const size_t maxIter = _runParams->getAttributeValue<size_t>("MAX_ITERATION_PER_MEGAITERATION");
+    const size_t maxIter = _runParams->getSnapshot().MAX_ITERATION_PER_MEGAITERATION;
     const size_t maxXFeas0 = maxXFeas;
     const size_t maxXInf0 = maxXInf;
 
@@ -5,10 +5,47 @@
 #include "QPModelUtils.hpp"
 #include "../../Util/utils.hpp"
 
+bool NOMAD::AugLagWarmStart::isCompatible(const SGTELIB::Matrix& QPModel,
+                                          const int n,
+                                          const double relTol) const
+{
+    if (!_valid ||
+        _x.get_nb_rows() != n ||
+        _QPModel.get_nb_rows() != QPModel.get_nb_rows() ||
+        _QPModel.get_nb_cols() != QPModel.get_nb_cols())
+    {
+        return false;
+    }
+
+    double diff = 0.0;
+    for (int i = 0; i < QPModel.get_nb_rows(); ++i)
+    {
+        for (int j = 0; j < QPModel.get_nb_cols(); ++j)
+        {
+            const double dij = QPModel.get(i, j) - _QPModel.get(i, j);
+            diff += dij * dij;
+        }
+    }
+    return std::sqrt(diff) <= relTol * std::max(1.0, _QPModel.norm());
+}
+
+void NOMAD::AugLagWarmStart::store(const SGTELIB::Matrix& QPModel,
+                                   const SGTELIB::Matrix& x,
+                                   const SGTELIB::Matrix& lambda,
+                                   const double mu)
+{
+    _QPModel = QPModel;
+    _x = x;
+    _lambda = lambda;
+    _mu = mu;
+    _valid = true;
+}
+
 NOMAD::AugLagSolverStatus NOMAD::AugLagSolver::solve(SGTELIB::Matrix& x,
                                                      SGTELIB::Matrix& QPModel,
                                                      SGTELIB::Matrix& lb,
-                                                     SGTELIB::Matrix& ub) const
+                                                     SGTELIB::Matrix& ub,
+                                                     AugLagWarmStart* warmStart) const
 {
     if (!checkDimensions(x, QPModel, lb, ub))
     {
@@ -33,6 +70,15 @@ NOMAD::AugLagSolverStatus NOMAD::AugLagSolver::solve(SGTELIB::Matrix& x,
         }
     }
 
+    // Warm start: restart from the previous primal solution. It is projected on the new bounds.
+    const bool warmStarted = (nullptr != warmStart) && warmStart->isCompatible(QPModel, n, WARM_START_MODEL_TOL);
+    const SGTELIB::Matrix xCold = warmStarted ? x : SGTELIB::Matrix();
+    if (warmStarted)
+    {
+        x = warmStart->_x;
+        warmStart->_nbWarmStarts++;
+    }
+
     projectOnBounds(x, lb, ub);
 
     const int ncons = QPModel.get_nb_rows() - 1;
@@ -82,6 +128,13 @@ NOMAD::AugLagSolverStatus NOMAD::AugLagSolver::solve(SGTELIB::Matrix& x,
         const bool feasible = (XS.get(i, 0) >= lvar.get(i, 0)) && (XS.get(i, 0) <= uvar.get(i, 0));
         if (!feasible)
         {
+            if (warmStarted)
+            {
+                // The previous solution is not a good starting point anymore: solve from scratch.
+                warmStart->clear();
+                x = xCold;
+                return solve(x, QPModel, lb, ub, warmStart);
+            }
             return NOMAD::AugLagSolverStatus::LM_FAILURE;
         }
     }
@@ -117,6 +170,18 @@ NOMAD::AugLagSolverStatus NOMAD::AugLagSolver::solve(SGTELIB::Matrix& x,
     constexpr double tol_opt = 1e-7;
     constexpr double tol_feas = 1e-7;
 
+    if (warmStarted)
+    {
+        // Restart from the previous multipliers. The previous penalty parameter is kept
+        // away from the stagnation threshold, and the tolerances are reset as after
+        // an update of mu.
+        lambda_l = warmStart->_lambda;
+        lambda_l.set_name("lambda_l");
+        mu_l = std::min(mu_init, std::max(warmStart->_mu, std::sqrt(tol_opt)));
+        eta_l = std::max(std::pow(mu_l, 0.1), tol_opt);
+        omega_l = std::max(mu_l, tol_opt);
+    }
+
     size_t successive_failure = 0;
     size_t successive_acceptable = 0;
     constexpr size_t successive_failure_before_update = 2;
@@ -128,6 +193,7 @@ NOMAD::AugLagSolverStatus NOMAD::AugLagSolver::solve(SGTELIB::Matrix& x,
         std::printf("\nAugmented lagrangian algorithm\n");
         std::printf("Number of total variables: %d\n", n);
         std::printf("Number of inequality constraints: %d\n", ncons);
+        std::printf("Warm start: %s\n", warmStarted ? "yes" : "no");
         std::printf("Stopping criterion tolerance for optimality: %e\n", tol_opt * std::max(1.0, nprojFx0));
         std::printf("Stopping criterion tolerance for feasibility: %e\n", tol_feas * std::max(1.0, ncx0s0));
         std::printf("Maximum number of iterations allowed for outer loop: %zu\n", max_iter_outer);
@@ -406,6 +472,18 @@ NOMAD::AugLagSolverStatus NOMAD::AugLagSolver::solve(SGTELIB::Matrix& x,
         printf("\n");
     }
 
+    if (nullptr != warmStart)
+    {
+        if (status == AugLagSolverStatus::NUM_ERROR)
+        {
+            warmStart->clear();
+        }
+        else
+        {
+            warmStart->store(QPModel, x, lambda_l, mu_l);
+        }
+    }
+
     return status;
 }
 
@@ -1024,7 +1102,7 @@ void NOMAD::AugLagSolver::computeAugLagGrad(SGTELIB::Matrix& gradL,
     QPModelUtils::getModelJacobianCons(Jx, QPModel, x);
 
     SGTELIB::Matrix gradLax("gradLax", n, 1);
-    SGTELIB::Matrix::inplace_product(gradLax, Jx.transpose(), cslack);
+    SGTELIB::Matrix::inplace_transposeA_product(gradLax, Jx, cslack);
     gradLax.multiply(1.0 / mu);
     gradLax.add(gradLx);
 
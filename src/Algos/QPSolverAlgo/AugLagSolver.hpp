@@ -18,15 +18,58 @@ enum class AugLagSolverStatus
     UNDEFINED ///< Undefined status
 };
 
+// Solution of a previous resolution by AugLagSolver, used to warm start the next one.
+// The primal solution x, the Lagrange multipliers and the final penalty parameter are
+// kept with the QP model they solve. They are reused only when the new QP model is a
+// small perturbation of the stored one. The active bounds are not stored explicitly:
+// the stored x lies on them, so the inner bound-constrained solver starts with the
+// same working set.
+class AugLagWarmStart
+{
+public:
+    AugLagWarmStart() : _valid(false), _mu(0.0), _nbWarmStarts(0) {}
+
+    void clear() { _valid = false; }
+    bool isValid() const { return _valid; }
+
+    // Number of resolutions that have been warm started from this state.
+    size_t getNbWarmStarts() const { return _nbWarmStarts; }
+
+    // Return true if the QPModel on bounds of size n can be solved from the stored state:
+    // same dimensions and || QPModel - storedQPModel ||_F <= relTol * max(1, || storedQPModel ||_F).
+    bool isCompatible(const SGTELIB::Matrix& QPModel, const int n, const double relTol) const;
+
+private:
+    friend class AugLagSolver;
+
+    void store(const SGTELIB::Matrix& QPModel,
+               const SGTELIB::Matrix& x,
+               const SGTELIB::Matrix& lambda,
+               const double mu);
+
+    bool _valid;
+    SGTELIB::Matrix _QPModel;
+    SGTELIB::Matrix _x;
+    SGTELIB::Matrix _lambda;
+    double _mu;
+    size_t _nbWarmStarts;
+};
+
 // Augmented Lagrangian solver
 // Solve the QCQP
 class AugLagSolver
 {
 public:
+    // When warmStart is provided, the resolution starts from its state if the QPModel
+    // is compatible, and the state is updated with the new solution on exit.
     AugLagSolverStatus solve(SGTELIB::Matrix& x,
                              SGTELIB::Matrix& QPModel,
                              SGTELIB::Matrix& lb,
-                             SGTELIB::Matrix& ub) const;
+                             SGTELIB::Matrix& ub,
+                             AugLagWarmStart* warmStart = nullptr) const;
+
+    // Maximal relative perturbation of the QP model for which a warm start is used.
+    static constexpr double WARM_START_MODEL_TOL = 0.25;
 
     // Parameters
     double mu_init; // Initial augmented Lagrangian penalty parameter
@@ -6,9 +6,15 @@
  */
 #include "../../Math/MathUtils.hpp"
 #include "../../Math/MatrixUtils.hpp"
+#include "../../Math/MatrixWorkspace.hpp"
 
 #include "DoglegTRSolver.hpp"
 
+namespace {
+    // Scratch memory of the solver, kept between calls (one per thread).
+    thread_local NOMAD::MatrixWorkspace doglegWorkspace;
+}
+
 NOMAD::DoglegTRSolverStatus NOMAD::DoglegTRSolver::solve(SGTELIB::Matrix& x,
                                                          const SGTELIB::Matrix& A,
                                                          const SGTELIB::Matrix& b,
@@ -65,15 +71,10 @@ NOMAD::DoglegTRSolverStatus NOMAD::DoglegTRSolver::solve(SGTELIB::Matrix& x,
     // Compute the Newton point, which minimizes || A x + b ||^2 with QR decomposition.
     // 1- Compute the QR factorization of A if A has more rows than columns, otherwise
     // the computation of A^T.
-    auto Q = new double*[std::max(m, n)];
-    auto R = new double*[std::max(m, n)];
-    auto M = new double*[std::max(m, n)];
-    for (int i = 0; i < std::max(m, n); ++i)
-    {
-        Q[i] = new double[std::max(m, n)];
-        R[i] = new double[std::min(m, n)];
-        M[i] = new double[std::min(m, n)];
-    }
+    NOMAD::MatrixWorkspace::Frame frame(doglegWorkspace);
+    double** Q = doglegWorkspace.getMatrix(std::max(m, n), std::max(m, n));
+    double** R = doglegWorkspace.getMatrix(std::max(m, n), std::min(m, n));
+    double** M = doglegWorkspace.getMatrix(std::max(m, n), std::min(m, n));
     for (int i = 0; i < std::max(m, n); ++i)
     {
         for (int j = 0; j < std::min(m, n); ++j)
@@ -95,20 +96,11 @@ NOMAD::DoglegTRSolverStatus NOMAD::DoglegTRSolver::solve(SGTELIB::Matrix& x,
 
     if (!factorization_success)
     {
-        for (int i = 0; i < std::max(m, n); ++i)
-        {
-            delete [] Q[i];
-            delete [] R[i];
-            delete [] M[i];
-        }
-        delete [] Q;
-        delete [] R;
-        delete [] M;
         return NOMAD::DoglegTRSolverStatus::QR_FACTORIZATION_FAILURE;
     }
 
     SGTELIB::Matrix xN("xN", n, 1);
-    auto c = new double[m];
+    double* c = doglegWorkspace.getVector(m);
     if (m >= n)
     {
         // The solution is the least-square solution of || A x + b ||^2
@@ -164,17 +156,6 @@ NOMAD::DoglegTRSolverStatus NOMAD::DoglegTRSolver::solve(SGTELIB::Matrix& x,
         }
     }
 
-    delete[] c;
-    for (int i = 0; i < std::max(m, n); ++i)
-    {
-        delete [] Q[i];
-        delete [] R[i];
-        delete [] M[i];
-    }
-    delete [] Q;
-    delete [] R;
-    delete [] M;
-
     // Compute x according to the dogleg method.
     if (xN.norm() <= delta)
     {
@@ -7,8 +7,14 @@
 #include "L1AugLagSolver.hpp"
 
 #include "../../Nomad/nomad.hpp"
+#include "../../Math/MatrixWorkspace.hpp"
 #include "QPModelUtils.hpp"
 
+namespace {
+    // Scratch memory of the multipliers estimation, kept between calls (one per thread).
+    thread_local NOMAD::MatrixWorkspace multipliersWorkspace;
+}
+
 NOMAD::L1AugLagSolverStatus NOMAD::L1AugLagSolver::solve(SGTELIB::Matrix& x,
                                                          const SGTELIB::Matrix& QPModel,
                                                          const SGTELIB::Matrix& lb,
@@ -1661,17 +1667,10 @@ void NOMAD::L1AugLagSolver::computeMultipliersInfeasibleConstraints(SGTELIB::Mat
 
     // 1- Initialize matrices for SVD decomposition
     const int nbCons = JActiveT.get_nb_cols();
-    auto U = new double *[n];
-    auto W = new double[nbCons];
-    auto V = new double *[nbCons];
-    for (int i = 0; i < n; ++i)
-    {
-        U[i] = new double[nbCons];
-    }
-    for (int i = 0; i < nbCons; ++i)
-    {
-        V[i] = new double[nbCons];
-    }
+    NOMAD::MatrixWorkspace::Frame frame(multipliersWorkspace);
+    double** U = multipliersWorkspace.getMatrix(n, nbCons);
+    double* W = multipliersWorkspace.getVector(nbCons);
+    double** V = multipliersWorkspace.getMatrix(nbCons, nbCons);
 
     // 2- Compute the SVD of the transposed Jacobian matrix
     std::string error_msg;
@@ -1714,18 +1713,6 @@ void NOMAD::L1AugLagSolver::computeMultipliersInfeasibleConstraints(SGTELIB::Mat
         lambda.set(j, 0, sol.get(curInd, 0));
         curInd++;
     }
-
-    for (int i = 0; i < n; i++)
-    {
-        delete [] U[i];
-    }
-    delete [] U;
-    for (int j = 0; j < nbCons; j++)
-    {
-        delete [] V[j];
-    }
-    delete [] V;
-    delete [] W;
 }
 
 
@@ -135,7 +135,7 @@ NOMAD::LMSolverStatus NOMAD::LevenbergMarquardtSolver::solve(SGTELIB::Matrix& x,
 
     // Second stopping criterion: stop as soon as possible
     SGTELIB::Matrix wq("vxs", nbCons + n, 1);
-    SGTELIB::Matrix::inplace_product(wq, W.transpose(), cslack);
+    SGTELIB::Matrix::inplace_transposeA_product(wq, W, cslack);
     const double wqNorm = wq.norm();
     if (wqNorm <= tol)
     {
@@ -315,7 +315,7 @@ NOMAD::LMSolverStatus NOMAD::LevenbergMarquardtSolver::solve(SGTELIB::Matrix& x,
         r.add(cslack);
 
         // Update W' W r (for stopping criteria)
-        SGTELIB::Matrix::inplace_product(WtWr, W.transpose(), r);
+        SGTELIB::Matrix::inplace_transposeA_product(WtWr, W, r);
 
         const double f_current = cslack.norm();
         const double qm = r.norm();
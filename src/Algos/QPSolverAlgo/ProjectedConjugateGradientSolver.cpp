@@ -10,6 +10,12 @@
 
 #include "../../Math/MathUtils.hpp"
 #include "../../Math/MatrixUtils.hpp"
+#include "../../Math/MatrixWorkspace.hpp"
+
+namespace {
+    // Scratch memory of the solver, kept between calls (one per thread).
+    thread_local NOMAD::MatrixWorkspace pcgWorkspace;
+}
 
 NOMAD::ProjectedConjugateGradientSolverStatus NOMAD::ProjectedConjugateGradientSolver::solve(SGTELIB::Matrix& x,
                                                                                              const SGTELIB::Matrix& G,
@@ -53,10 +59,10 @@ NOMAD::ProjectedConjugateGradientSolverStatus NOMAD::ProjectedConjugateGradientS
     // M = [ I  A^T ]
     //     [ A  0   ]
     const int npm = n + m;
-    auto M = new double*[npm];
+    NOMAD::MatrixWorkspace::Frame frame(pcgWorkspace);
+    double** M = pcgWorkspace.getMatrix(npm, npm);
     for (int i = 0; i < npm; ++i)
     {
-        M[i] = new double[npm];
         for (int j = 0; j < npm; ++j)
         {
             if ((i < n) & (j < n))
@@ -84,7 +90,7 @@ NOMAD::ProjectedConjugateGradientSolverStatus NOMAD::ProjectedConjugateGradientS
 
     // Compute LDL^T factorization
     std::string error_msg;
-    auto pivots = new int[npm];
+    int* pivots = pcgWorkspace.getIntVector(npm);
     NOMAD::LDLt_factorization(error_msg, M, pivots, npm);
 
     // Algorithm PCG may assume that an initial feasible point x0 satisfying A x0 = b
@@ -92,8 +98,8 @@ NOMAD::ProjectedConjugateGradientSolverStatus NOMAD::ProjectedConjugateGradientS
     // [ I  A^T ]  [ x0 ]  = [ 0 ]
     // [ A  0   ]  [ y  ]  = [ b ]
     constexpr double tolAxbSolved = 1e-15;
-    auto sol = new double[npm];
-    auto rhs = new double[npm];
+    double* sol = pcgWorkspace.getVector(npm);
+    double* rhs = pcgWorkspace.getVector(npm);
 
     SGTELIB::Matrix Ax = SGTELIB::Matrix::product(A, x);
     SGTELIB::Matrix init_ro = b;
@@ -141,7 +147,7 @@ NOMAD::ProjectedConjugateGradientSolverStatus NOMAD::ProjectedConjugateGradientS
             break;
 
         // Compute rhog = - x - A'w+
-        SGTELIB::Matrix::inplace_product(rhog, A.transpose(), wp);
+        SGTELIB::Matrix::inplace_transposeA_product(rhog, A, wp);
         rhog.multiply(-1.0);
         rhog.sub(x);
 
@@ -187,13 +193,6 @@ NOMAD::ProjectedConjugateGradientSolverStatus NOMAD::ProjectedConjugateGradientS
         // No initial solution has been found.
         if ((init_ro.norm() > tolAxbSolved) || xtmp.norm() > delta)
         {
-            for (int i = 0; i < npm; ++i) {
-                delete[] M[i];
-            }
-            delete[] M;
-            delete[] sol;
-            delete[] rhs;
-
             return NOMAD::ProjectedConjugateGradientSolverStatus::NO_INIT_SOLUTION;
         }
         x = xtmp;
@@ -444,7 +443,7 @@ NOMAD::ProjectedConjugateGradientSolverStatus NOMAD::ProjectedConjugateGradientS
             }
 
             // Compute rhog = r+ - g+ - A'w+
-            SGTELIB::Matrix::inplace_product(rhog, A.transpose(), wp);
+            SGTELIB::Matrix::inplace_transposeA_product(rhog, A, wp);
             rhog.multiply(-1.0);
             rhog.sub(gp);
             rhog.add(rp);
@@ -532,13 +531,5 @@ NOMAD::ProjectedConjugateGradientSolverStatus NOMAD::ProjectedConjugateGradientS
         }
     }
 
-    for (int i = 0; i < npm; ++i)
-    {
-        delete [] M[i];
-    }
-    delete [] M;
-    delete [] sol;
-    delete [] rhs;
-
     return solverStatus;
 }
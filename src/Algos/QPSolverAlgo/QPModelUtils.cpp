@@ -262,7 +262,7 @@ void NOMAD::QPModelUtils::getModelLagrangianGrad(SGTELIB::Matrix& gradL,
     getModelJacobianCons(jacobianCons, QPModel, x);
 
     SGTELIB::Matrix outGrad("outGrad", n, 1);
-    SGTELIB::Matrix::inplace_product(outGrad, jacobianCons.transpose(), lambda);
+    SGTELIB::Matrix::inplace_transposeA_product(outGrad, jacobianCons, lambda);
     outGrad.multiply(-1.0);
 
     gradL.add(outGrad);
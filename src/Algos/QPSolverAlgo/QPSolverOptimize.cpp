@@ -19,6 +19,7 @@
 #include "../../Cache/CacheBase.hpp"
 #include "../../Math/MathUtils.hpp"
 #include "../../Math/MatrixUtils.hpp"
+#include "../../Math/MatrixWorkspace.hpp"
 
 #include "../../../ext/sgtelib/src/Surrogate_PRS.hpp"
 
@@ -26,6 +27,8 @@ NOMAD::EvalPointPtr NOMAD::QPSolverOptimize::_prevFeasRefCenter = nullptr;
 NOMAD::EvalPointPtr NOMAD::QPSolverOptimize::_prevInfeasRefCenter = nullptr;
 NOMAD::Point NOMAD::QPSolverOptimize::_prevFeasXopt = NOMAD::Point();
 NOMAD::Point NOMAD::QPSolverOptimize::_prevInfeasXopt = NOMAD::Point();
+NOMAD::AugLagWarmStart NOMAD::QPSolverOptimize::_prevFeasWarmStart = NOMAD::AugLagWarmStart();
+NOMAD::AugLagWarmStart NOMAD::QPSolverOptimize::_prevInfeasWarmStart = NOMAD::AugLagWarmStart();
 
 void NOMAD::QPSolverOptimize::init()
 {
@@ -84,6 +87,7 @@ void NOMAD::QPSolverOptimize::init()
 
     _verbose = _runParams->getAttributeValue<bool>("QP_verbose");
     _verboseFull = _runParams->getAttributeValue<bool>("QP_verboseFull");
+    _warmStart = _runParams->getAttributeValue<bool>("QP_AugLag_warmStart");
 
 }
 
@@ -207,27 +211,37 @@ void NOMAD::QPSolverOptimize::generateTrialPointsImp()
     const auto computeType = getMegaIterationBarrier()->getFHComputeType();
     if (refCenter->isFeasible(computeType))
     {
-        if ( nullptr != _prevFeasRefCenter &&
-            _prevFeasRefCenter->NOMAD::ArrayOfDouble::isDefined() &&
-            X_k == *(_prevFeasRefCenter->getX()) &&
+        const bool sameRefCenter = nullptr != _prevFeasRefCenter &&
+                                   _prevFeasRefCenter->NOMAD::ArrayOfDouble::isDefined() &&
+                                   X_k == *(_prevFeasRefCenter->getX());
+        if (sameRefCenter &&
             _prevFeasXopt.isComplete() &&
             isInBounds(_prevFeasXopt, _modelLowerBound, _modelUpperBound))
         {
             X_k = _prevFeasXopt;
         }
+        if (!sameRefCenter)
+        {
+            _prevFeasWarmStart.clear();
+        }
         _prevFeasRefCenter = refCenter;
         feasRefCenter = true;
     }
     else if (! refCenter->isFeasible(computeType))
     {
-        if (nullptr != _prevInfeasRefCenter &&
-            _prevInfeasRefCenter->NOMAD::ArrayOfDouble::isDefined() &&
-            X_k == *(_prevInfeasRefCenter->getX()) &&
+        const bool sameRefCenter = nullptr != _prevInfeasRefCenter &&
+                                   _prevInfeasRefCenter->NOMAD::ArrayOfDouble::isDefined() &&
+                                   X_k == *(_prevInfeasRefCenter->getX());
+        if (sameRefCenter &&
             _prevInfeasXopt.isComplete() &&
             isInBounds(_prevInfeasXopt, _modelLowerBound, _modelUpperBound))
         {
             X_k = _prevInfeasXopt;
         }
+        if (!sameRefCenter)
+        {
+            _prevInfeasWarmStart.clear();
+        }
         _prevInfeasRefCenter = refCenter;
         feasRefCenter = false;
     }
@@ -337,15 +351,20 @@ void NOMAD::QPSolverOptimize::generateTrialPointsImp()
             if (SelectAlgo == 0)
             {
                 AugLagSolverStatus status = AugLagSolverStatus::UNDEFINED;
+                AugLagWarmStart* warmStart = nullptr;
+                if (_warmStart)
+                {
+                    warmStart = feasRefCenter ? &_prevFeasWarmStart : &_prevInfeasWarmStart;
+                }
                 if (_flagReducedIterations)
                 {
                     AugLagSolver auglag_solver{0.1, 10.0, omega0, eta0, 1e-12, 40, 150, 25, 0};
-                    status = auglag_solver.solve(x, QPModel, lb, ub);
+                    status = auglag_solver.solve(x, QPModel, lb, ub, warmStart);
                 }
                 else
                 {
                     AugLagSolver auglag_solver{0.1, 10.0, omega0, eta0, 1e-12, 80, 600, 100, 0};
-                    status = auglag_solver.solve(x, QPModel, lb, ub);
+                    status = auglag_solver.solve(x, QPModel, lb, ub, warmStart);
                 }
                 runOk = status != AugLagSolverStatus::MATRIX_DIMENSIONS_FAILURE &&
                         status != AugLagSolverStatus::NUM_ERROR &&
@@ -721,29 +740,21 @@ void NOMAD::QPSolverOptimize::solve_TR_constrained_QP(
     // Initialize matrices for LDLt decomposition. The LDLt decomposition is more generic than
     // the Cholesky decomposition, as for the former, the matrix needs to be positive-definite.
     // At the end of the initialization, M = HW.
-    auto M = new double*[nfree];
-    auto L = new double*[nfree];
-    auto D = new double*[nfree];
+    NOMAD::MatrixWorkspace::Frame frame(_workspace);
+    double** M = _workspace.getMatrix(nfree, nfree);
+    double** L = _workspace.getMatrix(nfree, nfree);
+    double** D = _workspace.getMatrix(nfree, nfree);
     for (int i = 0 ; i < nfree ; ++i )
     {
-        M[i] = new double[nfree];
-        L[i] = new double[nfree];
-        D[i] = new double[nfree];
         for (int j = 0 ; j < nfree ; ++j )
         {
             M[i][j] = HW.get(i, j);
-            L[i][j] = 0;
-            D[i][j] = 0;
         }
     }
-    auto pp = new int[nfree];
-    for (int i = 0 ; i < nfree ; ++i )
-    {
-        pp[i] = 0;
-    }
+    int* pp = _workspace.getIntVector(nfree);
 
     std::string error_msg;
-    const bool success = NOMAD::LDLt_decomposition(error_msg, M, L, D, pp, nfree);
+    const bool success = NOMAD::LDLt_decomposition(error_msg, M, L, D, pp, nfree, 1500, &_workspace);
     if (!success)
     {
         throw NOMAD::Exception(__FILE__, __LINE__, "Error with LDLt decomposition");
@@ -809,24 +820,6 @@ void NOMAD::QPSolverOptimize::solve_TR_constrained_QP(
             }
         }
     }
-
-    // Free memory
-    for (int i=0 ; i<nfree ; i++)
-    {
-        delete [] M[i];
-    }
-    delete [] M;
-    for (int j=0 ; j<nfree ; j++)
-    {
-        delete [] L[j];
-    }
-    delete [] L;
-    for (int j=0 ; j<nfree ; j++)
-    {
-        delete [] D[j];
-    }
-    delete [] D;
-    delete [] pp;
 }
 
 bool NOMAD::QPSolverOptimize::solveBCQP(
@@ -4567,12 +4560,12 @@ size_t NOMAD::QPSolverOptimize::solveLM(
             }
         }
     }
-    SGTELIB::Matrix::inplace_product(WtW, W.transpose(), W);
+    SGTELIB::Matrix::inplace_transposeA_product(WtW, W, W);
     for (int i = 0; i < nbVar; i++)
     {
         WtW.set(i, i, WtW.get(i, i) + normal_step_regularization); // regularization term
     }
-    SGTELIB::Matrix::inplace_product(wq, W.transpose(), cslack);
+    SGTELIB::Matrix::inplace_transposeA_product(wq, W, cslack);
 
     // Trust-region parameters:
     double ared, pred;
@@ -4700,7 +4693,7 @@ size_t NOMAD::QPSolverOptimize::solveLM(
         // Compute the residual: r = Jx * vx + vs + (cx + s)
         SGTELIB::Matrix::inplace_product(r, W, vxs);
         r.add(cslack);
-        SGTELIB::Matrix::inplace_product(WtWr, W.transpose(), r);
+        SGTELIB::Matrix::inplace_transposeA_product(WtWr, W, r);
 
         for (int j = 0; j < _nbCons; ++j)
         {
@@ -4736,12 +4729,12 @@ size_t NOMAD::QPSolverOptimize::solveLM(
                     W.set(i, j, Jx.get(i, j));
                 }
             }
-            SGTELIB::Matrix::inplace_product(WtW, W.transpose(), W);
+            SGTELIB::Matrix::inplace_transposeA_product(WtW, W, W);
             for (int i = 0; i < nbVar; i++)
             {
                 WtW.set(i, i, WtW.get(i, i) + normal_step_regularization); // regularization term
             }
-            SGTELIB::Matrix::inplace_product(wq, W.transpose(), cslack);
+            SGTELIB::Matrix::inplace_transposeA_product(wq, W, cslack);
         }
         else
         {
@@ -5393,12 +5386,12 @@ int NOMAD::QPSolverOptimize::solver_barrier(
                     }
                 }
             }
-            SGTELIB::Matrix::inplace_product(WtW, W.transpose(), W);
+            SGTELIB::Matrix::inplace_transposeA_product(WtW, W, W);
             for (int i = 0; i < nbVar; i++)
             {
                 WtW.set(i, i, WtW.get(i, i) + normal_step_regularization); // regularization term
             }
-            SGTELIB::Matrix::inplace_product(wq, W.transpose(), cslack);
+            SGTELIB::Matrix::inplace_transposeA_product(wq, W, cslack);
         }
 
         vxs.fill(0.0);
@@ -5969,7 +5962,8 @@ bool NOMAD::QPSolverOptimize::Convex_TR_QP(
     lencheck(n, g);
     lencheck(nfree, gW);
 
-    auto sol = new double[nfree];
+    NOMAD::MatrixWorkspace::Frame frame(_workspace);
+    double* sol = _workspace.getVector(nfree);
 
     const bool solve_success = computeNewtonDirection(gW, pp, D, L, sol, nfree);
     if (!solve_success)
@@ -6008,8 +6002,6 @@ bool NOMAD::QPSolverOptimize::Convex_TR_QP(
     }
     verbose && std::cout << "|d|= " << nd << " slope = " << slope << std::endl;
 
-    delete [] sol;
-
     return true;
 }
 
@@ -6023,7 +6015,8 @@ bool NOMAD::QPSolverOptimize::computeNewtonDirection(
 {
     lencheck(n, g);
 
-    auto rhs = new double[n];
+    NOMAD::MatrixWorkspace::Frame frame(_workspace);
+    double* rhs = _workspace.getVector(n);
     for (int i = 0 ; i < n ; ++i )
     {
         rhs[i] = - g.get(i, 0);
@@ -6033,9 +6026,7 @@ bool NOMAD::QPSolverOptimize::computeNewtonDirection(
     // Solve LDLt x = -g (via a direct method)
     string error_msg;
     bool success = true;
-    success = NOMAD::ldl_solve(error_msg, D, L, rhs, sol, pp, n);
-
-    delete [] rhs;
+    success = NOMAD::ldl_solve(error_msg, D, L, rhs, sol, pp, n, &_workspace);
 
     return success;
 }
@@ -6144,14 +6135,12 @@ bool NOMAD::QPSolverOptimize::projected_conjugate_gradient (
 
     ////////// LDLt
     // init matrices for LDLt
-    auto M = new double *[npm];
-    auto L = new double *[npm];
-    auto D = new double *[npm];
+    NOMAD::MatrixWorkspace::Frame frame(_workspace);
+    double** M = _workspace.getMatrix(npm, npm);
+    double** L = _workspace.getMatrix(npm, npm);
+    double** D = _workspace.getMatrix(npm, npm);
     for (int i = 0 ; i < npm ; ++i )
     {
-        M[i] = new double[npm];
-        L[i] = new double[npm];
-        D[i] = new double[npm];
         for (int j = 0 ; j < npm ; ++j )
         {
             if ((i < n) & (j < n)) {
@@ -6163,25 +6152,19 @@ bool NOMAD::QPSolverOptimize::projected_conjugate_gradient (
             } else { // i >= n, j >= n
                 M[i][j] = 0;
             }
-            L[i][j] = 0;
-            D[i][j] = 0;
         }
     }
-    auto pp = new int [npm];
-    for (int i = 0 ; i < npm ; ++i )
-    {
-        pp[i] = 0;
-    }
+    int* pp = _workspace.getIntVector(npm);
     std::string error_msg;
 
-    bool success = NOMAD::LDLt_decomposition(error_msg, M, L, D, pp, npm);
+    bool success = NOMAD::LDLt_decomposition(error_msg, M, L, D, pp, npm, 1500, &_workspace);
     if (!success)
     {
         throw NOMAD::Exception(__FILE__, __LINE__, "Error with LDLt decomposition");
     }
 
-    auto rhs = new double [npm];
-    auto sol = new double [npm];
+    double* rhs = _workspace.getVector(npm);
+    double* sol = _workspace.getVector(npm);
 
     // Initial guess
     x = x0;
@@ -6204,7 +6187,7 @@ bool NOMAD::QPSolverOptimize::projected_conjugate_gradient (
             rhs[i] = b.get(i - n, 0);
             sol[i] = 0;
         }
-        success = NOMAD::ldl_solve(error_msg, D, L, rhs, sol, pp, npm);
+        success = NOMAD::ldl_solve(error_msg, D, L, rhs, sol, pp, npm, &_workspace);
         if (!success) {
             throw NOMAD::Exception(__FILE__, __LINE__, "Error with LDLt solve");
         }
@@ -6236,7 +6219,7 @@ bool NOMAD::QPSolverOptimize::projected_conjugate_gradient (
         rhs[i] = 0;
         sol[i] = 0;
     }
-    success = NOMAD::ldl_solve(error_msg, D, L, rhs, sol, pp, npm);
+    success = NOMAD::ldl_solve(error_msg, D, L, rhs, sol, pp, npm, &_workspace);
     if (!success) {
         throw NOMAD::Exception(__FILE__, __LINE__, "Error with LDLt solve");
     }
@@ -6344,7 +6327,7 @@ bool NOMAD::QPSolverOptimize::projected_conjugate_gradient (
             rhs[i] = 0;
             sol[i] = 0;
         }
-        success = NOMAD::ldl_solve(error_msg, D, L, rhs, sol, pp, npm);
+        success = NOMAD::ldl_solve(error_msg, D, L, rhs, sol, pp, npm, &_workspace);
         if (!success) {
             throw NOMAD::Exception(__FILE__, __LINE__, "Error with LDLt solve");
         }
@@ -6448,25 +6431,6 @@ bool NOMAD::QPSolverOptimize::projected_conjugate_gradient (
 //
 //    }
 
-    for (int i=0 ; i<npm ; i++)
-    {
-        delete [] M[i];
-    }
-    delete [] M;
-    for (int j=0 ; j<npm ; j++)
-    {
-        delete [] L[j];
-    }
-    delete [] L;
-    for (int j=0 ; j<npm ; j++)
-    {
-        delete [] D[j];
-    }
-    delete [] D;
-    delete [] pp;
-    delete [] rhs;
-    delete [] sol;
-
     // TODO : normally, one should retrieve the former direction if the feasibility has not be reached.
     if (max_iter_reached)
     {
@@ -6671,7 +6635,7 @@ SGTELIB::Matrix NOMAD::QPSolverOptimize::getModelLagGradient(
     outGradient.multiply(sigma) ;
     lagGradient.add(outGradient);
 
-    SGTELIB::Matrix::inplace_product(outGradient, modelJacobian.transpose(), multiplier);
+    SGTELIB::Matrix::inplace_transposeA_product(outGradient, modelJacobian, multiplier);
     outGradient.multiply(-1) ;
     lagGradient.add(outGradient);
 
@@ -9,7 +9,9 @@
 
 #include "../../Algos/AlgoStopReasons.hpp"
 #include "../../Algos/Step.hpp"
+#include "../../Algos/QPSolverAlgo/AugLagSolver.hpp"
 #include "../../Algos/QuadModel/QuadModelIterationUtils.hpp"
+#include "../../Math/MatrixWorkspace.hpp"
 
 #include "../../nomad_nsbegin.hpp"
 
@@ -36,6 +38,7 @@ private:
     
     static EvalPointPtr _prevFeasRefCenter, _prevInfeasRefCenter; ///> Previous refCenter to identify change of pb.
     static Point _prevFeasXopt, _prevInfeasXopt; ///>  Previous QP solver solutions (1 feas, 1 infeas) can be used for initial points
+    static AugLagWarmStart _prevFeasWarmStart, _prevInfeasWarmStart; ///> Previous augmented Lagrangian states (1 feas, 1 infeas), valid for the previous refCenter
 
     const std::shared_ptr<PbParameters> _refPbParams; ///< Reference to the original problem parameters.
 
@@ -55,6 +58,10 @@ private:
     BBOutputTypeList _bbot;
 
     bool _verbose, _verboseFull;
+
+    bool _warmStart; ///< Warm start the augmented Lagrangian solver from the previous solve around the same refCenter
+
+    mutable MatrixWorkspace _workspace; ///< Scratch memory of the dense linear algebra routines, reused between iterations.
     
 public:
     /// Constructor
@@ -77,7 +84,8 @@ public:
         _optWithScaledBounds(optWithScaledBounds),
         _flagReducedIterations(flagReducedIterations),
         _verbose(false),
-        _verboseFull(false)
+        _verboseFull(false),
+        _warmStart(false)
     {
         _qpStopReason = std::make_shared<AlgoStopReasons<QPStopType>>();
         init();
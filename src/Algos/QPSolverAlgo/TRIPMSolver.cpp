@@ -12,6 +12,12 @@
 #include "../../Algos/QPSolverAlgo/ProjectedConjugateGradientSolver.hpp"
 #include "../../Algos/QPSolverAlgo/QPModelUtils.hpp"
 #include "../../Math/MatrixUtils.hpp"
+#include "../../Math/MatrixWorkspace.hpp"
+
+namespace {
+    // Scratch memory of the second-order correction step, kept between calls (one per thread).
+    thread_local NOMAD::MatrixWorkspace socWorkspace;
+}
 
 NOMAD::TRIPMSolverStatus NOMAD::TRIPMSolver::solve(SGTELIB::Matrix& x,
                                                    const SGTELIB::Matrix& QPModel,
@@ -1550,15 +1556,10 @@ bool NOMAD::TRIPMSolver::computeSecondOrderCorrectionStep(SGTELIB::Matrix& y,
     // the computation of W^T.
     const int nrows = W.get_nb_rows();
     const int ncols = W.get_nb_cols();
-    auto Q = new double*[std::max(nrows, ncols)];
-    auto R = new double*[std::max(nrows, ncols)];
-    auto M = new double*[std::max(nrows, ncols)];
-    for (int i = 0; i < std::max(nrows, ncols); ++i)
-    {
-        Q[i] = new double[std::max(nrows, ncols)];
-        R[i] = new double[std::min(nrows, ncols)];
-        M[i] = new double[std::min(nrows, ncols)];
-    }
+    NOMAD::MatrixWorkspace::Frame frame(socWorkspace);
+    double** Q = socWorkspace.getMatrix(std::max(nrows, ncols), std::max(nrows, ncols));
+    double** R = socWorkspace.getMatrix(std::max(nrows, ncols), std::min(nrows, ncols));
+    double** M = socWorkspace.getMatrix(std::max(nrows, ncols), std::min(nrows, ncols));
     for (int i = 0; i < std::max(nrows, ncols); ++i)
     {
         for (int j = 0; j < std::min(nrows, ncols); ++j)
@@ -1580,19 +1581,10 @@ bool NOMAD::TRIPMSolver::computeSecondOrderCorrectionStep(SGTELIB::Matrix& y,
 
     if (!factorization_success)
     {
-        for (int i = 0; i < std::max(nrows, ncols); ++i)
-        {
-            delete [] Q[i];
-            delete [] R[i];
-            delete [] M[i];
-        }
-        delete [] Q;
-        delete [] R;
-        delete [] M;
         return false;
     }
 
-    auto c = new double[nrows];
+    double* c = socWorkspace.getVector(nrows);
     if (nrows >= ncols)
     {
         // The solution is the least-square solution of || W y - cslackXcan ||^2
@@ -1647,16 +1639,5 @@ bool NOMAD::TRIPMSolver::computeSecondOrderCorrectionStep(SGTELIB::Matrix& y,
         }
     }
 
-    delete[] c;
-    for (int i = 0; i < std::max(nrows, ncols); ++i)
-    {
-        delete [] Q[i];
-        delete [] R[i];
-        delete [] M[i];
-    }
-    delete [] Q;
-    delete [] R;
-    delete [] M;
-
     return true;
 }
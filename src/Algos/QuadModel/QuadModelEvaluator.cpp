@@ -99,18 +99,11 @@ std::vector<bool> NOMAD::QuadModelEvaluator::eval_block(NOMAD::Block &block,
     // ------------------------- //
     NOMAD::OutputQueue::Add("Predict with quadratic formulation... ", _displayLevel);
 
-
-    // Unfortunately, Sgtelib is not thread-safe.
-    // For this reason we have to set part of the eval_x code to critical.
-#ifdef _OPENMP
-#pragma omp critical(SgtelibEvalBlock)
-#endif // _OPENMP
-    {
-        _model->check_ready(__FILE__,__FUNCTION__,__LINE__);
-
-        _model->predict(X_predict, &M_predict);
-        NOMAD::OutputQueue::Add("ok", _displayLevel);
-    }
+    // Sgtelib predictions are reentrant on a ready model: threads evaluating
+    // blocks with the same model do not need to be serialized.
+    _model->check_ready(__FILE__,__FUNCTION__,__LINE__);
+    _model->predict(X_predict, &M_predict);
+    NOMAD::OutputQueue::Add("ok", _displayLevel);
 
     j = 0;
     // Verify all points are completely defined
@@ -145,7 +138,7 @@ std::vector<bool> NOMAD::QuadModelEvaluator::eval_block(NOMAD::Block &block,
         {
             newbbo[i] = M_predict.get(j,static_cast<int>(i));
         }
-        (*it)->setBBO(newbbo.tostring(), _bbOutputTypeList, _evalType);
+        (*it)->setBBO(newbbo, _bbOutputTypeList, _evalType);
 
         // ================== //
         // Exit Status        //
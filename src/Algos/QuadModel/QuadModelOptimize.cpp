@@ -9,10 +9,19 @@
 #include "../../Algos/SubproblemManager.hpp"
 #include "../../Cache/CacheBase.hpp"
 #include "../../Eval/ComputeSuccessType.hpp"
+#include "../../Math/LHS.hpp"
 #include "../../Output/OutputQueue.hpp"
 #include "../../Type/DirectionType.hpp"
 #include "../../Type/EvalSortType.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <exception>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif // _OPENMP
+
 void NOMAD::QuadModelOptimize::init()
 {
     setStepType(NOMAD::StepType::MODEL_OPTIMIZE);
@@ -315,34 +324,46 @@ void NOMAD::QuadModelOptimize::generateTrialPointsImp()
     // NOTE: Mads works with fixed variables detected during construction of the training set. Fixed variables from the original problem are not considered. The evaluator works on the quad model, we don't need to map to the global full space for evaluation because this is not BB eval.
 
     std::unique_ptr<NOMAD::Mads> mads;
-    
-    if (_runParams->getAttributeValue<bool>("QUAD_MODEL_SEARCH_SIMPLE_MADS"))
+
+    // For now, use this formula for max eval of simple Mads
+    size_t maxModelEval = _optPbParams->getAttributeValue<size_t>("DIMENSION")*800;
+    if (maxModelEval > 8000)
     {
-        
-        // Simple Mads for subproblem optimization has direct access to model outputs to compute f and h.
-        // The way to compute f may change (for example DMultiMads). Let's pass the compute function from evaluator control.
-        // For now, use this formula for max eval
-        size_t maxModelEval = _optPbParams->getAttributeValue<size_t>("DIMENSION")*800;
-        if (maxModelEval > 8000)
-        {
-            maxModelEval = 8000;
-        }
-        mads = std::make_unique<NOMAD::SimpleMads>(this, madsStopReasons, _optRunParams, _optPbParams, _model, bbot, evc->getFHComputeTypeS().singleObjectiveCompute, maxModelEval);
+        maxModelEval = 8000;
     }
-    else
+
+    const size_t nbStarts = _runParams->getAttributeValue<size_t>("QUAD_MODEL_SEARCH_NB_STARTS");
+    if (nbStarts > 1)
     {
-        // Mads for subproblem optimization automatically utilizes the evaluator control for obj function computation
-        mads = std::make_unique<NOMAD::Mads>(this, madsStopReasons, _optRunParams, _optPbParams, false /* false: barrier not initialized from cache */, true /* true: use only local fixed variables */);
-        
+        // Multi-start always uses simple Mads: each run evaluates the model directly and
+        // does not go through the evaluator control. The runs can be done concurrently.
+        // The best points of the runs are inserted as trial points by runMultiStart.
+        runOk = runMultiStart(nbStarts, maxModelEval, bbot, evc->getFHComputeTypeS().singleObjectiveCompute);
     }
+    else
+    {
+        if (_runParams->getAttributeValue<bool>("QUAD_MODEL_SEARCH_SIMPLE_MADS"))
+        {
 
-    evc->resetModelEval();
-    
-    mads->start();
-    runOk = mads->run();
-    mads->end();
-    
-    evc->resetModelEval();
+            // Simple Mads for subproblem optimization has direct access to model outputs to compute f and h.
+            // The way to compute f may change (for example DMultiMads). Let's pass the compute function from evaluator control.
+            mads = std::make_unique<NOMAD::SimpleMads>(this, madsStopReasons, _optRunParams, _optPbParams, _model, bbot, evc->getFHComputeTypeS().singleObjectiveCompute, maxModelEval);
+        }
+        else
+        {
+            // Mads for subproblem optimization automatically utilizes the evaluator control for obj function computation
+            mads = std::make_unique<NOMAD::Mads>(this, madsStopReasons, _optRunParams, _optPbParams, false /* false: barrier not initialized from cache */, true /* true: use only local fixed variables */);
+
+        }
+
+        evc->resetModelEval();
+
+        mads->start();
+        runOk = mads->run();
+        mads->end();
+
+        evc->resetModelEval();
+    }
 
     // Note: No need to check the Mads stop reason: It is not a stop reason
     // for QuadModel.
@@ -360,7 +381,7 @@ void NOMAD::QuadModelOptimize::generateTrialPointsImp()
         auto modelStopReasons = NOMAD::AlgoStopReasons<NOMAD::ModelStopType>::get(_stopReasons);
         modelStopReasons->set(NOMAD::ModelStopType::MODEL_OPTIMIZATION_FAIL);
     }
-    else
+    else if (nullptr != mads)
     {
         // Get the best points in their reference dimension
         _bestXFeas = std::make_shared<NOMAD::EvalPoint>(mads->getBestSolution(true));
@@ -407,6 +428,295 @@ void NOMAD::QuadModelOptimize::generateTrialPointsImp()
 }
 
 
+// Starting points of the multi-start model optimization.
+// The model center comes first, then the best points of the training set (they come from the cache)
+// and LH samples in the model bounds for the remaining starts.
+std::vector<NOMAD::Point> NOMAD::QuadModelOptimize::generateStartPoints(const size_t nbStarts) const
+{
+    const size_t n = _modelCenter.size();
+    std::vector<NOMAD::Point> x0s;
+
+    // Fixed variables keep their value and the other variables are projected on the model bounds.
+    auto addStartPoint = [&](NOMAD::Point x) -> void
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            if (_modelFixedVar[i].isDefined())
+            {
+                x[i] = _modelFixedVar[i];
+                continue;
+            }
+            if (_modelLowerBound[i].isDefined() && x[i] < _modelLowerBound[i])
+            {
+                x[i] = _modelLowerBound[i];
+            }
+            if (_modelUpperBound[i].isDefined() && x[i] > _modelUpperBound[i])
+            {
+                x[i] = _modelUpperBound[i];
+            }
+        }
+        if (x0s.size() < nbStarts && std::find(x0s.begin(), x0s.end(), x) == x0s.end())
+        {
+            x0s.push_back(std::move(x));
+        }
+    };
+
+    // 1- Model center
+    addStartPoint(_modelCenter);
+
+    // 2- Best points of the training set, for about half of the starts.
+    // Feasible points are ranked by f, then infeasible points by h.
+    const size_t nbTrainingStarts = 1 + nbStarts / 2;
+    const SGTELIB::Matrix & X = _trainingSet->get_matrix_X();
+    const SGTELIB::Matrix Z = _trainingSet->Z_unscale(_trainingSet->get_matrix_Zs());
+    const int jObj = _trainingSet->get_j_obj();
+
+    std::vector<std::pair<std::pair<double,double>,int>> ranking;
+    for (int p = 0; p < X.get_nb_rows(); p++)
+    {
+        double h = 0.0;
+        bool valid = std::isfinite(Z.get(p, jObj));
+        for (int j = 0; valid && j < Z.get_nb_cols(); j++)
+        {
+            const double c = Z.get(p, j);
+            valid = std::isfinite(c);
+            if (valid && SGTELIB::BBO_CON == _trainingSet->get_bbo(j) && c > 0.0)
+            {
+                h += c*c;
+            }
+        }
+        if (valid)
+        {
+            ranking.push_back({{h, Z.get(p, jObj)}, p});
+        }
+    }
+    std::sort(ranking.begin(), ranking.end());
+
+    for (const auto & r : ranking)
+    {
+        if (x0s.size() >= nbTrainingStarts)
+        {
+            break;
+        }
+        NOMAD::Point x(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            x[i] = X.get(r.second, static_cast<int>(i));
+        }
+        addStartPoint(x);
+    }
+
+    // 3- LH samples in the model bounds of the free variables
+    std::vector<size_t> freeIndices;
+    for (size_t i = 0; i < n; i++)
+    {
+        if (!_modelFixedVar[i].isDefined() && _modelLowerBound[i].isDefined() && _modelUpperBound[i].isDefined())
+        {
+            freeIndices.push_back(i);
+        }
+    }
+    if (x0s.size() < nbStarts && !freeIndices.empty())
+    {
+        const size_t nFree = freeIndices.size();
+        NOMAD::ArrayOfDouble lb(nFree), ub(nFree);
+        for (size_t k = 0; k < nFree; k++)
+        {
+            lb[k] = _modelLowerBound[freeIndices[k]];
+            ub[k] = _modelUpperBound[freeIndices[k]];
+        }
+        NOMAD::LHS lhs(nFree, nbStarts - x0s.size(), lb, ub);
+        for (const auto & y : lhs.Sample())
+        {
+            NOMAD::Point x(_modelCenter);
+            for (size_t k = 0; k < nFree; k++)
+            {
+                x[freeIndices[k]] = y[k];
+            }
+            addStartPoint(x);
+        }
+    }
+
+    return x0s;
+}
+
+
+bool NOMAD::QuadModelOptimize::runMultiStart(const size_t nbStarts,
+                                             const size_t maxModelEval,
+                                             const NOMAD::BBOutputTypeList & bbot,
+                                             const NOMAD::singleOutputComputeFType & singleObjCompute)
+{
+    const auto x0s = generateStartPoints(nbStarts);
+    const size_t nbRuns = x0s.size();
+    if (0 == nbRuns)
+    {
+        return false;
+    }
+
+    // The model optimizations use the threads of the blackbox evaluations.
+    // They are idle during the model search.
+    int nbThreads = 1;
+#ifdef _OPENMP
+    nbThreads = NOMAD::EvcInterface::getEvaluatorControl()->getNbThreadsForParallelEval();
+    if (nbThreads <= 0)
+    {
+        nbThreads = omp_get_max_threads();
+    }
+    nbThreads = std::max(1, std::min(nbThreads, static_cast<int>(nbRuns)));
+#endif // _OPENMP
+
+    // Each thread gets the budget of a single start, shared equally between the runs it performs.
+    // The wall-clock time is the same as for a single start.
+    const size_t nbRounds = (nbRuns + nbThreads - 1) / nbThreads;
+    const size_t maxModelEvalPerRun = std::max(maxModelEval / nbRounds, static_cast<size_t>(1));
+
+    OUTPUT_INFO_START
+    std::string s = "Multi-start model optimization: " + std::to_string(nbRuns) + " starts on ";
+    s += std::to_string(nbThreads) + " threads, max model eval per start = " + std::to_string(maxModelEvalPerRun);
+    AddOutputInfo(s);
+    OUTPUT_INFO_END
+
+    // Construction and start are sequential: the subproblems are registered in the SubproblemManager.
+    std::vector<std::unique_ptr<NOMAD::SimpleMads>> madsRuns;
+    for (const auto & x0 : x0s)
+    {
+        auto pbParams = std::make_shared<NOMAD::PbParameters>(*_optPbParams);
+        pbParams->setAttributeValue("X0", NOMAD::ArrayOfPoint{x0});
+        pbParams->checkAndComply();
+
+        auto madsStopReasons = std::make_shared<NOMAD::AlgoStopReasons<NOMAD::MadsStopType>>();
+        madsRuns.push_back(std::make_unique<NOMAD::SimpleMads>(this, madsStopReasons, _optRunParams, pbParams, _model, bbot, singleObjCompute, maxModelEvalPerRun));
+        madsRuns.back()->start();
+    }
+
+    // Each simple Mads has its own barrier, mesh and random number generator, and
+    // evaluates the model (reentrant prediction) without the evaluator control.
+    // The runs are done without the Step bookkeeping: worker threads are not main threads of the evaluator control.
+    std::vector<char> runOk(nbRuns, false);
+    std::vector<std::exception_ptr> runErrors(nbRuns);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(nbThreads) schedule(dynamic,1)
+#endif // _OPENMP
+    for (int k = 0; k < static_cast<int>(nbRuns); k++)
+    {
+        // Exceptions cannot leave the parallel region.
+        try
+        {
+            runOk[k] = madsRuns[k]->runInWorkerThread();
+        }
+        catch (...)
+        {
+            runErrors[k] = std::current_exception();
+        }
+    }
+    for (const auto & runError : runErrors)
+    {
+        if (nullptr != runError)
+        {
+            std::rethrow_exception(runError);
+        }
+    }
+
+    // Collect the best feasible and infeasible points of the runs, with their model f and h.
+    struct Candidate
+    {
+        NOMAD::EvalPoint x;
+        NOMAD::Double f;
+        NOMAD::Double h;
+    };
+    std::vector<Candidate> feasCandidates, infCandidates;
+    bool anyRunOk = false;
+    for (size_t k = 0; k < nbRuns; k++)
+    {
+        madsRuns[k]->end();
+        if (!runOk[k])
+        {
+            continue;
+        }
+        anyRunOk = true;
+
+        auto xFeas = madsRuns[k]->getBestSolution(true);
+        if (xFeas.isComplete())
+        {
+            const auto & simpleFeas = madsRuns[k]->getBestSimpleSolution(true);
+            feasCandidates.push_back({xFeas, simpleFeas.getF(), simpleFeas.getH()});
+        }
+        auto xInf = madsRuns[k]->getBestSolution(false);
+        if (xInf.isComplete())
+        {
+            const auto & simpleInf = madsRuns[k]->getBestSimpleSolution(false);
+            infCandidates.push_back({xInf, simpleInf.getF(), simpleInf.getH()});
+        }
+    }
+
+    std::stable_sort(feasCandidates.begin(), feasCandidates.end(),
+                     [](const Candidate & c1, const Candidate & c2) { return c1.f < c2.f; });
+    std::stable_sort(infCandidates.begin(), infCandidates.end(),
+                     [](const Candidate & c1, const Candidate & c2) { return (c1.h < c2.h) || (c1.h == c2.h && c1.f < c2.f); });
+
+    // Runs converging to the same minimizer give points that differ by about the final mesh size.
+    // Such points are duplicates: only the best one is kept.
+    std::vector<NOMAD::Point> selected;
+    auto isDuplicate = [&](const NOMAD::Point & x) -> bool
+    {
+        for (const auto & y : selected)
+        {
+            bool same = (x.size() == y.size());
+            for (size_t i = 0; same && i < x.size(); i++)
+            {
+                NOMAD::Double tol = MULTI_START_DUPLICATE_TOL;
+                if (x.size() == _modelLowerBound.size() && _modelLowerBound[i].isDefined() && _modelUpperBound[i].isDefined())
+                {
+                    tol *= _modelUpperBound[i] - _modelLowerBound[i];
+                }
+                same = ((x[i] - y[i]).abs() <= tol);
+            }
+            if (same)
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    _bestXFeas.reset();
+    _bestXInf.reset();
+    for (auto * candidates : {&feasCandidates, &infCandidates})
+    {
+        const bool feas = (candidates == &feasCandidates);
+        for (const auto & c : *candidates)
+        {
+            if (feas && nullptr == _bestXFeas)
+            {
+                _bestXFeas = std::make_shared<NOMAD::EvalPoint>(c.x);
+            }
+            else if (!feas && nullptr == _bestXInf)
+            {
+                _bestXInf = std::make_shared<NOMAD::EvalPoint>(c.x);
+            }
+
+            if (isDuplicate(c.x))
+            {
+                continue;
+            }
+            selected.push_back(c.x);
+
+            // New EvalPoint to be evaluated.
+            // Add it to the list (local or in Search method).
+            bool inserted = insertTrialPoint(c.x);
+
+            OUTPUT_INFO_START
+            std::string s = "xt:";
+            s += (inserted) ? " " : " not inserted: ";
+            s += c.x.display();
+            AddOutputInfo(s);
+            OUTPUT_INFO_END
+        }
+    }
+
+    return anyRunOk;
+}
+
+
 // Set the bounds and the extra fixed variables (when lb=ub) of the model.
 void NOMAD::QuadModelOptimize::setModelBoundsAndFixedVar()
 {
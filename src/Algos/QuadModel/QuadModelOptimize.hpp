@@ -3,6 +3,7 @@
 
 #include "../../Algos/Step.hpp"
 #include "../../Algos/QuadModel/QuadModelIterationUtils.hpp"
+#include "../../Type/ComputeType.hpp"
 
 #include "../../nomad_nsbegin.hpp"
 
@@ -36,7 +37,9 @@ private:
     
     bool _flagPriorCombineObjsForModel;
 
-    
+    /// Multi-start: two best points are duplicates when they differ by less than this fraction of the model bounds.
+    static constexpr double MULTI_START_DUPLICATE_TOL = 1e-6;
+
 public:
     /// Constructor
     /* Parent must explicitly be a (pointer to a) QuadModelAlgo.
@@ -71,6 +74,7 @@ public:
      - Setup run and pb parameters for Mads
      - Perform start, run and end tasks on Mads.
      - best feasible and best infeasible (if available) are inserted as trial points.
+     - With QUAD_MODEL_SEARCH_NB_STARTS > 1, several simple Mads are run concurrently from different starting points and the distinct best points of all runs are inserted as trial points.
      */
     void generateTrialPointsImp() override;
         
@@ -87,6 +91,15 @@ private:
     void setupPbParameters();
     void setModelBoundsAndFixedVar();
 
+    /// Starting points for multi-start: model center, best points of the training set and LH samples in the model bounds.
+    std::vector<Point> generateStartPoints(const size_t nbStarts) const;
+
+    /// Run one simple Mads per starting point on the available threads and insert the distinct best points as trial points.
+    bool runMultiStart(const size_t nbStarts,
+                       const size_t maxModelEval,
+                       const BBOutputTypeList & bbot,
+                       const singleOutputComputeFType & singleObjCompute);
+
 };
 
 #include "../../nomad_nsend.hpp"
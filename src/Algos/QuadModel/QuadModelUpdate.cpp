@@ -6,6 +6,9 @@
 #include "../../Algos/QuadModel/QuadModelUpdate.hpp"
 #include "../../Cache/CacheBase.hpp"
 #include "../../Output/OutputQueue.hpp"
+#ifdef TIME_STATS
+#include "../../Util/Instrumentation.hpp"
+#endif // TIME_STATS
 
 #include "../../../ext/sgtelib/src/Surrogate_PRS.hpp"
 
@@ -445,6 +448,9 @@ bool NOMAD::QuadModelUpdate::runImp()
         AddOutputInfo("Build model from training set...", _displayLevel);
         OUTPUT_INFO_END
 
+#ifdef TIME_STATS
+        NOMAD::Instrumentation::incCounter(NOMAD::InstrumentationCounter::MODEL_BUILD);
+#endif // TIME_STATS
         if (model->build())
         {
             OUTPUT_INFO_START
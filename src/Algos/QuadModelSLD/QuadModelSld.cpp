@@ -6,6 +6,78 @@
  \see    QuadModelSld.hpp
  */
 #include "../../Algos/QuadModelSLD/QuadModelSld.hpp"
+#include "../../Math/MatrixUtils.hpp"
+#include "../../../ext/sgtelib/src/Linear_Algebra.hpp"
+
+#include <algorithm>
+
+namespace {
+
+    // Bounds for the incremental construction of the regression model.
+    const double REGRESSION_STATE_MAX_COND    = 1e10; // Max condition number of M'M estimated from its Cholesky factor
+    const double REGRESSION_STATE_MAX_SCALING = 10.0; // Max ratio between the current and the stored scaling
+
+    // Cholesky factorization A = L.L' of the n x n row-major matrix A (lower part), in place.
+    bool cholesky_factor ( std::vector<double> & A , int n )
+    {
+        for ( int j = 0 ; j < n ; ++j )
+        {
+            double d = A[j*n+j];
+            for ( int k = 0 ; k < j ; ++k )
+                d -= A[j*n+k] * A[j*n+k];
+            if ( d <= 0.0 )
+                return false;
+            d = std::sqrt ( d );
+            A[j*n+j] = d;
+            for ( int i = j+1 ; i < n ; ++i )
+            {
+                double v = A[i*n+j];
+                for ( int k = 0 ; k < j ; ++k )
+                    v -= A[i*n+k] * A[j*n+k];
+                A[i*n+j] = v / d;
+            }
+            for ( int k = j+1 ; k < n ; ++k )
+                A[j*n+k] = 0.0;
+        }
+        return true;
+    }
+
+    // Rank-one update (sign=1) or downdate (sign=-1) of the Cholesky factor: L.L' + sign x.x'.
+    // x is overwritten. Return false if the downdated matrix is not positive definite.
+    bool cholesky_rank_one ( std::vector<double> & L , int n , std::vector<double> & x , double sign )
+    {
+        for ( int k = 0 ; k < n ; ++k )
+        {
+            const double Lkk = L[k*n+k];
+            const double r2  = Lkk * Lkk + sign * x[k] * x[k];
+            if ( r2 <= 0.0 )
+                return false;
+            const double r = std::sqrt ( r2 );
+            const double c = r / Lkk;
+            const double s = x[k] / Lkk;
+            L[k*n+k] = r;
+            for ( int i = k+1 ; i < n ; ++i )
+            {
+                L[i*n+k] = ( L[i*n+k] + sign * s * x[i] ) / c;
+                x[i]     = c * x[i] - s * L[i*n+k];
+            }
+        }
+        return true;
+    }
+
+    // Lexicographic order of points, to match the interpolation points between two constructions.
+    bool point_less ( const NOMAD::Point & x , const NOMAD::Point & y )
+    {
+        for ( size_t i = 0 ; i < x.size() ; ++i )
+        {
+            if ( x[i].todouble() < y[i].todouble() )
+                return true;
+            if ( x[i].todouble() > y[i].todouble() )
+                return false;
+        }
+        return false;
+    }
+}
 
 /*-----------------------------------------------------------*/
 /*                         constructor                       */
@@ -18,7 +90,8 @@ _nfree                ( static_cast<int>(n)                 ) ,
 _fixed_vars           ( new bool [_n]                       ) ,
 _index                ( nullptr                             ) ,
 _alpha                ( nullptr                             ) ,
-_error_flag           ( true                                )
+_error_flag           ( true                                ) ,
+_regression_state     ( nullptr                             )
 {
     for ( int i = 0 ; i < _n ; ++i )
         _fixed_vars[i] = false;
@@ -695,10 +768,11 @@ double NOMAD::QuadModelSld::compute_M ( int i , int j ) const
 /*-----------------------------------------------------------*/
 /*               construct m models (one by output)          */
 /*-----------------------------------------------------------*/
-void NOMAD::QuadModelSld::construct ( bool   use_WP     ,
-                                   double eps        ,
-                                   int    max_mpn    ,
-                                   int    max_Y_size   )
+void NOMAD::QuadModelSld::construct ( bool   use_WP      ,
+                                   double eps         ,
+                                   int    max_mpn     ,
+                                   int    max_Y_size  ,
+                                   bool   incremental   )
 {
     if ( _error_flag )
         return;
@@ -729,7 +803,7 @@ void NOMAD::QuadModelSld::construct ( bool   use_WP     ,
         if ( _error_flag )
         {
             _interpolation_type = NOMAD::REGRESSION;
-            _error_flag = !construct_regression_model ( eps , max_mpn , max_Y_size );
+            _error_flag = !construct_regression_model ( eps , max_mpn , max_Y_size , incremental );
         }
     }
 }
@@ -1026,9 +1100,10 @@ bool NOMAD::QuadModelSld::construct_WP_model ( int max_Y_size )
 /*-----------------------------------------------------------*/
 /*             construct regression model (private)          */
 /*-----------------------------------------------------------*/
-bool NOMAD::QuadModelSld::construct_regression_model ( double eps        ,
-                                                    int    max_mpn    ,
-                                                    int    max_Y_size   )
+bool NOMAD::QuadModelSld::construct_regression_model ( double eps         ,
+                                                    int    max_mpn     ,
+                                                    int    max_Y_size  ,
+                                                    bool   incremental   )
 {
 #ifdef DEBUG
     _out << std::endl
@@ -1037,6 +1112,9 @@ bool NOMAD::QuadModelSld::construct_regression_model ( double eps        ,
     
     _error_flag = false;
     
+    // the normal equations are kept by the owner of the regression state:
+    incremental = incremental && ( nullptr != _regression_state );
+    
     // check the set Y:
     if ( !check_Y() )
         return false;
@@ -1065,6 +1143,17 @@ bool NOMAD::QuadModelSld::construct_regression_model ( double eps        ,
         // p1 = 500;
     }
     
+    // update of the previous normal equations (Y changed by a few points):
+    // --------------------------------------------------------------------
+    if ( incremental && update_regression_model() )
+    {
+#ifdef DEBUG
+        _out << std::endl << "incremental construction, cond=" << _cond
+        << std::endl << NOMAD::close_block() << std::endl;
+#endif
+        return true;
+    }
+    
     // construct the matrix F=M'M (_n_alpha,_n_alpha):
     // -----------------------------------------------
     int       i , j , k;
@@ -1103,6 +1192,19 @@ bool NOMAD::QuadModelSld::construct_regression_model ( double eps        ,
     
     bool error = false;
     
+    // copy of F=M'M for the next incremental construction:
+    double ** F_copy = nullptr;
+    if ( incremental )
+    {
+        F_copy = new double *[_n_alpha];
+        for ( i = 0 ; i < _n_alpha ; ++i )
+        {
+            F_copy[i] = new double[_n_alpha];
+            for ( j = 0 ; j < _n_alpha ; ++j )
+                F_copy[i][j] = F[i][j];
+        }
+    }
+    
     // SVD decomposition of the F matrix (F=U.W.V'):
     // ---------------------------------------------
     // (F will be transformed in U)
@@ -1165,9 +1267,18 @@ bool NOMAD::QuadModelSld::construct_regression_model ( double eps        ,
         for ( i = 0 ; i < m ; ++i )
             if ( _alpha[i] )
                 solve_regression_system ( M , F , W  , V , i , *_alpha[i] , eps );
+        
+        if ( incremental )
+            store_regression_state ( M , F_copy );
     }
     
     // free memory:
+    if ( nullptr != F_copy )
+    {
+        for ( i = 0 ; i < _n_alpha ; ++i )
+            delete [] F_copy[i];
+        delete [] F_copy;
+    }
     for ( i = 0 ; i < _n_alpha ; ++i )
     {
         delete [] F[i];
@@ -1225,15 +1336,17 @@ void NOMAD::QuadModelSld::solve_regression_system ( double      ** M         ,
     double * alpha_tmp  = new double [_n_alpha];
     int      i , k , p1 = get_nY();
     
+    // outputs f(Y), converted once:
+    std::vector<double> fY ( p1 );
+    for ( k = 0 ; k < p1 ; ++k )
+        fY[k] = _Y[k].getEval(NOMAD::EvalType::BB)->getBBOutput().getBBOAsArrayOfDouble()[bbo_index].todouble();
+    
     // solve the system:
     for ( i = 0 ; i < _n_alpha ; ++i )
     {
         alpha_tmp[i] = 0.0;
         for ( k = 0 ; k < p1 ; ++k )
-        {
-            NOMAD::ArrayOfDouble bbo = _Y[k].getEval(NOMAD::EvalType::BB)->getBBOutput().getBBOAsArrayOfDouble();
-            alpha_tmp[i] += M[k][i] * ( bbo[bbo_index].todouble() );
-        }
+            alpha_tmp[i] += M[k][i] * fY[k];
     }
     
     double * alpha_tmp2 = new double [_n_alpha];
@@ -1261,6 +1374,277 @@ void NOMAD::QuadModelSld::solve_regression_system ( double      ** M         ,
     delete [] alpha_tmp2;
 }
 
+/*----------------------------------------------------------------*/
+/*  row of the interpolation matrix M(phi,Y) for an unscaled      */
+/*  point and a given scaling (private)                           */
+/*----------------------------------------------------------------*/
+void NOMAD::QuadModelSld::compute_phi ( const NOMAD::Point & x       ,
+                                     const NOMAD::Point & ref     ,
+                                     const NOMAD::Point & scaling ,
+                                     double             * phi       ) const
+{
+    std::vector<double> xs ( _nfree );
+    int i , k = 0;
+    for ( i = 0 ; i < _n ; ++i )
+        if ( !_fixed_vars[i] )
+            xs[k++] = ( x[i].todouble() - ref[i].todouble() ) / scaling[i].todouble();
+    
+    phi[0] = 1.0;
+    for ( k = 0 ; k < _nfree ; ++k )
+    {
+        phi[k+1       ] = xs[k];
+        phi[k+1+_nfree] = 0.5 * xs[k] * xs[k];
+    }
+    int c = 2 * _nfree + 1;
+    for ( int k1 = 0 ; k1 < _nfree - 1 ; ++k1 )
+        for ( int k2 = k1+1 ; k2 < _nfree ; ++k2 )
+            phi[c++] = xs[k1] * xs[k2];
+}
+
+/*----------------------------------------------------------------*/
+/*  keep the normal equations of a full regression construction   */
+/*  (private)                                                     */
+/*----------------------------------------------------------------*/
+void NOMAD::QuadModelSld::store_regression_state ( double ** M , double ** F )
+{
+    RegressionState & state = *_regression_state;
+    state.valid = false;
+    
+    int i , j , k;
+    const int m  = static_cast<int> ( _bbot.size() );
+    const int p1 = get_nY();
+    
+    state.L.resize ( _n_alpha * _n_alpha );
+    for ( i = 0 ; i < _n_alpha ; ++i )
+        for ( j = 0 ; j < _n_alpha ; ++j )
+            state.L[i*_n_alpha+j] = F[i][j];
+    if ( !cholesky_factor ( state.L , _n_alpha ) )
+        return;
+    
+    state.n_alpha    = _n_alpha;
+    state.nb_updates = 0;
+    state.fixed_vars.assign ( _fixed_vars , _fixed_vars + _n );
+    state.ref        = _ref;
+    state.scaling    = _scaling;
+    state.X          = _Y_unscaled;
+    
+    state.active.assign ( m , false );
+    for ( i = 0 ; i < m ; ++i )
+        state.active[i] = ( nullptr != _alpha[i] );
+    
+    state.bbo.assign ( p1 , std::vector<double> ( m , 0.0 ) );
+    for ( k = 0 ; k < p1 ; ++k )
+    {
+        const NOMAD::ArrayOfDouble bbo = _Y[k].getEval(NOMAD::EvalType::BB)->getBBOutput().getBBOAsArrayOfDouble();
+        for ( i = 0 ; i < m ; ++i )
+            if ( _alpha[i] )
+                state.bbo[k][i] = bbo[i].todouble();
+    }
+    
+    state.rhs.assign ( m , std::vector<double> ( _n_alpha , 0.0 ) );
+    for ( i = 0 ; i < m ; ++i )
+    {
+        if ( !_alpha[i] )
+            continue;
+        for ( k = 0 ; k < p1 ; ++k )
+            for ( j = 0 ; j < _n_alpha ; ++j )
+                state.rhs[i][j] += M[k][j] * state.bbo[k][i];
+    }
+    
+    state.valid = true;
+}
+
+/*----------------------------------------------------------------*/
+/*  construct regression model by updating the normal equations   */
+/*  of the previous construction (private)                        */
+/*----------------------------------------------------------------*/
+/*  . F = L.L' and M'f(Y) are updated with the points that        */
+/*    entered or left Y: O(n_alpha^2) per point instead of the    */
+/*    O(p.n_alpha^2 + n_alpha^3) of a full construction           */
+/*  . the coefficients obtained in the stored scaling are mapped  */
+/*    to the current scaling                                      */
+/*----------------------------------------------------------------*/
+bool NOMAD::QuadModelSld::update_regression_model ( void )
+{
+    if ( nullptr == _regression_state )
+        return false;
+    RegressionState & state = *_regression_state;
+    
+    int i , j , k;
+    const int m  = static_cast<int> ( _bbot.size() );
+    const int p1 = get_nY();
+    
+    if ( !state.valid                                           ||
+        state.n_alpha != _n_alpha                               ||
+        static_cast<int> ( state.fixed_vars.size() ) != _n      ||
+        static_cast<int> ( state.rhs.size() ) != m              ||
+        static_cast<int> ( _Y_unscaled.size() ) != p1              )
+        return false;
+    
+    // same outputs with a model:
+    for ( i = 0 ; i < m ; ++i )
+        if ( state.active[i] != ( nullptr != _alpha[i] ) )
+            return false;
+    
+    // same fixed variables and close scaling:
+    std::vector<double> sa , sb;
+    for ( i = 0 ; i < _n ; ++i )
+    {
+        if ( state.fixed_vars[i] != _fixed_vars[i] )
+            return false;
+        if ( _fixed_vars[i] )
+            continue;
+        const double ratio = _scaling[i].todouble() / state.scaling[i].todouble();
+        if ( ratio > REGRESSION_STATE_MAX_SCALING || ratio * REGRESSION_STATE_MAX_SCALING < 1.0 )
+            return false;
+        sa.push_back ( ratio );
+        sb.push_back ( ( _ref[i].todouble() - state.ref[i].todouble() ) / state.scaling[i].todouble() );
+    }
+    
+    // match the points of Y with the points of the normal equations:
+    const int nX = static_cast<int> ( state.X.size() );
+    std::vector<int> order ( nX );
+    for ( k = 0 ; k < nX ; ++k )
+        order[k] = k;
+    std::sort ( order.begin() , order.end() ,
+               [&state] ( int a , int b ) { return point_less ( state.X[a] , state.X[b] ); } );
+    
+    // a stored point is kept when its outputs are also the same:
+    std::vector<std::vector<double>> f ( p1 , std::vector<double> ( m , 0.0 ) );
+    std::vector<bool> kept ( nX , false );
+    std::vector<int>  added , removed;
+    for ( k = 0 ; k < p1 ; ++k )
+    {
+        const NOMAD::ArrayOfDouble bbo = _Y[k].getEval(NOMAD::EvalType::BB)->getBBOutput().getBBOAsArrayOfDouble();
+        for ( i = 0 ; i < m ; ++i )
+            if ( _alpha[i] )
+                f[k][i] = bbo[i].todouble();
+        
+        const NOMAD::Point & y = _Y_unscaled[k];
+        auto it = std::lower_bound ( order.begin() , order.end() , y ,
+                                    [&state] ( int a , const NOMAD::Point & x ) { return point_less ( state.X[a] , x ); } );
+        if ( it != order.end() && !point_less ( y , state.X[*it] ) && !kept[*it] && state.bbo[*it] == f[k] )
+            kept[*it] = true;
+        else
+            added.push_back ( k );
+    }
+    for ( k = nX - 1 ; k >= 0 ; --k )
+        if ( !kept[k] )
+            removed.push_back ( k );
+    
+    // beyond this number of changes, a full construction is cheaper or more accurate:
+    const int nb_changes = static_cast<int> ( added.size() + removed.size() );
+    if ( 2 * nb_changes > _n_alpha || state.nb_updates + nb_changes > p1 )
+        return false;
+    
+    // rank-one updates, then downdates:
+    std::vector<double> phi ( _n_alpha );
+    for ( int ka : added )
+    {
+        compute_phi ( _Y_unscaled[ka] , state.ref , state.scaling , phi.data() );
+        for ( i = 0 ; i < m ; ++i )
+            if ( _alpha[i] )
+                for ( j = 0 ; j < _n_alpha ; ++j )
+                    state.rhs[i][j] += phi[j] * f[ka][i];
+        cholesky_rank_one ( state.L , _n_alpha , phi , 1.0 );
+        
+        state.X.push_back   ( _Y_unscaled[ka] );
+        state.bbo.push_back ( f[ka] );
+    }
+    for ( int kr : removed )
+    {
+        compute_phi ( state.X[kr] , state.ref , state.scaling , phi.data() );
+        for ( i = 0 ; i < m ; ++i )
+            if ( _alpha[i] )
+                for ( j = 0 ; j < _n_alpha ; ++j )
+                    state.rhs[i][j] -= phi[j] * state.bbo[kr][i];
+        if ( !cholesky_rank_one ( state.L , _n_alpha , phi , -1.0 ) )
+        {
+            state.valid = false;
+            return false;
+        }
+        state.X.erase   ( state.X.begin()   + kr );
+        state.bbo.erase ( state.bbo.begin() + kr );
+    }
+    state.nb_updates += nb_changes;
+    
+    // condition number estimated from the diagonal of L:
+    double dmin = NOMAD::INF , dmax = 0.0;
+    for ( j = 0 ; j < _n_alpha ; ++j )
+    {
+        const double d = state.L[j*_n_alpha+j];
+        dmin = std::min ( dmin , d );
+        dmax = std::max ( dmax , d );
+    }
+    const double cond = ( dmax / dmin ) * ( dmax / dmin );
+    if ( !( cond <= REGRESSION_STATE_MAX_COND ) )
+    {
+        state.valid = false;
+        return false;
+    }
+    _cond = cond;
+    
+    // resolution of L.L'.a = M'.f(Y) and change of scaling:
+    // x_stored = sa.x + sb, where x is scaled with the current scaling
+    std::vector<double> a ( _n_alpha ) , Hb ( _nfree );
+    for ( i = 0 ; i < m ; ++i )
+    {
+        if ( !_alpha[i] )
+            continue;
+        
+        a = state.rhs[i];
+        for ( j = 0 ; j < _n_alpha ; ++j )
+        {
+            for ( k = 0 ; k < j ; ++k )
+                a[j] -= state.L[j*_n_alpha+k] * a[k];
+            a[j] /= state.L[j*_n_alpha+j];
+        }
+        for ( j = _n_alpha - 1 ; j >= 0 ; --j )
+        {
+            for ( k = j+1 ; k < _n_alpha ; ++k )
+                a[j] -= state.L[k*_n_alpha+j] * a[k];
+            a[j] /= state.L[j*_n_alpha+j];
+        }
+        
+        // constant term and H.sb:
+        double c0 = a[0];
+        for ( k = 0 ; k < _nfree ; ++k )
+        {
+            const double hkk = a[k+1+_nfree];
+            c0   += a[k+1] * sb[k] + 0.5 * hkk * sb[k] * sb[k];
+            Hb[k] = hkk * sb[k];
+        }
+        int c = 2 * _nfree + 1;
+        for ( int k1 = 0 ; k1 < _nfree - 1 ; ++k1 )
+            for ( int k2 = k1+1 ; k2 < _nfree ; ++k2 )
+            {
+                const double h = a[c++];
+                c0     += h * sb[k1] * sb[k2];
+                Hb[k1] += h * sb[k2];
+                Hb[k2] += h * sb[k1];
+            }
+        
+        NOMAD::Point & alpha = *_alpha[i];
+        if ( alpha.size() != _n_alpha )
+            alpha.reset ( _n_alpha , 0.0 );
+        alpha[0] = c0;
+        for ( k = 0 ; k < _nfree ; ++k )
+        {
+            alpha[k+1       ] = sa[k] * ( a[k+1] + Hb[k] );
+            alpha[k+1+_nfree] = sa[k] * sa[k] * a[k+1+_nfree];
+        }
+        c = 2 * _nfree + 1;
+        for ( int k1 = 0 ; k1 < _nfree - 1 ; ++k1 )
+            for ( int k2 = k1+1 ; k2 < _nfree ; ++k2 )
+            {
+                alpha[c] = sa[k1] * sa[k2] * a[c];
+                ++c;
+            }
+    }
+    
+    return true;
+}
+
 /*----------------------------------------------------------*/
 /*  construct Minimum Frobenius Norm (MFN) model (private)  */
 /*----------------------------------------------------------*/
@@ -1479,6 +1863,10 @@ void NOMAD::QuadModelSld::solve_MFN_system ( double      ** F         ,
     double * mu_tmp    = new double [ p1];
     double * mu        = new double [ p1];
     
+    // outputs f(Y), converted once:
+    std::vector<double> fY ( p1 );
+    for ( k = 0 ; k < p1 ; ++k )
+        fY[k] = _Y[k].getEval(NOMAD::EvalType::BB)->getBBOutput().getBBOAsArrayOfDouble()[bbo_index].todouble();
     
     // if F is singular, some W values will be zero (or near zero);
     // each value that is smaller than eps is ignored:
@@ -1487,11 +1875,7 @@ void NOMAD::QuadModelSld::solve_MFN_system ( double      ** F         ,
         mu_tmp[i] = 0.0;
         if ( W[i] > eps )
             for ( k = 0 ; k < p1 ; ++k )
-            {
-                NOMAD::ArrayOfDouble bbo = _Y[k].getEval(NOMAD::EvalType::BB)->getBBOutput().getBBOAsArrayOfDouble();
-                mu_tmp[i] += F[k][i] *
-                ( bbo[bbo_index].todouble() ) / W[i];
-            }
+                mu_tmp[i] += F[k][i] * fY[k] / W[i];
     }
     
     for ( i = p1 ; i < nF ; ++i )
@@ -1499,11 +1883,7 @@ void NOMAD::QuadModelSld::solve_MFN_system ( double      ** F         ,
         alpha_tmp[i-p1] = 0.0;
         if ( W[i] > eps )
             for ( k = 0 ; k < p1 ; ++k )
-            {
-                NOMAD::ArrayOfDouble bbo = _Y[k].getEval(NOMAD::EvalType::BB)->getBBOutput().getBBOAsArrayOfDouble();
-                alpha_tmp[i-p1] += F[k][i] *
-                ( bbo[bbo_index].todouble() ) / W[i];
-            }
+                alpha_tmp[i-p1] += F[k][i] * fY[k] / W[i];
     }
     
     for ( i = 0 ; i < p1 ; ++i )
@@ -2149,6 +2529,12 @@ bool NOMAD::QuadModelSld::SVD_decomposition ( std::string & error_msg ,
         error_msg = "SVD_decomposition() error: m+n > " + NOMAD::itos ( max_mpn );
         return false;
     }
+
+    // Large matrices: dense linear algebra backend (LAPACK), through MatrixUtils
+    if ( SGTELIB::linalg::use_backend ( n ) && m >= n )
+    {
+        return NOMAD::SVD_decomposition ( error_msg , M , W , V , m , n , max_mpn );
+    }
     
     double * rv1   = new double[n];
     double   scale = 0.0;
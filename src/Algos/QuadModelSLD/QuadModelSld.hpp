@@ -34,9 +34,35 @@ enum hnorm_type
 class QuadModelSld  
 {
     
+public:
+    
+    /// Normal equations of the regression model, kept between two model constructions.
+    /**
+     The Cholesky factor of \c F=M'M and the right-hand sides \c M'f(Y) are
+     expressed in the scaling of the full construction that created them.
+     They are updated when points enter or leave \c Y. A point of \c Y is
+     matched with a stored point when both its coordinates and its outputs
+     are the same.
+     */
+    struct RegressionState
+    {
+        bool                             valid = false;
+        int                              n_alpha = 0;
+        int                              nb_updates = 0; ///< Points added or removed since the full construction.
+        std::vector<bool>                fixed_vars;
+        Point                            ref;
+        Point                            scaling;
+        std::vector<Point>               X;              ///< Unscaled points of the normal equations.
+        std::vector<std::vector<double>> bbo;            ///< Outputs of these points.
+        std::vector<bool>                active;         ///< Outputs with a model.
+        std::vector<double>              L;              ///< Cholesky factor of \c F (row-major, lower triangular).
+        std::vector<std::vector<double>> rhs;            ///< \c M'f(Y), one vector per output.
+    };
+    
 private:
     
     std::vector<EvalPoint>                    _Y;    ///< Interpolation points.
+    std::vector<Point>                _Y_unscaled;    ///< Interpolation points before scaling.
     
     const BBOutputTypeList _bbot; ///< Blackbox output types.
     
@@ -59,6 +85,8 @@ private:
     
     Double             _cond;                  ///< Condition number.
     
+    std::shared_ptr<RegressionState> _regression_state; ///< Normal equations of the previous regression construction (can be null).
+    
     /// Initialize alpha (model parameters).
     void init_alpha ( void );
     
@@ -143,14 +171,43 @@ private:
     /// Construct regression model.
     /**
      - This occurs when \c p+1 \c >= \c (n+1)(n+2)/2.
-     \param eps        Epsilon                               -- \b IN.
-     \param max_mpn    Maximum \c m+n value for SVD matrices -- \b IN.
-     \param max_Y_size Maximum number of elements in \c Y    -- \b IN.
+     \param eps         Epsilon                                -- \b IN.
+     \param max_mpn     Maximum \c m+n value for SVD matrices  -- \b IN.
+     \param max_Y_size  Maximum number of elements in \c Y     -- \b IN.
+     \param incremental Update the normal equations of the previous construction -- \b IN.
      \return \c true if the construction succeeded
      */
-    bool construct_regression_model ( double eps        ,
-                                     int    max_mpn    ,
-                                     int    max_Y_size   );
+    bool construct_regression_model ( double eps         ,
+                                     int    max_mpn     ,
+                                     int    max_Y_size  ,
+                                     bool   incremental   );
+    
+    /// Construct regression model by updating the normal equations of the previous construction.
+    /**
+     - The points that entered or left \c Y are added to or removed from the
+       Cholesky factor of \c M'M by rank-one updates, and the model
+       coefficients are mapped to the current scaling.
+     - Fails when the previous state does not match (fixed variables, too many
+       changes, scaling too different) or when the factor is ill-conditioned.
+     \return \c true if the construction succeeded, \c false if a full construction is needed.
+     */
+    bool update_regression_model ( void );
+    
+    /// Keep the normal equations of a full regression construction.
+    /**
+     \param M The \c (p+1)x(n_alpha) interpolation matrix -- \b IN.
+     \param F The \c n_alpha x n_alpha matrix \c M'M      -- \b IN.
+     */
+    void store_regression_state ( double ** M , double ** F );
+    
+    /// Compute the row of the interpolation matrix for an unscaled point and a given scaling.
+    /**
+     \param x       The unscaled point          -- \b IN.
+     \param ref     Reference of the scaling    -- \b IN.
+     \param scaling Scaling                     -- \b IN.
+     \param phi     The row, of size \c n_alpha -- \b OUT.
+     */
+    void compute_phi ( const Point & x , const Point & ref , const Point & scaling , double * phi ) const;
     
     /// Construct well-poised (WP) model.
     /**
@@ -263,10 +320,19 @@ public:
     /// Destructor.
     virtual ~QuadModelSld ( void );
     
+    /// Set the normal equations kept between regression constructions.
+    /**
+     The state belongs to the caller (for example the model search of a Mads run).
+     Without a state, regression models are always fully constructed.
+     \param state The regression state -- \b IN.
+     */
+    void set_regression_state ( const std::shared_ptr<RegressionState> & state ) { _regression_state = state; }
+    
     void setY(const std::vector<EvalPoint> & evalPoints)
     {
         _Y.resize(evalPoints.size());
         std::copy(evalPoints.begin(), evalPoints.end(), _Y.begin());
+        _Y_unscaled.assign(evalPoints.begin(), evalPoints.end());
         _error_flag = false;
     }
     
@@ -371,15 +437,20 @@ public:
     
     /// Construct \c m models (one by output).
     /**
-     \param use_WP     Use or not well-poisedness            -- \b IN.
-     \param eps        Epsilon                               -- \b IN.
-     \param max_mpn    Maximum \c m+n value for SVD matrices -- \b IN.
-     \param max_Y_size Maximum number of elements in \c Y    -- \b IN.
-     */
-    void construct ( bool   use_WP     ,
-                    double eps        ,
-                    int    max_mpn    ,
-                    int    max_Y_size   );
+     \param use_WP      Use or not well-poisedness            -- \b IN.
+     \param eps         Epsilon                               -- \b IN.
+     \param max_mpn     Maximum \c m+n value for SVD matrices -- \b IN.
+     \param max_Y_size  Maximum number of elements in \c Y    -- \b IN.
+     \param incremental Build regression models by updating the previous
+                         construction when \c Y changed by a few points.
+                         Requires a regression state (set_regression_state) -- \b IN
+                         -- \b optional (default = \c false).
+     */
+    void construct ( bool   use_WP             ,
+                    double eps                ,
+                    int    max_mpn            ,
+                    int    max_Y_size         ,
+                    bool   incremental = false  );
     
     /// Define scaling to put all coordinates centered in \c [-r;r].
     /**
@@ -119,11 +119,9 @@ bool NOMAD::QuadModelSldEvaluator::eval_x(NOMAD::EvalPoint &x,
     
     // Reset point outputs
     // By default, set everything to -1
-    // Note: Currently NOMAD cannot set a bbo value by index, so we have to
-    // work around by constructing a suitable string.
     // Note: Why set some default values on bbo?
-    NOMAD::ArrayOfString defbbo(_m, "-1");
-    x.setBBO(defbbo.display(), _bbOutputTypeList, _evalType);
+    NOMAD::ArrayOfDouble bbo(_m, -1.0);
+    x.setBBO(bbo, _bbOutputTypeList, _evalType);
     
     // ------------------------- //
     //   Output Prediction    //
@@ -146,8 +144,6 @@ bool NOMAD::QuadModelSldEvaluator::eval_x(NOMAD::EvalPoint &x,
     std::string sObj = "F = ";
     std::string sCons = "C = [ ";
     
-    std::string bbo;
-    
     for ( int oi = 0 ; oi < _m ; ++oi )
     {
         z = 0.0;
@@ -183,7 +179,7 @@ bool NOMAD::QuadModelSldEvaluator::eval_x(NOMAD::EvalPoint &x,
         ss.precision(NOMAD::DISPLAY_PRECISION_FULL);
         ss << z;
         
-        bbo+= ss.str() + " " ;
+        bbo[oi] = z;
         if (_bbOutputTypeList[oi] != NOMAD::BBOutputType::OBJ)
             //sCons += std::to_string(z) + " ";
             sCons += ss.str() + " ";
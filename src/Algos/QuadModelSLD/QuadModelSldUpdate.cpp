@@ -242,9 +242,10 @@ bool NOMAD::QuadModelSldUpdate::runImp()
     // construct model:
     // ----------------
     const bool quad_use_WP        = false;
+    const bool quad_incremental   = true;   ///< Regression: update the previous normal equations when Y changed by a few points
     const double SVD_EPS      = 1e-13;      ///< Epsilon for SVD
     const int    SVD_MAX_MPN  = 1500;       ///< Matrix maximal size (\c m+n )
-    model->construct ( quad_use_WP , SVD_EPS , SVD_MAX_MPN , static_cast<int>(maxNbPoints) );
+    model->construct ( quad_use_WP , SVD_EPS , SVD_MAX_MPN , static_cast<int>(maxNbPoints) , quad_incremental );
 
 
     //
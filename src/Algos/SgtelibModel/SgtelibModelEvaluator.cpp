@@ -57,67 +57,97 @@ bool NOMAD::SgtelibModelEvaluator::eval_x(NOMAD::EvalPoint &x,
                                           const NOMAD::Double &hMax,
                                           bool &countEval) const
 {
-    
-    // Convert x to subspace, because model is in subspace.
-    x = x.makeSubSpacePointFromFixed(_fixedVariable);
+    // Evaluate a block of one point.
+    NOMAD::Block block;
+    std::shared_ptr<NOMAD::EvalPoint> epp = std::make_shared<NOMAD::EvalPoint>(x);
+    block.push_back(epp);
 
-    std::string s;
-    OUTPUT_INFO_START
-    s = "X = " + x.display();
-    NOMAD::OutputQueue::Add(s, _displayLevel);
-    OUTPUT_INFO_END
+    std::vector<bool> countEvalVector(1, countEval);
+    std::vector<bool> evalOkVector = eval_block(block, hMax, countEvalVector);
+
+    x = *block[0];
+    countEval = countEvalVector[0];
+
+    return evalOkVector[0];
+}
 
-    size_t n = x.size();
+
+/*------------------------------------------------------------------------*/
+/*               evaluate the sgtelib_model model at given points         */
+/*------------------------------------------------------------------------*/
+std::vector<bool> NOMAD::SgtelibModelEvaluator::eval_block(NOMAD::Block &block,
+                                                           const NOMAD::Double &hMax,
+                                                           std::vector<bool> &countEval) const
+{
+    std::vector<bool> evalOk;
+    countEval.clear();
+
+    // Verify there is at least one point to evaluate
+    if (block.empty())
+    {
+        throw NOMAD::Exception(__FILE__, __LINE__, "Evaluator: eval_block called with an empty block");
+    }
+
+    // Convert points to subspace, because model is in subspace.
+    for (auto& evPt : block)
+    {
+        evPt = std::make_shared<NOMAD::EvalPoint>(evPt->makeSubSpacePointFromFixed(_fixedVariable));
+    }
+
+    std::string s;
+    const int m = static_cast<int>(block.size());
+    size_t n = block[0]->size();
     size_t nbConstraints = NOMAD::getNbConstraints(_bbOutputTypeList);
     size_t nbModels = NOMAD::SgtelibModel::getNbModels(_modelFeasibility, nbConstraints);
     // Init the matrices for prediction
-    SGTELIB::Matrix   M_predict (  "M_predict", 1, static_cast<int>(nbModels));
-    SGTELIB::Matrix STD_predict ("STD_predict", 1, static_cast<int>(nbModels));
-    SGTELIB::Matrix CDF_predict ("CDF_predict", 1, static_cast<int>(nbModels));
-    SGTELIB::Matrix  EI_predict ( "EI_predict", 1, static_cast<int>(nbModels));
-
-
-    // --------------------- //
-    // In/Out Initialisation //
-    // --------------------- //
-    // Declaration of the statistical measurements
-    NOMAD::Double pf = 1; // P[x]
-    NOMAD::Double f = 0; // predicted mean of the objective
-    NOMAD::Double sigma_f = 0; // predicted variance of the objective
-    NOMAD::Double pi = 0; // probability of improvement
-    NOMAD::Double ei = 0; // expected improvement
-    NOMAD::Double efi = 0; // expected feasible improvement
-    NOMAD::Double pfi = 0; // probability of feasible improvement
-    NOMAD::Double mu = 0; // uncertainty on the feasibility
-    NOMAD::Double penalty = 0; // exclusion area penalty
-    NOMAD::Double d = 0; // Distance to the closest point of the cache
+    // All the points of the block are predicted in one call.
+    SGTELIB::Matrix   M_predict (  "M_predict", m, static_cast<int>(nbModels));
+    SGTELIB::Matrix STD_predict ("STD_predict", m, static_cast<int>(nbModels));
+    SGTELIB::Matrix CDF_predict ("CDF_predict", m, static_cast<int>(nbModels));
+    SGTELIB::Matrix  EI_predict ( "EI_predict", m, static_cast<int>(nbModels));
+    // Distance to the closest point of the cache (formulation D)
+    SGTELIB::Matrix  D_predict  (  "D_predict", m, 1);
+    // Exclusion area penalty
+    SGTELIB::Matrix  P_predict  (  "P_predict", m, 1);
 
     // Creation of matrix for input / output of SGTELIB model
-    SGTELIB::Matrix X_predict("X_predict", 1, static_cast<int>(n));
+    SGTELIB::Matrix X_predict("X_predict", m, static_cast<int>(n));
     // Shall we compute statistical criteria
     bool useStatisticalCriteria = false;
-    // FORMULATION USED IN THIS EVAL_X
+    // FORMULATION USED IN THIS EVAL_BLOCK
     const NOMAD::SgtelibModelFormulationType formulation = _modelAlgo->getFormulation();
 
-    // Unfortunately, Sgtelib is not thread-safe.
-    // For this reason we have to set part of the eval_x code to critical.
-#ifdef _OPENMP
-    #pragma omp critical(SgtelibEvalX)
-#endif // _OPENMP
+    // Set the input matrix
+    int j = 0;
+    for (auto it = block.begin(); it != block.end(); it++, j++)
     {
-        // Set the input matrix
+        if (!(*it)->isComplete())
+        {
+            throw NOMAD::Exception(__FILE__, __LINE__, "Evaluator: Incomplete point " + (*it)->display());
+        }
+
+        OUTPUT_INFO_START
+        s = "X = " + (*it)->display();
+        NOMAD::OutputQueue::Add(s, _displayLevel);
+        OUTPUT_INFO_END
+
         for (size_t i = 0; i < n; i++)
         {
-            X_predict.set(0, static_cast<int>(i), x[i].todouble());
+            X_predict.set(j, static_cast<int>(i), (*(*it))[i].todouble());
         }
+    }
 
+    // Sgtelib predictions are reentrant on a ready model: the blocks of
+    // several threads are predicted concurrently.
+    {
         // Reset point outputs
         // By default, set everything to -1
-        // Note: Currently NOMAD cannot set a bbo value by index, so we have to
-        // work around by constructing a suitable string.
         // Note: Why set some default values on bbo?
-        NOMAD::ArrayOfString defbbo(_bbOutputTypeList.size(), "-1");
-        x.setBBO(defbbo.display(), _bbOutputTypeList, _evalType);
+        const NOMAD::ArrayOfDouble defbbo(_bbOutputTypeList.size(), -1.0);
+        for (auto& evPt : block)
+        {
+            evPt->setBBO(defbbo, _bbOutputTypeList, _evalType);
+        }
 
         // ------------------------- //
         //   Objective Prediction    //
@@ -156,16 +186,7 @@ bool NOMAD::SgtelibModelEvaluator::eval_x(NOMAD::EvalPoint &x,
         // Prediction
         if ( formulation == NOMAD::SgtelibModelFormulationType::D )
         {
-            OUTPUT_INFO_START
-            d = _modelAlgo->getTrainingSet()->get_distance_to_closest(X_predict).get(0,0);
-            s = "d = " + d.display();
-            NOMAD::OutputQueue::Add(s, _displayLevel);
-            OUTPUT_INFO_END
-        }
-        else if (formulation == NOMAD::SgtelibModelFormulationType::EXTERN)
-        {
-            throw SGTELIB::Exception(__FILE__, __LINE__,
-                                     "SgtelibModelEvaluator::eval_x: Formulation Extern should not been called in this context.");
+            D_predict = _modelAlgo->getTrainingSet()->get_distance_to_closest(X_predict);
         }
         else
         {
@@ -190,17 +211,56 @@ bool NOMAD::SgtelibModelEvaluator::eval_x(NOMAD::EvalPoint &x,
             OUTPUT_INFO_END
         }
 
+        // ------------------------- //
+        //   exclusion area          //
+        // ------------------------- //
+        if (_tc > 0.0)
+        {
+            P_predict = _modelAlgo->getModel()->get_exclusion_area_penalty(X_predict, _tc);
+        }
+
+    }
+
+    j = 0;
+    for (auto it = block.begin(); it != block.end(); it++, j++)
+    {
+        NOMAD::EvalPoint& x = *(*it);
+
+        // --------------------- //
+        // In/Out Initialisation //
+        // --------------------- //
+        // Declaration of the statistical measurements
+        NOMAD::Double pf = 1; // P[x]
+        NOMAD::Double f = 0; // predicted mean of the objective
+        NOMAD::Double sigma_f = 0; // predicted variance of the objective
+        NOMAD::Double pi = 0; // probability of improvement
+        NOMAD::Double ei = 0; // expected improvement
+        NOMAD::Double efi = 0; // expected feasible improvement
+        NOMAD::Double pfi = 0; // probability of feasible improvement
+        NOMAD::Double mu = 0; // uncertainty on the feasibility
+        NOMAD::Double penalty = 0; // exclusion area penalty
+        NOMAD::Double d = 0; // Distance to the closest point of the cache
+
+        if ( formulation == NOMAD::SgtelibModelFormulationType::D )
+        {
+            d = D_predict.get(j,0);
+            OUTPUT_INFO_START
+            s = "d = " + d.display();
+            NOMAD::OutputQueue::Add(s, _displayLevel);
+            OUTPUT_INFO_END
+        }
+
         // Get the prediction from the matrices
-        f = M_predict.get(0,0);
+        f = M_predict.get(j,0);
 
         if (useStatisticalCriteria)
         {
             // If no feasible points is found so far, then sigma_f, ei and pi are bypassed.
             if (_modelAlgo->getFoundFeasible())
             {
-                sigma_f = STD_predict.get(0,0);
-                pi      = CDF_predict.get(0,0);
-                ei      = EI_predict.get(0,0);
+                sigma_f = STD_predict.get(j,0);
+                pi      = CDF_predict.get(j,0);
+                ei      = EI_predict.get(j,0);
             }
             else
             {
@@ -233,9 +293,9 @@ bool NOMAD::SgtelibModelEvaluator::eval_x(NOMAD::EvalPoint &x,
                 {
                     for (size_t i = 1; i < nbModels; i++)
                     {
-                        s += "C" + std::to_string(i) + " = " + std::to_string(M_predict.get(0,static_cast<int>(i)));
-                        s += " +/- " + std::to_string(STD_predict.get(0,static_cast<int>(i)));
-                        s += " (CDF : " + std::to_string(CDF_predict.get(0,static_cast<int>(i))) +  ")";
+                        s += "C" + std::to_string(i) + " = " + std::to_string(M_predict.get(j,static_cast<int>(i)));
+                        s += " +/- " + std::to_string(STD_predict.get(j,static_cast<int>(i)));
+                        s += " (CDF : " + std::to_string(CDF_predict.get(j,static_cast<int>(i))) +  ")";
                     }
                 }
                 else
@@ -243,7 +303,7 @@ bool NOMAD::SgtelibModelEvaluator::eval_x(NOMAD::EvalPoint &x,
                     s += "C = [ ";
                     for (size_t i = 1; i < nbModels; i++)
                     {
-                        s += std::to_string(M_predict.get(0,static_cast<int>(i))) + " ";
+                        s += std::to_string(M_predict.get(j,static_cast<int>(i))) + " ";
                         s += " ]";
                     }
                 }
@@ -251,20 +311,20 @@ bool NOMAD::SgtelibModelEvaluator::eval_x(NOMAD::EvalPoint &x,
 
             case NOMAD::SgtelibModelFeasibilityType::H:
                 s += "Feasibility_Method : H (Aggregate prediction)";
-                s += "H = " + std::to_string(M_predict.get(0,1));
-                s += " +/- " + std::to_string(STD_predict.get(0,1));
-                s += " (CDF : " + std::to_string(CDF_predict.get(0,1)) + ")";
+                s += "H = " + std::to_string(M_predict.get(j,1));
+                s += " +/- " + std::to_string(STD_predict.get(j,1));
+                s += " (CDF : " + std::to_string(CDF_predict.get(j,1)) + ")";
                 break;
             case NOMAD::SgtelibModelFeasibilityType::B:
                 s += "Feasibility_Method : B (binary prediction)";
-                s += "B = " + std::to_string(M_predict.get(0,1));
-                s += " (CDF : " + std::to_string(CDF_predict.get(0,1)) + ")";
+                s += "B = " + std::to_string(M_predict.get(j,1));
+                s += " (CDF : " + std::to_string(CDF_predict.get(j,1)) + ")";
                 break;
             case NOMAD::SgtelibModelFeasibilityType::M:
                 s += "Feasibility_Method : M (Biggest constraint prediction)";
-                s += "M = " + std::to_string(M_predict.get(0,1));
-                s += " +/- " + std::to_string(STD_predict.get(0,1));
-                s += " (CDF : " + std::to_string(CDF_predict.get(0,1)) + ")";
+                s += "M = " + std::to_string(M_predict.get(j,1));
+                s += " +/- " + std::to_string(STD_predict.get(j,1));
+                s += " (CDF : " + std::to_string(CDF_predict.get(j,1)) + ")";
                 break;
             case NOMAD::SgtelibModelFeasibilityType::UNDEFINED:
             default:
@@ -289,8 +349,8 @@ bool NOMAD::SgtelibModelEvaluator::eval_x(NOMAD::EvalPoint &x,
                 // If there is only one output in C (models B, H and M) then pf = CDF
                 for (size_t i = 1; i < nbModels; i++)
                 {
-                    pfj = CDF_predict.get(0,static_cast<int>(i));
-                    L2 += max( 0 , M_predict.get(0,static_cast<int>(i))).pow2();
+                    pfj = CDF_predict.get(j,static_cast<int>(i));
+                    L2 += max( 0 , M_predict.get(j,static_cast<int>(i))).pow2();
                     pf *= pfj;
                 }
             }   // end (if constraints are present)
@@ -307,154 +367,157 @@ bool NOMAD::SgtelibModelEvaluator::eval_x(NOMAD::EvalPoint &x,
             mu = 4*pf*(1-pf);
         }
 
-    } // pragma omp critical
-
-    // ====================================== //
-    // Application of the formulation         //
-    // ====================================== //
-    NOMAD::Double obj;
-    NOMAD::ArrayOfDouble newbbo(_bbOutputTypeList.size(), -1);
-    int k = 0;
-    switch (formulation)
-    {
-        case NOMAD::SgtelibModelFormulationType::FS:
-            // Define obj
-            obj = f - _diversification*sigma_f;
-            // Set constraints
-            for (size_t i = 0; i < _bbOutputTypeList.size(); i++)
-            {
-                if (_bbOutputTypeList[i] != NOMAD::BBOutputType::OBJ)
+        // ====================================== //
+        // Application of the formulation         //
+        // ====================================== //
+        NOMAD::Double obj;
+        NOMAD::ArrayOfDouble newbbo(_bbOutputTypeList.size(), -1);
+        int k = 0;
+        switch (formulation)
+        {
+            case NOMAD::SgtelibModelFormulationType::FS:
+                // Define obj
+                obj = f - _diversification*sigma_f;
+                // Set constraints
+                for (size_t i = 0; i < _bbOutputTypeList.size(); i++)
                 {
-                    newbbo[i] = M_predict.get(0,k+1) - _diversification*STD_predict.get(0,k+1);
-                    k++;
+                    if (_bbOutputTypeList[i] != NOMAD::BBOutputType::OBJ)
+                    {
+                        newbbo[i] = M_predict.get(j,k+1) - _diversification*STD_predict.get(j,k+1);
+                        k++;
+                    }
                 }
-            }
-            break;
+                break;
 
-        case NOMAD::SgtelibModelFormulationType::FSP:
-            // Define obj
-            obj = f - _diversification*sigma_f;
-            // Set constraints
-            for (size_t i = 0; i < _bbOutputTypeList.size(); i++)
-            {
-                if (_bbOutputTypeList[i] != NOMAD::BBOutputType::OBJ)
+            case NOMAD::SgtelibModelFormulationType::FSP:
+                // Define obj
+                obj = f - _diversification*sigma_f;
+                // Set constraints
+                for (size_t i = 0; i < _bbOutputTypeList.size(); i++)
                 {
-                    newbbo[i] = 0.5 - pf;
+                    if (_bbOutputTypeList[i] != NOMAD::BBOutputType::OBJ)
+                    {
+                        newbbo[i] = 0.5 - pf;
+                    }
                 }
-            }
-            break;
+                break;
 
-        case NOMAD::SgtelibModelFormulationType::EIS:
-            // Define obj
-            obj = - ei - _diversification*sigma_f;
-            // Set constraints
-            for (size_t i = 0; i < _bbOutputTypeList.size(); i++)
-            {
-                if ( _bbOutputTypeList[i] != NOMAD::BBOutputType::OBJ )
+            case NOMAD::SgtelibModelFormulationType::EIS:
+                // Define obj
+                obj = - ei - _diversification*sigma_f;
+                // Set constraints
+                for (size_t i = 0; i < _bbOutputTypeList.size(); i++)
                 {
-                    newbbo[i] = M_predict.get(0,k+1) - _diversification*STD_predict.get(0,k+1);
-                    k++;
+                    if ( _bbOutputTypeList[i] != NOMAD::BBOutputType::OBJ )
+                    {
+                        newbbo[i] = M_predict.get(j,k+1) - _diversification*STD_predict.get(j,k+1);
+                        k++;
+                    }
                 }
-            }
-            break;
+                break;
 
-        case NOMAD::SgtelibModelFormulationType::EFI:
-            obj = -efi;
-            break;
+            case NOMAD::SgtelibModelFormulationType::EFI:
+                obj = -efi;
+                break;
 
-        case NOMAD::SgtelibModelFormulationType::EFIS:
-            obj = -efi - _diversification*sigma_f;
-            break;
+            case NOMAD::SgtelibModelFormulationType::EFIS:
+                obj = -efi - _diversification*sigma_f;
+                break;
 
-        case NOMAD::SgtelibModelFormulationType::EFIM:
-            obj = -efi - _diversification*sigma_f*mu;
-            break;
+            case NOMAD::SgtelibModelFormulationType::EFIM:
+                obj = -efi - _diversification*sigma_f*mu;
+                break;
 
-        case NOMAD::SgtelibModelFormulationType::EFIC:
-            obj = -efi - _diversification*( ei*mu + pf*sigma_f);
-            break;
+            case NOMAD::SgtelibModelFormulationType::EFIC:
+                obj = -efi - _diversification*( ei*mu + pf*sigma_f);
+                break;
 
-        case NOMAD::SgtelibModelFormulationType::PFI:
-            obj = -pfi;
-            break;
+            case NOMAD::SgtelibModelFormulationType::PFI:
+                obj = -pfi;
+                break;
 
-        case NOMAD::SgtelibModelFormulationType::D:
-            obj = -d;
-            break;
+            case NOMAD::SgtelibModelFormulationType::D:
+                obj = -d;
+                break;
 
-        case NOMAD::SgtelibModelFormulationType::EXTERN:
-        case NOMAD::SgtelibModelFormulationType::UNDEFINED:
-        default:
-            OUTPUT_INFO_START
-            s = "SgtelibModel formulation: " + NOMAD::SgtelibModelFormulationTypeToString(formulation);
-            NOMAD::OutputQueue::Add(s, _displayLevel);
-            OUTPUT_INFO_END
-            break;
-    }
+            case NOMAD::SgtelibModelFormulationType::EXTERN:
+            case NOMAD::SgtelibModelFormulationType::UNDEFINED:
+            default:
+                OUTPUT_INFO_START
+                s = "SgtelibModel formulation: " + NOMAD::SgtelibModelFormulationTypeToString(formulation);
+                NOMAD::OutputQueue::Add(s, _displayLevel);
+                OUTPUT_INFO_END
+                break;
+        }
 
-    // ------------------------- //
-    //   exclusion area          //
-    // ------------------------- //
-    if (_tc > 0.0)
-    {
-        penalty = _modelAlgo->getModel()->get_exclusion_area_penalty(X_predict, _tc).get(0,0);
-        obj += penalty;
-    }
+        // ------------------------- //
+        //   exclusion area          //
+        // ------------------------- //
+        if (_tc > 0.0)
+        {
+            penalty = P_predict.get(j,0);
+            obj += penalty;
+        }
 
-    // ------------------------- //
-    //   Set obj and BBO         //
-    // ------------------------- //
-    for (size_t i = 0; i < _bbOutputTypeList.size(); i++)
-    {
-        if (_bbOutputTypeList[i] == NOMAD::BBOutputType::OBJ)
+        // ------------------------- //
+        //   Set obj and BBO         //
+        // ------------------------- //
+        for (size_t i = 0; i < _bbOutputTypeList.size(); i++)
         {
-            newbbo[i] = obj;
+            if (_bbOutputTypeList[i] == NOMAD::BBOutputType::OBJ)
+            {
+                newbbo[i] = obj;
+            }
         }
-    }
-    x.setBBO(newbbo.tostring(), _bbOutputTypeList, NOMAD::EvalType::MODEL);
+        x.setBBO(newbbo, _bbOutputTypeList, NOMAD::EvalType::MODEL);
 
-    // ================== //
-    //       DISPLAY      //
-    // ================== //
-    OUTPUT_INFO_START
-    if (useStatisticalCriteria)
-    {
-        s = "f_min                    f_min = " + std::to_string(_modelAlgo->getTrainingSet()->get_f_min());
-        NOMAD::OutputQueue::Add(s, _displayLevel);
-        s = "Probability of Feasibility PF  = " + pf.display();
-        NOMAD::OutputQueue::Add(s, _displayLevel);
-        s = "Feasibility Uncertainty    mu  = " + mu.display();
-        NOMAD::OutputQueue::Add(s, _displayLevel);
-        s = "Probability Improvement    PI  = " + pi.display();
-        NOMAD::OutputQueue::Add(s, _displayLevel);
-        s = "Expected Improvement      EI  = " + ei.display();
-        NOMAD::OutputQueue::Add(s, _displayLevel);
-        s = "Proba. of Feasible Imp.    PFI = " + pfi.display();
+        // ================== //
+        //       DISPLAY      //
+        // ================== //
+        OUTPUT_INFO_START
+        if (useStatisticalCriteria)
+        {
+            s = "f_min                    f_min = " + std::to_string(_modelAlgo->getTrainingSet()->get_f_min());
+            NOMAD::OutputQueue::Add(s, _displayLevel);
+            s = "Probability of Feasibility PF  = " + pf.display();
+            NOMAD::OutputQueue::Add(s, _displayLevel);
+            s = "Feasibility Uncertainty    mu  = " + mu.display();
+            NOMAD::OutputQueue::Add(s, _displayLevel);
+            s = "Probability Improvement    PI  = " + pi.display();
+            NOMAD::OutputQueue::Add(s, _displayLevel);
+            s = "Expected Improvement      EI  = " + ei.display();
+            NOMAD::OutputQueue::Add(s, _displayLevel);
+            s = "Proba. of Feasible Imp.    PFI = " + pfi.display();
+            NOMAD::OutputQueue::Add(s, _displayLevel);
+            s = "Expected Feasible Imp.     EFI = " + efi.display();
+            NOMAD::OutputQueue::Add(s, _displayLevel);
+        }
+        s = "Exclusion area penalty = " + penalty.display();
         NOMAD::OutputQueue::Add(s, _displayLevel);
-        s = "Expected Feasible Imp.     EFI = " + efi.display();
+        s = "Model Output = (" + x.getBBO(NOMAD::EvalType::MODEL) + ")";
         NOMAD::OutputQueue::Add(s, _displayLevel);
+        OUTPUT_INFO_END
+
+        if (!pf.isDefined() || !pi.isDefined())
+        {
+            throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
+                                      "SgtelibModelEvaluator::eval_block: NaN values in pi or pf." );
+        }
+
+        // ================== //
+        // Exit Status        //
+        // ================== //
+        countEval.push_back(true);
+        // Always eval_ok = true
+        evalOk.push_back(true);
+        x.setEvalStatus(NOMAD::EvalStatusType::EVAL_OK, NOMAD::EvalType::MODEL);
     }
-    s = "Exclusion area penalty = " + penalty.display();
-    NOMAD::OutputQueue::Add(s, _displayLevel);
-    s = "Model Output = (" + x.getBBO(NOMAD::EvalType::MODEL) + ")";
-    NOMAD::OutputQueue::Add(s, _displayLevel);
-    OUTPUT_INFO_END
 
-    if (!pf.isDefined() || !pi.isDefined())
+    // Convert points back to full space
+    for (auto& evPt : block)
     {
-        throw SGTELIB::Exception ( __FILE__ , __LINE__ ,
-                                  "SgtelibModelEvaluator::eval_x: NaN values in pi or pf." );
+        evPt = std::make_shared<NOMAD::EvalPoint>(evPt->makeFullSpacePointFromFixed(_fixedVariable));
     }
 
-    // ================== //
-    // Exit Status        //
-    // ================== //
-    countEval = true;
-    x.setEvalStatus(NOMAD::EvalStatusType::EVAL_OK, NOMAD::EvalType::MODEL);
-
-    // Convert back x to full space
-    x = x.makeFullSpacePointFromFixed(_fixedVariable);
-
-    // Always eval_ok = true
-    return true;
+    return evalOk;
 }
@@ -36,6 +36,13 @@ public:
                 const Double &NOMAD_UNUSED(hMax),
                 bool &countEval) const override;
 
+    /**
+     Points for evaluations are given in a block. The whole block is predicted by the sgtelib model in one call.
+     */
+    std::vector<bool> eval_block(Block &block,
+                                 const Double &NOMAD_UNUSED(hMax),
+                                 std::vector<bool> &countEval) const override;
+
 private:
     void init();
 
@@ -8,6 +8,9 @@
 #include "../../Output/OutputQueue.hpp"
 #include "../../Type/SgtelibModelFeasibilityType.hpp"
 #include "../../Type/SgtelibModelFormulationType.hpp"
+#ifdef TIME_STATS
+#include "../../Util/Instrumentation.hpp"
+#endif // TIME_STATS
 
 
 NOMAD::SgtelibModelUpdate::~SgtelibModelUpdate() = default;
@@ -298,6 +301,9 @@ bool NOMAD::SgtelibModelUpdate::runImp()
         AddOutputInfo("Build model...", _displayLevel);
         OUTPUT_INFO_END
 
+#ifdef TIME_STATS
+        NOMAD::Instrumentation::incCounter(NOMAD::InstrumentationCounter::MODEL_BUILD);
+#endif // TIME_STATS
         model->build();
         OUTPUT_INFO_START
         AddOutputInfo("OK.", _displayLevel);
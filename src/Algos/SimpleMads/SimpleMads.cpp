@@ -25,6 +25,18 @@ void NOMAD::SimpleMads::init()
 }
 
 bool NOMAD::SimpleMads::runImp()
+{
+    return runPollIterations(true);
+}
+
+
+bool NOMAD::SimpleMads::runInWorkerThread()
+{
+    return runPollIterations(false);
+}
+
+
+bool NOMAD::SimpleMads::runPollIterations(bool stepBookkeeping)
 {
     size_t k = 0;   // Iteration number (incremented at start)
     
@@ -33,9 +45,16 @@ bool NOMAD::SimpleMads::runImp()
     // Termination: 1- Reach max model eval, 2- fail to create trial points on mesh
     while ( _poll.getNbEval() < _maxEval && pollSuccess)
     {
-        _poll.start();
-        pollSuccess = _poll.run();
-        _poll.end();
+        if (stepBookkeeping)
+        {
+            _poll.start();
+            pollSuccess = _poll.run();
+            _poll.end();
+        }
+        else
+        {
+            pollSuccess = _poll.runIteration();
+        }
         k++;
     }
 
@@ -82,6 +82,13 @@ public:
 
     EvalPoint getBestSolution (bool bestFeas) const override;
 
+    /// Run the algorithm from a worker thread.
+    /**
+     The poll iterations are done without the Step bookkeeping that needs the evaluator control of a main thread. Used to run several simple Mads concurrently. Call start() before and end() after, from the main thread.
+     \return \c true
+     */
+    bool runInWorkerThread();
+
 private:
     ///  Initialization of class, to be used by Constructor.
     void init();
@@ -95,6 +102,9 @@ private:
      */
     virtual bool runImp() override;
 
+    /// Helper for runImp and runInWorkerThread
+    bool runPollIterations(bool stepBookkeeping);
+
     virtual void endImp() override;
 
     void endDisplay() const ;
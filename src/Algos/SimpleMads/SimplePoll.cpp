@@ -1,5 +1,6 @@
 
 #include "../../Algos/AlgoStopReasons.hpp"
+#include "../../Algos/EvcInterface.hpp"
 #include "../../Algos/Mads/DoublePollMethod.hpp"
 #include "../../Algos/Mads/Ortho2NPollMethod.hpp"
 #include "../../Algos/SimpleMads/SimplePoll.hpp"
@@ -89,6 +90,18 @@ void NOMAD::SimplePoll::init()
     
     // Dedicated random number generator
     _rng = std::make_shared<NOMAD::SimpleRNG>();
+
+    // Eval type of the generated trial points. The poll methods may generate them in a worker thread
+    // (multi-start quad model search) where the evaluator control cannot give the current eval type.
+    auto evc = NOMAD::EvcInterface::getEvaluatorControl();
+    if (nullptr != _model || nullptr == evc)
+    {
+        _trialPointsEvalType = NOMAD::EvalType::MODEL;
+    }
+    else
+    {
+        _trialPointsEvalType = evc->getCurrentEvalType();
+    }
     
     // Rho parameter of the progressive barrier. Used to choose if the primary frame center is the feasible or infeasible incumbent.
     _rho = _runParams->getAttributeValue<NOMAD::Double>("RHO");
@@ -206,6 +219,16 @@ bool NOMAD::SimplePoll::runImp()
 }
 
 
+bool NOMAD::SimplePoll::runIteration()
+{
+    startImp();
+    const bool pollSuccess = runImp();
+    endImp();
+
+    return pollSuccess;
+}
+
+
 void NOMAD::SimplePoll::endImp()
 {
 
@@ -412,6 +435,7 @@ void NOMAD::SimplePoll::createPollMethod(const bool isPrimary, const SimpleEvalP
         pollMethod = std::make_unique<NOMAD::DoublePollMethod>(this, fc );
     }
     pollMethod->setRandomGenerator(_rng);
+    pollMethod->setTrialPointsEvalType(_trialPointsEvalType);
     _frameCenters.push_back(frameCenter);
     _pollMethods.push_back(std::move(pollMethod));
 
@@ -53,6 +53,8 @@ private:
     
     std::shared_ptr<SimpleRNG> _rng = nullptr;
 
+    EvalType _trialPointsEvalType; ///< Eval type of the trial points generated by the poll methods
+
     std::function<bool(std::vector<NOMAD::SimpleEvalPoint>&)> _eval_x; ///< Function for outputs evaluation
 
 public:
@@ -99,6 +101,14 @@ public:
 
     bool getPhaseOneSearch () const { return _phaseOneSearch; }
 
+    /// Perform one poll iteration (start, run and end tasks) without the Step bookkeeping.
+    /**
+     Stop reasons, success stats and step display need the evaluator control of a main thread.
+     Used when several simple Mads are run concurrently on worker threads.
+     \return Flag \c true if trial points were generated and evaluated, \c false otherwise.
+     */
+    bool runIteration();
+
 protected:
     /// Helper for start: get lists of Primary and Secondary Polls
     void computePrimarySecondaryPollCenters(SimpleEvalPoint & primaryCenter, SimpleEvalPoint & secondaryCenter) const;
@@ -7,6 +7,9 @@
 #include "../Algos/Step.hpp"
 #include "../Cache/CacheBase.hpp"
 #include "../Output/OutputQueue.hpp"
+#ifdef TIME_STATS
+#include "../Util/Instrumentation.hpp"
+#endif // TIME_STATS
 
 /*-----------------------------------*/
 /*   static members initialization   */
@@ -86,8 +89,8 @@ void NOMAD::Step::init()
        // In case no run params is provided (not even from parent)
         if ( nullptr != _runParams)
         {
-            _isMegaSearchPoll = _runParams->getAttributeValue<bool>("MEGA_SEARCH_POLL");
-            _hMax0 = _runParams->getAttributeValue<NOMAD::Double>("H_MAX_0");
+            _isMegaSearchPoll = _runParams->getSnapshot().MEGA_SEARCH_POLL;
+            _hMax0 = _runParams->getSnapshot().H_MAX_0;
         }
     }
 }
@@ -254,6 +257,9 @@ void NOMAD::Step::end()
 
 bool NOMAD::Step::run()
 {
+#ifdef TIME_STATS
+    NOMAD::ScopedTimer timer(_stepType);
+#endif // TIME_STATS
     return runImp();
 }
 
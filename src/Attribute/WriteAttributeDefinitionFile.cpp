@@ -37,6 +37,10 @@ const std::string attributeDefinitionNames[20] = { "deprecatedAttributesDefiniti
     "runAttributesDefinitionCOOP"
 };
 
+// The deprecated attributes are only registered to give a message to the user.
+// No field list is written for them.
+const std::string deprecatedAttributeDefinitionName = "deprecatedAttributesDefinition";
+
 const std::string forbiddenWords[3] = {"SOLVER", "NOMAD", "RUNNER"};
 
 /// \brief Registered attribute flags and default value
@@ -55,6 +59,27 @@ void  toUpperCase(std::string& str)
     for_each(str.begin(), str.end(), [](char& in){ in = std::toupper(in); });
 }
 
+/// \brief Type utility
+/**
+ Get the C++ type used for an attribute field in the parameter snapshots. The types in the txt files can be given with or without the NOMAD namespace.
+ */
+std::string snapshotFieldType(const std::string& attributeType)
+{
+    if ("string" == attributeType || "std::string" == attributeType)
+    {
+        return "std::string";
+    }
+    if ("int" == attributeType || "size_t" == attributeType || "bool" == attributeType)
+    {
+        return attributeType;
+    }
+    if (attributeType.find("NOMAD::") == 0)
+    {
+        return attributeType;
+    }
+    return "NOMAD::" + attributeType;
+}
+
 /// \brief Exception utility
 class Exception : public std::exception
 {
@@ -209,6 +234,7 @@ int main(int argc, char *argv[])
 
     std::istringstream iss;
     std::ostringstream oss;
+    std::ostringstream ossFields;
 
     std::map<std::string,bool> attributeFlags;
     
@@ -218,6 +244,8 @@ int main(int argc, char *argv[])
     {
         std::string attDefFile      = inputDir + attDefName + ".txt";
         std::string attDefHeader    = outputDir + attDefName + ".hpp";
+        std::string attDefFields    = outputDir + attDefName + "Fields.hpp";
+        bool writeFields            = (deprecatedAttributeDefinitionName != attDefName);
 
         // Clear input stream
         iss.str("");
@@ -232,6 +260,16 @@ int main(int argc, char *argv[])
         oss << "//////////// THIS FILE MUST BE CREATED BY EXECUTING WriteAttributeDefinitionFile ////////////" << std::endl;
         oss << "//////////// DO NOT MODIFY THIS FILE MANUALLY ///////////////////////////////////////////////" << std::endl << std::endl;
 
+        // Clear field list stream
+        ossFields.str("");
+        ossFields.clear();
+
+        // The field list is included several times with different
+        // definitions of NOMAD_PARAMETER_FIELD: no include guard.
+        ossFields << "//////////// THIS FILE MUST BE CREATED BY EXECUTING WriteAttributeDefinitionFile ////////////" << std::endl;
+        ossFields << "//////////// DO NOT MODIFY THIS FILE MANUALLY ///////////////////////////////////////////////" << std::endl << std::endl;
+        ossFields << "// NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) must be defined before including this file." << std::endl << std::endl;
+
         oss << "#ifndef __NOMAD_4_5_"<< UpperAttDefName << "__" << std::endl;
         oss << "#define __NOMAD_4_5_"<< UpperAttDefName << "__" << std::endl << std::endl;
         oss << "_definition = {" ;
@@ -338,6 +376,10 @@ int main(int argc, char *argv[])
                     throw ( Exception(lineNumber,errMsg) );
                 }
                 oss << " \"" << attributeType << "\", " ;
+                // Attributes are registered with their name in upper case.
+                std::string attributeKey = attributeName;
+                toUpperCase(attributeKey);
+                ossFields << "NOMAD_PARAMETER_FIELD(" << snapshotFieldType(attributeType) << ", " << attributeName << ", \"" << attributeKey << "\")" << std::endl;
 
                 // Read attribute default value (can be undefined)
                 getline(fin, line);
@@ -491,6 +533,19 @@ int main(int argc, char *argv[])
             fout << oss.str() ;
             fout.close();
 
+            // write field list used by the parameter snapshots
+            if (writeFields)
+            {
+                fout.open( attDefFields );
+                if ( fout.fail() )
+                {
+                    errMsg = " Failed to open the header file for writing attribute field list.";
+                    throw ( Exception(0,errMsg) );
+                }
+                fout << ossFields.str() ;
+                fout.close();
+            }
+
             flagInFile = false;
 
         }
@@ -8,6 +8,9 @@
 #include "../Cache/CacheSet.hpp"
 #include "../Output/OutputQueue.hpp"
 #include "../Util/fileutils.hpp"
+#ifdef TIME_STATS
+#include "../Util/Instrumentation.hpp"
+#endif // TIME_STATS
 #include "../Util/MicroSleep.hpp"
 #include "BBOutputType.hpp"
 #include "CompareType.hpp"
@@ -249,6 +252,9 @@ bool NOMAD::CacheSet::smartInsert(const NOMAD::EvalPoint &evalPoint,
     omp_unset_lock(&_cacheLock);
 #endif // _OPENMP
     inserted = ret.second;
+#ifdef TIME_STATS
+    NOMAD::Instrumentation::incCounter(NOMAD::InstrumentationCounter::CACHE_INSERT);
+#endif // TIME_STATS
     bool canEval = (*ret.first).toEval(maxNumberEval, evalType);
     bool doEval = canEval;
     
@@ -304,6 +310,9 @@ bool NOMAD::CacheSet::smartInsert(const NOMAD::EvalPoint &evalPoint,
         if (!inserted && NOMAD::EvalType::BB == evalType)
         {
             _nbCacheHits++;
+#ifdef TIME_STATS
+            NOMAD::Instrumentation::incCounter(NOMAD::InstrumentationCounter::CACHE_HIT);
+#endif // TIME_STATS
             OUTPUT_INFO_START
             std::string s = "Cache hit: ";
             s += ret.first->display();
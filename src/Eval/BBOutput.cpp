@@ -5,6 +5,7 @@
  \date   January 2018
  \see    BBOutput.hpp
  */
+#include <cmath>
 #include <utility>
 
 #include "../Eval/BBOutput.hpp"
@@ -20,6 +21,7 @@ const std::string NOMAD::BBOutput::bboEnd = ")";
 // Reading BBOutput from string
 NOMAD::BBOutput::BBOutput(std::string rawBBO, const bool evalOk)
   : _rawBBO(std::move(rawBBO)),
+    _rawBBOIsDef(true),
     _evalOk(evalOk)
 {
     NOMAD::ArrayOfString array(_rawBBO);
@@ -33,7 +35,8 @@ NOMAD::BBOutput::BBOutput(std::string rawBBO, const bool evalOk)
 }
 // Reading BBOutput from ArrayOfDouble
 NOMAD::BBOutput::BBOutput(const ArrayOfDouble & bbo)
-  : _BBO(bbo)
+  : _rawBBOIsDef(false),
+    _BBO(bbo)
 {
     _evalOk = true;
     for (size_t i = 0; i < _BBO.size(); i++)
@@ -47,9 +50,19 @@ NOMAD::BBOutput::BBOutput(const ArrayOfDouble & bbo)
 }
 
 
+// Reading BBOutput from ArrayOfDouble, with the given eval status
+NOMAD::BBOutput::BBOutput(const ArrayOfDouble & bbo, const bool evalOk)
+  : _rawBBOIsDef(false),
+    _evalOk(evalOk)
+{
+    setBBO(bbo, evalOk);
+}
+
+
 void NOMAD::BBOutput::setBBO(const std::string &bbOutputString, const bool evalOk)
 {
     _rawBBO = bbOutputString;
+    _rawBBOIsDef = true;
     _evalOk = evalOk;
     NOMAD::ArrayOfString array(_rawBBO);
     _BBO =  ArrayOfDouble( array.size() );
@@ -62,6 +75,23 @@ void NOMAD::BBOutput::setBBO(const std::string &bbOutputString, const bool evalO
 }
 
 
+void NOMAD::BBOutput::setBBO(const ArrayOfDouble &bbo, const bool evalOk)
+{
+    _rawBBO.clear();
+    _rawBBOIsDef = false;
+    _evalOk = evalOk;
+    _BBO = bbo;
+    // Same values as when reading the text: NaN is not a valid output.
+    for (size_t i = 0; i < _BBO.size(); i++)
+    {
+        if (_BBO[i].isDefined() && std::isnan(_BBO[i].todouble()))
+        {
+            _BBO[i] = NOMAD::Double();
+        }
+    }
+}
+
+
 bool NOMAD::BBOutput::getCountEval(const BBOutputTypeList &bbOutputType) const
 {
     bool countEval = true;
@@ -20,7 +20,8 @@
 /**
  *
  * Manage output from blackbox:
- *  - Raw output (string)
+ *  - Raw output (string). When the outputs are given as numbers, the string is
+ *    only produced when it is requested (display, cache file).
  *  - Is eval ok. This is a boolean indicating that there were no problem during evaluation.
  *  - Scaling (future work)
  */
@@ -31,7 +32,8 @@ public:
 
 
 private:
-    std::string             _rawBBO;    ///< Actual output string
+    std::string             _rawBBO;    ///< Actual output string (when set from a string)
+    bool                    _rawBBOIsDef; ///< False when set from numerical values
     ArrayOfDouble           _BBO;       ///< Actual numerical values
     bool                    _evalOk;    ///< Flag for evaluation
 
@@ -56,6 +58,14 @@ public:
      */
     explicit BBOutput(const ArrayOfDouble &bbo);
 
+    /// Constructor #3
+    /**
+     No text is parsed: the values are stored directly.
+     \param bbo     The outputs of the blackbox as a array of double -- \b IN.
+     \param evalOk  The eval ok flag -- \b IN.
+     */
+    BBOutput(const ArrayOfDouble &bbo, const bool evalOk);
+
     /*---------*/
     /* Get/Set */
     /*---------*/
@@ -96,6 +106,14 @@ public:
      */
     void setBBO(const std::string &bbOutputString, const bool evalOk = true);
 
+    /// Set each blackbox output separately from numerical values.
+    /**
+     Used by the model evaluators: the values are not converted to text.
+     \param bbo       The blackbox outputs -- \b IN.
+     \param evalOk    The evaluation status -- \b IN.
+     */
+    void setBBO(const ArrayOfDouble &bbo, const bool evalOk = true);
+
     /// Get if this evaluation proceeded properly
     /**
      \return \c True if the evaluation ended normally; \c False if there was an error.
@@ -110,9 +128,11 @@ public:
 
     /// Get the raw blackbox outputs
     /**
+     When the outputs were set from numerical values, the string is
+     built from them, in full precision.
      \return    A single string containing the raw blackbox outputs.
      */
-    const std::string& getBBO() const { return _rawBBO; }
+    std::string getBBO() const { return _rawBBOIsDef ? _rawBBO : _BBO.tostring(); }
 
     /// Test if raw blackbox outputs for functions (OBJ, PB, EB) is complete
     /**
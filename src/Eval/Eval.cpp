@@ -34,7 +34,7 @@ NOMAD::Eval::Eval(const std::shared_ptr<NOMAD::EvalParameters>& params,
   : _evalStatus(NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED),
     _preEvalStatus(NOMAD::EvalStatusType::EVAL_STATUS_UNDEFINED),
     _bbOutput(bbOutput),
-    _bbOutputTypeList(params->getAttributeValue<NOMAD::BBOutputTypeList>("BB_OUTPUT_TYPE"))
+    _bbOutputTypeList(params->getSnapshot().BB_OUTPUT_TYPE)
 {
     _bbOutputComplete = _bbOutput.isComplete(_bbOutputTypeList);
 
@@ -388,6 +388,22 @@ void NOMAD::Eval::setBBO(const std::string &bbo,
                          const bool evalOk)
 {
     _bbOutput = NOMAD::BBOutput(bbo, evalOk);
+    updateForBBO(bbOutputTypeList);
+}
+
+
+void NOMAD::Eval::setBBO(const NOMAD::ArrayOfDouble &bbo,
+                         const NOMAD::BBOutputTypeList &bbOutputTypeList,
+                         const bool evalOk)
+{
+    _bbOutput = NOMAD::BBOutput(bbo, evalOk);
+    updateForBBO(bbOutputTypeList);
+}
+
+
+// Called by setBBO, once the blackbox output is set.
+void NOMAD::Eval::updateForBBO(const NOMAD::BBOutputTypeList &bbOutputTypeList)
+{
     _bbOutputTypeList = bbOutputTypeList;
     _moInfo = std::make_unique<NOMAD::MOInfo>();
 
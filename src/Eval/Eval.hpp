@@ -140,6 +140,11 @@ public:
                 const BBOutputTypeList &bbOutputTypeList,
                 const bool evalOk = true);
 
+    /// Set blackbox output from numerical values (no conversion to text)
+    void setBBO(const ArrayOfDouble &bbo,
+                const BBOutputTypeList &bbOutputTypeList,
+                const bool evalOk = true);
+
     /*---------------*/
     /* Other methods */
     /*---------------*/
@@ -281,6 +286,9 @@ private:
     /// Helpers for getF() and getH()
     Double computeHStandard( NOMAD::HNormType hNormType) const;
     Double computeFPhaseOne( NOMAD::HNormType hNormType) const;
+
+    /// Helper for setBBO: update the output types and the status for the new blackbox output
+    void updateForBBO(const BBOutputTypeList &bbOutputTypeList);
     
 
     
@@ -368,6 +368,21 @@ void NOMAD::EvalPoint::setBBO(const std::string &bbo,
                               const NOMAD::BBOutputTypeList &bbOutputTypeList,
                               NOMAD::EvalType evalType,
                               const bool evalOk)
+{
+    getEvalForBBO(evalType)->setBBO(bbo, bbOutputTypeList, evalOk);
+}
+
+
+void NOMAD::EvalPoint::setBBO(const NOMAD::ArrayOfDouble &bbo,
+                              const NOMAD::BBOutputTypeList &bbOutputTypeList,
+                              NOMAD::EvalType evalType,
+                              const bool evalOk)
+{
+    getEvalForBBO(evalType)->setBBO(bbo, bbOutputTypeList, evalOk);
+}
+
+
+NOMAD::Eval* NOMAD::EvalPoint::getEvalForBBO(NOMAD::EvalType evalType)
 {
     // The default (unset) eval type is passed (see library mode examples using simple setBBO(bbo) function). This function is used for simplicity BUT we need to check which eval is in progress. It should not be too costly.
     // Quad model evaluator passes the eval type explicitly.
@@ -390,11 +405,8 @@ void NOMAD::EvalPoint::setBBO(const std::string &bbo,
     {
         throw NOMAD::Exception(__FILE__, __LINE__, "EvalPoint::setBBO: Could not create new Eval");
     }
-    else
-    {
-        eval->setBBO(bbo, bbOutputTypeList, evalOk);
-    }
 
+    return eval;
 }
 
 
@@ -563,7 +575,7 @@ void NOMAD::EvalPoint::setRevealedConstraint(const NOMAD::Double &constraintValu
                     size_t index = it - allBbot.begin();
                     auto bbo = eval->getBBOutput().getBBOAsArrayOfDouble();
                     bbo[index]=constraintValue;
-                    eval->setBBO(bbo.tostring(), allBbot);
+                    eval->setBBO(bbo, allBbot);
                 }
             else
             {
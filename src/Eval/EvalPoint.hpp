@@ -98,6 +98,9 @@ private:
     /// Helper for copy constructor and others
     void copyMembers(const EvalPoint &evalPoint);
 
+    /// Helper for setBBO: get the Eval to set, created if needed
+    Eval* getEvalForBBO(EvalType evalType);
+
 public:
 
     /// Affectation operator.
@@ -173,6 +176,19 @@ public:
                 EvalType evalType = EvalType::LAST,
                 const bool evalOk = true);
 
+    /// Set the blackbox output for the Eval of this EvalType from numerical values.
+    /**
+     Used by the model evaluators: the values are stored without being converted to text.
+     \param bbo                 The blackbox outputs -- \b IN.
+     \param bbOutputTypeList    The list of blackbox output types -- \b IN.
+     \param evalType            Blackbox or model evaluation  -- \b IN.
+     \param evalOk              Flag for evaluation status  -- \b IN.
+     */
+    void setBBO(const ArrayOfDouble &bbo,
+                const BBOutputTypeList& bbOutputTypeList,
+                EvalType evalType = EvalType::LAST,
+                const bool evalOk = true);
+
     void setBBOutputType(const BBOutputTypeList& bbOutputType, const EvalType evalType) const;
     void setBBOutputType(const BBOutputTypeList& bbOutputType);
     
@@ -1,6 +1,9 @@
 #include "../Eval/Evaluator.hpp"
 #include "../Output/OutputQueue.hpp"
 #include "../Util/fileutils.hpp"
+#ifdef TIME_STATS
+#include "../Util/Instrumentation.hpp"
+#endif // TIME_STATS
 #include <cstdio>  // For popen
 #include <fstream>  // For ofstream
 #ifndef _WIN32
@@ -42,8 +45,8 @@ NOMAD::Evaluator::Evaluator(
   : _evalParams(evalParams),
     _evalXDefined(evalXDefined),
     _evalType(evalType),
-    _bbOutputTypeList(_evalParams->getAttributeValue<NOMAD::BBOutputTypeList>("BB_OUTPUT_TYPE")),
-    _bbEvalFormat(_evalParams->getAttributeValue<NOMAD::ArrayOfDouble>("BB_EVAL_FORMAT"))
+    _bbOutputTypeList(_evalParams->getSnapshot().BB_OUTPUT_TYPE),
+    _bbEvalFormat(_evalParams->getSnapshot().BB_EVAL_FORMAT)
 {
     init();
 }
@@ -381,6 +384,9 @@ std::vector<bool> NOMAD::Evaluator::evalXBBExe(NOMAD::Block &block,
     // Stream for output file when bb manages output files (no redirection)
     std::ifstream finWithoutRedirection;
 
+#ifdef TIME_STATS
+    NOMAD::Instrumentation::incCounter(NOMAD::InstrumentationCounter::EXTERNAL_CALL);
+#endif // TIME_STATS
     FILE *fresult = popen(cmd.c_str(), "r");
     if (!fresult)
     {
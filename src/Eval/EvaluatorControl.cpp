@@ -8,6 +8,9 @@
 #include "../Type/EvalSortType.hpp"
 #include "../Util/AllStopReasons.hpp"
 #include "../Util/Clock.hpp"
+#ifdef TIME_STATS
+#include "../Util/Instrumentation.hpp"
+#endif // TIME_STATS
 #include "../Util/MicroSleep.hpp"
 
 /*-----------------------------------*/
@@ -842,6 +845,9 @@ bool NOMAD::EvaluatorControl::addToQueue(const NOMAD::EvalQueuePointPtr& evalQue
         if (pointInserted)
         {
             getMainThreadInfo(mainThreadNum).incNbPointsInQueue();
+#ifdef TIME_STATS
+            NOMAD::Instrumentation::incCounter(NOMAD::InstrumentationCounter::EVAL_QUEUE_PUSH);
+#endif // TIME_STATS
         }
     }
 
@@ -1468,7 +1474,7 @@ NOMAD::SuccessType NOMAD::EvaluatorControl::run()
         getMainThreadInfo(mainThreadNum).setStopReason(NOMAD::EvalMainThreadStopType::ALL_POINTS_EVALUATED);
     }
 
-    const bool clearEvalQueue = _evalContGlobalParams->getAttributeValue<bool>("EVAL_QUEUE_CLEAR");
+    const bool clearEvalQueue = _evalContGlobalParams->getSnapshot().EVAL_QUEUE_CLEAR;
 
     // Note that when all points are evaluated, getSuccessType() has the correct
     // value, even if it was modified by those last points being evaluated.
@@ -2041,7 +2047,7 @@ bool NOMAD::EvaluatorControl::evalBlock(NOMAD::BlockForEval& blockForEval)
             else if (NOMAD::EvalType::SURROGATE == evalType)
             {
                 // Note: bb eval in subproblem and lap bb eval are not updated, only the global counter.
-                size_t surrogateCost = _evalContGlobalParams->getAttributeValue<size_t>("EVAL_SURROGATE_COST");
+                size_t surrogateCost = _evalContGlobalParams->getSnapshot().EVAL_SURROGATE_COST;
                 _surrogateEval++;
                 _surrogateEvalFromCacheForRerun++;
                     // When surrogateCost surrogate evaluations have been done, increment _bbEval and _nbEvalSentToEvaluator.
@@ -2289,6 +2295,7 @@ std::vector<bool> NOMAD::EvaluatorControl::evalBlockOfPoints(
         OUTPUT_INFO_END
 #ifdef TIME_STATS
         double evalStartTime = NOMAD::Clock::getCPUTime();
+        NOMAD::Instrumentation::incCounter(NOMAD::InstrumentationCounter::EVAL_BLOCK);
 #endif // TIME_STATS
         evalOk = evaluator.eval_block(block, hMax, countEval);
 #ifdef TIME_STATS
@@ -2388,7 +2395,7 @@ std::vector<bool> NOMAD::EvaluatorControl::evalBlockOfPoints(
             else if (NOMAD::EvalType::SURROGATE == evalType)
             {
                 // Note: bb eval in subproblem and lap bb eval are not updated, only the global counter.
-                size_t surrogateCost = _evalContGlobalParams->getAttributeValue<size_t>("EVAL_SURROGATE_COST");
+                size_t surrogateCost = _evalContGlobalParams->getSnapshot().EVAL_SURROGATE_COST;
                 if (countEval[index])
                 {
                     _surrogateEval++;
@@ -0,0 +1,307 @@
+#include "../Eval/RecordReplayEvaluator.hpp"
+#include "../Output/OutputQueue.hpp"
+
+#include <algorithm> // for equal
+#include <chrono>
+#include <cstdint>
+
+namespace {
+    // Log file layout: a header followed by records.
+    // Record: uint32 n | n doubles | double evalTime | int32 evalStatus
+    //         | uint8 evalOk | uint8 countEval | uint32 bboLength | bbo chars
+    const char RECORD_REPLAY_MAGIC[8] = {'N','O','M','A','D','R','R','1'};
+
+    template<typename T>
+    void writeValue(std::ofstream& out, const T& value)
+    {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    bool readValue(std::ifstream& in, T& value)
+    {
+        in.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return in.good();
+    }
+}
+
+
+NOMAD::RecordReplayEvaluator::RecordReplayEvaluator(
+                    const std::shared_ptr<NOMAD::EvalParameters>& evalParams,
+                    const NOMAD::EvaluatorPtr& evaluator,
+                    const NOMAD::RecordReplayMode mode,
+                    const std::string& logFileName,
+                    const NOMAD::ReplayMissPolicy missPolicy,
+                    const NOMAD::EvalType evalType)
+  : NOMAD::Evaluator(evalParams, evalType),
+    _evaluator(evaluator),
+    _mode(mode),
+    _logFileName(logFileName),
+    _missPolicy(missPolicy),
+    _logFile(),
+    _entries(),
+    _nbReplayHits(0),
+    _nbReplayMisses(0)
+{
+    initLog();
+}
+
+
+NOMAD::RecordReplayEvaluator::~RecordReplayEvaluator()
+{
+    if (_logFile.is_open())
+    {
+        _logFile.close();
+    }
+}
+
+
+void NOMAD::RecordReplayEvaluator::initLog()
+{
+    if (_logFileName.empty())
+    {
+        throw NOMAD::Exception(__FILE__, __LINE__, "RecordReplayEvaluator: log file name is empty.");
+    }
+
+    if (nullptr != _evaluator && _evaluator->getEvalType() != _evalType)
+    {
+        throw NOMAD::Exception(__FILE__, __LINE__, "RecordReplayEvaluator: the wrapped evaluator has a different eval type.");
+    }
+
+    if (NOMAD::RecordReplayMode::RECORD == _mode)
+    {
+        if (nullptr == _evaluator)
+        {
+            throw NOMAD::Exception(__FILE__, __LINE__, "RecordReplayEvaluator: an evaluator is required to record.");
+        }
+        _logFile.open(_logFileName, std::ios::binary | std::ios::trunc);
+        if (_logFile.fail())
+        {
+            throw NOMAD::Exception(__FILE__, __LINE__, "RecordReplayEvaluator: cannot open log file " + _logFileName);
+        }
+        _logFile.write(RECORD_REPLAY_MAGIC, sizeof(RECORD_REPLAY_MAGIC));
+        _logFile.flush();
+    }
+    else
+    {
+        if (NOMAD::ReplayMissPolicy::EVALUATE == _missPolicy && nullptr == _evaluator)
+        {
+            throw NOMAD::Exception(__FILE__, __LINE__, "RecordReplayEvaluator: an evaluator is required to evaluate points missing from the log.");
+        }
+        // When the same point is recorded more than once, keep the first evaluation.
+        for (auto& entry : readLog(_logFileName))
+        {
+            auto key = entry.x;
+            _entries.emplace(std::move(key), std::move(entry));
+        }
+    }
+}
+
+
+std::vector<NOMAD::RecordReplayEntry> NOMAD::RecordReplayEvaluator::readLog(const std::string& logFileName)
+{
+    std::ifstream in(logFileName, std::ios::binary);
+    if (in.fail())
+    {
+        throw NOMAD::Exception(__FILE__, __LINE__, "RecordReplayEvaluator: cannot open log file " + logFileName);
+    }
+
+    char magic[sizeof(RECORD_REPLAY_MAGIC)];
+    in.read(magic, sizeof(magic));
+    if (!in.good() || !std::equal(magic, magic + sizeof(magic), RECORD_REPLAY_MAGIC))
+    {
+        throw NOMAD::Exception(__FILE__, __LINE__, "RecordReplayEvaluator: " + logFileName + " is not a record/replay log file.");
+    }
+
+    std::vector<NOMAD::RecordReplayEntry> entries;
+    std::uint32_t n = 0;
+    // A truncated last record (e.g. the recorded run was killed) is ignored.
+    while (readValue(in, n))
+    {
+        NOMAD::RecordReplayEntry entry;
+        entry.x.resize(n);
+        in.read(reinterpret_cast<char*>(entry.x.data()), n * sizeof(double));
+
+        std::int32_t evalStatus = 0;
+        std::uint8_t evalOk = 0, countEval = 0;
+        std::uint32_t bboLength = 0;
+        if (   !in.good()
+            || !readValue(in, entry.evalTime)
+            || !readValue(in, evalStatus)
+            || !readValue(in, evalOk)
+            || !readValue(in, countEval)
+            || !readValue(in, bboLength))
+        {
+            break;
+        }
+        entry.bbo.resize(bboLength);
+        in.read(&entry.bbo[0], bboLength);
+        if (in.gcount() != static_cast<std::streamsize>(bboLength))
+        {
+            break;
+        }
+        entry.evalStatus = static_cast<NOMAD::EvalStatusType>(evalStatus);
+        entry.evalOk = (0 != evalOk);
+        entry.countEval = (0 != countEval);
+        entries.push_back(std::move(entry));
+    }
+
+    return entries;
+}
+
+
+void NOMAD::RecordReplayEvaluator::writeEntries(const std::vector<NOMAD::RecordReplayEntry>& entries) const
+{
+#ifdef _OPENMP
+#pragma omp critical(recordReplayWrite)
+#endif // _OPENMP
+    {
+        for (const auto& entry : entries)
+        {
+            writeValue(_logFile, static_cast<std::uint32_t>(entry.x.size()));
+            _logFile.write(reinterpret_cast<const char*>(entry.x.data()), entry.x.size() * sizeof(double));
+            writeValue(_logFile, entry.evalTime);
+            writeValue(_logFile, static_cast<std::int32_t>(entry.evalStatus));
+            writeValue(_logFile, static_cast<std::uint8_t>(entry.evalOk));
+            writeValue(_logFile, static_cast<std::uint8_t>(entry.countEval));
+            writeValue(_logFile, static_cast<std::uint32_t>(entry.bbo.size()));
+            _logFile.write(entry.bbo.data(), entry.bbo.size());
+        }
+        // Flush after each block, so that the log is usable even if the run is interrupted.
+        _logFile.flush();
+    }
+}
+
+
+std::vector<double> NOMAD::RecordReplayEvaluator::makeKey(const NOMAD::EvalPoint& x)
+{
+    // Exact match on coordinates: a replay with the same seed generates
+    // the same points, bit for bit.
+    std::vector<double> key(x.size());
+    for (size_t i = 0; i < x.size(); i++)
+    {
+        key[i] = x[i].todouble();
+    }
+    return key;
+}
+
+
+std::vector<bool> NOMAD::RecordReplayEvaluator::evalAndRecord(NOMAD::Block &block,
+                                                              const NOMAD::Double &hMax,
+                                                              std::vector<bool> &countEval) const
+{
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<bool> evalOk = _evaluator->eval_block(block, hMax, countEval);
+    std::chrono::duration<double> blockTime = std::chrono::steady_clock::now() - startTime;
+
+    if (NOMAD::RecordReplayMode::RECORD != _mode)
+    {
+        return evalOk;
+    }
+
+    std::vector<NOMAD::RecordReplayEntry> entries;
+    for (size_t index = 0; index < block.size(); index++)
+    {
+        const auto& x = block[index];
+        // Points with EVAL_WAIT are evaluated by another main thread.
+        if (NOMAD::EvalStatusType::EVAL_WAIT == x->getEvalStatus(_evalType))
+        {
+            continue;
+        }
+        NOMAD::RecordReplayEntry entry;
+        entry.x = makeKey(*x);
+        entry.bbo = x->getBBO(_evalType);
+        entry.evalStatus = x->getEvalStatus(_evalType);
+        entry.evalOk = evalOk[index];
+        entry.countEval = countEval[index];
+        entries.push_back(std::move(entry));
+    }
+
+    // The blackbox evaluates a block at once: share the time between its points.
+    for (auto& entry : entries)
+    {
+        entry.evalTime = blockTime.count() / static_cast<double>(entries.size());
+    }
+    writeEntries(entries);
+
+    return evalOk;
+}
+
+
+std::vector<bool> NOMAD::RecordReplayEvaluator::eval_block(NOMAD::Block &block,
+                                                           const NOMAD::Double &hMax,
+                                                           std::vector<bool> &countEval) const
+{
+    if (block.empty())
+    {
+        throw NOMAD::Exception(__FILE__, __LINE__, "RecordReplayEvaluator: eval_block called with an empty block");
+    }
+
+    if (NOMAD::RecordReplayMode::RECORD == _mode)
+    {
+        return evalAndRecord(block, hMax, countEval);
+    }
+
+    std::vector<bool> evalOk(block.size(), false);
+    countEval.resize(block.size(), false);
+
+    NOMAD::Block missingBlock;
+    std::vector<size_t> missingIndex;
+
+    for (size_t index = 0; index < block.size(); index++)
+    {
+        auto& x = block[index];
+        if (NOMAD::EvalStatusType::EVAL_WAIT == x->getEvalStatus(_evalType))
+        {
+            evalOk[index] = true;
+            countEval[index] = false;
+            continue;
+        }
+
+        auto it = _entries.find(makeKey(*x));
+        if (it != _entries.end())
+        {
+            const auto& entry = it->second;
+            x->setBBO(entry.bbo, _bbOutputTypeList, _evalType, entry.evalOk);
+            if (NOMAD::EvalStatusType::EVAL_IN_PROGRESS != entry.evalStatus)
+            {
+                x->setEvalStatus(entry.evalStatus, _evalType);
+            }
+            evalOk[index] = entry.evalOk;
+            countEval[index] = entry.countEval;
+            _nbReplayHits++;
+            continue;
+        }
+
+        _nbReplayMisses++;
+        switch (_missPolicy)
+        {
+            case NOMAD::ReplayMissPolicy::EVALUATE:
+                missingBlock.push_back(x);
+                missingIndex.push_back(index);
+                break;
+            case NOMAD::ReplayMissPolicy::EXCEPTION:
+                throw NOMAD::Exception(__FILE__, __LINE__, "RecordReplayEvaluator: point not found in log: " + x->display());
+            case NOMAD::ReplayMissPolicy::EVAL_FAILED:
+            default:
+                OUTPUT_DEBUG_START
+                NOMAD::OutputQueue::Add("RecordReplayEvaluator: point not found in log: " + x->display(), NOMAD::OutputLevel::LEVEL_DEBUG);
+                OUTPUT_DEBUG_END
+                x->setEvalStatus(NOMAD::EvalStatusType::EVAL_FAILED, _evalType);
+                break;
+        }
+    }
+
+    if (!missingBlock.empty())
+    {
+        std::vector<bool> missingCountEval(missingBlock.size(), false);
+        auto missingEvalOk = evalAndRecord(missingBlock, hMax, missingCountEval);
+        for (size_t i = 0; i < missingIndex.size(); i++)
+        {
+            evalOk[missingIndex[i]] = missingEvalOk[i];
+            countEval[missingIndex[i]] = missingCountEval[i];
+        }
+    }
+
+    return evalOk;
+}
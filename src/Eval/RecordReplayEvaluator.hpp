@@ -0,0 +1,129 @@
+/**
+ \file   RecordReplayEvaluator.hpp
+ \brief  Evaluator decorator to record blackbox evaluations and replay them.
+ \see    RecordReplayEvaluator.cpp
+ */
+
+#ifndef __NOMAD_4_5_RECORDREPLAYEVALUATOR__
+#define __NOMAD_4_5_RECORDREPLAYEVALUATOR__
+
+#include <atomic>
+#include <fstream>
+#include <map>
+
+#include "../Eval/Evaluator.hpp"
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Mode of a record/replay evaluator.
+enum class RecordReplayMode
+{
+    RECORD,     ///< Forward to the wrapped evaluator and append each evaluation to the log
+    REPLAY      ///< Answer evaluations from the log
+};
+
+/// What to do in replay mode when a point is not in the log.
+enum class ReplayMissPolicy
+{
+    EVAL_FAILED,    ///< The evaluation fails (evalOk is false, not counted)
+    EVALUATE,       ///< Forward the point to the wrapped evaluator
+    EXCEPTION       ///< Throw an exception
+};
+
+
+/// A single evaluation stored in the log.
+struct DLL_EVAL_API RecordReplayEntry
+{
+    std::vector<double> x;              ///< Coordinates of the evaluated point
+    std::string         bbo;            ///< Raw blackbox output
+    double              evalTime;       ///< Wall clock time of the evaluation (s)
+    EvalStatusType      evalStatus;     ///< Eval status after evaluation
+    bool                evalOk;         ///< Value returned for this point by eval_block
+    bool                countEval;      ///< Count eval flag returned for this point by eval_block
+};
+
+
+/// Evaluator decorator for deterministic replay of blackbox runs.
+/**
+ * In RECORD mode, the points are forwarded to the wrapped evaluator and
+ * each (x, raw bb outputs, eval time, eval status) is appended to a compact
+ * binary log file.\n
+ * In REPLAY mode, the log is loaded at construction and evaluations are
+ * answered without calling the blackbox. Points missing from the log are
+ * handled according to the ReplayMissPolicy.\n
+ * Combined with fixed SEED and RNG_ALT_SEEDING, a replay reproduces the
+ * trajectory of the recorded run, which isolates the time spent in the
+ * algorithm itself.
+ */
+class DLL_EVAL_API RecordReplayEvaluator : public Evaluator
+{
+private:
+    const EvaluatorPtr      _evaluator;     ///< Wrapped evaluator. May be nullptr in REPLAY mode.
+    const RecordReplayMode  _mode;
+    const std::string       _logFileName;
+    const ReplayMissPolicy  _missPolicy;
+
+    mutable std::ofstream   _logFile;       ///< Output stream (RECORD mode)
+
+    std::map<std::vector<double>, RecordReplayEntry> _entries; ///< Loaded log (REPLAY mode)
+
+    mutable std::atomic<size_t> _nbReplayHits;
+    mutable std::atomic<size_t> _nbReplayMisses;
+
+public:
+    /// Constructor
+    /**
+     \param evalParams  The parameters to control the behavior of the evaluator -- \b IN.
+     \param evaluator   The wrapped evaluator. Required for RECORD mode and for EVALUATE miss policy -- \b IN.
+     \param mode        Record or replay -- \b IN.
+     \param logFileName The binary log file -- \b IN.
+     \param missPolicy  Policy for points missing from the log (REPLAY mode) -- \b IN.
+     \param evalType    Which type of Eval is updated -- \b IN.
+     */
+    explicit RecordReplayEvaluator(const std::shared_ptr<EvalParameters>& evalParams,
+                                   const EvaluatorPtr& evaluator,
+                                   RecordReplayMode mode,
+                                   const std::string& logFileName,
+                                   ReplayMissPolicy missPolicy = ReplayMissPolicy::EVAL_FAILED,
+                                   EvalType evalType = EvalType::BB);
+
+    virtual ~RecordReplayEvaluator();
+
+    /*---------*/
+    /* Get/Set */
+    /*---------*/
+    RecordReplayMode getMode() const { return _mode; }
+    size_t getNbEntries() const { return _entries.size(); }
+    size_t getNbReplayHits() const { return _nbReplayHits; }
+    size_t getNbReplayMisses() const { return _nbReplayMisses; }
+
+    /*---------------*/
+    /* Other methods */
+    /*---------------*/
+    std::vector<bool> eval_block(Block &block,
+                                 const Double &hMax,
+                                 std::vector<bool> &countEval) const override;
+
+    /// Read all entries of a log file.
+    static std::vector<RecordReplayEntry> readLog(const std::string& logFileName);
+
+private:
+    /// Helper for constructor: open or load the log file
+    void initLog();
+
+    /// Forward a block to the wrapped evaluator, and record it in RECORD mode.
+    std::vector<bool> evalAndRecord(Block &block,
+                                    const Double &hMax,
+                                    std::vector<bool> &countEval) const;
+
+    /// Append entries to the log file
+    void writeEntries(const std::vector<RecordReplayEntry>& entries) const;
+
+    /// Key used to find a point in the log
+    static std::vector<double> makeKey(const EvalPoint& x);
+};
+
+#include "../nomad_nsend.hpp"
+
+#endif // __NOMAD_4_5_RECORDREPLAYEVALUATOR__
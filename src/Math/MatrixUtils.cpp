@@ -1,8 +1,32 @@
 #include "../Math/MatrixUtils.hpp"
+#include "../Math/MatrixWorkspace.hpp"
 #include "../Util/utils.hpp"
 
+#include "../../ext/sgtelib/src/Linear_Algebra.hpp"
+
 #include <cmath>
 #include <algorithm>
+#include <vector>
+
+namespace {
+    // Copy between a row-pointer matrix (m x n) and a contiguous row-major
+    // block, the storage of the dense linear algebra backend.
+    void packRows(double ** M, const int m, const int n, double * B)
+    {
+        for (int i = 0; i < m; ++i)
+        {
+            std::copy(M[i], M[i] + n, B + static_cast<size_t>(i) * n);
+        }
+    }
+
+    void unpackRows(const double * B, const int m, const int n, double ** M)
+    {
+        for (int i = 0; i < m; ++i)
+        {
+            std::copy(B + static_cast<size_t>(i) * n, B + static_cast<size_t>(i + 1) * n, M[i]);
+        }
+    }
+}
 
 bool NOMAD::getDeterminant(double ** M,
                             double  & det,
@@ -114,7 +138,8 @@ bool NOMAD::SVD_decomposition ( std::string & error_msg,
                                double     ** V,
                                int           m,
                                int           n,
-                               int           max_mpn     ) // default = 1500
+                               int           max_mpn,      // default = 1500
+                               NOMAD::MatrixWorkspace * workspace ) // default = nullptr
 {
     error_msg.clear();
 
@@ -124,7 +149,31 @@ bool NOMAD::SVD_decomposition ( std::string & error_msg,
         return false;
     }
 
-    auto     rv1   = new double[n];
+    NOMAD::MatrixWorkspace localWorkspace;
+    NOMAD::MatrixWorkspace& ws = (nullptr != workspace) ? *workspace : localWorkspace;
+    NOMAD::MatrixWorkspace::Frame frame(ws);
+
+    // Backend (LAPACK) for the large matrices
+    if (SGTELIB::linalg::use_backend(n) && m >= n)
+    {
+        double * A  = ws.getVector(static_cast<size_t>(m) * n);
+        double * Vb = ws.getVector(static_cast<size_t>(n) * n);
+        packRows(M, m, n, A);
+        const auto status = SGTELIB::linalg::svd(m, n, A, n, A, n, W, Vb, n);
+        if (SGTELIB::linalg::LINALG_FAILURE == status)
+        {
+            error_msg = "SVD_decomposition() error: no convergence of the backend";
+            return false;
+        }
+        if (SGTELIB::linalg::LINALG_SUCCESS == status)
+        {
+            unpackRows(A, m, n, M);
+            unpackRows(Vb, n, n, V);
+            return true;
+        }
+    }
+
+    double * rv1   = ws.getVector(n);
     double   scale = 0.0;
     double   g     = 0.0;
     double   norm  = 0.0;
@@ -327,7 +376,6 @@ bool NOMAD::SVD_decomposition ( std::string & error_msg,
             {
                 error_msg = "SVD_decomposition() error: no convergence in " +
                 NOMAD::itos ( NITER ) + " iterations";
-                delete [] rv1;
                 return false;
             }
             x  = W[l];
@@ -405,7 +453,6 @@ bool NOMAD::SVD_decomposition ( std::string & error_msg,
         }
     }
 
-    delete [] rv1;
     return true;
 }
 
@@ -543,6 +590,25 @@ bool NOMAD::qr_factorization(std::string & error_msg,
         return false;
     }
 
+    // Backend (LAPACK, Householder reflections) for the large matrices
+    if (SGTELIB::linalg::use_backend(n))
+    {
+        std::vector<double> A(static_cast<size_t>(m) * n), Qb(static_cast<size_t>(m) * m), Rb(static_cast<size_t>(m) * n);
+        packRows(M, m, n, A.data());
+        const auto status = SGTELIB::linalg::qr(m, n, A.data(), n, Qb.data(), m, Rb.data(), n);
+        if (SGTELIB::linalg::LINALG_FAILURE == status)
+        {
+            error_msg = "qr_factorization() error: failure of the backend";
+            return false;
+        }
+        if (SGTELIB::linalg::LINALG_SUCCESS == status)
+        {
+            unpackRows(Qb.data(), m, m, Q);
+            unpackRows(Rb.data(), m, n, R);
+            return true;
+        }
+    }
+
     // Initialization: R := M and Q := Imxm.
     for (int i = 0; i < m; ++i)
     {
@@ -1045,7 +1111,8 @@ bool NOMAD::LDLt_decomposition ( std::string & error_msg,
                               double     ** D,
                               int        * pp,
                               int           n,
-                              int           max_n     ) // default = 1500
+                              int           max_n,      // default = 1500
+                              NOMAD::MatrixWorkspace * workspace ) // default = nullptr
 {
     error_msg.clear();
 
@@ -1082,8 +1149,11 @@ bool NOMAD::LDLt_decomposition ( std::string & error_msg,
             }
     }
 
-    auto Mik = new double[n];
-    auto Mki = new double[n];
+    NOMAD::MatrixWorkspace localWorkspace;
+    NOMAD::MatrixWorkspace& ws = (nullptr != workspace) ? *workspace : localWorkspace;
+    NOMAD::MatrixWorkspace::Frame frame(ws);
+    double* Mik = ws.getVector(n);
+    double* Mki = ws.getVector(n);
 
     double detE;
     double tmp;
@@ -1166,8 +1236,6 @@ bool NOMAD::LDLt_decomposition ( std::string & error_msg,
                     }
                     if (m1 < 0 || m1 >= n || m2 < 0 || m2 >= n)
                     {
-                        delete [] Mik;
-                        delete [] Mki;
                         return false;
                     }
                     if (swap)
@@ -1257,8 +1325,6 @@ bool NOMAD::LDLt_decomposition ( std::string & error_msg,
             {
                 if (k >= n)
                 {
-                    delete [] Mik;
-                    delete [] Mki;
                     return false;
                 }
                 // E = A[k:k+1, k:k+1]
@@ -1275,8 +1341,6 @@ bool NOMAD::LDLt_decomposition ( std::string & error_msg,
                 if (detE == 0)
                 {
                     error_msg = "Error in pivoting: determinant of block diagonal is 0.";
-                    delete [] Mik;
-                    delete [] Mki;
                     return false;
                 }
 
@@ -1349,8 +1413,6 @@ bool NOMAD::LDLt_decomposition ( std::string & error_msg,
         }
     }
 
-    delete [] Mik;
-    delete [] Mki;
 
     return true;
 }
@@ -1553,11 +1615,14 @@ bool NOMAD::ldl_solve(std::string& error_msg,
 {
     error_msg.clear();
 
-    // Initialize y
-    auto y = new double[n];
-    for (int i = 0; i < n; ++i)
+    // Initialize y. The solve is done in place in sol, which may be rhs itself.
+    double* y = sol;
+    if (y != rhs)
     {
-        y[i] = rhs[i];
+        for (int i = 0; i < n; ++i)
+        {
+            y[i] = rhs[i];
+        }
     }
 
     // Solve A x = y, where P A P' = L D L'
@@ -1677,12 +1742,6 @@ bool NOMAD::ldl_solve(std::string& error_msg,
         }
     }
 
-    for (int i = 0; i < n; ++i)
-    {
-        sol[i] = y[i];
-    }
-    delete [] y;
-
     return true;
 }
 
@@ -1692,14 +1751,18 @@ bool NOMAD::ldl_solve( std::string & error_msg,
     const double * rhs,
     double       * sol,
     const int    * pp,
-    int            n
+    int            n,
+    NOMAD::MatrixWorkspace * workspace // default = nullptr
 )
 {
     error_msg.clear();
     bool success;
 
-    auto prhs = new double [n];
-    auto Lz = new double [n];
+    NOMAD::MatrixWorkspace localWorkspace;
+    NOMAD::MatrixWorkspace& ws = (nullptr != workspace) ? *workspace : localWorkspace;
+    NOMAD::MatrixWorkspace::Frame frame(ws);
+    double* prhs = ws.getVector(n);
+    double* Lz = ws.getVector(n);
     for (int i = 0; i < n; i++)
     {
         prhs[i] = rhs[pp[i]];
@@ -1710,7 +1773,7 @@ bool NOMAD::ldl_solve( std::string & error_msg,
     {
         return false;
     }
-    auto Dy = new double [n];
+    double* Dy = ws.getVector(n);
     for (int i = 0; i < n; i++)
     {
         Dy[i] = 0.0;
@@ -1718,13 +1781,10 @@ bool NOMAD::ldl_solve( std::string & error_msg,
     success = ldl_dsolve(D, Lz, Dy, n); // Dy = z
     if (!success)
     {
-        delete [] prhs;
-        delete [] Lz;
-        delete [] Dy;
         return false;
     }
 
-    auto psol = new double [n];
+    double* psol = ws.getVector(n);
     for (int i = 0; i < n; i++)
     {
         psol[i] = 0.0;
@@ -1736,10 +1796,5 @@ bool NOMAD::ldl_solve( std::string & error_msg,
         sol[i] = psol[pp[i]];
     }
 
-    delete [] prhs;
-    delete [] Lz;
-    delete [] Dy;
-    delete [] psol;
-
     return success;
 }
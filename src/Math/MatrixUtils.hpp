@@ -12,6 +12,8 @@ const double SVD_MAX_COND = NOMAD::INF; ///< Max. acceptable cond. number
 #include "../nomad_platform.hpp"
 #include "../nomad_nsbegin.hpp"
 
+class MatrixWorkspace;
+
 /// Utilities for matrix.
 /**
  Utilities for Matrix. Not everything that would be expected for a Matrix class is here. The methods are added when they are necessary for the code.
@@ -29,7 +31,12 @@ const double SVD_MAX_COND = NOMAD::INF; ///< Max. acceptable cond. number
  \param n         Number of columns in M                              -- \b IN.
  \param max_mpn   Maximum allowed value for \c m+n; ignored if \c <=0 -- \b IN
  (Opt) (default = \c 1500).
+ \param workspace Scratch memory for the temporaries; a local one is used
+                  if \c nullptr -- \b IN (Opt) (default = \c nullptr).
  \return          \c true if the decomposition worked.
+
+ When Nomad is built with \c USE_LAPACK, the large matrices with \c m>=n are decomposed
+ by LAPACK. The singular values are then sorted in decreasing order.
  */
 DLL_UTIL_API bool SVD_decomposition(std::string& error_msg,
                        double ** M,
@@ -37,7 +44,8 @@ DLL_UTIL_API bool SVD_decomposition(std::string& error_msg,
                        double ** V,
                        int       m,
                        int       n,
-                       int       max_mpn = 1500);
+                       int       max_mpn = 1500,
+                       MatrixWorkspace * workspace = nullptr);
 
 
 /// LU decomposition.
@@ -80,6 +88,8 @@ DLL_UTIL_API bool LU_decomposition(std::string & error_msg,
  This implementation could be improved, especially in the storing of the reflection matrices
  coefficients. For the small matrix sizes involved in this context, the memory cost is not
  a problem.
+
+ When Nomad is built with \c USE_LAPACK, the large matrices are factorized by LAPACK (Householder).
  */
 DLL_UTIL_API bool qr_factorization(std::string & error_msg,
                                    double ** M,
@@ -160,6 +170,8 @@ DLL_UTIL_API bool LDLt_extract(std::string& error_msg,
  \param pp        Permutation vector of size \c n ; -- \b OUT.
  \param n         Number of columns and rows in M                              -- \b IN.
  \param max_mpn   Maximum allowed value for \c n; ignored if \c <=0 -- \b IN.
+ \param workspace Scratch memory for the temporaries; a local one is used
+                  if \c nullptr -- \b IN (Opt) (default = \c nullptr).
  \return          \c true if the decomposition worked.
 
  We use the original `partial pivoting` strategy from Bunch and Kaufman.
@@ -170,7 +182,8 @@ DLL_UTIL_API bool LDLt_decomposition(std::string & error_msg,
                        double ** D,
                        int    * pp,
                        int       n,
-                       int       max_mpn = 1500);
+                       int       max_mpn = 1500,
+                       MatrixWorkspace * workspace = nullptr);
 
 /// Block-diagonal regularization.
 /**
@@ -206,7 +219,7 @@ DLL_UTIL_API double FindSmallestEigenvalue(double ** D, int n);
  \param error_msg Error message when the function returns \c false    -- \b OUT.
  \param M         The input factored \c nxn matrix; -- \b IN.
  \param rhs       Right-hand side vector of size \c n of the linear system; -- \b IN.
- \param sol       Solution vector of size \c n; -- \b OUT.
+ \param sol       Solution vector of size \c n; may be \c rhs itself -- \b OUT.
  \param pivots    Permutation vector of size \c n; -- \b IN.
  \param n         Number of columns and rows in M; -- \b IN.
  \return          \c true if the resolution has worked.
@@ -230,6 +243,8 @@ DLL_UTIL_API bool ldl_solve(std::string& error_msg,
  \param sol       Solution vector of size \c n ; -- \b OUT.
  \param pp        Permutation vector of size \c n ; -- \b IN.
  \param n         Number of columns and rows in M                              -- \b IN.
+ \param workspace Scratch memory for the temporaries; a local one is used
+                  if \c nullptr -- \b IN (Opt) (default = \c nullptr).
  \return          \c true if the solve worked.
 
 This function successively uses ldl_dsolve, ldl_ltsolve and ldl_lsolve.
@@ -240,7 +255,8 @@ DLL_UTIL_API bool ldl_solve(std::string & error_msg,
     const double * rhs,
     double       * sol,
     const int    * pp,
-    int          n);
+    int          n,
+    MatrixWorkspace * workspace = nullptr);
 
 DLL_UTIL_API bool ldl_dsolve( double ** D, const double * rhs, double * Ly, int n);
 
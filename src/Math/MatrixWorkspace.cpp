@@ -0,0 +1,111 @@
+/**
+ \file   MatrixWorkspace.cpp
+ \brief  Reusable scratch memory for the dense matrix routines: implementation
+ \see    MatrixWorkspace.hpp
+ */
+
+#include "../Math/MatrixWorkspace.hpp"
+
+#include <algorithm>
+
+/*---------------------------------------------------------*/
+/*                         constructor                     */
+/*---------------------------------------------------------*/
+NOMAD::MatrixWorkspace::MatrixWorkspace(const size_t nbDoubles,
+                                        const size_t nbRows,
+                                        const size_t nbInts)
+  : _doubles(),
+    _rows(),
+    _ints(),
+    _nbFrames(0)
+{
+    reserve(nbDoubles, nbRows, nbInts);
+}
+
+
+/*---------------------------------------------------------*/
+/*                           reserve                       */
+/*---------------------------------------------------------*/
+void NOMAD::MatrixWorkspace::reserve(const size_t nbDoubles,
+                                     const size_t nbRows,
+                                     const size_t nbInts)
+{
+    // The blocks cannot be reallocated while views are in use.
+    if (_nbFrames > 0)
+    {
+        return;
+    }
+    _doubles.consolidate(nbDoubles);
+    _rows.consolidate(nbRows);
+    _ints.consolidate(nbInts);
+}
+
+
+/*---------------------------------------------------------*/
+/*                       get temporaries                   */
+/*---------------------------------------------------------*/
+double* NOMAD::MatrixWorkspace::getVector(const size_t n)
+{
+    double* v = _doubles.take(n);
+    std::fill(v, v + n, 0.0);
+    return v;
+}
+
+
+double** NOMAD::MatrixWorkspace::getMatrix(const size_t nrows, const size_t ncols)
+{
+    double** M = _rows.take(nrows);
+    double* data = getVector(nrows * ncols);
+    for (size_t i = 0; i < nrows; ++i)
+    {
+        M[i] = data + i * ncols;
+    }
+    return M;
+}
+
+
+int* NOMAD::MatrixWorkspace::getIntVector(const size_t n)
+{
+    int* v = _ints.take(n);
+    std::fill(v, v + n, 0);
+    return v;
+}
+
+
+size_t NOMAD::MatrixWorkspace::getNbAllocations() const
+{
+    return _doubles.getNbAllocations() + _rows.getNbAllocations() + _ints.getNbAllocations();
+}
+
+
+/*---------------------------------------------------------*/
+/*                            Frame                        */
+/*---------------------------------------------------------*/
+NOMAD::MatrixWorkspace::Frame::Frame(NOMAD::MatrixWorkspace& ws)
+  : _ws(ws)
+{
+    _ws._doubles.mark(_mark[0], _mark[1], _mark[2]);
+    _ws._rows.mark(_mark[3], _mark[4], _mark[5]);
+    _ws._ints.mark(_mark[6], _mark[7], _mark[8]);
+    ++_ws._nbFrames;
+}
+
+
+NOMAD::MatrixWorkspace::Frame::~Frame()
+{
+    --_ws._nbFrames;
+    if (0 == _ws._nbFrames)
+    {
+        // Outermost frame: everything is given back. Merge the blocks so
+        // that the next use of the workspace fits in a single block.
+        _ws._doubles.consolidate();
+        _ws._rows.consolidate();
+        _ws._ints.consolidate();
+    }
+    else
+    {
+        _ws._doubles.release(_mark[0], _mark[1], _mark[2]);
+        _ws._rows.release(_mark[3], _mark[4], _mark[5]);
+        _ws._ints.release(_mark[6], _mark[7], _mark[8]);
+    }
+}
@@ -0,0 +1,185 @@
+/**
+ \file   MatrixWorkspace.hpp
+ \brief  Reusable scratch memory for the dense matrix routines
+ \see    MatrixWorkspace.cpp
+ */
+
+#ifndef __NOMAD_4_5_MATRIX_WORKSPACE__
+#define __NOMAD_4_5_MATRIX_WORKSPACE__
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "../Util/Uncopyable.hpp"
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+
+/// Scratch memory for the \c double** routines of MatrixUtils and the QP solvers.
+/**
+ The workspace hands out vectors and row-pointer matrices from arenas that
+ are kept between calls. A matrix is one contiguous row-major block: row \c i
+ starts at \c M[0] + i * ncols.
+
+ Memory is taken in a stack-like manner. A Frame records the current top of
+ the arenas and gives the memory back on destruction, so that a routine can
+ take its temporaries without caring about the early returns.
+
+ When a request does not fit, a new block is appended (the views already
+ handed out stay valid). When no frame is open, the blocks are merged into
+ one block large enough for the peak usage, so that once the largest problem
+ has been seen, the workspace does not allocate anymore.
+
+ A workspace must not be shared between threads.
+
+   \code
+   NOMAD::MatrixWorkspace ws;
+   {
+       NOMAD::MatrixWorkspace::Frame frame(ws);
+       double** Q = ws.getMatrix(m, m);
+       double*  c = ws.getVector(m);
+       ...
+   } // Q and c are given back here.
+   \endcode
+*/
+class DLL_UTIL_API MatrixWorkspace : private Uncopyable
+{
+private:
+
+    /// Stack of blocks of \c T.
+    template <typename T>
+    class Arena
+    {
+    private:
+        std::vector<std::unique_ptr<T[]>> _blocks; ///< Blocks of memory.
+        std::vector<size_t> _capacities;           ///< Capacity of each block.
+        size_t _block;      ///< Index of the block currently in use.
+        size_t _used;       ///< Number of elements used in the current block.
+        size_t _inUse;      ///< Number of elements in use, over all blocks.
+        size_t _peak;       ///< Peak of \c _inUse.
+        size_t _nbAllocations; ///< Number of blocks allocated so far.
+
+    public:
+        Arena() : _block(0), _used(0), _inUse(0), _peak(0), _nbAllocations(0) {}
+
+        T* take(const size_t n)
+        {
+            if (_blocks.empty() || _used + n > _capacities[_block])
+            {
+                const size_t next = _blocks.empty() ? 0 : _block + 1;
+                if (next >= _blocks.size() || _capacities[next] < n)
+                {
+                    const size_t capacity = std::max(n, _blocks.empty() ? n : _capacities[_block]);
+                    _blocks.insert(_blocks.begin() + next, std::unique_ptr<T[]>(new T[capacity]));
+                    _capacities.insert(_capacities.begin() + next, capacity);
+                    ++_nbAllocations;
+                }
+                _block = next;
+                _used = 0;
+            }
+            T* ptr = _blocks[_block].get() + _used;
+            _used += n;
+            _inUse += n;
+            _peak = std::max(_peak, _inUse);
+            return ptr;
+        }
+
+        void mark(size_t& block, size_t& used, size_t& inUse) const
+        {
+            block = _block;
+            used = _used;
+            inUse = _inUse;
+        }
+
+        void release(const size_t block, const size_t used, const size_t inUse)
+        {
+            _block = block;
+            _used = used;
+            _inUse = inUse;
+        }
+
+        /// Merge the blocks into a single one, large enough for the peak usage
+        /// (or for \c n elements). Only valid when nothing is in use.
+        void consolidate(const size_t n = 0)
+        {
+            _peak = std::max(_peak, n);
+            if (_blocks.size() > 1 || (_peak > 0 && getCapacity() < _peak))
+            {
+                const size_t capacity = std::max(_peak, getCapacity());
+                _blocks.clear();
+                _capacities.clear();
+                _blocks.push_back(std::unique_ptr<T[]>(new T[capacity]));
+                _capacities.push_back(capacity);
+                ++_nbAllocations;
+            }
+            _block = 0;
+            _used = 0;
+            _inUse = 0;
+        }
+
+        size_t getCapacity() const
+        {
+            size_t capacity = 0;
+            for (const auto c : _capacities)
+            {
+                capacity += c;
+            }
+            return capacity;
+        }
+
+        size_t getNbAllocations() const { return _nbAllocations; }
+    };
+
+    Arena<double>   _doubles;  ///< Vectors and matrix coefficients.
+    Arena<double*>  _rows;     ///< Row pointers of the matrices.
+    Arena<int>      _ints;     ///< Integer vectors (pivots, permutations).
+    size_t          _nbFrames; ///< Number of open frames.
+
+public:
+
+    /// Constructor.
+    /**
+     \param nbDoubles  Initial capacity in doubles       -- \b IN.
+     \param nbRows     Initial capacity in matrix rows   -- \b IN.
+     \param nbInts     Initial capacity in integers      -- \b IN.
+     */
+    explicit MatrixWorkspace(const size_t nbDoubles = 0,
+                             const size_t nbRows = 0,
+                             const size_t nbInts = 0);
+
+    /// Make sure that the given sizes can be taken without allocation.
+    void reserve(const size_t nbDoubles, const size_t nbRows, const size_t nbInts);
+
+    /// Get a vector of size \c n, filled with zeros.
+    double* getVector(const size_t n);
+
+    /// Get a contiguous row-major \c nrows x \c ncols matrix, filled with zeros.
+    double** getMatrix(const size_t nrows, const size_t ncols);
+
+    /// Get an integer vector of size \c n, filled with zeros.
+    int* getIntVector(const size_t n);
+
+    /// Number of blocks allocated since construction (for diagnostics).
+    size_t getNbAllocations() const;
+
+    /// Capacity in doubles.
+    size_t getCapacity() const { return _doubles.getCapacity(); }
+
+    /// Scope of the temporaries taken from a workspace.
+    class DLL_UTIL_API Frame : private Uncopyable
+    {
+    private:
+        MatrixWorkspace& _ws;
+        size_t _mark[9];
+
+    public:
+        explicit Frame(MatrixWorkspace& ws);
+        ~Frame();
+    };
+};
+
+#include "../nomad_nsend.hpp"
+
+#endif // __NOMAD_4_5_MATRIX_WORKSPACE__
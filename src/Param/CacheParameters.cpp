@@ -61,9 +61,21 @@ void NOMAD::CacheParameters::checkAndComply(const std::shared_ptr<NOMAD::RunPara
         }
     }
 
+    setSnapshot();
+
     _toBeChecked = false;
 
 }
 // End checkAndComply()
 
 
+/*----------------------------------------*/
+/*           snapshot (private)           */
+/*----------------------------------------*/
+void NOMAD::CacheParameters::setSnapshot()
+{
+    // Values are read before _toBeChecked is reset: no check exception.
+#define NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) _snapshot.NAME = getSpValue<TYPE>(KEY, false);
+    #include "../Attribute/cacheAttributesDefinitionFields.hpp"
+#undef NOMAD_PARAMETER_FIELD
+}
@@ -6,6 +6,18 @@
 
 #include "../nomad_nsbegin.hpp"
 
+/// The cache attribute values after the last CacheParameters::checkAndComply().
+/**
+ One field per attribute, with the attribute name. A field is accessed directly, without a lookup by name, and a snapshot is cheap to copy compared to the parameters.
+ The field list is created by the writeAttributeDefinition executable from the attribute definition txt files.
+ */
+struct CacheParametersSnapshot
+{
+#define NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) TYPE NAME{};
+#include "../Attribute/cacheAttributesDefinitionFields.hpp"
+#undef NOMAD_PARAMETER_FIELD
+};
+
 /// The class for all Cache parameters.
 /**
 - Register all parameters during construction.
@@ -13,6 +25,9 @@
 */
 class DLL_UTIL_API CacheParameters final : public Parameters
 {
+private:
+    CacheParametersSnapshot _snapshot; ///< Attribute values set by checkAndComply().
+
 public:
     /// Constructor
     explicit CacheParameters()
@@ -27,6 +42,16 @@ public:
      */
     void checkAndComply(const std::shared_ptr<RunParameters>& runParams);
 
+    /// Access to the attribute values set by the last checkAndComply().
+    /**
+     An exception is triggered if the parameters need to be checked.
+     */
+    const CacheParametersSnapshot& getSnapshot() const
+    {
+        verifyChecked();
+        return _snapshot;
+    }
+
 private:
     /// Helper for constructor
     /**
@@ -34,6 +59,9 @@ private:
      */
     void init() override ;
 
+    /// Helper for checkAndComply(): copy the checked attribute values into the snapshot.
+    void setSnapshot();
+
 };
 
 #include "../nomad_nsend.hpp"
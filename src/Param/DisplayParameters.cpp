@@ -138,6 +138,14 @@ void NOMAD::DisplayParameters::checkAndComply(
         setAttributeValue("EVAL_STATS_FILE", evalStatsFileName);
     }
 
+    auto profileFileName = getAttributeValueProtected<std::string>("PROFILE_FILE",false) ;
+    if (!profileFileName.empty() && profileFileName.compare("-") != 0  )
+    {
+        auto seed = runParams->getAttributeValue<int>("SEED");
+        NOMAD::completeFileName(profileFileName, problemDir, addSeedToFileNames, seed);
+        setAttributeValue("PROFILE_FILE", profileFileName);
+    }
+
     /*------------------------------------------------------*/
     /* History file                                           */
     /*------------------------------------------------------*/
@@ -166,6 +174,8 @@ void NOMAD::DisplayParameters::checkAndComply(
         throw NOMAD::InvalidParameter(__FILE__,__LINE__, "SOLUTION_FILE_FINAL must be enabled only with SOLUTION_FILE properly set.");
     }
 
+    setSnapshot();
+
     _toBeChecked = false;
 
 }
@@ -194,5 +204,13 @@ NOMAD::ArrayOfDouble NOMAD::DisplayParameters::setFormatFromGranularity( const N
 }
 
 
-
-
+/*----------------------------------------*/
+/*           snapshot (private)           */
+/*----------------------------------------*/
+void NOMAD::DisplayParameters::setSnapshot()
+{
+    // Values are read before _toBeChecked is reset: no check exception.
+#define NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) _snapshot.NAME = getSpValue<TYPE>(KEY, false);
+    #include "../Attribute/displayAttributesDefinitionFields.hpp"
+#undef NOMAD_PARAMETER_FIELD
+}
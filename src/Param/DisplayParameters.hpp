@@ -5,9 +5,22 @@
 #include "../Param/Parameters.hpp"
 #include "../Param/RunParameters.hpp"
 #include "../Param/PbParameters.hpp"
+#include "../Util/ArrayOfString.hpp"
 
 #include "../nomad_nsbegin.hpp"
 
+/// The display attribute values after the last DisplayParameters::checkAndComply().
+/**
+ One field per attribute, with the attribute name. A field is accessed directly, without a lookup by name, and a snapshot is cheap to copy compared to the parameters.
+ The field list is created by the writeAttributeDefinition executable from the attribute definition txt files.
+ */
+struct DisplayParametersSnapshot
+{
+#define NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) TYPE NAME{};
+#include "../Attribute/displayAttributesDefinitionFields.hpp"
+#undef NOMAD_PARAMETER_FIELD
+};
+
 /// The class for Display parameters
 /**
 - Register all parameters during construction.
@@ -15,6 +28,9 @@
 */
 class DLL_UTIL_API DisplayParameters final : public Parameters
 {
+private:
+    DisplayParametersSnapshot _snapshot; ///< Attribute values set by checkAndComply().
+
 public:
 
     explicit DisplayParameters()
@@ -28,6 +44,16 @@ public:
     void checkAndComply( const std::shared_ptr<RunParameters> & runParams ,
                         const std::shared_ptr<PbParameters> & pbParams );
 
+    /// Access to the attribute values set by the last checkAndComply().
+    /**
+     An exception is triggered if the parameters need to be checked.
+     */
+    const DisplayParametersSnapshot& getSnapshot() const
+    {
+        verifyChecked();
+        return _snapshot;
+    }
+
 
 private:
 
@@ -40,6 +66,9 @@ private:
     /// Helper for checkAndComply
     ArrayOfDouble setFormatFromGranularity(const ArrayOfDouble & aod );
 
+    /// Helper for checkAndComply(): copy the checked attribute values into the snapshot.
+    void setSnapshot();
+
 };
 
 #include "../nomad_nsend.hpp"
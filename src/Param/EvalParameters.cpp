@@ -146,6 +146,8 @@ void NOMAD::EvalParameters::checkAndComply(const std::shared_ptr<NOMAD::RunParam
     auto pointFormat = pbParams->getAttributeValue<NOMAD::ArrayOfDouble>("POINT_FORMAT");
     setAttributeValue("BB_EVAL_FORMAT", pointFormat);
 
+    setSnapshot();
+
     _toBeChecked = false;
 
 }
@@ -207,4 +209,13 @@ void NOMAD::EvalParameters::updateExeParam(const std::shared_ptr<NOMAD::RunParam
 }
 
 
-
+/*----------------------------------------*/
+/*           snapshot (private)           */
+/*----------------------------------------*/
+void NOMAD::EvalParameters::setSnapshot()
+{
+    // Values are read before _toBeChecked is reset: no check exception.
+#define NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) _snapshot.NAME = getSpValue<TYPE>(KEY, false);
+    #include "../Attribute/evalAttributesDefinitionFields.hpp"
+#undef NOMAD_PARAMETER_FIELD
+}
@@ -5,9 +5,22 @@
 #include "../Param/EvaluatorControlParameters.hpp"
 #include "../Param/Parameters.hpp"
 #include "../Param/RunParameters.hpp"
+#include "../Type/BBOutputType.hpp"
 
 #include "../nomad_nsbegin.hpp"
 
+/// The evaluation attribute values after the last EvalParameters::checkAndComply().
+/**
+ One field per attribute, with the attribute name. A field is accessed directly, without a lookup by name, and a snapshot is cheap to copy compared to the parameters.
+ The field list is created by the writeAttributeDefinition executable from the attribute definition txt files.
+ */
+struct EvalParametersSnapshot
+{
+#define NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) TYPE NAME{};
+#include "../Attribute/evalAttributesDefinitionFields.hpp"
+#undef NOMAD_PARAMETER_FIELD
+};
+
 /// Class for Evaluator parameters
 /**
 - Register all parameters during construction.
@@ -16,6 +29,9 @@
 */
 class DLL_UTIL_API EvalParameters final : public Parameters
 {
+private:
+    EvalParametersSnapshot _snapshot; ///< Attribute values set by checkAndComply().
+
 public:
 
     explicit EvalParameters()
@@ -29,6 +45,16 @@ public:
                         const std::shared_ptr<PbParameters>& pbParams,
                         const std::shared_ptr<EvaluatorControlGlobalParameters>& evaluatorControlGlobalParams,
                         const std::shared_ptr<EvaluatorControlParameters>& evaluatorControlParams);
+
+    /// Access to the attribute values set by the last checkAndComply().
+    /**
+     An exception is triggered if the parameters need to be checked.
+     */
+    const EvalParametersSnapshot& getSnapshot() const
+    {
+        verifyChecked();
+        return _snapshot;
+    }
     
     /**
      The copy constructor is not implemented in the parent class to allow some control over what parameters can be copied or not. Use the deep copy function of parameters: Parameters::copyParameters.
@@ -51,6 +77,9 @@ private:
     /// Helper for checkAndComply()
     void updateExeParam(const std::shared_ptr<NOMAD::RunParameters>& runParams, const std::string& paramName);
 
+    /// Helper for checkAndComply(): copy the checked attribute values into the snapshot.
+    void setSnapshot();
+
 };
 
 #include "../nomad_nsend.hpp"
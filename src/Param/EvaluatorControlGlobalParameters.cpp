@@ -220,11 +220,21 @@ void NOMAD::EvaluatorControlGlobalParameters::checkAndComply(const std::shared_p
 #endif // _OPENMP
     
     
+    setSnapshot();
+
     _toBeChecked = false;
     
 }
 // End checkAndComply()
 
 
-
-
+/*----------------------------------------*/
+/*           snapshot (private)           */
+/*----------------------------------------*/
+void NOMAD::EvaluatorControlGlobalParameters::setSnapshot()
+{
+    // Values are read before _toBeChecked is reset: no check exception.
+#define NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) _snapshot.NAME = getSpValue<TYPE>(KEY, false);
+    #include "../Attribute/evaluatorControlGlobalAttributesDefinitionFields.hpp"
+#undef NOMAD_PARAMETER_FIELD
+}
@@ -6,6 +6,18 @@
 
 #include "../nomad_nsbegin.hpp"
 
+/// The global evaluator control attribute values after the last EvaluatorControlGlobalParameters::checkAndComply().
+/**
+ One field per attribute, with the attribute name. A field is accessed directly, without a lookup by name, and a snapshot is cheap to copy compared to the parameters.
+ The field list is created by the writeAttributeDefinition executable from the attribute definition txt files.
+ */
+struct EvaluatorControlGlobalParametersSnapshot
+{
+#define NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) TYPE NAME{};
+#include "../Attribute/evaluatorControlGlobalAttributesDefinitionFields.hpp"
+#undef NOMAD_PARAMETER_FIELD
+};
+
 /// The class for global EvaluatorControl parameters.
 /**
 - Register all parameters during construction.
@@ -13,6 +25,9 @@
 */
 class DLL_UTIL_API EvaluatorControlGlobalParameters final : public Parameters
 {
+private:
+    EvaluatorControlGlobalParametersSnapshot _snapshot; ///< Attribute values set by checkAndComply().
+
 public:
 
     explicit EvaluatorControlGlobalParameters()
@@ -24,6 +39,16 @@ public:
     /// Check the sanity of parameters.
     void checkAndComply(const std::shared_ptr<PbParameters>& pbParams = nullptr);
 
+    /// Access to the attribute values set by the last checkAndComply().
+    /**
+     An exception is triggered if the parameters need to be checked.
+     */
+    const EvaluatorControlGlobalParametersSnapshot& getSnapshot() const
+    {
+        verifyChecked();
+        return _snapshot;
+    }
+
 
 private:
 
@@ -33,6 +58,9 @@ private:
      */
     void init() override;
 
+    /// Helper for checkAndComply(): copy the checked attribute values into the snapshot.
+    void setSnapshot();
+
 };
 
 #include "../nomad_nsend.hpp"
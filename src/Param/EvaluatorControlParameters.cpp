@@ -99,11 +99,21 @@ void NOMAD::EvaluatorControlParameters::checkAndComply(
 
     }
 
+    setSnapshot();
+
     _toBeChecked = false;
 
 }
 // End checkAndComply()
 
 
-
-
+/*----------------------------------------*/
+/*           snapshot (private)           */
+/*----------------------------------------*/
+void NOMAD::EvaluatorControlParameters::setSnapshot()
+{
+    // Values are read before _toBeChecked is reset: no check exception.
+#define NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) _snapshot.NAME = getSpValue<TYPE>(KEY, false);
+    #include "../Attribute/evaluatorControlAttributesDefinitionFields.hpp"
+#undef NOMAD_PARAMETER_FIELD
+}
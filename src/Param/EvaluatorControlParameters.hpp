@@ -4,9 +4,22 @@
 
 #include "../Param/Parameters.hpp"
 #include "../Param/RunParameters.hpp"
+#include "../Type/EvalSortType.hpp"
 
 #include "../nomad_nsbegin.hpp"
 
+/// The evaluator control attribute values after the last EvaluatorControlParameters::checkAndComply().
+/**
+ One field per attribute, with the attribute name. A field is accessed directly, without a lookup by name, and a snapshot is cheap to copy compared to the parameters.
+ The field list is created by the writeAttributeDefinition executable from the attribute definition txt files.
+ */
+struct EvaluatorControlParametersSnapshot
+{
+#define NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) TYPE NAME{};
+#include "../Attribute/evaluatorControlAttributesDefinitionFields.hpp"
+#undef NOMAD_PARAMETER_FIELD
+};
+
 /// The class for EvaluatorControl parameters that may be different between main threads.
 /**
 - Register all parameters during construction.
@@ -14,6 +27,9 @@
 */
 class DLL_UTIL_API EvaluatorControlParameters final : public Parameters
 {
+private:
+    EvaluatorControlParametersSnapshot _snapshot; ///< Attribute values set by checkAndComply().
+
 public:
 
     explicit EvaluatorControlParameters()
@@ -40,6 +56,16 @@ public:
     void checkAndComply(const std::shared_ptr<NOMAD::EvaluatorControlGlobalParameters>& evaluatorControlGlobalParams = nullptr,
                         const std::shared_ptr<RunParameters>& runParams = nullptr);
 
+    /// Access to the attribute values set by the last checkAndComply().
+    /**
+     An exception is triggered if the parameters need to be checked.
+     */
+    const EvaluatorControlParametersSnapshot& getSnapshot() const
+    {
+        verifyChecked();
+        return _snapshot;
+    }
+
 private:
 
     /// Helper for constructor
@@ -48,6 +74,9 @@ private:
      */
     void init() override;
 
+    /// Helper for checkAndComply(): copy the checked attribute values into the snapshot.
+    void setSnapshot();
+
 };
 
 #include "../nomad_nsend.hpp"
@@ -177,6 +177,16 @@ bool NOMAD::Parameters::toBeChecked() const
 }
 
 
+void NOMAD::Parameters::verifyChecked() const
+{
+    if (_toBeChecked)
+    {
+        std::string err = "The snapshot of " + _typeName + " parameters is not available: checkAndComply() must be called";
+        throw NOMAD::ParameterToBeChecked(__FILE__,__LINE__, err);
+    }
+}
+
+
 std::vector<std::string> NOMAD::Parameters::getAttributeNames() const
 {
     std::vector<std::string> names;
@@ -1179,11 +1189,8 @@ NOMAD::SPtrAtt NOMAD::Parameters::getAttribute(std::string name) const
 {
     NOMAD::toupper(name);
 
-    auto it =   find_if(_attributes.begin(), _attributes.end(),
-                        [name](NOMAD::SPtrAtt const& Att)
-                        {
-                            return name.compare(Att->getName()) == 0;
-                        });
+    // Logarithmic search in the set ordered by name
+    auto it = _attributes.find(name);
 
     if (it != _attributes.end())
     {
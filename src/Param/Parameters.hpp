@@ -32,10 +32,21 @@ using SPAttribute = std::shared_ptr<const TypeAttribute<T>>;
 /// Comparator of shared_ptr<Attribute>
 struct lessThanAttribute
 {
+    /// Allow to find an attribute in a set by its name (see Parameters::getAttribute).
+    using is_transparent = void;
+
     bool operator()(const SPtrAtt& lhs, const SPtrAtt& rhs) const
     {
         return (lhs->getName() < rhs->getName());
     }
+    bool operator()(const SPtrAtt& lhs, const std::string& rhs) const
+    {
+        return (lhs->getName() < rhs);
+    }
+    bool operator()(const std::string& lhs, const SPtrAtt& rhs) const
+    {
+        return (lhs < rhs->getName());
+    }
 };
 
 /**
@@ -801,6 +812,16 @@ protected:
 
     void checkInfo() const ;
 
+    /// Replace the trace of the attributes set (see getSetAttributeAsString).
+    void resetSetAttributeTrace(const std::string& trace)
+    {
+        _streamedAttribute.str(trace);
+        _streamedAttribute.seekp(0, std::ios_base::end);
+    }
+
+    /// Trigger an exception if checkAndComply() must be called. Used for the access to the snapshot of attribute values.
+    void verifyChecked() const;
+
 };
 
 #include "../nomad_nsend.hpp"
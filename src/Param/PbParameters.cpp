@@ -197,6 +197,8 @@ void NOMAD::PbParameters::checkAndComply( )
     setAttributeValue("POINT_FORMAT", pointFormat);
     
 
+    setSnapshot();
+
     _toBeChecked = false;
 
 
@@ -204,6 +206,80 @@ void NOMAD::PbParameters::checkAndComply( )
 // End checkAndComply()
 
 
+/*----------------------------------------*/
+/*   update the parameters of a nested    */
+/*   optimization (subproblem)            */
+/*----------------------------------------*/
+void NOMAD::PbParameters::checkAndComplySubproblem(const NOMAD::ArrayOfPoint& x0s,
+                                                   const NOMAD::Point& fixedVariable,
+                                                   const NOMAD::ArrayOfDouble& initialFrameSize,
+                                                   const NOMAD::ArrayOfDouble& minFrameSize)
+{
+    if (toBeChecked())
+    {
+        throw NOMAD::ParameterToBeChecked(__FILE__,__LINE__, "checkAndComplySubproblem: the problem parameters must be checked with checkAndComply() first");
+    }
+
+    const size_t n = _snapshot.DIMENSION;
+
+    // The updates of a nested optimization can be frequent: do not accumulate them in the trace of attributes set.
+    const std::string setAttributeTrace = getSetAttributeAsString();
+
+    if (!x0s.empty())
+    {
+        for (const auto& x0 : x0s)
+        {
+            if (x0.size() != n)
+            {
+                std::string err = "Error: X0 " + x0.display() + " has dimension ";
+                err += std::to_string(x0.size()) + " which is different from ";
+                err += "problem dimension " + std::to_string(n);
+                throw NOMAD::InvalidParameter(__FILE__,__LINE__, err);
+            }
+        }
+        setAttributeValue("X0", x0s);
+    }
+
+    if (fixedVariable.size() > 0)
+    {
+        setAttributeValue("FIXED_VARIABLE", fixedVariable);
+    }
+
+    // Fixed variables are verified against X0 and the bounds.
+    setFixedVariables();
+    checkX0AgainstBounds();
+    checkX0ForGranularity();
+
+    if (minFrameSize.size() > 0)
+    {
+        setAttributeValue("MIN_FRAME_SIZE", minFrameSize);
+        setMinMeshParameters("MIN_FRAME_SIZE");
+        checkForGranularity("MIN_FRAME_SIZE");
+    }
+
+    if (initialFrameSize.size() > 0)
+    {
+        // The initial mesh size is computed from the initial frame size.
+        setAttributeValue("INITIAL_FRAME_SIZE", initialFrameSize);
+        resetToDefaultValue("INITIAL_MESH_SIZE");
+        setInitialMeshParameters();
+        checkForGranularity("INITIAL_MESH_SIZE");
+        checkForGranularity("INITIAL_FRAME_SIZE");
+    }
+
+    // Only the modified attributes are updated in the snapshot.
+    _snapshot.X0                    = getSpValue<NOMAD::ArrayOfPoint>("X0", false);
+    _snapshot.FIXED_VARIABLE        = getSpValue<NOMAD::Point>("FIXED_VARIABLE", false);
+    _snapshot.MIN_FRAME_SIZE        = getSpValue<NOMAD::ArrayOfDouble>("MIN_FRAME_SIZE", false);
+    _snapshot.INITIAL_MESH_SIZE     = getSpValue<NOMAD::ArrayOfDouble>("INITIAL_MESH_SIZE", false);
+    _snapshot.INITIAL_FRAME_SIZE    = getSpValue<NOMAD::ArrayOfDouble>("INITIAL_FRAME_SIZE", false);
+
+    resetSetAttributeTrace(setAttributeTrace);
+
+    _toBeChecked = false;
+}
+
+
 // Set and adjust GRANULARITY and BB_INPUT_TYPE.
 // Adjust LOWER_BOUND and UPPER_BOUND if needed.
 void NOMAD::PbParameters::setGranularityAndBBInputType()
@@ -813,4 +889,13 @@ void NOMAD::PbParameters::checkForGranularity(const std::string &paramName, cons
 }
 
 
-
+/*----------------------------------------*/
+/*           snapshot (private)           */
+/*----------------------------------------*/
+void NOMAD::PbParameters::setSnapshot()
+{
+    // Values are read before _toBeChecked is reset: no check exception.
+#define NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) _snapshot.NAME = getSpValue<TYPE>(KEY, false);
+    #include "../Attribute/pbAttributesDefinitionFields.hpp"
+#undef NOMAD_PARAMETER_FIELD
+}
@@ -2,10 +2,23 @@
 #define __NOMAD_4_5_PBPARAMETERS__
 
 #include "../Param/Parameters.hpp"
+#include "../Type/BBInputType.hpp"
 
 #include "../nomad_platform.hpp"
 #include "../nomad_nsbegin.hpp"
 
+/// The problem attribute values after the last PbParameters::checkAndComply().
+/**
+ One field per attribute, with the attribute name. A field is accessed directly, without a lookup by name, and a snapshot is cheap to copy compared to the parameters.
+ The field list is created by the writeAttributeDefinition executable from the attribute definition txt files.
+ */
+struct PbParametersSnapshot
+{
+#define NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) TYPE NAME{};
+#include "../Attribute/pbAttributesDefinitionFields.hpp"
+#undef NOMAD_PARAMETER_FIELD
+};
+
 /// The class for the parameters defining the optimization problem.
 /**
 - Register all parameters during construction.
@@ -14,6 +27,7 @@
 class DLL_UTIL_API PbParameters final : public Parameters
 {
 private:
+    PbParametersSnapshot _snapshot; ///< Attribute values set by checkAndComply().
     bool _showWarningMeshSizeRedefined;
 
 public:
@@ -38,6 +52,31 @@ public:
     /// Check the sanity of parameters.
     void checkAndComply( );
 
+    /// Access to the attribute values set by the last checkAndComply().
+    /**
+     An exception is triggered if the parameters need to be checked.
+     */
+    const PbParametersSnapshot& getSnapshot() const
+    {
+        verifyChecked();
+        return _snapshot;
+    }
+
+    /// Lightweight update of the parameters for a nested optimization.
+    /**
+     Only X0, FIXED_VARIABLE, INITIAL_FRAME_SIZE and MIN_FRAME_SIZE are modified, in place. The parameters must have been checked before: the checks that do not depend on these attributes (dimension, bounds, granularity, input types, variable groups...) are not done again. When INITIAL_FRAME_SIZE is given, INITIAL_MESH_SIZE is recomputed from it.
+     An empty argument keeps the current value of the attribute.
+
+     \param x0s                The new X0 -- \b IN.
+     \param fixedVariable      The new FIXED_VARIABLE -- \b IN.
+     \param initialFrameSize   The new INITIAL_FRAME_SIZE -- \b IN.
+     \param minFrameSize       The new MIN_FRAME_SIZE -- \b IN.
+     */
+    void checkAndComplySubproblem(const ArrayOfPoint& x0s,
+                                  const Point& fixedVariable,
+                                  const ArrayOfDouble& initialFrameSize = ArrayOfDouble(),
+                                  const ArrayOfDouble& minFrameSize = ArrayOfDouble());
+
     /// Do not show certain warnings
     void doNotShowWarnings() { _showWarningMeshSizeRedefined = false; }
 
@@ -68,6 +107,9 @@ private:
     void checkForGranularity(const std::string &paramName,
                              const ArrayOfDouble &arrayToCheck) const;
 
+    /// Helper for checkAndComply(): copy the checked attribute values into the snapshot.
+    void setSnapshot();
+
 };
 
 #include "../nomad_nsend.hpp"
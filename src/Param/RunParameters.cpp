@@ -672,6 +672,11 @@ void NOMAD::RunParameters::checkAndComply(
         throw NOMAD::Exception(__FILE__,__LINE__, "Parameters check: QUAD_MODEL_SEARCH_BOUND_REDUCTION_FACTOR must be strictly greater than 0");
     }
 
+    if (0 == getAttributeValueProtected<size_t>("QUAD_MODEL_SEARCH_NB_STARTS", false))
+    {
+        throw NOMAD::Exception(__FILE__,__LINE__, "Parameters check: QUAD_MODEL_SEARCH_NB_STARTS must be strictly greater than 0");
+    }
+
     auto projectOnMesh = getAttributeValueProtected<bool>("SEARCH_METHOD_MESH_PROJECTION", false);
     auto granularity = pbParams->getAttributeValue<NOMAD::ArrayOfDouble>("GRANULARITY");
     if (!projectOnMesh && granularity != NOMAD::ArrayOfDouble(n,0.0))
@@ -681,6 +686,8 @@ void NOMAD::RunParameters::checkAndComply(
 
     _warningUnknownParamShown = true;
 
+    setSnapshot();
+
     _toBeChecked = false;
 }
 // End checkAndComply()
@@ -799,3 +806,27 @@ bool NOMAD::RunParameters::setListFixVGForQuadModelSearch(const std::shared_ptr<
     _fixVGForQMS = listFixVG;
     return true;
 }
+
+
+/*----------------------------------------*/
+/*           snapshot (private)           */
+/*----------------------------------------*/
+void NOMAD::RunParameters::setSnapshot()
+{
+    // Values are read before _toBeChecked is reset: no check exception.
+#define NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) _snapshot.NAME = getSpValue<TYPE>(KEY, false);
+    #include "../Attribute/runAttributesDefinitionFields.hpp"
+    #include "../Attribute/runAttributesDefinitionDMultiFields.hpp"
+    #include "../Attribute/runAttributesDefinitionIBEXFields.hpp"
+    #include "../Attribute/runAttributesDefinitionLHFields.hpp"
+    #include "../Attribute/runAttributesDefinitionCSFields.hpp"
+    #include "../Attribute/runAttributesDefinitionNMFields.hpp"
+    #include "../Attribute/runAttributesDefinitionPSDSSDFields.hpp"
+    #include "../Attribute/runAttributesDefinitionCOOPFields.hpp"
+    #include "../Attribute/runAttributesDefinitionQPSolverFields.hpp"
+    #include "../Attribute/runAttributesDefinitionQuadModelFields.hpp"
+    #include "../Attribute/runAttributesDefinitionSgtelibModelFields.hpp"
+    #include "../Attribute/runAttributesDefinitionVNSFields.hpp"
+    #include "../Attribute/runAttributesDefinitionDiscoFields.hpp"
+#undef NOMAD_PARAMETER_FIELD
+}
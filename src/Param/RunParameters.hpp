@@ -4,9 +4,39 @@
 #include "../Param/EvaluatorControlGlobalParameters.hpp"
 #include "../Param/Parameters.hpp"
 #include "../Param/PbParameters.hpp"
+#include "../Type/ComputeType.hpp"
+#include "../Type/DMultiMadsSearchStrategyType.hpp"
+#include "../Type/LHSearchType.hpp"
+#include "../Type/SgtelibModelFeasibilityType.hpp"
+#include "../Type/SgtelibModelFormulationType.hpp"
+#include "../Util/ArrayOfString.hpp"
 
 #include "../nomad_nsbegin.hpp"
 
+/// The run attribute values after the last RunParameters::checkAndComply().
+/**
+ One field per attribute, with the attribute name. A field is accessed directly, without a lookup by name, and a snapshot is cheap to copy compared to the parameters.
+ The field list is created by the writeAttributeDefinition executable from the attribute definition txt files.
+ */
+struct RunParametersSnapshot
+{
+#define NOMAD_PARAMETER_FIELD(TYPE, NAME, KEY) TYPE NAME{};
+#include "../Attribute/runAttributesDefinitionFields.hpp"
+#include "../Attribute/runAttributesDefinitionDMultiFields.hpp"
+#include "../Attribute/runAttributesDefinitionIBEXFields.hpp"
+#include "../Attribute/runAttributesDefinitionLHFields.hpp"
+#include "../Attribute/runAttributesDefinitionCSFields.hpp"
+#include "../Attribute/runAttributesDefinitionNMFields.hpp"
+#include "../Attribute/runAttributesDefinitionPSDSSDFields.hpp"
+#include "../Attribute/runAttributesDefinitionCOOPFields.hpp"
+#include "../Attribute/runAttributesDefinitionQPSolverFields.hpp"
+#include "../Attribute/runAttributesDefinitionQuadModelFields.hpp"
+#include "../Attribute/runAttributesDefinitionSgtelibModelFields.hpp"
+#include "../Attribute/runAttributesDefinitionVNSFields.hpp"
+#include "../Attribute/runAttributesDefinitionDiscoFields.hpp"
+#undef NOMAD_PARAMETER_FIELD
+};
+
 /// The class for the parameters defining the type of optimization/task to perform.
 /**
 The RunParameter are used by other parameters to update their value during sanity check.
@@ -17,6 +47,7 @@ The RunParameter are used by other parameters to update their value during sanit
 class DLL_UTIL_API RunParameters final : public Parameters
 {
 private:
+    RunParametersSnapshot _snapshot; ///< Attribute values set by checkAndComply().
     static bool _warningUnknownParamShown;
     
     // Map direction type and variable group for poll
@@ -43,6 +74,16 @@ public:
     */
     void checkAndComply(const std::shared_ptr<EvaluatorControlGlobalParameters>& evaluatorControlGlobalParams,
                         const std::shared_ptr<PbParameters>& pbParams);
+
+    /// Access to the attribute values set by the last checkAndComply().
+    /**
+     An exception is triggered if the parameters need to be checked.
+     */
+    const RunParametersSnapshot& getSnapshot() const
+    {
+        verifyChecked();
+        return _snapshot;
+    }
     
     
     // ChT. These set and get are temp methods for CatMads
@@ -62,6 +103,9 @@ private:
     /// Helper for checkAndComply()
     void setStaticParameters();
 
+    /// Helper for checkAndComply(): copy the checked attribute values into the snapshot.
+    void setSnapshot();
+
 };
 
 #include "../nomad_nsend.hpp"
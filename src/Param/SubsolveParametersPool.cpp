@@ -0,0 +1,73 @@
+
+#include "../Param/SubsolveParametersPool.hpp"
+
+NOMAD::SubsolveParametersPool::SubsolveParametersPool(const std::shared_ptr<NOMAD::PbParameters>& refPbParams,
+                                                      const std::shared_ptr<NOMAD::RunParameters>& refRunParams,
+                                                      const std::shared_ptr<NOMAD::EvaluatorControlGlobalParameters>& evcParams,
+                                                      const SetupFunction& setup)
+  : _basePbParams(nullptr),
+    _runParams(nullptr),
+    _pbParamsPool()
+{
+    if (nullptr == refPbParams || nullptr == refRunParams)
+    {
+        throw NOMAD::Exception(__FILE__, __LINE__, "SubsolveParametersPool: valid problem and run parameters must be provided.");
+    }
+
+    _basePbParams = std::make_shared<NOMAD::PbParameters>(*refPbParams);
+    _runParams = std::make_shared<NOMAD::RunParameters>(*refRunParams);
+
+    if (nullptr != setup)
+    {
+        setup(*_basePbParams, *_runParams);
+    }
+
+    // We do not want certain warnings appearing in sub-optimization.
+    _basePbParams->doNotShowWarnings();
+    _basePbParams->checkAndComply();
+    _runParams->checkAndComply(evcParams, _basePbParams);
+}
+
+
+std::shared_ptr<NOMAD::PbParameters> NOMAD::SubsolveParametersPool::acquirePbParams(const NOMAD::ArrayOfPoint& x0s,
+                                                                                     const NOMAD::Point& fixedVariable,
+                                                                                     const NOMAD::ArrayOfDouble& initialFrameSize,
+                                                                                     const NOMAD::ArrayOfDouble& minFrameSize)
+{
+    // Problem parameters are available when the pool is their only owner.
+    std::shared_ptr<NOMAD::PbParameters> pbParams = nullptr;
+    for (const auto& pooledPbParams : _pbParamsPool)
+    {
+        if (1 == pooledPbParams.use_count())
+        {
+            pbParams = pooledPbParams;
+            break;
+        }
+    }
+
+    if (nullptr == pbParams)
+    {
+        // Full copy and check, done once for each problem parameters of the pool.
+        pbParams = std::make_shared<NOMAD::PbParameters>(*_basePbParams);
+        pbParams->doNotShowWarnings();
+        pbParams->checkAndComply();
+        _pbParamsPool.push_back(pbParams);
+    }
+
+    const auto& base = _basePbParams->getSnapshot();
+    const auto& current = pbParams->getSnapshot();
+
+    // Mesh sizes are recomputed only when the frame sizes change.
+    // The initial frame size is adjusted to the min frame size.
+    const NOMAD::ArrayOfDouble& frameSize = (initialFrameSize.size() > 0) ? initialFrameSize : base.INITIAL_FRAME_SIZE;
+    const NOMAD::ArrayOfDouble& minFrame = (minFrameSize.size() > 0) ? minFrameSize : base.MIN_FRAME_SIZE;
+    const bool updateMinFrame = (minFrame != current.MIN_FRAME_SIZE);
+    const bool updateFrameSize = updateMinFrame || (frameSize != current.INITIAL_FRAME_SIZE);
+
+    pbParams->checkAndComplySubproblem((x0s.empty()) ? base.X0 : x0s,
+                                       (fixedVariable.size() > 0) ? fixedVariable : base.FIXED_VARIABLE,
+                                       (updateFrameSize) ? frameSize : NOMAD::ArrayOfDouble(),
+                                       (updateMinFrame) ? minFrame : NOMAD::ArrayOfDouble());
+
+    return pbParams;
+}
@@ -0,0 +1,75 @@
+#ifndef __NOMAD_4_5_SUBSOLVEPARAMETERSPOOL__
+#define __NOMAD_4_5_SUBSOLVEPARAMETERSPOOL__
+
+#include <functional>
+#include <vector>
+
+#include "../Param/EvaluatorControlGlobalParameters.hpp"
+#include "../Param/PbParameters.hpp"
+#include "../Param/RunParameters.hpp"
+
+#include "../nomad_nsbegin.hpp"
+
+/// Reusable parameters for nested optimizations (sub-solves).
+/**
+ A nested optimization (extended poll, model optimization, multi-start...) uses problem and run parameters that differ from the reference parameters by a few attributes only. Copying and checking all the parameters for each nested optimization is expensive.
+
+- The reference parameters are copied and checked once, with the attributes common to all the nested optimizations (setup function).
+- The run parameters are shared by all the nested optimizations.
+- The problem parameters of a nested optimization are obtained with acquirePbParams(). Only X0, FIXED_VARIABLE, INITIAL_FRAME_SIZE and MIN_FRAME_SIZE are changed, in place (see PbParameters::checkAndComplySubproblem).
+- Problem parameters are reused when the pool is their only owner, that is when the nested optimization that used them is destroyed.
+
+ The pool is not thread safe: acquirePbParams() must be called from a single thread.
+ */
+class DLL_UTIL_API SubsolveParametersPool
+{
+public:
+    /// Function to set the attributes common to all the nested optimizations.
+    typedef std::function<void(PbParameters&, RunParameters&)> SetupFunction;
+
+private:
+    std::shared_ptr<PbParameters>   _basePbParams;  ///< Checked copy of the reference problem parameters, with the common attributes.
+    std::shared_ptr<RunParameters>  _runParams;     ///< Checked copy of the reference run parameters, with the common attributes.
+
+    std::vector<std::shared_ptr<PbParameters>> _pbParamsPool;  ///< The problem parameters given to the nested optimizations.
+
+public:
+    /// Constructor
+    /**
+     \param refPbParams     The reference problem parameters -- \b IN.
+     \param refRunParams    The reference run parameters -- \b IN.
+     \param evcParams       The evaluator control global parameters, used to check the run parameters -- \b IN.
+     \param setup           Function to set the attributes common to all the nested optimizations. Can be null -- \b IN.
+     */
+    explicit SubsolveParametersPool(const std::shared_ptr<PbParameters>& refPbParams,
+                                    const std::shared_ptr<RunParameters>& refRunParams,
+                                    const std::shared_ptr<EvaluatorControlGlobalParameters>& evcParams,
+                                    const SetupFunction& setup = nullptr);
+
+    /// Get checked problem parameters for a nested optimization.
+    /**
+     An empty argument gives the value of the reference problem parameters (after setup).
+     The parameters must not be modified by the nested optimization.
+
+     \param x0s                 The X0 of the nested optimization -- \b IN.
+     \param fixedVariable       The FIXED_VARIABLE of the nested optimization -- \b IN.
+     \param initialFrameSize    The INITIAL_FRAME_SIZE of the nested optimization. INITIAL_MESH_SIZE is computed from it -- \b IN.
+     \param minFrameSize        The MIN_FRAME_SIZE of the nested optimization -- \b IN.
+     \return                    The problem parameters.
+     */
+    std::shared_ptr<PbParameters> acquirePbParams(const ArrayOfPoint& x0s,
+                                                  const Point& fixedVariable = Point(),
+                                                  const ArrayOfDouble& initialFrameSize = ArrayOfDouble(),
+                                                  const ArrayOfDouble& minFrameSize = ArrayOfDouble());
+
+    /// Get the checked run parameters shared by the nested optimizations.
+    const std::shared_ptr<RunParameters>& getRunParams() const { return _runParams; }
+
+    /// Number of problem parameters created by the pool.
+    size_t size() const { return _pbParamsPool.size(); }
+
+};
+
+#include "../nomad_nsend.hpp"
+
+#endif // __NOMAD_4_5_SUBSOLVEPARAMETERSPOOL__
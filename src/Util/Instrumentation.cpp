@@ -0,0 +1,261 @@
+/**
+ \file   Instrumentation.cpp
+ \brief  Scoped timers, event counters and latency histograms per StepType (implementation)
+ \see    Instrumentation.hpp
+ */
+
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "../Util/Instrumentation.hpp"
+
+namespace {
+
+    const size_t NB_STEP_TYPES = static_cast<size_t>(NOMAD::StepType::UPDATE) + 1;
+    const size_t NB_COUNTERS = static_cast<size_t>(NOMAD::InstrumentationCounter::NB_COUNTERS);
+
+    /// Statistics of a single thread. Only this thread writes into it.
+    struct ThreadProfile
+    {
+        std::array<NOMAD::InstrumentationStepStats, NB_STEP_TYPES> stepStats{};
+        std::array<size_t, NB_COUNTERS> counters{};
+    };
+
+    // Profiles are owned here so that they survive the threads that filled them.
+    std::mutex _profilesMutex;
+    std::vector<std::unique_ptr<ThreadProfile>> _profiles;
+
+    ThreadProfile& getThreadProfile()
+    {
+        // The lock is taken only the first time a thread records something.
+        thread_local ThreadProfile* threadProfile = nullptr;
+        if (nullptr == threadProfile)
+        {
+            std::lock_guard<std::mutex> lock(_profilesMutex);
+            _profiles.push_back(std::make_unique<ThreadProfile>());
+            threadProfile = _profiles.back().get();
+        }
+        return *threadProfile;
+    }
+
+    size_t histogramBin(double wallTime)
+    {
+        size_t bin = 0;
+        auto us = static_cast<unsigned long long>(wallTime * 1e6);
+        while (us > 0 && bin < NOMAD::InstrumentationStepStats::NB_HISTOGRAM_BINS - 1)
+        {
+            us >>= 1;
+            bin++;
+        }
+        return bin;
+    }
+}
+
+
+std::string NOMAD::instrumentationCounterToString(const NOMAD::InstrumentationCounter counter)
+{
+    switch (counter)
+    {
+        case NOMAD::InstrumentationCounter::CACHE_HIT:
+            return "CACHE_HIT";
+        case NOMAD::InstrumentationCounter::CACHE_INSERT:
+            return "CACHE_INSERT";
+        case NOMAD::InstrumentationCounter::EVAL_QUEUE_PUSH:
+            return "EVAL_QUEUE_PUSH";
+        case NOMAD::InstrumentationCounter::EVAL_BLOCK:
+            return "EVAL_BLOCK";
+        case NOMAD::InstrumentationCounter::MODEL_BUILD:
+            return "MODEL_BUILD";
+        case NOMAD::InstrumentationCounter::EXTERNAL_CALL:
+            return "EXTERNAL_CALL";
+        default:
+            return "UNDEFINED";
+    }
+}
+
+
+void NOMAD::InstrumentationStepStats::add(double wall, double cpu)
+{
+    count++;
+    wallTime += wall;
+    cpuTime += cpu;
+    if (wall > maxWallTime)
+    {
+        maxWallTime = wall;
+    }
+    histogram[histogramBin(wall)]++;
+}
+
+
+void NOMAD::InstrumentationStepStats::merge(const NOMAD::InstrumentationStepStats& other)
+{
+    count += other.count;
+    wallTime += other.wallTime;
+    cpuTime += other.cpuTime;
+    if (other.maxWallTime > maxWallTime)
+    {
+        maxWallTime = other.maxWallTime;
+    }
+    for (size_t i = 0; i < NB_HISTOGRAM_BINS; i++)
+    {
+        histogram[i] += other.histogram[i];
+    }
+}
+
+
+void NOMAD::Instrumentation::addTime(const NOMAD::StepType& stepType, double wallTime, double cpuTime)
+{
+    getThreadProfile().stepStats[static_cast<size_t>(stepType)].add(wallTime, cpuTime);
+}
+
+
+void NOMAD::Instrumentation::incCounter(const NOMAD::InstrumentationCounter counter, size_t n)
+{
+    getThreadProfile().counters[static_cast<size_t>(counter)] += n;
+}
+
+
+NOMAD::InstrumentationStepStats NOMAD::Instrumentation::getStepStats(const NOMAD::StepType& stepType)
+{
+    NOMAD::InstrumentationStepStats stats;
+    std::lock_guard<std::mutex> lock(_profilesMutex);
+    for (const auto& profile : _profiles)
+    {
+        stats.merge(profile->stepStats[static_cast<size_t>(stepType)]);
+    }
+    return stats;
+}
+
+
+size_t NOMAD::Instrumentation::getCounter(const NOMAD::InstrumentationCounter counter)
+{
+    size_t n = 0;
+    std::lock_guard<std::mutex> lock(_profilesMutex);
+    for (const auto& profile : _profiles)
+    {
+        n += profile->counters[static_cast<size_t>(counter)];
+    }
+    return n;
+}
+
+
+void NOMAD::Instrumentation::reset()
+{
+    std::lock_guard<std::mutex> lock(_profilesMutex);
+    for (auto& profile : _profiles)
+    {
+        *profile = ThreadProfile();
+    }
+}
+
+
+bool NOMAD::Instrumentation::writeProfile(const std::string& fileName)
+{
+    std::ofstream out(fileName, std::ofstream::out | std::ios::trunc);
+    if (out.fail())
+    {
+        return false;
+    }
+
+    const bool csv = (fileName.size() >= 4 && 0 == fileName.compare(fileName.size() - 4, 4, ".csv"));
+
+    if (csv)
+    {
+        out << "type,name,count,wall_time,cpu_time,max_wall_time,histogram_us" << std::endl;
+    }
+    else
+    {
+        out << "{" << std::endl << "  \"steps\": [";
+    }
+
+    bool first = true;
+    for (size_t i = 0; i < NB_STEP_TYPES; i++)
+    {
+        const auto stepType = static_cast<NOMAD::StepType>(i);
+        const auto stats = getStepStats(stepType);
+        if (0 == stats.count)
+        {
+            continue;
+        }
+
+        // Histogram is written up to the last non-empty bin.
+        size_t nbBins = NOMAD::InstrumentationStepStats::NB_HISTOGRAM_BINS;
+        while (nbBins > 0 && 0 == stats.histogram[nbBins - 1])
+        {
+            nbBins--;
+        }
+
+        const std::string name = NOMAD::stepTypeToString(stepType);
+        if (csv)
+        {
+            out << "step,\"" << name << "\"," << stats.count << "," << stats.wallTime << ","
+                << stats.cpuTime << "," << stats.maxWallTime << ",";
+            for (size_t bin = 0; bin < nbBins; bin++)
+            {
+                out << (bin > 0 ? ";" : "") << stats.histogram[bin];
+            }
+            out << std::endl;
+        }
+        else
+        {
+            out << (first ? "" : ",") << std::endl;
+            out << "    { \"step\": \"" << name << "\", \"count\": " << stats.count
+                << ", \"wall_time\": " << stats.wallTime << ", \"cpu_time\": " << stats.cpuTime
+                << ", \"max_wall_time\": " << stats.maxWallTime << ", \"histogram_us\": [";
+            for (size_t bin = 0; bin < nbBins; bin++)
+            {
+                out << (bin > 0 ? ", " : "") << stats.histogram[bin];
+            }
+            out << "] }";
+        }
+        first = false;
+    }
+
+    if (!csv)
+    {
+        out << std::endl << "  ]," << std::endl << "  \"counters\": {";
+    }
+    for (size_t i = 0; i < NB_COUNTERS; i++)
+    {
+        const auto counter = static_cast<NOMAD::InstrumentationCounter>(i);
+        const std::string name = NOMAD::instrumentationCounterToString(counter);
+        if (csv)
+        {
+            out << "counter," << name << "," << getCounter(counter) << ",,,," << std::endl;
+        }
+        else
+        {
+            out << (i > 0 ? "," : "") << std::endl;
+            out << "    \"" << name << "\": " << getCounter(counter);
+        }
+    }
+    if (!csv)
+    {
+        out << std::endl << "  }" << std::endl << "}" << std::endl;
+    }
+
+    return !out.fail();
+}
+
+
+double NOMAD::Instrumentation::getWallTime()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+double NOMAD::Instrumentation::getThreadCPUTime()
+{
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + 1e-9 * static_cast<double>(ts.tv_nsec);
+#else
+    // No per-thread CPU clock: use process CPU time.
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
@@ -0,0 +1,120 @@
+/**
+ \file   Instrumentation.hpp
+ \brief  Scoped timers, event counters and latency histograms per StepType
+ \see    Instrumentation.cpp
+ */
+#ifndef __NOMAD_4_5_INSTRUMENTATION__
+#define __NOMAD_4_5_INSTRUMENTATION__
+
+#include <array>
+#include <string>
+
+#include "../Type/StepType.hpp"
+
+#include "../nomad_platform.hpp"
+#include "../nomad_nsbegin.hpp"
+
+/// Events counted by the instrumentation.
+enum class InstrumentationCounter
+{
+    CACHE_HIT,          ///< Point found in cache instead of being evaluated
+    CACHE_INSERT,       ///< Call to cache smart insert
+    EVAL_QUEUE_PUSH,    ///< Point added to the evaluation queue
+    EVAL_BLOCK,         ///< Block of points sent to an evaluator
+    MODEL_BUILD,        ///< Quad or sgtelib model build attempt (successful or not)
+    EXTERNAL_CALL,      ///< Call to an external process (Python script, blackbox executable)
+    NB_COUNTERS         ///< Number of counters. Must be last.
+};
+
+/// Utility to convert a counter to a string.
+DLL_UTIL_API std::string instrumentationCounterToString(const InstrumentationCounter counter);
+
+
+/// Time and count statistics for a single StepType.
+struct DLL_UTIL_API InstrumentationStepStats
+{
+    /// Histogram bin i holds the events with wall time in [2^(i-1), 2^i) microseconds.
+    static const size_t NB_HISTOGRAM_BINS = 32;
+
+    size_t count = 0;           ///< Number of timed events
+    double wallTime = 0.0;      ///< Total wall time (s)
+    double cpuTime = 0.0;       ///< Total CPU time of the calling thread (s)
+    double maxWallTime = 0.0;   ///< Longest event (s)
+    std::array<size_t, NB_HISTOGRAM_BINS> histogram{};
+
+    void add(double wall, double cpu);
+    void merge(const InstrumentationStepStats& other);
+};
+
+
+/// Instrumentation of the optimizer overhead.
+/**
+ Statistics are accumulated per thread, without locks, and merged when
+ the profile is written. Timers are inclusive: time spent in a sub-step is
+ also counted in the parent step.\n
+ Instrumentation is collected only when NOMAD is built with TIME_STATS.
+ The profile is written at the end of the run if PROFILE_FILE is set.
+ */
+class DLL_UTIL_API Instrumentation
+{
+public:
+    // No need for constructor. All is static.
+
+    /// Add a timed event for this step type, on the current thread.
+    static void addTime(const StepType& stepType, double wallTime, double cpuTime);
+
+    /// Increment a counter, on the current thread.
+    static void incCounter(const InstrumentationCounter counter, size_t n = 1);
+
+    /// Merge the statistics of all threads for this step type.
+    static InstrumentationStepStats getStepStats(const StepType& stepType);
+
+    /// Merge the counts of all threads for this counter.
+    static size_t getCounter(const InstrumentationCounter counter);
+
+    /// Clear all statistics. Threads must not be timing anything.
+    static void reset();
+
+    /// Write the merged profile. Format is CSV if the file name ends with ".csv", JSON otherwise.
+    /**
+     \return \c true if the file was written.
+     */
+    static bool writeProfile(const std::string& fileName);
+
+    /// Wall time from a monotonic clock (s).
+    static double getWallTime();
+
+    /// CPU time of the calling thread (s).
+    static double getThreadCPUTime();
+};
+
+
+/// Time the enclosing scope and add it to the instrumentation of a StepType.
+class DLL_UTIL_API ScopedTimer
+{
+private:
+    const StepType  _stepType;
+    const double    _wallStartTime;
+    const double    _cpuStartTime;
+
+public:
+    explicit ScopedTimer(const StepType& stepType)
+      : _stepType(stepType),
+        _wallStartTime(Instrumentation::getWallTime()),
+        _cpuStartTime(Instrumentation::getThreadCPUTime())
+    {}
+
+    ~ScopedTimer()
+    {
+        Instrumentation::addTime(_stepType,
+                                 Instrumentation::getWallTime() - _wallStartTime,
+                                 Instrumentation::getThreadCPUTime() - _cpuStartTime);
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+#include "../nomad_nsend.hpp"
+
+#endif // __NOMAD_4_5_INSTRUMENTATION__